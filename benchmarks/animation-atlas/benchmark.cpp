@@ -0,0 +1,142 @@
+#include <centurion.hpp>
+
+#include <cmath>   // fmod
+#include <random>  // mt19937, uniform_real_distribution
+#include <vector>  // vector
+
+#include "benchmark_utils.hpp"
+
+namespace {
+
+inline constexpr int kFrames = 200;
+inline constexpr int kInstanceCount = 10'000;
+inline constexpr int kAnimationFrames = 48;
+inline constexpr int kFrameDelay = 40;
+inline constexpr cen::iarea kFrameSize {64, 48};
+
+/// Creates an animation from crops of the panda image, allocated like SDL_image does.
+[[nodiscard]] auto make_animation(const cen::surface& panda) -> cen::animation
+{
+  auto* anim = static_cast<IMG_Animation*>(SDL_calloc(1, sizeof(IMG_Animation)));
+  anim->w = kFrameSize.width;
+  anim->h = kFrameSize.height;
+  anim->count = kAnimationFrames;
+  anim->frames = static_cast<SDL_Surface**>(SDL_calloc(kAnimationFrames, sizeof(SDL_Surface*)));
+  anim->delays = static_cast<int*>(SDL_calloc(kAnimationFrames, sizeof(int)));
+
+  for (int i = 0; i < kAnimationFrames; ++i) {
+    auto* frame = SDL_CreateRGBSurfaceWithFormat(0,
+                                                 kFrameSize.width,
+                                                 kFrameSize.height,
+                                                 32,
+                                                 SDL_PIXELFORMAT_ARGB8888);
+
+    SDL_Rect src {i % 4 * 8, i / 4 * 2, kFrameSize.width, kFrameSize.height};
+    SDL_BlitSurface(panda.get(), &src, frame, nullptr);
+
+    anim->frames[i] = frame;
+    anim->delays[i] = kFrameDelay;
+  }
+
+  return cen::animation {anim};
+}
+
+struct instance final {
+  double start {};
+  cen::frect dst;
+};
+
+}  // namespace
+
+int main(int, char**)
+{
+  const cen::sdl sdl;
+  const cen::img img;
+
+  cen::window window {"Animation atlas benchmark"};
+  cen::renderer renderer = window.make_renderer(cen::renderer::accelerated);
+
+  const cen::surface panda {RESOURCE_DIR "panda.png"};
+
+  const auto eagerMs = bench::measure_ms(5, [&] {
+    const cen::animation_atlas atlas {renderer, make_animation(panda), cen::frame_upload::eager};
+  });
+
+  const auto lazyMs = bench::measure_ms(5, [&] {
+    const cen::animation_atlas atlas {renderer, make_animation(panda), cen::frame_upload::lazy};
+  });
+
+  std::mt19937 engine {42};
+  std::uniform_real_distribution<float> pos {0, 750};
+  std::uniform_real_distribution<double> offset {0, kAnimationFrames * kFrameDelay};
+
+  std::vector<instance> instances;
+  instances.reserve(kInstanceCount);
+
+  for (int i = 0; i < kInstanceCount; ++i) {
+    instances.push_back({-offset(engine), cen::frect {pos(engine), pos(engine), 32, 24}});
+  }
+
+  window.show();
+
+  // The naive approach, with a texture per frame and a linear search for the current frame
+  auto frames = make_animation(panda);
+  std::vector<cen::texture> textures;
+  for (int i = 0; i < frames.count(); ++i) {
+    textures.push_back(renderer.make_texture(frames.at(static_cast<cen::usize>(i))));
+  }
+
+  const auto duration = static_cast<double>(kAnimationFrames * kFrameDelay);
+  double time {};
+
+  const auto perFrame = bench::measure_ms(kFrames, [&] {
+    renderer.clear_with(cen::colors::black);
+    time += 1'000.0 / 60.0;
+
+    for (const auto& inst : instances) {
+      auto elapsed = static_cast<int>(std::fmod(time - inst.start, duration));
+
+      cen::usize index = 0;
+      while (elapsed >= frames.delay(index)) {
+        elapsed -= frames.delay(index);
+        ++index;
+      }
+
+      renderer.render(textures[index], inst.dst);
+    }
+
+    renderer.present();
+  });
+
+  cen::animation_atlas atlas {renderer, make_animation(panda)};
+  cen::animation_player player {atlas};
+  cen::sprite_batch batch;
+  batch.reserve(instances.size());
+
+  std::vector<cen::animation_state> states;
+  for (const auto& inst : instances) {
+    states.push_back({inst.start, 1.0f, true});
+  }
+
+  const auto batched = bench::measure_ms(kFrames, [&] {
+    renderer.clear_with(cen::colors::black);
+    player.update(cen::seconds<double> {1.0 / 60.0});
+
+    for (cen::usize i = 0; i < states.size(); ++i) {
+      const auto frame = player.frame(states[i]);
+      batch.add(frame.atlas(), frame.region(), instances[i].dst);
+    }
+
+    batch.flush(renderer);
+    renderer.present();
+  });
+
+  window.hide();
+
+  bench::report("animation_atlas, eager upload", eagerMs, 0);
+  bench::report("animation_atlas, lazy upload", lazyMs, 0);
+  bench::report("texture per frame", perFrame, instances.size());
+  bench::report("animation_player + sprite_batch", batched, batch.draw_calls());
+
+  return 0;
+}
@@ -0,0 +1,68 @@
+#ifndef CENTURION_BENCHMARKS_BENCHMARK_UTILS_HPP_
+#define CENTURION_BENCHMARKS_BENCHMARK_UTILS_HPP_
+
+#include <centurion.hpp>
+
+#include <cstring>   // memcpy
+#include <iomanip>   // setw, setprecision
+#include <iostream>  // cout
+
+namespace bench {
+
+/// Runs the function the specified amount of times and returns the mean time in milliseconds.
+template <typename Fn>
+[[nodiscard]] auto measure_ms(const int iterations, Fn&& fn) -> double
+{
+  const auto start = cen::now();
+
+  for (int i = 0; i < iterations; ++i) {
+    fn();
+  }
+
+  const auto end = cen::now();
+  const auto seconds = static_cast<double>(end - start) / static_cast<double>(cen::frequency());
+
+  return (seconds * 1'000.0) / static_cast<double>(iterations);
+}
+
+inline void report(const char* name, const double ms, const cen::usize drawCalls)
+{
+  std::cout << std::left << std::setw(32) << name << std::right << std::fixed
+            << std::setprecision(3) << std::setw(10) << ms << " ms/frame" << std::setw(10)
+            << drawCalls << " draw calls\n";
+}
+
+/// Reports a CPU-bound image operation, along with its throughput in megapixels per second.
+inline void report_pixels(const char* name, const double ms, const cen::usize pixels)
+{
+  const auto megapixelsPerSecond = static_cast<double>(pixels) / (ms * 1'000.0);
+  std::cout << std::left << std::setw(32) << name << std::right << std::fixed
+            << std::setprecision(3) << std::setw(10) << ms << " ms/iter" << std::setw(10)
+            << megapixelsPerSecond << " Mpx/s\n";
+}
+
+/// Creates a large image by tiling the panda image, so that it has some detail to process.
+[[nodiscard]] inline auto make_tiled_image(const cen::iarea size) -> cen::surface
+{
+  const auto panda = cen::surface {RESOURCE_DIR "panda.png"}.convert_to(cen::pixel_format::rgba32);
+
+  cen::surface image {size, cen::pixel_format::rgba32};
+
+  const auto rowBytes = static_cast<cen::usize>(panda.width() * 4);
+  for (int y = 0; y < image.height(); ++y) {
+    const auto* src = static_cast<const cen::uint8*>(panda.pixel_data()) +
+                      (y % panda.height()) * panda.pitch();
+    auto* dst = static_cast<cen::uint8*>(image.pixel_data()) + y * image.pitch();
+
+    for (int x = 0; x < image.width(); x += panda.width()) {
+      const auto count = cen::detail::min(rowBytes, static_cast<cen::usize>(image.width() - x) * 4);
+      std::memcpy(dst + x * 4, src, count);
+    }
+  }
+
+  return image;
+}
+
+}  // namespace bench
+
+#endif  // CENTURION_BENCHMARKS_BENCHMARK_UTILS_HPP_
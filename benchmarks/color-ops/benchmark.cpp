@@ -0,0 +1,138 @@
+#include <centurion.hpp>
+
+#include <iostream>  // cout
+#include <random>    // mt19937, uniform_real_distribution, uniform_int_distribution
+#include <vector>    // vector
+
+#include "benchmark_utils.hpp"
+
+namespace {
+
+inline constexpr int kIterations = 20;
+inline constexpr cen::usize kCount = 1 << 20;
+
+/// Sums the components of the colors, so that the results can't be optimized away.
+[[nodiscard]] auto checksum(const std::vector<cen::color>& colors) -> cen::uint64
+{
+  cen::uint64 sum {};
+  for (const auto& color : colors) {
+    sum += color.red() + color.green() + color.blue() + color.alpha();
+  }
+
+  return sum;
+}
+
+}  // namespace
+
+int main(int, char**)
+{
+  std::mt19937 engine {42};
+  std::uniform_real_distribution<float> hue {0, 360};
+  std::uniform_real_distribution<float> percent {0, 100};
+  std::uniform_int_distribution<int> component {0, 255};
+
+  std::vector<cen::hsv_color> hsv(kCount);
+  std::vector<cen::hsl_color> hsl(kCount);
+  std::vector<cen::color> first(kCount);
+  std::vector<cen::color> second(kCount);
+
+  for (cen::usize i = 0; i < kCount; ++i) {
+    hsv[i] = {hue(engine), percent(engine), percent(engine)};
+    hsl[i] = {hue(engine), percent(engine), percent(engine)};
+
+    first[i] = cen::color(static_cast<cen::uint8>(component(engine)),
+                          static_cast<cen::uint8>(component(engine)),
+                          static_cast<cen::uint8>(component(engine)),
+                          static_cast<cen::uint8>(component(engine)));
+    second[i] = cen::color(static_cast<cen::uint8>(component(engine)),
+                           static_cast<cen::uint8>(component(engine)),
+                           static_cast<cen::uint8>(component(engine)),
+                           static_cast<cen::uint8>(component(engine)));
+  }
+
+  std::vector<cen::color> colors(kCount);
+  std::vector<cen::hsv_color> hsvResult(kCount);
+  cen::uint64 sink {};
+
+  const auto report = [&](const char* name, const double ms) {
+    bench::report_pixels(name, ms, kCount);
+    sink += checksum(colors);
+  };
+
+  report("color::from_hsv", bench::measure_ms(kIterations, [&] {
+           for (cen::usize i = 0; i < kCount; ++i) {
+             colors[i] = cen::color::from_hsv(hsv[i].hue, hsv[i].saturation, hsv[i].value);
+           }
+         }));
+
+  report("color::from_hsl", bench::measure_ms(kIterations, [&] {
+           for (cen::usize i = 0; i < kCount; ++i) {
+             colors[i] = cen::color::from_hsl(hsl[i].hue, hsl[i].saturation, hsl[i].lightness);
+           }
+         }));
+
+  report("blend", bench::measure_ms(kIterations, [&] {
+           for (cen::usize i = 0; i < kCount; ++i) {
+             colors[i] = cen::blend(first[i], second[i], 0.3f);
+           }
+         }));
+
+  report("blend, gradient", bench::measure_ms(kIterations, [&] {
+           const auto step = 1.0f / static_cast<float>(kCount - 1);
+           for (cen::usize i = 0; i < kCount; ++i) {
+             colors[i] =
+                 cen::blend(cen::colors::red, cen::colors::blue, static_cast<float>(i) * step);
+           }
+         }));
+
+  for (const auto level : {cen::simd_level::scalar, cen::best_simd_level()}) {
+    cen::set_simd_level(level);
+    std::cout << "\nBatch functions (" << level << ")\n";
+
+    report("hsv_to_rgb", bench::measure_ms(kIterations, [&] {
+             cen::hsv_to_rgb(hsv.data(), colors.data(), kCount);
+           }));
+
+    report("hsl_to_rgb", bench::measure_ms(kIterations, [&] {
+             cen::hsl_to_rgb(hsl.data(), colors.data(), kCount);
+           }));
+
+    report("rgb_to_hsv", bench::measure_ms(kIterations, [&] {
+             cen::rgb_to_hsv(first.data(), hsvResult.data(), kCount);
+           }));
+  }
+
+  std::cout << '\n';
+
+  report("lerp_colors", bench::measure_ms(kIterations, [&] {
+           cen::lerp_colors(first.data(), second.data(), colors.data(), kCount, 0.3f);
+         }));
+
+  report("blend_colors, srgb", bench::measure_ms(kIterations, [&] {
+           cen::blend_colors(first.data(), second.data(), colors.data(), kCount, 0.3f);
+         }));
+
+  report("blend_colors, linear", bench::measure_ms(kIterations, [&] {
+           cen::blend_colors(first.data(),
+                             second.data(),
+                             colors.data(),
+                             kCount,
+                             0.3f,
+                             cen::blend_space::linear);
+         }));
+
+  report("fill_gradient, srgb", bench::measure_ms(kIterations, [&] {
+           cen::fill_gradient(colors.data(), kCount, cen::colors::red, cen::colors::blue);
+         }));
+
+  report("fill_gradient, linear", bench::measure_ms(kIterations, [&] {
+           cen::fill_gradient(colors.data(),
+                              kCount,
+                              cen::colors::red,
+                              cen::colors::blue,
+                              cen::blend_space::linear);
+         }));
+
+  std::cout << "\nChecksum: " << sink << '\n';
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include <centurion.hpp>
+
+#include <algorithm>  // sort
+#include <cmath>      // abs
+#include <iomanip>    // setw, setprecision
+#include <iostream>   // cout
+#include <vector>     // vector
+
+namespace {
+
+inline constexpr int kFrames = 600;
+inline constexpr double kFrameRate = 144;
+
+/// Prints the mean, 99th percentile and worst deviation from the target frame time.
+void report(const char* name, std::vector<double> frameTimes)
+{
+  const auto target = 1'000.0 / kFrameRate;
+
+  double sum {};
+  for (auto& time : frameTimes) {
+    time = std::abs(time - target);
+    sum += time;
+  }
+
+  std::sort(frameTimes.begin(), frameTimes.end());
+  const auto p99 = frameTimes[frameTimes.size() * 99 / 100];
+
+  std::cout << std::left << std::setw(32) << name << std::right << std::fixed
+            << std::setprecision(3) << "error mean " << std::setw(7)
+            << sum / static_cast<double>(frameTimes.size()) << " ms, p99 " << std::setw(7)
+            << p99 << " ms, max " << std::setw(7) << frameTimes.back() << " ms\n";
+}
+
+[[nodiscard]] auto elapsed_ms(const cen::uint64 start, const cen::uint64 end) -> double
+{
+  return static_cast<double>(end - start) * 1'000.0 / static_cast<double>(cen::frequency());
+}
+
+}  // namespace
+
+int main(int, char**)
+{
+  const cen::sdl sdl;
+
+  std::vector<double> frameTimes;
+  frameTimes.reserve(kFrames);
+
+  {  // Sleeping for the remaining whole milliseconds, as a typical hand-written loop does
+    auto previous = cen::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+      const auto start = cen::now();
+      const auto remaining = 1'000.0 / kFrameRate - elapsed_ms(previous, start);
+
+      if (remaining > 0) {
+        cen::thread::sleep(cen::u32ms {static_cast<cen::uint32>(remaining)});
+      }
+
+      const auto end = cen::now();
+      frameTimes.push_back(elapsed_ms(previous, end));
+      previous = end;
+    }
+
+    report("thread::sleep", frameTimes);
+  }
+
+  {
+    cen::frame_scheduler scheduler {{60, kFrameRate}};
+
+    frameTimes.clear();
+    auto previous = cen::now();
+
+    scheduler.run([&] { return frameTimes.size() < kFrames; },
+                  [](cen::seconds<double>) {},
+                  [&](double) {
+                    const auto current = cen::now();
+                    frameTimes.push_back(elapsed_ms(previous, current));
+                    previous = current;
+                  });
+
+    frameTimes.erase(frameTimes.begin());
+    report("frame_scheduler", frameTimes);
+
+    const auto stats = scheduler.stats();
+    std::cout << "\nScheduler stats: mean " << stats.mean.count() << " ms, p99 "
+              << stats.p99.count() << " ms, " << stats.dropped_frames << " dropped frames\n";
+  }
+
+  return 0;
+}
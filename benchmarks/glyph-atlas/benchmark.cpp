@@ -0,0 +1,54 @@
+#include <centurion.hpp>
+
+#include "benchmark_utils.hpp"
+
+namespace {
+
+inline constexpr int kFrames = 200;
+inline constexpr int kLines = 40;
+
+inline const cen::unicode_string kText {'F', 'P', 'S', ':', ' ', '6', '0', ' ', 'H', 'P',
+                                        ':', ' ', '1', '0', '0', '/', '1', '0', '0', ' ',
+                                        'S', 'c', 'o', 'r', 'e', ':', ' ', '4', '2', '!'};
+
+void render_lines(cen::renderer& renderer, cen::font_cache& cache)
+{
+  renderer.clear_with(cen::colors::black);
+
+  renderer.set_color(cen::colors::white);
+  for (int line = 0; line < kLines; ++line) {
+    cache.render_text(renderer, kText, cen::ipoint {10, 10 + line * 14});
+  }
+
+  renderer.present();
+}
+
+}  // namespace
+
+int main(int, char**)
+{
+  const cen::sdl sdl;
+  const cen::ttf ttf;
+
+  cen::window window {"Glyph atlas benchmark"};
+  cen::renderer renderer = window.make_renderer(cen::renderer::accelerated);
+
+  cen::font_cache textures {RESOURCE_DIR "daniel.ttf", 12};
+  textures.store_latin1_glyphs(renderer);
+
+  cen::font_cache atlas {RESOURCE_DIR "daniel.ttf", 12};
+  atlas.enable_atlas();
+  atlas.store_latin1_glyphs(renderer);
+
+  window.show();
+
+  const auto textureTime = bench::measure_ms(kFrames, [&] { render_lines(renderer, textures); });
+  const auto atlasTime = bench::measure_ms(kFrames, [&] { render_lines(renderer, atlas); });
+
+  window.hide();
+
+  bench::report("font_cache (glyph textures)", textureTime, kText.size() * kLines);
+  bench::report("font_cache (glyph atlas)", atlasTime, atlas.atlas_draw_calls() * kLines);
+
+  return 0;
+}
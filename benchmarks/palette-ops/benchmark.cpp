@@ -0,0 +1,80 @@
+#include <centurion.hpp>
+
+#include <iostream>  // cout
+#include <string>    // string
+#include <vector>    // vector
+
+#include "benchmark_utils.hpp"
+
+namespace {
+
+inline constexpr int kIterations = 3;
+inline constexpr int kCycleUpdates = 10'000;
+inline constexpr cen::iarea kImageSize {2048, 2048};
+
+}  // namespace
+
+int main(int, char**)
+{
+  const cen::sdl sdl;
+  const cen::img img;
+
+  const auto image = bench::make_tiled_image(kImageSize);
+  const auto pixels = static_cast<cen::usize>(kImageSize.width * kImageSize.height);
+
+  for (const auto dither : {cen::dither_mode::none,
+                            cen::dither_mode::ordered,
+                            cen::dither_mode::floyd_steinberg}) {
+    cen::quantize_options options;
+    options.dither = dither;
+
+    const auto name = "quantize, " + std::string {cen::to_string(dither)};
+    bench::report_pixels(name.c_str(), bench::measure_ms(kIterations, [&] {
+                           const auto indexed = cen::quantize(image, options);
+                         }),
+                         pixels);
+  }
+
+  auto indexed = cen::quantize(image);
+
+  bench::report_pixels("remap_to_palette", bench::measure_ms(kIterations, [&] {
+                         const auto remapped = cen::remap_to_palette(image, indexed.colors);
+                       }),
+                       pixels);
+
+  // Uploading a cycled image to a streaming texture requires expanding it to 32-bit pixels
+  std::vector<cen::uint32> expanded(pixels);
+  const auto pitch = kImageSize.width * 4;
+
+  bench::report_pixels("convert_to, index8 -> rgba32", bench::measure_ms(kIterations, [&] {
+                         const auto converted =
+                             indexed.image.convert_to(cen::pixel_format::rgba32);
+                       }),
+                       pixels);
+
+  bench::report_pixels("expand_indexed, rgba32", bench::measure_ms(kIterations, [&] {
+                         cen::expand_indexed(indexed.image,
+                                             cen::pixel_format::rgba32,
+                                             expanded.data(),
+                                             pitch);
+                       }),
+                       pixels);
+
+  cen::palette_cycler cycler {indexed.colors};
+  cycler.add({16, 32, 10.0f});
+  cycler.add({64, 16, -4.0f});
+  cycler.add({128, 64, 30.0f});
+
+  int changed = 0;
+  const auto cycleMs = bench::measure_ms(kCycleUpdates, [&] {
+    changed += cycler.update(indexed.colors, cen::seconds<double> {1.0 / 60.0});
+  });
+
+  std::cout << "palette_cycler::update          " << cycleMs * 1'000.0 << " us/update, "
+            << changed << " entries rewritten\n";
+
+  std::cout << "\nIndexed image: " << indexed.colors.size() << " colors, "
+            << (pixels / 1'024) << " KiB instead of " << (pixels * 4 / 1'024) << " KiB\n";
+
+  return 0;
+}
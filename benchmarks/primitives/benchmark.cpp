@@ -0,0 +1,193 @@
+#include <centurion.hpp>
+
+#include <cmath>   // floor, sqrt
+#include <random>  // mt19937, uniform_real_distribution
+#include <vector>  // vector
+
+#include "benchmark_utils.hpp"
+
+namespace {
+
+inline constexpr int kFrames = 200;
+inline constexpr int kShapeCount = 2'000;
+
+struct shape_data final {
+  cen::fpoint center;
+  float radius {};
+};
+
+/// The original circle outline routine, which submits every point separately.
+auto draw_circle_per_point(cen::renderer& renderer, const shape_data& shape) -> cen::usize
+{
+  cen::usize calls = 0;
+
+  auto error = -shape.radius;
+  auto x = shape.radius - 0.5f;
+  auto y = 0.5f;
+
+  const auto cx = shape.center.x() - 0.5f;
+  const auto cy = shape.center.y() - 0.5f;
+
+  auto point = [&](const float px, const float py) {
+    renderer.draw_point(cen::fpoint {px, py});
+    ++calls;
+  };
+
+  while (x >= y) {
+    point(cx + x, cy + y);
+    point(cx + y, cy + x);
+
+    if (x != 0) {
+      point(cx - x, cy + y);
+      point(cx + y, cy - x);
+    }
+
+    if (y != 0) {
+      point(cx + x, cy - y);
+      point(cx - y, cy + x);
+    }
+
+    if (x != 0 && y != 0) {
+      point(cx - x, cy - y);
+      point(cx - y, cy - x);
+    }
+
+    error += y;
+    ++y;
+    error += y;
+
+    if (error >= 0) {
+      --x;
+      error -= x;
+      error -= x;
+    }
+  }
+
+  return calls;
+}
+
+/// The original filled circle routine, which submits two lines per scanline pair.
+auto fill_circle_per_line(cen::renderer& renderer, const shape_data& shape) -> cen::usize
+{
+  cen::usize calls = 0;
+
+  const auto cx = shape.center.x();
+  const auto cy = shape.center.y();
+  const auto radius = shape.radius;
+
+  for (auto dy = 1.0f; dy <= radius; dy += 1.0f) {
+    const auto dx = std::floor(std::sqrt((2.0f * radius * dy) - (dy * dy)));
+    renderer.draw_line<float>({cx - dx, cy + dy - radius}, {cx + dx, cy + dy - radius});
+    renderer.draw_line<float>({cx - dx, cy - dy + radius}, {cx + dx, cy - dy + radius});
+    calls += 2;
+  }
+
+  return calls;
+}
+
+}  // namespace
+
+int main(int, char**)
+{
+  const cen::sdl sdl;
+
+  cen::window window {"Primitives benchmark"};
+  cen::renderer renderer = window.make_renderer(cen::renderer::accelerated);
+
+  std::mt19937 engine {42};
+  std::uniform_real_distribution<float> pos {0, 750};
+  std::uniform_real_distribution<float> radius {4, 48};
+
+  std::vector<shape_data> shapes;
+  shapes.reserve(kShapeCount);
+
+  for (int i = 0; i < kShapeCount; ++i) {
+    shapes.push_back({cen::fpoint {pos(engine), pos(engine)}, radius(engine)});
+  }
+
+  std::vector<cen::frect> rects;
+  rects.reserve(shapes.size());
+
+  for (const auto& shape : shapes) {
+    rects.emplace_back(shape.center.x(), shape.center.y(), shape.radius, shape.radius);
+  }
+
+  window.show();
+
+  cen::usize outlineCalls = 0;
+  const auto outlinePerPoint = bench::measure_ms(kFrames, [&] {
+    outlineCalls = 0;
+    renderer.clear_with(cen::colors::black);
+    renderer.set_color(cen::colors::white);
+
+    for (const auto& shape : shapes) {
+      outlineCalls += draw_circle_per_point(renderer, shape);
+    }
+
+    renderer.present();
+  });
+
+  const auto outlineBatched = bench::measure_ms(kFrames, [&] {
+    renderer.clear_with(cen::colors::black);
+    renderer.set_color(cen::colors::white);
+
+    for (const auto& shape : shapes) {
+      renderer.draw_circle(shape.center, shape.radius);
+    }
+
+    renderer.present();
+  });
+
+  cen::usize fillCalls = 0;
+  const auto fillPerLine = bench::measure_ms(kFrames, [&] {
+    fillCalls = 0;
+    renderer.clear_with(cen::colors::black);
+    renderer.set_color(cen::colors::white);
+
+    for (const auto& shape : shapes) {
+      fillCalls += fill_circle_per_line(renderer, shape);
+    }
+
+    renderer.present();
+  });
+
+  const auto fillBatched = bench::measure_ms(kFrames, [&] {
+    renderer.clear_with(cen::colors::black);
+    renderer.set_color(cen::colors::white);
+
+    for (const auto& shape : shapes) {
+      renderer.fill_circle(shape.center, shape.radius);
+    }
+
+    renderer.present();
+  });
+
+  const auto rectsPerRect = bench::measure_ms(kFrames, [&] {
+    renderer.clear_with(cen::colors::black);
+    renderer.set_color(cen::colors::white);
+
+    for (const auto& rect : rects) {
+      renderer.fill_rect(rect);
+    }
+
+    renderer.present();
+  });
+
+  const auto rectsBatched = bench::measure_ms(kFrames, [&] {
+    renderer.clear_with(cen::colors::black);
+    renderer.set_color(cen::colors::white);
+    renderer.fill_rects(rects);
+    renderer.present();
+  });
+
+  window.hide();
+
+  bench::report("draw_circle (per point)", outlinePerPoint, outlineCalls);
+  bench::report("draw_circle (batched)", outlineBatched, shapes.size());
+  bench::report("fill_circle (per scanline)", fillPerLine, fillCalls);
+  bench::report("fill_circle (batched)", fillBatched, shapes.size());
+  bench::report("fill_rect (per rect)", rectsPerRect, rects.size());
+  bench::report("fill_rects", rectsBatched, 1);
+
+  return 0;
+}
@@ -0,0 +1,325 @@
+#include <centurion.hpp>
+
+#include <algorithm>   // sort
+#include <cstdlib>     // abs, atof, EXIT_SUCCESS, EXIT_FAILURE
+#include <cstring>     // strcmp
+#include <fstream>     // ifstream, ofstream
+#include <functional>  // function
+#include <iomanip>     // setw, setprecision
+#include <iostream>    // cout
+#include <map>         // map
+#include <random>      // mt19937
+#include <string>      // string, to_string
+#include <utility>     // pair
+#include <vector>      // vector
+
+#include "benchmark_utils.hpp"
+
+/*
+ * Renders a set of representative workloads with a software renderer on an offscreen surface,
+ * using the dummy video driver, so that no display is required.
+ *
+ * The output of every workload is compared against a golden image, and the timings are
+ * compared against a stored baseline. The program fails if an image differs from its golden
+ * image, or if a workload is slower than its baseline by more than the threshold.
+ *
+ * Usage: bench-render-regression [--update] [--images-only] [--threshold <fraction>]
+ *
+ *   --update       records new golden images and timings, instead of comparing against them.
+ *   --images-only  only compares the images, skipping the timings.
+ *   --threshold    the allowed slowdown relative to the baseline, 0.25 (25%) by default.
+ *
+ * The golden images and the timing baseline are versioned in the golden directory next to the
+ * sources, and missing reference data is an error. Run with --update to record them after an
+ * intended change in the rendering output or performance, and commit the resulting files. The
+ * CTest test is only registered once the reference data has been committed.
+ *
+ * Timings are only comparable on similar machines, so the baseline should be recorded on the
+ * machine that runs the test, and the threshold may need to be raised elsewhere.
+ */
+
+namespace {
+
+inline constexpr cen::iarea kCanvasSize {320, 240};
+inline constexpr cen::uint32 kSeed = 42;
+inline constexpr int kFrames = 50;
+inline constexpr int kRepeats = 5;
+
+inline constexpr int kChannelTolerance = 8;     ///< Allowed difference per color channel.
+inline constexpr double kMaxMismatch = 0.001;   ///< Allowed ratio of differing pixels.
+
+inline const std::string kBaselineFile = BASELINE_FILE;
+
+struct workload final {
+  std::string name;
+  std::function<void(cen::renderer&)> draw;
+};
+
+/// Returns a value in [0, range), the standard distributions are not portable across libraries.
+[[nodiscard]] auto next(std::mt19937& engine, const cen::uint32 range) -> int
+{
+  return static_cast<int>(engine() % range);
+}
+
+[[nodiscard]] auto load_baseline() -> std::map<std::string, double>
+{
+  std::map<std::string, double> baseline;
+
+  std::ifstream stream {kBaselineFile};
+  std::string name;
+  double ms {};
+  while (stream >> name >> ms) {
+    baseline[name] = ms;
+  }
+
+  return baseline;
+}
+
+void save_baseline(const std::map<std::string, double>& baseline)
+{
+  std::ofstream stream {kBaselineFile};
+  stream << std::fixed << std::setprecision(4);
+
+  for (const auto& [name, ms] : baseline) {
+    stream << name << ' ' << ms << '\n';
+  }
+}
+
+[[nodiscard]] auto load_golden(const std::string& path) -> cen::maybe<cen::surface>
+{
+  if (auto* ptr = SDL_LoadBMP(path.c_str())) {
+    return cen::surface {ptr}.convert_to(cen::pixel_format::argb8888);
+  }
+  else {
+    return cen::nothing;
+  }
+}
+
+/// Returns the amount of pixels that differ by more than the tolerance in any channel.
+[[nodiscard]] auto count_mismatches(const cen::surface& a, const cen::surface& b) -> cen::usize
+{
+  cen::usize mismatches = 0;
+
+  for (int y = 0; y < a.height(); ++y) {
+    const auto* rowA = static_cast<const cen::uint8*>(a.pixel_data()) + y * a.pitch();
+    const auto* rowB = static_cast<const cen::uint8*>(b.pixel_data()) + y * b.pitch();
+
+    for (int x = 0; x < a.width(); ++x) {
+      for (int channel = 0; channel < 4; ++channel) {
+        const auto index = x * 4 + channel;
+        if (std::abs(rowA[index] - rowB[index]) > kChannelTolerance) {
+          ++mismatches;
+          break;
+        }
+      }
+    }
+  }
+
+  return mismatches;
+}
+
+/// Returns the median of several timed runs, which is less sensitive to outliers.
+[[nodiscard]] auto time_workload(cen::renderer& renderer, const workload& work) -> double
+{
+  std::vector<double> samples;
+  samples.reserve(kRepeats);
+
+  for (int i = 0; i < kRepeats; ++i) {
+    samples.push_back(bench::measure_ms(kFrames, [&] {
+      work.draw(renderer);
+      renderer.present();
+    }));
+  }
+
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  auto update = false;
+  auto imagesOnly = false;
+  auto threshold = 0.25;
+
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--update") == 0) {
+      update = true;
+    }
+    else if (std::strcmp(argv[i], "--images-only") == 0) {
+      imagesOnly = true;
+    }
+    else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+      threshold = std::atof(argv[++i]);
+    }
+  }
+
+  SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+
+  const cen::sdl sdl {cen::sdl_cfg {SDL_INIT_VIDEO}};
+  const cen::img img;
+  const cen::ttf ttf;
+
+  /* The canvas must outlive the renderer, which draws directly into it */
+  cen::surface canvas {kCanvasSize, cen::pixel_format::argb8888};
+  cen::renderer renderer {SDL_CreateSoftwareRenderer(canvas.get())};
+
+  const auto sprite = renderer.make_texture(RESOURCE_DIR "panda.png");
+
+  cen::font_cache cache {RESOURCE_DIR "daniel.ttf", 12};
+  cache.enable_atlas();
+  cache.store_basic_latin_glyphs(renderer);
+
+  std::mt19937 engine {kSeed};
+
+  std::vector<cen::irect> blits;
+  for (int i = 0; i < 400; ++i) {
+    const auto width = 16 + next(engine, 48);
+    const auto height = 16 + next(engine, 48);
+    blits.emplace_back(next(engine, kCanvasSize.width), next(engine, kCanvasSize.height),
+                       width, height);
+  }
+
+  std::vector<std::pair<cen::fpoint, float>> circles;
+  for (int i = 0; i < 200; ++i) {
+    const cen::fpoint center {static_cast<float>(next(engine, kCanvasSize.width)),
+                              static_cast<float>(next(engine, kCanvasSize.height))};
+    circles.emplace_back(center, static_cast<float>(4 + next(engine, 28)));
+  }
+
+  std::vector<SDL_Vertex> vertices;
+  for (int i = 0; i < 300 * 3; ++i) {
+    const SDL_FPoint position {static_cast<float>(next(engine, kCanvasSize.width)),
+                               static_cast<float>(next(engine, kCanvasSize.height))};
+    const SDL_Color color {static_cast<cen::uint8>(next(engine, 256)),
+                           static_cast<cen::uint8>(next(engine, 256)),
+                           static_cast<cen::uint8>(next(engine, 256)),
+                           128};
+    vertices.push_back({position, color, {0, 0}});
+  }
+
+  const cen::unicode_string text {u"The quick brown fox jumps over the lazy dog 0123456789"};
+
+  const std::vector<workload> workloads {
+      {"sprite_blits",
+       [&](cen::renderer& r) {
+         r.clear_with(cen::colors::black);
+         for (const auto& dst : blits) {
+           r.render(sprite, dst);
+         }
+       }},
+      {"font_cache_text",
+       [&](cen::renderer& r) {
+         r.clear_with(cen::colors::black);
+         for (int line = 0; line < 16; ++line) {
+           cache.render_text(r, text, cen::ipoint {4, 4 + line * 14});
+         }
+       }},
+      {"circles",
+       [&](cen::renderer& r) {
+         r.clear_with(cen::colors::black);
+         r.set_color(cen::colors::orange);
+         for (const auto& [center, radius] : circles) {
+           r.fill_circle(center, radius);
+         }
+
+         r.set_color(cen::colors::white);
+         for (const auto& [center, radius] : circles) {
+           r.draw_circle(center, radius);
+         }
+       }},
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+      {"geometry",
+       [&](cen::renderer& r) {
+         r.clear_with(cen::colors::black);
+         r.render_geo(vertices);
+       }},
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+  };
+
+  auto baseline = load_baseline();
+  auto recorded = false;
+  auto failed = false;
+
+  renderer.set_blend_mode(cen::blend_mode::blend);
+
+  for (const auto& work : workloads) {
+    work.draw(renderer);
+    const auto output = renderer.capture(cen::pixel_format::argb8888);
+    renderer.present();
+
+    const auto goldenPath = GOLDEN_DIR + work.name + ".bmp";
+    std::string imageStatus;
+
+    if (update) {
+      output.save_as_bmp(goldenPath);
+      imageStatus = "recorded";
+    }
+    else if (const auto golden = load_golden(goldenPath)) {
+      const auto pixels = static_cast<cen::usize>(output.width() * output.height());
+      const auto mismatches =
+          (golden->size() == output.size()) ? count_mismatches(*golden, output) : pixels;
+
+      if (static_cast<double>(mismatches) > kMaxMismatch * static_cast<double>(pixels)) {
+        imageStatus = "MISMATCH (" + std::to_string(mismatches) + " px)";
+        output.save_as_bmp(GOLDEN_DIR + work.name + ".actual.bmp");
+        failed = true;
+      }
+      else {
+        imageStatus = "ok";
+      }
+    }
+    else {
+      imageStatus = "MISSING (run with --update to record it)";
+      failed = true;
+    }
+
+    if (imagesOnly) {
+      std::cout << std::left << std::setw(20) << work.name << "image: " << imageStatus << '\n';
+      continue;
+    }
+
+    const auto ms = time_workload(renderer, work);
+    std::string timeStatus;
+
+    if (const auto it = baseline.find(work.name); it != baseline.end() && !update) {
+      const auto change = (ms - it->second) / it->second;
+      if (change > threshold) {
+        timeStatus = "REGRESSED";
+        failed = true;
+      }
+      else {
+        timeStatus = "ok";
+      }
+
+      std::cout << std::left << std::setw(20) << work.name << std::right << std::fixed
+                << std::setprecision(3) << std::setw(10) << ms << " ms/frame" << std::setw(10)
+                << it->second << " ms baseline" << std::setw(8) << std::setprecision(1)
+                << change * 100.0 << "%  ";
+    }
+    else {
+      if (update) {
+        baseline[work.name] = ms;
+        recorded = true;
+        timeStatus = "recorded";
+      }
+      else {
+        timeStatus = "MISSING (run with --update to record it)";
+        failed = true;
+      }
+
+      std::cout << std::left << std::setw(20) << work.name << std::right << std::fixed
+                << std::setprecision(3) << std::setw(10) << ms << " ms/frame" << std::setw(31)
+                << ' ';
+    }
+
+    std::cout << "image: " << imageStatus << ", time: " << timeStatus << '\n';
+  }
+
+  if (recorded) {
+    save_baseline(baseline);
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,83 @@
+#include <centurion.hpp>
+
+#include <array>   // array
+#include <random>  // mt19937, uniform_real_distribution
+#include <vector>  // vector
+
+#include "benchmark_utils.hpp"
+
+namespace {
+
+inline constexpr int kFrames = 200;
+inline constexpr int kSpriteCount = 20'000;
+
+struct sprite_data final {
+  cen::usize texture {};
+  cen::irect src;
+  cen::frect dst;
+  double angle {};
+};
+
+}  // namespace
+
+int main(int, char**)
+{
+  const cen::sdl sdl;
+  const cen::img img;
+
+  cen::window window {"Sprite batch benchmark"};
+  cen::renderer renderer = window.make_renderer(cen::renderer::accelerated);
+
+  // Several copies of the same image, to exercise texture grouping
+  std::array<cen::texture, 4> textures {renderer.make_texture(RESOURCE_DIR "panda.png"),
+                                        renderer.make_texture(RESOURCE_DIR "panda.png"),
+                                        renderer.make_texture(RESOURCE_DIR "panda.png"),
+                                        renderer.make_texture(RESOURCE_DIR "panda.png")};
+
+  std::mt19937 engine {42};
+  std::uniform_real_distribution<float> pos {0, 750};
+  std::uniform_real_distribution<double> angle {0, 360};
+
+  std::vector<sprite_data> sprites;
+  sprites.reserve(kSpriteCount);
+
+  for (int i = 0; i < kSpriteCount; ++i) {
+    sprites.push_back({static_cast<cen::usize>(i) % textures.size(),
+                       cen::irect {0, 0, 100, 75},
+                       cen::frect {pos(engine), pos(engine), 32, 24},
+                       angle(engine)});
+  }
+
+  window.show();
+
+  const auto perSprite = bench::measure_ms(kFrames, [&] {
+    renderer.clear_with(cen::colors::black);
+
+    for (const auto& sprite : sprites) {
+      renderer.render(textures[sprite.texture], sprite.src, sprite.dst, sprite.angle);
+    }
+
+    renderer.present();
+  });
+
+  cen::sprite_batch batch;
+  batch.reserve(sprites.size());
+
+  const auto batched = bench::measure_ms(kFrames, [&] {
+    renderer.clear_with(cen::colors::black);
+
+    for (const auto& sprite : sprites) {
+      batch.add(textures[sprite.texture], sprite.src, sprite.dst, sprite.angle);
+    }
+
+    batch.flush(renderer);
+    renderer.present();
+  });
+
+  window.hide();
+
+  bench::report("renderer::render (per sprite)", perSprite, sprites.size());
+  bench::report("sprite_batch::flush", batched, batch.draw_calls());
+
+  return 0;
+}
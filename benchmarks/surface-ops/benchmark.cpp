@@ -0,0 +1,66 @@
+#include <centurion.hpp>
+
+#include <string>  // string
+
+#include "benchmark_utils.hpp"
+
+namespace {
+
+inline constexpr int kIterations = 5;
+inline constexpr cen::iarea kImageSize {4096, 4096};
+inline constexpr cen::iarea kThumbnailSize {256, 256};
+
+void run(const char* label, cen::thread_pool* pool)
+{
+  const auto image = bench::make_tiled_image(kImageSize);
+  const auto pixels = static_cast<cen::usize>(kImageSize.width * kImageSize.height);
+
+  const auto report = [&](const char* name, const double ms) {
+    bench::report_pixels((std::string {name} + " (" + label + ")").c_str(), ms, pixels);
+  };
+
+  cen::surface thumbnail {kThumbnailSize, image.format_info().format()};
+
+  report("resize, box", bench::measure_ms(kIterations, [&] {
+           cen::resize(image, thumbnail, cen::resize_filter::box, pool);
+         }));
+
+  report("resize, bilinear", bench::measure_ms(kIterations, [&] {
+           cen::resize(image, thumbnail, cen::resize_filter::bilinear, pool);
+         }));
+
+  report("resize, lanczos", bench::measure_ms(kIterations, [&] {
+           cen::resize(image, thumbnail, cen::resize_filter::lanczos, pool);
+         }));
+
+  auto target = image;
+
+  report("box blur, r=16", bench::measure_ms(kIterations, [&] {
+           cen::box_blur(target, 16, pool);
+         }));
+
+  report("gaussian blur, sigma=4", bench::measure_ms(kIterations, [&] {
+           cen::gaussian_blur(target, 4.0f, pool);
+         }));
+
+  const auto matrix = cen::color_matrix::contrast(1.2f) * cen::color_matrix::sepia();
+  report("color matrix", bench::measure_ms(kIterations, [&] {
+           cen::transform_colors(target, matrix, pool);
+         }));
+}
+
+}  // namespace
+
+int main(int, char**)
+{
+  const cen::sdl sdl;
+  const cen::img img;
+
+  run("1 thread", nullptr);
+
+  cen::thread_pool pool;
+  const auto label = std::to_string(pool.size() + 1) + " threads";
+  run(label.c_str(), &pool);
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include <centurion.hpp>
+
+#include <random>  // mt19937, uniform_int_distribution
+
+#include "benchmark_utils.hpp"
+
+namespace {
+
+inline constexpr int kFrames = 200;
+inline constexpr int kMapSize = 256;
+inline constexpr int kTileSize = 16;
+
+}  // namespace
+
+int main(int, char**)
+{
+  const cen::sdl sdl;
+  const cen::img img;
+
+  cen::window window {"Tilemap benchmark"};
+  cen::renderer renderer = window.make_renderer(cen::renderer::accelerated);
+
+  const auto tileset = renderer.make_texture(RESOURCE_DIR "panda.png");
+
+  cen::tilemap map {tileset, {kTileSize, kTileSize}, {kMapSize, kMapSize}};
+
+  std::mt19937 engine {42};
+  std::uniform_int_distribution<cen::tilemap::tile_type> tiles {1, 12 * 9};
+
+  for (int y = 0; y < kMapSize; ++y) {
+    for (int x = 0; x < kMapSize; ++x) {
+      map.set_tile(x, y, tiles(engine));
+    }
+  }
+
+  // The camera pans across the map, to also exercise chunk baking
+  cen::fpoint camera;
+  const auto pan = [&] {
+    camera.set_x(camera.x() + 4.0f);
+    camera.set_y(camera.y() + 2.0f);
+  };
+
+  const auto renderTile = [&](const int x, const int y, cen::usize& calls) {
+    const cen::frect dst {static_cast<float>(x * kTileSize) - camera.x(),
+                          static_cast<float>(y * kTileSize) - camera.y(),
+                          kTileSize,
+                          kTileSize};
+    renderer.render(tileset, map.source(map.tile(x, y)), dst);
+    ++calls;
+  };
+
+  window.show();
+
+  cen::usize naiveCalls {};
+  const auto naive = bench::measure_ms(kFrames, [&] {
+    naiveCalls = 0;
+    renderer.clear_with(cen::colors::black);
+
+    for (int y = 0; y < kMapSize; ++y) {
+      for (int x = 0; x < kMapSize; ++x) {
+        renderTile(x, y, naiveCalls);
+      }
+    }
+
+    renderer.present();
+    pan();
+  });
+
+  camera = {};
+
+  cen::usize culledCalls {};
+  const auto culled = bench::measure_ms(kFrames, [&] {
+    culledCalls = 0;
+    renderer.clear_with(cen::colors::black);
+
+    const auto viewport = renderer.viewport();
+    const auto beginX = static_cast<int>(camera.x()) / kTileSize;
+    const auto beginY = static_cast<int>(camera.y()) / kTileSize;
+    const auto endX = cen::detail::min(kMapSize, beginX + viewport.width() / kTileSize + 2);
+    const auto endY = cen::detail::min(kMapSize, beginY + viewport.height() / kTileSize + 2);
+
+    for (int y = beginY; y < endY; ++y) {
+      for (int x = beginX; x < endX; ++x) {
+        renderTile(x, y, culledCalls);
+      }
+    }
+
+    renderer.present();
+    pan();
+  });
+
+  camera = {};
+
+  cen::usize chunkCalls {};
+  const auto chunked = bench::measure_ms(kFrames, [&] {
+    renderer.clear_with(cen::colors::black);
+
+    map.render(renderer, camera);
+    chunkCalls = map.stats().rendered;
+
+    renderer.present();
+    pan();
+  });
+
+  window.hide();
+
+  bench::report("renderer::render (every tile)", naive, naiveCalls);
+  bench::report("renderer::render (visible tiles)", culled, culledCalls);
+  bench::report("tilemap::render", chunked, chunkCalls);
+
+  return 0;
+}
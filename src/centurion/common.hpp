@@ -28,6 +28,7 @@
 #include "common/math.hpp"
 #include "common/memory.hpp"
 #include "common/primitives.hpp"
+#include "common/rect_packer.hpp"
 #include "common/result.hpp"
 #include "common/sdl_string.hpp"
 #include "common/traits.hpp"
@@ -0,0 +1,218 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_COMMON_RECT_PACKER_HPP_
+#define CENTURION_COMMON_RECT_PACKER_HPP_
+
+#include <cassert>  // assert
+#include <cstddef>  // ptrdiff_t
+#include <limits>   // numeric_limits
+#include <vector>   // vector
+
+#include "../detail/stdlib.hpp"
+#include "math.hpp"
+#include "primitives.hpp"
+
+namespace cen {
+
+/**
+ * Packs rectangles into a fixed area using the skyline bottom-left heuristic.
+ *
+ * This is intended for building texture atlases, where a large amount of small images, such
+ * as glyphs, are packed into a few large textures. Inserted rectangles are never moved, so
+ * the packer can be grown without invalidating previously returned positions.
+ */
+class rect_packer final {
+ public:
+  explicit rect_packer(const iarea size) : mSize {size} { reset(); }
+
+  /**
+   * Attempts to find space for a rectangle of the specified size.
+   *
+   * \param size the size of the rectangle.
+   *
+   * \return the location of the packed rectangle; an empty optional if there is no space.
+   */
+  [[nodiscard]] auto insert(const iarea size) -> maybe<irect>
+  {
+    if (size.width <= 0 || size.height <= 0) {
+      return nothing;
+    }
+
+    usize bestIndex = mSkyline.size();
+    int bestX {};
+    int bestY = std::numeric_limits<int>::max();
+    int bestWidth = std::numeric_limits<int>::max();
+
+    for (usize index = 0; index < mSkyline.size(); ++index) {
+      if (const auto y = fit(index, size)) {
+        const auto& node = mSkyline[index];
+        const auto bottom = *y + size.height;
+
+        if (bottom < bestY || (bottom == bestY && node.width < bestWidth)) {
+          bestIndex = index;
+          bestX = node.x;
+          bestY = bottom;
+          bestWidth = node.width;
+        }
+      }
+    }
+
+    if (bestIndex == mSkyline.size()) {
+      return nothing;
+    }
+
+    const irect result {bestX, bestY - size.height, size.width, size.height};
+    add_skyline_level(bestIndex, result);
+
+    mUsedArea += static_cast<usize>(size.width) * static_cast<usize>(size.height);
+
+    return result;
+  }
+
+  /**
+   * Enlarges the packed area, previously packed rectangles are unaffected.
+   *
+   * \param size the new size, which must not be smaller than the current size.
+   */
+  void grow(const iarea size)
+  {
+    assert(size.width >= mSize.width);
+    assert(size.height >= mSize.height);
+
+    if (size.width > mSize.width) {
+      mSkyline.push_back({mSize.width, 0, size.width - mSize.width});
+      merge_skylines();
+    }
+
+    mSize = size;
+  }
+
+  /// Removes all packed rectangles.
+  void reset()
+  {
+    mSkyline.clear();
+    mSkyline.push_back({0, 0, mSize.width});
+    mUsedArea = 0;
+  }
+
+  /// Returns the total area of the packed rectangles.
+  [[nodiscard]] auto used_area() const noexcept -> usize { return mUsedArea; }
+
+  /// Returns the ratio of the used area and the total area, in the range [0, 1].
+  [[nodiscard]] auto occupancy() const noexcept -> float
+  {
+    const auto total = static_cast<usize>(mSize.width) * static_cast<usize>(mSize.height);
+    return (total != 0) ? static_cast<float>(mUsedArea) / static_cast<float>(total) : 0.0f;
+  }
+
+  [[nodiscard]] auto size() const noexcept -> iarea { return mSize; }
+
+ private:
+  struct skyline_node final {
+    int x {};
+    int y {};
+    int width {};
+  };
+
+  iarea mSize;
+  std::vector<skyline_node> mSkyline;
+  usize mUsedArea {};
+
+  /// Returns the lowest y-coordinate of a rectangle placed at the skyline node, if it fits.
+  [[nodiscard]] auto fit(const usize index, const iarea size) const -> maybe<int>
+  {
+    const auto x = mSkyline[index].x;
+    if (x + size.width > mSize.width) {
+      return nothing;
+    }
+
+    int y = mSkyline[index].y;
+    int remaining = size.width;
+
+    for (auto i = index; remaining > 0; ++i) {
+      assert(i < mSkyline.size());
+
+      const auto& node = mSkyline[i];
+      y = detail::max(y, node.y);
+
+      if (y + size.height > mSize.height) {
+        return nothing;
+      }
+
+      remaining -= node.width;
+    }
+
+    return y;
+  }
+
+  void add_skyline_level(const usize index, const irect& rect)
+  {
+    const auto it = mSkyline.begin() + static_cast<std::ptrdiff_t>(index);
+    mSkyline.insert(it, {rect.x(), rect.max_y(), rect.width()});
+
+    // Shrink or remove the nodes that are now covered by the new node
+    for (auto i = index + 1; i < mSkyline.size();) {
+      const auto& previous = mSkyline[i - 1];
+      auto& node = mSkyline[i];
+
+      const auto previousEnd = previous.x + previous.width;
+      if (node.x >= previousEnd) {
+        break;
+      }
+
+      const auto shrink = previousEnd - node.x;
+      if (node.width <= shrink) {
+        mSkyline.erase(mSkyline.begin() + static_cast<std::ptrdiff_t>(i));
+      }
+      else {
+        node.x += shrink;
+        node.width -= shrink;
+        break;
+      }
+    }
+
+    merge_skylines();
+  }
+
+  void merge_skylines()
+  {
+    for (usize i = 0; i + 1 < mSkyline.size();) {
+      auto& node = mSkyline[i];
+      const auto& next = mSkyline[i + 1];
+
+      if (node.y == next.y) {
+        node.width += next.width;
+        mSkyline.erase(mSkyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+      }
+      else {
+        ++i;
+      }
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_COMMON_RECT_PACKER_HPP_
@@ -26,4 +26,5 @@
 #include "concurrency/locks.hpp"
 #include "concurrency/mutex.hpp"
 #include "concurrency/semaphore.hpp"
-#include "concurrency/thread.hpp"
\ No newline at end of file
+#include "concurrency/thread.hpp"
+#include "concurrency/thread_pool.hpp"
\ No newline at end of file
@@ -0,0 +1,189 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef CENTURION_CONCURRENCY_THREAD_POOL_HPP_
+#define CENTURION_CONCURRENCY_THREAD_POOL_HPP_
+
+#include <SDL.h>
+
+#include <cassert>     // assert
+#include <deque>       // deque
+#include <functional>  // function
+#include <memory>      // unique_ptr, make_unique
+#include <utility>     // move
+#include <vector>      // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "condition.hpp"
+#include "locks.hpp"
+#include "mutex.hpp"
+#include "thread.hpp"
+
+namespace cen {
+
+/**
+ * A fixed set of worker threads that execute submitted tasks in FIFO order.
+ *
+ * \details Tasks that are still queued when the pool is destroyed are executed before the
+ *          workers are joined, so a submitted task is always run exactly once. Exceptions
+ *          thrown by tasks are swallowed, tasks should report failures through their own state.
+ *
+ * \see thread
+ */
+class thread_pool final {
+ public:
+  using task_type = std::function<void()>;
+  using size_type = usize;
+
+  /**
+   * Creates a thread pool and starts its workers.
+   *
+   * \param count the amount of worker threads, must be greater than zero.
+   */
+  CENTURION_NODISCARD_CTOR explicit thread_pool(const size_type count = default_size())
+  {
+    assert(count > 0);
+
+    try {
+      mThreads.reserve(count);
+      for (size_type index = 0; index < count; ++index) {
+        mThreads.push_back(std::make_unique<thread>(&thread_pool::work, "cen-worker", this));
+      }
+    }
+    catch (...) {
+      stop();  // The destructor is not run, so the started workers must be stopped here
+      throw;
+    }
+  }
+
+  CENTURION_DISABLE_COPY(thread_pool)
+  CENTURION_DISABLE_MOVE(thread_pool)
+
+  ~thread_pool() noexcept { stop(); }
+
+  /// Queues a task for execution by one of the workers.
+  void submit(task_type task)
+  {
+    assert(task);
+
+    {
+      scoped_lock lock {mMutex};
+      mTasks.push_back(std::move(task));
+    }
+
+    mTaskAvailable.signal();
+  }
+
+  /// Blocks until all submitted tasks have finished executing.
+  void wait()
+  {
+    scoped_lock lock {mMutex};
+    while (!mTasks.empty() || mActive != 0) {
+      mIdle.wait(mMutex);
+    }
+  }
+
+  /// Returns the amount of tasks that are queued or currently executing.
+  [[nodiscard]] auto pending() -> size_type
+  {
+    scoped_lock lock {mMutex};
+    return mTasks.size() + mActive;
+  }
+
+  /// Indicates whether there are no queued or executing tasks.
+  [[nodiscard]] auto idle() -> bool { return pending() == 0; }
+
+  /// Returns the amount of worker threads.
+  [[nodiscard]] auto size() const noexcept -> size_type { return mThreads.size(); }
+
+  /// Returns the default amount of workers, i.e. one less than the amount of CPU cores.
+  [[nodiscard]] static auto default_size() noexcept -> size_type
+  {
+    return static_cast<size_type>(detail::max(SDL_GetCPUCount() - 1, 1));
+  }
+
+ private:
+  mutex mMutex;
+  condition mTaskAvailable;
+  condition mIdle;
+  std::deque<task_type> mTasks;
+  size_type mActive {};
+  bool mStop {};
+  std::vector<std::unique_ptr<thread>> mThreads;
+
+  /// Stops and joins the workers, after the remaining tasks have been executed.
+  void stop() noexcept
+  {
+    mMutex.lock();
+    mStop = true;
+    mMutex.unlock();
+
+    mTaskAvailable.broadcast();
+    mThreads.clear();  // Joins the workers
+  }
+
+  static auto work(void* data) -> int
+  {
+    auto& self = *static_cast<thread_pool*>(data);
+
+    while (true) {
+      task_type task;
+
+      self.mMutex.lock();
+      while (self.mTasks.empty() && !self.mStop) {
+        self.mTaskAvailable.wait(self.mMutex);
+      }
+
+      if (self.mTasks.empty()) {
+        self.mMutex.unlock();
+        return 0;
+      }
+
+      task = std::move(self.mTasks.front());
+      self.mTasks.pop_front();
+      ++self.mActive;
+      self.mMutex.unlock();
+
+      try {
+        task();
+      }
+      catch (...) {
+        /* Tasks are responsible for their own error handling */
+      }
+
+      self.mMutex.lock();
+      --self.mActive;
+      if (self.mTasks.empty() && self.mActive == 0) {
+        self.mIdle.broadcast();
+      }
+      self.mMutex.unlock();
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_CONCURRENCY_THREAD_POOL_HPP_
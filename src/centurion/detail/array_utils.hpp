@@ -25,14 +25,20 @@
 #ifndef CENTURION_DETAIL_ARRAY_UTILS_HPP_
 #define CENTURION_DETAIL_ARRAY_UTILS_HPP_
 
-#include <array>    // array, to_array
-#include <cstddef>  // size_t
+#include <array>        // array, to_array
+#include <cstddef>      // size_t
+#include <type_traits>  // enable_if_t, is_same_v, remove_cv_t
 
 #include "../common/primitives.hpp"
 #include "../features.hpp"
 
 namespace cen::detail {
 
+/// Enables a template for contiguous containers, e.g. `std::vector`, of the specified type.
+template <typename Container, typename T>
+using enable_for_container_of =
+    std::enable_if_t<std::is_same_v<std::remove_cv_t<typename Container::value_type>, T>, int>;
+
 template <typename T, usize Size>
 constexpr void assign(const std::array<T, Size>& array, bounded_array_ref<T, Size> out)
 {
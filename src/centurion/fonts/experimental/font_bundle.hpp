@@ -35,6 +35,7 @@
 
 #include "../../common/errors.hpp"
 #include "../../common/primitives.hpp"
+#include "../../concurrency/thread_pool.hpp"
 #include "../../features.hpp"
 #include "../font.hpp"
 #include "../font_cache.hpp"
@@ -86,7 +87,7 @@ class font_bundle final {
   {
     assert(path);
     if (const auto id = get_id(path)) {
-      mPools[*id].caches.try_emplace(size, font {path, size});
+      mPools[*id].caches.try_emplace(size, path, size);
       return *id;
     }
     else {
@@ -94,7 +95,7 @@ class font_bundle final {
 
       auto& pack = mPools[newId];
       pack.path = path;
-      pack.caches.try_emplace(size, font {path, size});
+      pack.caches.try_emplace(size, path, size);
 
       ++mNextFontId;
 
@@ -168,6 +169,88 @@ class font_bundle final {
     return at(id, size).get_font();
   }
 
+  /**
+   * Rasterizes a range of glyphs for every loaded font on worker threads.
+   *
+   * \param renderer the renderer that will be used.
+   * \param pool the thread pool that will rasterize the glyphs.
+   * \param begin the first glyph that will be cached.
+   * \param end the range terminator (will not be cached).
+   *
+   * \see font_cache::store_glyphs_async
+   */
+  template <typename T>
+  void store_glyphs_async(basic_renderer<T>& renderer,
+                          thread_pool& pool,
+                          const unicode_t begin,
+                          const unicode_t end)
+  {
+    for (auto& [id, pack] : mPools) {
+      for (auto& [size, cache] : pack.caches) {
+        cache.store_glyphs_async(renderer, pool, begin, end);
+      }
+    }
+  }
+
+  /**
+   * Caches glyphs that have been rasterized by worker threads, for all loaded fonts.
+   *
+   * \param renderer the renderer that will be used.
+   * \param budget the maximum total amount of glyphs that will be uploaded.
+   *
+   * \return the amount of glyphs that were uploaded.
+   *
+   * \see font_cache::upload_glyphs
+   */
+  template <typename T>
+  auto upload_glyphs(basic_renderer<T>& renderer, const usize budget = 32) -> usize
+  {
+    usize uploaded = 0;
+
+    for (auto& [id, pack] : mPools) {
+      for (auto& [size, cache] : pack.caches) {
+        if (uploaded == budget) {
+          return uploaded;
+        }
+
+        uploaded += cache.upload_glyphs(renderer, budget - uploaded);
+      }
+    }
+
+    return uploaded;
+  }
+
+  /// Indicates whether any font has asynchronously loaded glyphs that have not been uploaded.
+  [[nodiscard]] auto is_loading() const noexcept -> bool
+  {
+    for (const auto& [id, pack] : mPools) {
+      for (const auto& [size, cache] : pack.caches) {
+        if (cache.is_loading()) {
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  /// Returns the combined progress of asynchronously loaded glyphs for all fonts.
+  [[nodiscard]] auto glyph_progress() const -> glyph_load_progress
+  {
+    glyph_load_progress total;
+
+    for (const auto& [id, pack] : mPools) {
+      for (const auto& [size, cache] : pack.caches) {
+        const auto progress = cache.glyph_progress();
+        total.requested += progress.requested;
+        total.rasterized += progress.rasterized;
+        total.uploaded += progress.uploaded;
+      }
+    }
+
+    return total;
+  }
+
   /// Returns the amount of fonts that have been loaded (including different sizes).
   [[nodiscard]] auto font_count() const noexcept -> size_type
   {
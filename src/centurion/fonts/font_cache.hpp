@@ -29,16 +29,37 @@
 
 #include <SDL_ttf.h>
 
+#include <algorithm>      // equal
+#include <atomic>         // atomic
+#include <cassert>        // assert
+#include <cstring>        // memcpy
+#include <functional>     // hash
+#include <iterator>       // begin, end, prev
+#include <list>           // list
+#include <memory>         // unique_ptr, make_unique
 #include <ostream>        // ostream
 #include <string>         // string
+#include <string_view>    // string_view
 #include <unordered_map>  // unordered_map
 #include <utility>        // move
+#include <vector>         // vector
 
+#include "../common/errors.hpp"
 #include "../common/primitives.hpp"
+#include "../common/rect_packer.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/condition.hpp"
+#include "../concurrency/locks.hpp"
+#include "../concurrency/mutex.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../detail/stdlib.hpp"
 #include "../features.hpp"
+#include "../video/pixels.hpp"
 #include "../video/renderer.hpp"
+#include "../video/sprite_batch.hpp"
 #include "../video/texture.hpp"
 #include "font.hpp"
+#include "text_layout.hpp"
 
 #if CENTURION_HAS_FEATURE_FORMAT
 
@@ -48,6 +69,83 @@
 
 namespace cen {
 
+/// Determines how a font cache stores rendered glyphs.
+enum class glyph_storage {
+  textures,  ///< Every glyph is stored in a separate texture.
+  atlas      ///< Glyphs are packed into a few large shared textures.
+};
+
+[[nodiscard]] constexpr auto to_string(const glyph_storage storage) -> std::string_view
+{
+  switch (storage) {
+    case glyph_storage::textures:
+      return "textures";
+
+    case glyph_storage::atlas:
+      return "atlas";
+
+    default:
+      throw exception {"Did not recognize glyph storage!"};
+  }
+}
+
+inline auto operator<<(std::ostream& stream, const glyph_storage storage) -> std::ostream&
+{
+  return stream << to_string(storage);
+}
+
+/// The SDL_ttf function family used to render strings.
+enum class text_render_mode {
+  solid,   ///< Fast, aliased rendering to an 8-bit surface.
+  shaded,  ///< Antialiased rendering on a solid background color.
+  blended  ///< Antialiased rendering with alpha blending.
+};
+
+[[nodiscard]] constexpr auto to_string(const text_render_mode mode) -> std::string_view
+{
+  switch (mode) {
+    case text_render_mode::solid:
+      return "solid";
+
+    case text_render_mode::shaded:
+      return "shaded";
+
+    case text_render_mode::blended:
+      return "blended";
+
+    default:
+      throw exception {"Did not recognize text render mode!"};
+  }
+}
+
+inline auto operator<<(std::ostream& stream, const text_render_mode mode) -> std::ostream&
+{
+  return stream << to_string(mode);
+}
+
+/// Provides statistics about the dynamic string cache of a font cache.
+struct string_cache_stats final {
+  usize hits {};       ///< The amount of lookups that found a cached texture.
+  usize misses {};     ///< The amount of lookups that rendered a new texture.
+  usize evictions {};  ///< The amount of textures that were evicted to respect the budget.
+  usize bytes {};      ///< The estimated amount of texture memory used by cached strings.
+  usize count {};      ///< The amount of cached strings.
+};
+
+/// Provides the progress of asynchronously loaded glyphs.
+struct glyph_load_progress final {
+  usize requested {};   ///< The amount of glyphs that have been requested.
+  usize rasterized {};  ///< The amount of requested glyphs that have been rendered to surfaces.
+  usize uploaded {};    ///< The amount of rasterized glyphs that have been handled on upload.
+};
+
+/// Configures the glyph atlas of a font cache.
+struct glyph_atlas_cfg final {
+  iarea page_size {256, 256};         ///< The initial size of atlas pages.
+  iarea max_page_size {2048, 2048};  ///< Pages are grown up to this size before more are added.
+  int padding {1};                    ///< The empty space between packed glyphs.
+};
+
 /**
  * Provides efficient font rendering.
  *
@@ -61,6 +159,15 @@ namespace cen {
  * identifiers. In contrast with the first approach, this will result in accurate kerning. The
  * only problem is that it is hard to know the exact strings you will render at compile-time.
  * Use this option if you know that you are going to render some specific string a lot.
+ * Strings that are not known in advance can instead be fetched by their contents, in which
+ * case the least recently used strings are evicted to stay within a memory budget.
+ *
+ * Glyphs may also be packed into a glyph atlas, i.e. a few large textures, by enabling atlas
+ * storage. In that mode, strings are rendered with a single geometry call per atlas page
+ * instead of one texture switch per glyph (requires SDL 2.0.18).
+ *
+ * To avoid stalling the render thread, glyphs can also be rasterized on a thread pool, in
+ * which case only the final texture uploads are done by the render thread, in small batches.
  *
  * Note, instances of this class are initially empty, i.e. they hold no cached glyphs or
  * strings. It is up to you to explicitly specify what you want to cache.
@@ -78,15 +185,21 @@ class font_cache final {
     glyph_metrics metrics;  ///< The metrics associate with the glyph.
   };
 
+  struct atlas_glyph final {
+    usize page {};          ///< The index of the atlas page that holds the glyph.
+    irect source;           ///< The area of the glyph in the atlas page.
+    glyph_metrics metrics;  ///< The metrics associate with the glyph.
+  };
+
   /**
    * Creates a font cache based on the font at the specified file path.
    *
    * \param file the file path of the font.
    * \param size the size of the font.
    */
-  font_cache(const char* file, const int size) : mFont {file, size} {}
+  font_cache(const char* file, const int size) : mFont {file, size}, mPath {file} {}
 
-  font_cache(const std::string& file, const int size) : mFont {file, size} {}
+  font_cache(const std::string& file, const int size) : mFont {file, size}, mPath {file} {}
 
   explicit font_cache(font&& font) noexcept : mFont {std::move(font)} {}
 
@@ -95,6 +208,25 @@ class font_cache final {
   auto render_glyph(basic_renderer<T>& renderer, const unicode_t glyph, const ipoint& position)
       -> int
   {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (const auto* data = find_atlas_glyph(glyph)) {
+      const auto& [page, source, metrics] = *data;
+      const auto outline = mFont.outline();
+
+      const auto x = position.x() + metrics.min_x - outline;
+      const auto y = position.y() - outline;
+
+      if (source.has_area()) {
+        auto& sheet = mPages.at(page).sheet;
+        sheet.set_color_mod(renderer.get_color());
+        renderer.render(sheet, source, irect {x, y, source.width(), source.height()});
+        sheet.set_color_mod(colors::white);
+      }
+
+      return x + metrics.advance;
+    }
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
     if (const auto* data = find_glyph(glyph)) {
       const auto& [texture, metrics] = *data;
       const auto outline = mFont.outline();
@@ -115,8 +247,9 @@ class font_cache final {
   /**
    * Renders a string as a series of glyphs.
    *
-   * You can provide null-characters in the string to indicate line breaks. This function will
-   * not output rendered text with accurate kerning.
+   * You can provide newline characters in the string to indicate line breaks. The string is
+   * laid out with kerning, using an internal layout that is reused as long as the same string
+   * is rendered. Use `layout_text()` and `render_layout()` to keep several layouts around.
    *
    * \tparam String the type of the string-like object, storing Unicode glyphs.
    *
@@ -125,21 +258,216 @@ class font_cache final {
    * \param position the position of the rendered string.
    */
   template <typename T, typename String>
-  void render_text(basic_renderer<T>& renderer, const String& str, ipoint position)
+  void render_text(basic_renderer<T>& renderer, const String& str, const ipoint position)
+  {
+    layout_text(str, mScratchLayout);
+    render_layout(renderer, mScratchLayout, position);
+  }
+
+  /**
+   * Splits a string into positioned glyphs, accounting for kerning and line wrapping.
+   *
+   * Glyph metrics and kerning pairs are cached, so glyphs do not have to be stored in order to
+   * be laid out. This function does nothing if the layout was already created by this cache
+   * for the same string and configuration, and the font size, style, outline, hinting and
+   * kerning are unchanged.
+   *
+   * \tparam String the type of the string-like object, storing Unicode glyphs.
+   *
+   * \param str the source of the Unicode glyphs, newline characters result in line breaks.
+   * \param layout the layout that will be updated.
+   * \param cfg the layout configuration.
+   *
+   * \return `true` if the layout was updated; `false` if it was already up-to-date.
+   */
+  template <typename String>
+  auto layout_text(const String& str, text_layout& layout, const text_layout_cfg& cfg = {})
+      -> bool
   {
-    const auto originalX = position.x();
+    const auto fontState = sync_font_state();
+
+    if (owns(layout) && layout.mCfg == cfg && layout.mFontState == fontState &&
+        std::equal(std::begin(str), std::end(str), layout.mSource.begin(), layout.mSource.end())) {
+      return false;
+    }
+
+    layout.clear();
+    layout.mSource.assign(std::begin(str), std::end(str));
+    layout.mOwner = this;
+    layout.mOwnerId = mId;
+    layout.mCfg = cfg;
+    layout.mFontState = fontState;
+
+    auto& quads = layout.mQuads;
+    auto& lines = layout.mLines;
+
+    const auto outline = mFont.outline();
     const auto lineSkip = mFont.line_skip();
+    const auto kerning = mFont.has_kerning();
+    const auto wrapWidth = cfg.wrap_width;
+
+    constexpr auto none = static_cast<usize>(-1);
+
+    int pen {};
+    int y {};
+    int contentWidth {};  // The line width, excluding trailing spaces
+    unicode_t previous {};
+
+    usize lineFirst {};
+    usize breakIndex {none};  // The index of the first glyph after the latest space
+    int breakPen {};
+    int breakWidth {};
+
+    const auto new_line = [&](const usize end, const int width) {
+      lines.push_back({lineFirst, end - lineFirst, width});
+      lineFirst = end;
+      y += lineSkip;
+      breakIndex = none;
+    };
 
-    for (const unicode_t glyph : str) {
+    for (const unicode_t glyph : layout.mSource) {
       if (glyph == '\n') {
-        position.set_x(originalX);
-        position.set_y(position.y() + lineSkip);
+        new_line(quads.size(), contentWidth);
+        pen = 0;
+        contentWidth = 0;
+        previous = 0;
+        continue;
+      }
+
+      const auto* metrics = cached_metrics(glyph);
+      if (!metrics) {
+        continue;
+      }
+
+      if (kerning && previous != 0) {
+        pen += cached_kerning(previous, glyph);
+      }
+
+      if (wrapWidth > 0 && glyph != ' ' && pen + metrics->advance > wrapWidth &&
+          quads.size() > lineFirst) {
+        if (breakIndex != none && breakIndex > lineFirst) {
+          /* Move the current word to the next line */
+          const auto first = breakIndex;
+          new_line(first, breakWidth);
+
+          for (auto index = first; index < quads.size(); ++index) {
+            auto& position = quads[index].position;
+            position.set_x(position.x() - breakPen);
+            position.set_y(y - outline);
+          }
+
+          pen -= breakPen;
+          contentWidth = detail::max(contentWidth - breakPen, 0);
+        }
+        else {
+          new_line(quads.size(), contentWidth);
+          pen = 0;
+          contentWidth = 0;
+        }
+      }
+
+      quads.push_back({glyph, ipoint {pen + metrics->min_x - outline, y - outline}});
+      pen += metrics->advance;
+      previous = glyph;
+
+      if (glyph == ' ') {
+        breakIndex = quads.size();
+        breakWidth = contentWidth;
+        breakPen = pen;
       }
       else {
-        const auto x = render_glyph(renderer, glyph, position);
-        position.set_x(x);
+        contentWidth = pen;
+      }
+    }
+
+    lines.push_back({lineFirst, quads.size() - lineFirst, contentWidth});
+
+    int maxWidth {};
+    for (const auto& line : lines) {
+      maxWidth = detail::max(maxWidth, line.width);
+    }
+
+#if SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+    if (cfg.align != wrap_alignment::left) {
+      const auto reference = (wrapWidth > 0) ? wrapWidth : maxWidth;
+
+      for (const auto& line : lines) {
+        auto offset = reference - line.width;
+        if (cfg.align == wrap_alignment::center) {
+          offset /= 2;
+        }
+
+        for (auto index = line.first; index < line.first + line.count; ++index) {
+          auto& position = quads[index].position;
+          position.set_x(position.x() + offset);
+        }
+      }
+
+      maxWidth = reference;
+    }
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+
+    layout.mSize = {maxWidth, (isize(lines) - 1) * lineSkip + mFont.height()};
+    return true;
+  }
+
+  /// Lays out a UTF-8 encoded string.
+  auto layout_utf8(const std::string_view str,
+                   text_layout& layout,
+                   const text_layout_cfg& cfg = {}) -> bool
+  {
+    detail::decode_utf8(str, mDecoded);
+    return layout_text(mDecoded, layout, cfg);
+  }
+
+  /**
+   * Renders a previously created layout.
+   *
+   * Glyphs stored in the atlas are submitted as a single batch, whilst glyphs stored as
+   * separate textures are rendered one by one. Glyphs that have not been stored are skipped.
+   *
+   * \param renderer the renderer that will be used.
+   * \param layout the layout that will be rendered, created by this cache.
+   * \param position the position of the top-left corner of the layout.
+   */
+  template <typename T>
+  void render_layout(basic_renderer<T>& renderer,
+                     const text_layout& layout,
+                     const ipoint position)
+  {
+    assert(layout.empty() || owns(layout));
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    const auto tint = renderer.get_color();
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+    for (const auto& [glyph, offset] : layout.quads()) {
+      const auto x = position.x() + offset.x();
+      const auto y = position.y() + offset.y();
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+      if (const auto* data = find_atlas_glyph(glyph)) {
+        const auto& source = data->source;
+        if (source.has_area()) {
+          const frect dst {static_cast<float>(x),
+                           static_cast<float>(y),
+                           static_cast<float>(source.width()),
+                           static_cast<float>(source.height())};
+          mBatch.add(mPages[data->page].sheet, source, dst, 0, renderer_flip::none, tint);
+        }
+
+        continue;
+      }
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+      if (const auto* data = find_glyph(glyph)) {
+        renderer.render(data->glyph, ipoint {x, y});
       }
     }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    mBatch.flush(renderer);
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
   }
 
   /**
@@ -170,6 +498,98 @@ class font_cache final {
     return id;
   }
 
+  /**
+   * Returns a cached texture of a rendered string, rendering and caching it if necessary.
+   *
+   * In contrast with `store()`, strings are identified by their contents, color and render
+   * mode, and the least recently used strings are evicted when the estimated texture memory
+   * exceeds the string budget. This makes it suitable for frequently changing strings. The
+   * most recently fetched string is never evicted.
+   *
+   * \param renderer the renderer that will be used to create the texture on a cache miss.
+   * \param str the UTF-8 string that will be rendered, must not be empty.
+   * \param fg the foreground color of the text.
+   * \param mode the render mode used to render the text.
+   * \param bg the background color, only used by the shaded render mode.
+   *
+   * \return the cached texture, which is valid until the next call to this function.
+   *
+   * \see set_string_budget()
+   * \see string_stats()
+   */
+  template <typename T>
+  auto fetch_string(basic_renderer<T>& renderer,
+                    const std::string_view str,
+                    const color& fg,
+                    const text_render_mode mode = text_render_mode::blended,
+                    const color& bg = colors::black) -> const texture&
+  {
+    const auto background = (mode == text_render_mode::shaded) ? bg : colors::black;
+    const auto key = string_key(str, fg, mode, background);
+
+    if (const auto it = mStringIndex.find(key); it != mStringIndex.end()) {
+      const auto entry = it->second;
+
+      if (entry->str == str && entry->fg == fg && entry->bg == background &&
+          entry->mode == mode) {
+        ++mStringStats.hits;
+        mStringLru.splice(mStringLru.begin(), mStringLru, entry);
+        return entry->image;
+      }
+
+      /* Different strings with the same key, replace the old one */
+      evict_string(entry);
+    }
+
+    ++mStringStats.misses;
+
+    std::string copy {str};
+    auto texture = renderer.make_texture(render_string(copy.c_str(), fg, mode, background));
+    const auto bytes = texture_bytes(texture);
+
+    mStringLru.push_front(
+        string_entry {std::move(copy), fg, background, mode, key, bytes, std::move(texture)});
+    mStringIndex.insert_or_assign(key, mStringLru.begin());
+    mStringStats.bytes += bytes;
+
+    trim_strings();
+
+    return mStringLru.front().image;
+  }
+
+  /// Sets the maximum estimated texture memory used by strings obtained with `fetch_string()`.
+  void set_string_budget(const usize bytes)
+  {
+    mStringBudget = bytes;
+    trim_strings();
+  }
+
+  [[nodiscard]] auto string_budget() const noexcept -> usize { return mStringBudget; }
+
+  /// Returns statistics about the strings obtained with `fetch_string()`.
+  [[nodiscard]] auto string_stats() const noexcept -> string_cache_stats
+  {
+    auto stats = mStringStats;
+    stats.count = mStringLru.size();
+    return stats;
+  }
+
+  /// Resets the hit, miss and eviction counters.
+  void reset_string_stats() noexcept
+  {
+    mStringStats.hits = 0;
+    mStringStats.misses = 0;
+    mStringStats.evictions = 0;
+  }
+
+  /// Removes all strings obtained with `fetch_string()`.
+  void clear_strings() noexcept
+  {
+    mStringIndex.clear();
+    mStringLru.clear();
+    mStringStats.bytes = 0;
+  }
+
   /// Returns the cached string texture for an identifier, if there is one.
   [[nodiscard]] auto find_string(const id_type id) const -> const texture*
   {
@@ -214,6 +634,13 @@ class font_cache final {
       return;
     }
 
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (mStorage == glyph_storage::atlas) {
+      store_atlas_glyph(renderer, glyph);
+      return;
+    }
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
     glyph_data data {make_glyph_texture(renderer, glyph), mFont.get_metrics(glyph).value()};
     mGlyphs.try_emplace(glyph, std::move(data));
   }
@@ -261,6 +688,158 @@ class font_cache final {
     store_latin1_supplement_glyphs(renderer);
   }
 
+  /**
+   * Rasterizes a range of glyphs on worker threads, without blocking the calling thread.
+   *
+   * The glyphs are rendered to surfaces by the thread pool, using separate instances of the
+   * underlying font, and are cached once they are uploaded by `upload_glyphs()`. Glyphs that
+   * have not been uploaded yet are skipped when rendering text, but text can still be laid
+   * out. Large ranges are split into several tasks that are rasterized in parallel.
+   *
+   * Like `store_glyphs()`, glyphs are rendered with the current renderer color, or in white if
+   * atlas storage is enabled, so the storage should be selected before calling this function.
+   * Pending glyphs are cancelled when the cache is destroyed.
+   *
+   * \note This function requires that the cache was created from a font file, since a font
+   *       cannot be safely used by several threads at once. Font DPI settings are not kept.
+   *
+   * \param renderer the renderer that will be used.
+   * \param pool the thread pool that will rasterize the glyphs.
+   * \param begin the first glyph that will be cached.
+   * \param end the range terminator (will not be cached).
+   *
+   * \throws exception if the cache was not created from a font file.
+   *
+   * \see upload_glyphs
+   * \see glyph_progress
+   */
+  template <typename T>
+  void store_glyphs_async(basic_renderer<T>& renderer,
+                          thread_pool& pool,
+                          const unicode_t begin,
+                          const unicode_t end)
+  {
+    if (mPath.empty()) {
+      throw exception {"Asynchronous glyph loading requires a font file path!"};
+    }
+
+    std::vector<unicode_t> glyphs;
+    for (auto glyph = begin; glyph < end; ++glyph) {
+      if (!has_glyph(glyph) && mFont.is_glyph_provided(glyph)) {
+        glyphs.push_back(glyph);
+      }
+    }
+
+    if (glyphs.empty()) {
+      return;
+    }
+
+    const auto atlas = mStorage == glyph_storage::atlas;
+    const auto fg = atlas ? colors::white : renderer.get_color();
+
+    /* Every task needs its own font, so avoid splitting small ranges */
+    constexpr usize min_glyphs_per_task = 32;
+    const auto tasks = detail::max(
+        usize {1},
+        detail::min(pool.size(), glyphs.size() / min_glyphs_per_task));
+    const auto chunk = (glyphs.size() + tasks - 1) / tasks;
+
+    for (usize first = 0; first < glyphs.size(); first += chunk) {
+      const auto last = detail::min(first + chunk, glyphs.size());
+
+      auto job = std::make_unique<glyph_job>(make_rasterizer(),
+                                             fg,
+                                             atlas,
+                                             std::vector<unicode_t>(glyphs.begin() + first,
+                                                                    glyphs.begin() + last));
+      auto* ptr = job.get();
+      mGlyphJobs.push_back(std::move(job));
+
+      try {
+        pool.submit([ptr] { ptr->run(); });
+      }
+      catch (...) {
+        /* The job will never run, so it must not wait for it to finish when destroyed */
+        ptr->abandon();
+        mGlyphJobs.pop_back();
+        throw;
+      }
+
+      mLoadProgress.requested += last - first;
+    }
+  }
+
+  /// Rasterizes the basic latin and Latin-1 supplement glyphs on worker threads.
+  template <typename T>
+  void store_latin1_glyphs_async(basic_renderer<T>& renderer, thread_pool& pool)
+  {
+    store_glyphs_async(renderer, pool, 0x20, 0x7F);
+    store_glyphs_async(renderer, pool, 0xA0, 0xFF + 0x1);
+  }
+
+  /**
+   * Caches glyphs that have been rasterized by worker threads.
+   *
+   * This function is intended to be called once per frame, where the budget limits how much
+   * time is spent on creating textures.
+   *
+   * \param renderer the renderer that will be used.
+   * \param budget the maximum amount of glyphs that will be uploaded.
+   *
+   * \return the amount of glyphs that were uploaded.
+   */
+  template <typename T>
+  auto upload_glyphs(basic_renderer<T>& renderer, const usize budget = 32) -> usize
+  {
+    usize uploaded = 0;
+
+    auto it = mGlyphJobs.begin();
+    while (it != mGlyphJobs.end() && uploaded < budget) {
+      auto& job = **it;
+
+      rasterized_glyph result;
+      while (uploaded < budget && job.pop(result)) {
+        ++mLoadProgress.uploaded;
+        if (upload_glyph(renderer, result)) {
+          ++uploaded;
+        }
+      }
+
+      if (job.done()) {
+        mLoadProgress.rasterized += job.size();
+        it = mGlyphJobs.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+
+    return uploaded;
+  }
+
+  /// Cancels all pending asynchronous glyphs, blocks until running tasks have stopped.
+  void cancel_async_glyphs() noexcept
+  {
+    mGlyphJobs.clear();
+    mLoadProgress.requested = mLoadProgress.uploaded;
+    mLoadProgress.rasterized = mLoadProgress.uploaded;
+  }
+
+  /// Indicates whether there are asynchronously loaded glyphs that have not been uploaded.
+  [[nodiscard]] auto is_loading() const noexcept -> bool { return !mGlyphJobs.empty(); }
+
+  /// Returns the progress of all asynchronously loaded glyphs.
+  [[nodiscard]] auto glyph_progress() const -> glyph_load_progress
+  {
+    auto progress = mLoadProgress;
+
+    for (const auto& job : mGlyphJobs) {
+      progress.rasterized += job->rasterized();
+    }
+
+    return progress;
+  }
+
   /// Returns the cached information associated with a glyph, if there is any.
   [[nodiscard]] auto find_glyph(const unicode_t glyph) const -> const glyph_data*
   {
@@ -272,9 +851,15 @@ class font_cache final {
     }
   }
 
-  /// Indicates whether a glyph has been cached.
+  /// Indicates whether a glyph has been cached, either as a texture or in the atlas.
   [[nodiscard]] auto has_glyph(const unicode_t glyph) const noexcept -> bool
   {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (find_atlas_glyph(glyph)) {
+      return true;
+    }
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
     return find_glyph(glyph) != nullptr;
   }
 
@@ -289,15 +874,542 @@ class font_cache final {
     }
   }
 
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+  /**
+   * Makes subsequently stored glyphs get packed into a glyph atlas.
+   *
+   * Atlas glyphs are rendered in white and tinted with the renderer color when rendered, so
+   * the same atlas can be used for text of any color. Full pages are grown in place until
+   * they reach the maximum page size, at which point additional pages are created.
+   *
+   * \param cfg the atlas configuration.
+   */
+  void enable_atlas(const glyph_atlas_cfg& cfg = {})
+  {
+    assert(cfg.page_size.width > 0 && cfg.page_size.height > 0);
+    assert(cfg.page_size.width <= cfg.max_page_size.width);
+    assert(cfg.page_size.height <= cfg.max_page_size.height);
+    assert(cfg.padding >= 0);
+
+    mStorage = glyph_storage::atlas;
+    mAtlasCfg = cfg;
+  }
+
+  /// Returns the atlas information associated with a glyph, if it is stored in the atlas.
+  [[nodiscard]] auto find_atlas_glyph(const unicode_t glyph) const -> const atlas_glyph*
+  {
+    if (const auto it = mAtlasGlyphs.find(glyph); it != mAtlasGlyphs.end()) {
+      return &it->second;
+    }
+    else {
+      return nullptr;
+    }
+  }
+
+  /// Returns the texture of an atlas page.
+  [[nodiscard]] auto atlas_page(const usize index) const -> const texture&
+  {
+    return mPages.at(index).sheet;
+  }
+
+  /// Returns the amount of atlas pages.
+  [[nodiscard]] auto atlas_page_count() const noexcept -> usize { return mPages.size(); }
+
+  /// Returns the amount of geometry calls issued by the latest atlas text rendering.
+  [[nodiscard]] auto atlas_draw_calls() const noexcept -> usize { return mBatch.draw_calls(); }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+  [[nodiscard]] auto storage() const noexcept -> glyph_storage { return mStorage; }
+
   /// Returns the underlying font instance.
   [[nodiscard]] auto get_font() noexcept -> font& { return mFont; }
   [[nodiscard]] auto get_font() const noexcept -> const font& { return mFont; }
 
  private:
+  /// A glyph rendered to a surface by a worker thread.
+  struct rasterized_glyph final {
+    unicode_t glyph {};
+    maybe<surface> image;  ///< Empty if the glyph could not be rendered.
+    maybe<glyph_metrics> metrics;
+  };
+
+  /// A range of glyphs that is rasterized by a single task, using a private font instance.
+  class glyph_job final {
+   public:
+    glyph_job(font&& rasterizer, const color& fg, const bool atlas, std::vector<unicode_t> glyphs)
+        : mRasterizer {std::move(rasterizer)}
+        , mColor {fg}
+        , mAtlas {atlas}
+        , mGlyphs {std::move(glyphs)}
+    {
+      /* Every glyph fits, so that run() never has to allocate */
+      mReady.reserve(mGlyphs.size());
+    }
+
+    CENTURION_DISABLE_COPY(glyph_job)
+    CENTURION_DISABLE_MOVE(glyph_job)
+
+    /// Cancels the task, and blocks until it is no longer running.
+    ~glyph_job() noexcept
+    {
+      mCancelled = true;
+
+      mMutex.lock();
+      while (!mFinished) {
+        mDone.wait(mMutex);
+      }
+      mMutex.unlock();
+    }
+
+    /// Marks a job that was never submitted as finished.
+    void abandon() noexcept
+    {
+      mMutex.lock();
+      mFinished = true;
+      mMutex.unlock();
+    }
+
+    /// Rasterizes the glyphs, invoked by a worker thread.
+    void run() noexcept
+    {
+      for (const auto glyph : mGlyphs) {
+        if (mCancelled) {
+          break;
+        }
+
+        rasterized_glyph result;
+        result.glyph = glyph;
+
+        try {
+          auto image = mRasterizer.render_blended_glyph(glyph, mColor);
+          if (mAtlas && image.format_info().format() != pixel_format::argb8888) {
+            image = image.convert_to(pixel_format::argb8888);
+          }
+
+          result.image = std::move(image);
+          result.metrics = mRasterizer.get_metrics(glyph);
+        }
+        catch (...) {
+          /* The glyph is skipped on upload */
+        }
+
+        mMutex.lock();
+        mReady.push_back(std::move(result));
+        ++mRasterized;
+        mMutex.unlock();
+      }
+
+      mMutex.lock();
+      mFinished = true;
+      mDone.broadcast();
+      mMutex.unlock();
+    }
+
+    /// Obtains the next rasterized glyph, returns false if there is none available yet.
+    auto pop(rasterized_glyph& result) -> bool
+    {
+      scoped_lock lock {mMutex};
+
+      if (mPopped == mReady.size()) {
+        return false;
+      }
+
+      result = std::move(mReady[mPopped]);
+      ++mPopped;
+
+      return true;
+    }
+
+    /// Indicates whether all glyphs have been rasterized and obtained.
+    [[nodiscard]] auto done() -> bool
+    {
+      scoped_lock lock {mMutex};
+      return mFinished && mPopped == mReady.size();
+    }
+
+    [[nodiscard]] auto rasterized() -> usize
+    {
+      scoped_lock lock {mMutex};
+      return mRasterized;
+    }
+
+    [[nodiscard]] auto size() const noexcept -> usize { return mGlyphs.size(); }
+
+   private:
+    font mRasterizer;
+    color mColor;
+    bool mAtlas {};
+    std::vector<unicode_t> mGlyphs;
+    std::atomic<bool> mCancelled {false};
+
+    mutex mMutex;
+    condition mDone;
+    std::vector<rasterized_glyph> mReady;  ///< Reserved for all glyphs up front.
+    usize mPopped {};                      ///< The amount of glyphs obtained from mReady.
+    usize mRasterized {};
+    bool mFinished {};
+  };
+
   font mFont;
+  std::string mPath;  ///< Empty if the cache was not created from a file.
   std::unordered_map<unicode_t, glyph_data> mGlyphs;
   std::unordered_map<id_type, texture> mStrings;
   id_type mNextStringId {1};
+  glyph_storage mStorage {glyph_storage::textures};
+  std::unordered_map<unicode_t, maybe<glyph_metrics>> mMetrics;
+  std::unordered_map<uint32, int> mKerning;
+  detail::font_layout_state mMetricsState;  ///< The state of the font used by the metrics.
+  uint64 mId {next_id()};  ///< Tells caches apart, even if one is created where another was.
+  std::vector<unicode_t> mDecoded;
+  text_layout mScratchLayout;
+  std::vector<std::unique_ptr<glyph_job>> mGlyphJobs;
+  glyph_load_progress mLoadProgress;
+
+  struct string_entry final {
+    std::string str;
+    color fg;
+    color bg;
+    text_render_mode mode {};
+    usize key {};
+    usize bytes {};
+    texture image;
+  };
+
+  std::list<string_entry> mStringLru;  ///< Most recently used strings first.
+  std::unordered_map<usize, std::list<string_entry>::iterator> mStringIndex;
+  string_cache_stats mStringStats;
+  usize mStringBudget {16u * 1'024u * 1'024u};
+
+  [[nodiscard]] static auto string_key(const std::string_view str,
+                                       const color& fg,
+                                       const text_render_mode mode,
+                                       const color& bg) noexcept -> usize
+  {
+    auto seed = std::hash<std::string_view> {}(str);
+
+    const auto combine = [&seed](const usize value) noexcept {
+      seed ^= value + 0x9E3779B9u + (seed << 6u) + (seed >> 2u);
+    };
+
+    const auto pack = [](const color& c) noexcept -> usize {
+      return (usize {c.red()} << 24u) | (usize {c.green()} << 16u) |
+             (usize {c.blue()} << 8u) | usize {c.alpha()};
+    };
+
+    combine(pack(fg));
+    combine(pack(bg));
+    combine(static_cast<usize>(mode));
+
+    return seed;
+  }
+
+  [[nodiscard]] static auto texture_bytes(const texture& texture) noexcept -> usize
+  {
+    const auto [width, height] = texture.size();
+    return detail::texture_bytes(width, height, to_underlying(texture.format()));
+  }
+
+  [[nodiscard]] auto render_string(const char* str,
+                                   const color& fg,
+                                   const text_render_mode mode,
+                                   const color& bg) const -> surface
+  {
+    switch (mode) {
+      case text_render_mode::solid:
+        return mFont.render_solid_utf8(str, fg);
+
+      case text_render_mode::shaded:
+        return mFont.render_shaded_utf8(str, fg, bg);
+
+      case text_render_mode::blended:
+        return mFont.render_blended_utf8(str, fg);
+
+      default:
+        throw exception {"Did not recognize text render mode!"};
+    }
+  }
+
+  void evict_string(const std::list<string_entry>::iterator entry)
+  {
+    mStringStats.bytes -= entry->bytes;
+    mStringIndex.erase(entry->key);
+    mStringLru.erase(entry);
+  }
+
+  void trim_strings()
+  {
+    while (mStringStats.bytes > mStringBudget && mStringLru.size() > 1) {
+      evict_string(std::prev(mStringLru.end()));
+      ++mStringStats.evictions;
+    }
+  }
+
+  [[nodiscard]] static auto next_id() noexcept -> uint64
+  {
+    static std::atomic<uint64> id {1};
+    return id.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Indicates whether a layout was created by this cache.
+  [[nodiscard]] auto owns(const text_layout& layout) const noexcept -> bool
+  {
+    return layout.mOwner == this && layout.mOwnerId == mId;
+  }
+
+  /// Returns the current layout state of the font, the cached metrics are discarded if stale.
+  auto sync_font_state() -> detail::font_layout_state
+  {
+    const detail::font_layout_state state {mFont.size(),
+                                           TTF_GetFontStyle(mFont.get()),
+                                           mFont.outline(),
+                                           to_underlying(mFont.hinting()),
+                                           mFont.has_kerning()};
+
+    if (state != mMetricsState) {
+      mMetrics.clear();
+      mKerning.clear();
+      mMetricsState = state;
+    }
+
+    return state;
+  }
+
+  /// Returns the metrics of a glyph, or null if the glyph is not provided by the font.
+  [[nodiscard]] auto cached_metrics(const unicode_t glyph) -> const glyph_metrics*
+  {
+    auto it = mMetrics.find(glyph);
+    if (it == mMetrics.end()) {
+      it = mMetrics.try_emplace(glyph, mFont.get_metrics(glyph)).first;
+    }
+
+    const auto& metrics = it->second;
+    return metrics ? &metrics.value() : nullptr;
+  }
+
+  [[nodiscard]] auto cached_kerning(const unicode_t previous, const unicode_t current) -> int
+  {
+    const auto key = (static_cast<uint32>(previous) << 16u) | current;
+
+    auto it = mKerning.find(key);
+    if (it == mKerning.end()) {
+      it = mKerning.try_emplace(key, mFont.get_kerning(previous, current)).first;
+    }
+
+    return it->second;
+  }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+  struct page_data final {
+    texture sheet;       ///< The texture that holds the packed glyphs.
+    surface pixels;      ///< CPU-side copy of the sheet, used when the page grows.
+    rect_packer packer;  ///< Keeps track of the free space in the sheet.
+  };
+
+  std::unordered_map<unicode_t, atlas_glyph> mAtlasGlyphs;
+  std::vector<page_data> mPages;
+  glyph_atlas_cfg mAtlasCfg;
+  sprite_batch mBatch {sprite_sort_mode::texture};
+
+  template <typename T>
+  void store_atlas_glyph(basic_renderer<T>& renderer, const unicode_t glyph)
+  {
+    insert_atlas_glyph(renderer,
+                       glyph,
+                       rasterize_atlas_glyph(glyph),
+                       mFont.get_metrics(glyph).value());
+  }
+
+  template <typename T>
+  void insert_atlas_glyph(basic_renderer<T>& renderer,
+                          const unicode_t glyph,
+                          const surface& image,
+                          const glyph_metrics& metrics)
+  {
+    if (image.width() == 0 || image.height() == 0) {
+      mAtlasGlyphs.try_emplace(glyph, atlas_glyph {0, irect {}, metrics});
+      return;
+    }
+
+    if (mPages.empty()) {
+      add_atlas_page(renderer, mAtlasCfg.page_size);
+    }
+
+    /* Prefer existing pages, then grow the last page, and finally create a new page */
+    for (usize page = 0; page < mPages.size(); ++page) {
+      if (pack_atlas_glyph(page, glyph, image, metrics)) {
+        return;
+      }
+    }
+
+    const auto last = mPages.size() - 1;
+    const auto size = mPages[last].packer.size();
+
+    if (size.width < mAtlasCfg.max_page_size.width ||
+        size.height < mAtlasCfg.max_page_size.height) {
+      const iarea larger {detail::min(size.width * 2, mAtlasCfg.max_page_size.width),
+                          detail::min(size.height * 2, mAtlasCfg.max_page_size.height)};
+      grow_atlas_page(renderer, last, larger);
+
+      if (pack_atlas_glyph(last, glyph, image, metrics)) {
+        return;
+      }
+    }
+
+    add_atlas_page(renderer, mAtlasCfg.page_size);
+    if (!pack_atlas_glyph(mPages.size() - 1, glyph, image, metrics)) {
+      throw exception {"Glyph does not fit in an empty atlas page!"};
+    }
+  }
+
+  [[nodiscard]] auto rasterize_atlas_glyph(const unicode_t glyph) const -> surface
+  {
+    auto image = mFont.render_blended_glyph(glyph, colors::white);
+    if (image.format_info().format() != pixel_format::argb8888) {
+      image = image.convert_to(pixel_format::argb8888);
+    }
+
+    return image;
+  }
+
+  auto pack_atlas_glyph(const usize page,
+                        const unicode_t glyph,
+                        const surface& image,
+                        const glyph_metrics& metrics) -> bool
+  {
+    auto& [sheet, pixels, packer] = mPages[page];
+
+    const auto padding = mAtlasCfg.padding;
+    const auto area = packer.insert({image.width() + padding, image.height() + padding});
+    if (!area) {
+      return false;
+    }
+
+    const irect source {area->x(), area->y(), image.width(), image.height()};
+    copy_atlas_pixels(pixels, source.position(), image.pixel_data(), image.pitch(), image.size());
+    upload_atlas_pixels(sheet, &source, image.pixel_data(), image.pitch());
+
+    mAtlasGlyphs.insert_or_assign(glyph, atlas_glyph {page, source, metrics});
+    return true;
+  }
+
+  template <typename T>
+  void add_atlas_page(basic_renderer<T>& renderer, const iarea size)
+  {
+    surface pixels {size, pixel_format::argb8888};
+    auto sheet = make_atlas_texture(renderer, size);
+    upload_atlas_pixels(sheet, nullptr, pixels.pixel_data(), pixels.pitch());
+
+    mPages.push_back(page_data {std::move(sheet), std::move(pixels), rect_packer {size}});
+  }
+
+  /**
+   * Enlarges an atlas page, without moving or rasterizing any of its glyphs again.
+   *
+   * The larger page is built from the CPU-side copy of the old page, and only replaces the old
+   * page once it is complete, so the page is left untouched if anything fails.
+   */
+  template <typename T>
+  void grow_atlas_page(basic_renderer<T>& renderer, const usize page, const iarea size)
+  {
+    auto& current = mPages.at(page);
+
+    surface pixels {size, pixel_format::argb8888};
+    copy_atlas_pixels(pixels,
+                      ipoint {},
+                      current.pixels.pixel_data(),
+                      current.pixels.pitch(),
+                      current.pixels.size());
+
+    auto sheet = make_atlas_texture(renderer, size);
+    upload_atlas_pixels(sheet, nullptr, pixels.pixel_data(), pixels.pitch());
+
+    auto packer = current.packer;
+    packer.grow(size);
+
+    current.sheet = std::move(sheet);
+    current.pixels = std::move(pixels);
+    current.packer = std::move(packer);
+  }
+
+  template <typename T>
+  [[nodiscard]] auto make_atlas_texture(basic_renderer<T>& renderer, const iarea size)
+      -> texture
+  {
+    auto sheet = renderer.make_texture(size, pixel_format::argb8888, texture_access::streaming);
+    sheet.set_blend_mode(blend_mode::blend);
+    return sheet;
+  }
+
+  static void upload_atlas_pixels(texture& sheet,
+                                  const irect* area,
+                                  const void* pixels,
+                                  const int pitch)
+  {
+    const auto* rect = area ? area->data() : nullptr;
+    if (SDL_UpdateTexture(sheet.get(), rect, pixels, pitch) != 0) {
+      throw sdl_error {};
+    }
+  }
+
+  /// Copies ARGB8888 pixels into an atlas surface, which never has to be locked.
+  static void copy_atlas_pixels(surface& target,
+                                const ipoint& position,
+                                const void* pixels,
+                                const int pitch,
+                                const iarea& size) noexcept
+  {
+    assert(!target.must_lock());
+    assert(position.x() + size.width <= target.width());
+    assert(position.y() + size.height <= target.height());
+
+    const auto bytes = static_cast<usize>(size.width) * sizeof(uint32);
+    const auto* source = static_cast<const uint8*>(pixels);
+    auto* destination = static_cast<uint8*>(target.pixel_data()) +
+                        (position.y() * target.pitch()) +
+                        (static_cast<usize>(position.x()) * sizeof(uint32));
+
+    for (int row = 0; row < size.height; ++row) {
+      std::memcpy(destination + (row * target.pitch()), source + (row * pitch), bytes);
+    }
+  }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+  /// Creates a font instance with the same settings as the cached font, for use by workers.
+  [[nodiscard]] auto make_rasterizer() const -> font
+  {
+    font rasterizer {mPath, mFont.size()};
+
+    TTF_SetFontStyle(rasterizer.get(), TTF_GetFontStyle(mFont.get()));
+    rasterizer.set_outline(mFont.outline());
+    rasterizer.set_hinting(mFont.hinting());
+
+    return rasterizer;
+  }
+
+  /// Caches a glyph rasterized by a worker, returns false if the glyph was skipped.
+  template <typename T>
+  auto upload_glyph(basic_renderer<T>& renderer, const rasterized_glyph& result) -> bool
+  {
+    if (!result.image || !result.metrics || has_glyph(result.glyph)) {
+      return false;
+    }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (mStorage == glyph_storage::atlas) {
+      insert_atlas_glyph(renderer, result.glyph, *result.image, *result.metrics);
+      return true;
+    }
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+    glyph_data data {renderer.make_texture(*result.image), *result.metrics};
+    mGlyphs.try_emplace(result.glyph, std::move(data));
+
+    return true;
+  }
 
   template <typename T>
   [[nodiscard]] auto make_glyph_texture(basic_renderer<T>& renderer, const unicode_t glyph)
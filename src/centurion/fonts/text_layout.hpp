@@ -0,0 +1,223 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_FONTS_TEXT_LAYOUT_HPP_
+#define CENTURION_FONTS_TEXT_LAYOUT_HPP_
+
+#ifndef CENTURION_NO_SDL_TTF
+
+#include <SDL_ttf.h>
+
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "wrap_alignment.hpp"
+
+namespace cen {
+
+/// Configures how text is laid out by a font cache.
+struct text_layout_cfg final {
+  int wrap_width {};  ///< The maximum width of lines in pixels, zero disables wrapping.
+
+#if SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+  wrap_alignment align {wrap_alignment::left};  ///< The horizontal alignment of the lines.
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+};
+
+[[nodiscard]] inline auto operator==(const text_layout_cfg& a, const text_layout_cfg& b) noexcept
+    -> bool
+{
+#if SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+  return a.wrap_width == b.wrap_width && a.align == b.align;
+#else
+  return a.wrap_width == b.wrap_width;
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+}
+
+[[nodiscard]] inline auto operator!=(const text_layout_cfg& a, const text_layout_cfg& b) noexcept
+    -> bool
+{
+  return !(a == b);
+}
+
+namespace detail {
+
+/// The font properties that affect the layout of text.
+struct font_layout_state final {
+  int size {};
+  int style {};
+  int outline {};
+  int hinting {};
+  bool kerning {};
+};
+
+[[nodiscard]] inline auto operator==(const font_layout_state& a,
+                                     const font_layout_state& b) noexcept -> bool
+{
+  return a.size == b.size && a.style == b.style && a.outline == b.outline &&
+         a.hinting == b.hinting && a.kerning == b.kerning;
+}
+
+[[nodiscard]] inline auto operator!=(const font_layout_state& a,
+                                     const font_layout_state& b) noexcept -> bool
+{
+  return !(a == b);
+}
+
+}  // namespace detail
+
+/**
+ * Represents a string that has been split into positioned glyphs.
+ *
+ * Layouts are created by font caches, and are intended to be kept around for as long as the
+ * associated text is unchanged, so that the text can be rendered every frame without doing any
+ * layout work. Laying out a new string reuses the previously allocated memory.
+ *
+ * \see font_cache::layout_text()
+ */
+class text_layout final {
+ public:
+  struct quad final {
+    unicode_t glyph {};  ///< The glyph that should be rendered.
+    ipoint position;     ///< The position of the glyph image, relative to the layout origin.
+  };
+
+  struct line final {
+    usize first {};  ///< The index of the first quad in the line.
+    usize count {};  ///< The amount of quads in the line.
+    int width {};    ///< The width of the line, excluding trailing spaces.
+  };
+
+  /// Removes all glyphs, but keeps the allocated memory.
+  void clear() noexcept
+  {
+    mQuads.clear();
+    mLines.clear();
+    mSource.clear();
+    mOwner = nullptr;
+    mOwnerId = 0;
+    mSize = {};
+  }
+
+  [[nodiscard]] auto quads() const noexcept -> const std::vector<quad>& { return mQuads; }
+
+  [[nodiscard]] auto lines() const noexcept -> const std::vector<line>& { return mLines; }
+
+  /// Returns the size of the bounding box of the text.
+  [[nodiscard]] auto size() const noexcept -> iarea { return mSize; }
+
+  [[nodiscard]] auto cfg() const noexcept -> const text_layout_cfg& { return mCfg; }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mQuads.empty(); }
+
+ private:
+  friend class font_cache;
+
+  std::vector<quad> mQuads;
+  std::vector<line> mLines;
+  std::vector<unicode_t> mSource;
+  text_layout_cfg mCfg;
+  detail::font_layout_state mFontState;  ///< The state of the font when laid out.
+  iarea mSize {};
+  const void* mOwner {};
+  uint64 mOwnerId {};  ///< The identifier of the cache, since addresses may be reused.
+};
+
+namespace detail {
+
+/**
+ * Decodes a UTF-8 string into UCS-2 code points.
+ *
+ * Malformed sequences and code points outside of the basic multilingual plane are replaced with
+ * U+FFFD, since glyphs are identified using 16-bit values.
+ */
+inline void decode_utf8(const std::string_view str, std::vector<unicode_t>& out)
+{
+  constexpr unicode_t replacement = 0xFFFD;
+
+  out.clear();
+  out.reserve(str.size());
+
+  for (usize index = 0; index < str.size();) {
+    const auto lead = static_cast<unsigned char>(str[index]);
+
+    usize length {};
+    uint32 code {};
+
+    if (lead < 0x80) {
+      length = 1;
+      code = lead;
+    }
+    else if ((lead & 0xE0) == 0xC0) {
+      length = 2;
+      code = lead & 0x1Fu;
+    }
+    else if ((lead & 0xF0) == 0xE0) {
+      length = 3;
+      code = lead & 0x0Fu;
+    }
+    else if ((lead & 0xF8) == 0xF0) {
+      length = 4;
+      code = lead & 0x07u;
+    }
+    else {
+      out.push_back(replacement);
+      ++index;
+      continue;
+    }
+
+    if (index + length > str.size()) {
+      out.push_back(replacement);
+      break;
+    }
+
+    bool valid = true;
+    for (usize i = 1; i < length; ++i) {
+      const auto next = static_cast<unsigned char>(str[index + i]);
+      if ((next & 0xC0) != 0x80) {
+        valid = false;
+        break;
+      }
+
+      code = (code << 6u) | (next & 0x3Fu);
+    }
+
+    if (valid) {
+      out.push_back((code <= 0xFFFF) ? static_cast<unicode_t>(code) : replacement);
+      index += length;
+    }
+    else {
+      out.push_back(replacement);
+      ++index;
+    }
+  }
+}
+
+}  // namespace detail
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_TTF
+#endif  // CENTURION_FONTS_TEXT_LAYOUT_HPP_
@@ -41,12 +41,17 @@ class file;
 
 class font;
 class font_cache;
+class text_layout;
 class unicode_string;
 
 struct dpi_info;
 struct blend_task;
 struct renderer_scale;
 class color;
+struct color_matrix;
+struct hsv_color;
+struct hsl_color;
+struct gradient_stop;
 class gl_library;
 class vk_library;
 class display_mode;
@@ -54,6 +59,11 @@ class display_mode;
 class music;
 
 class palette;
+class pixel_buffer;
+struct quantize_options;
+struct indexed_image;
+struct color_cycle;
+class palette_cycler;
 
 class condition;
 class mutex;
@@ -61,6 +71,7 @@ class scoped_lock;
 class try_lock;
 class semaphore;
 class thread;
+class thread_pool;
 
 class audio_device_event;
 class controller_axis_event;
@@ -101,9 +112,41 @@ class locale;
 
 class simd_block;
 class shared_object;
+class precise_sleeper;
+struct frame_scheduler_options;
+struct frame_stats;
+class frame_scheduler;
 
 class message_box_color_scheme;
 class message_box;
+class rect_packer;
+class sprite_batch;
+class damage_tracker;
+class frame_capture;
+class render_command_list;
+struct render_frame_stats;
+class render_profiler;
+class shape_mesh;
+class shape_cache;
+class texture_lock;
+class sub_texture;
+class atlas_builder;
+class texture_atlas;
+struct atlas_layout;
+struct atlas_region;
+class texture_request;
+class texture_loader;
+class managed_texture;
+class texture_manager;
+struct texture_manager_stats;
+class tilemap;
+struct tilemap_stats;
+class animation_atlas;
+struct animation_state;
+class animation_player;
+struct pool_stats;
+class surface_pool;
+class texture_pool;
 
 namespace experimental {
 class font_bundle;
@@ -163,6 +206,9 @@ class basic_surface;
 template <typename T>
 class basic_texture;
 
+template <typename Pool>
+class basic_pool_lease;
+
 template <typename T>
 struct deleter;
 
@@ -24,6 +24,7 @@
 
 #include "system/clipboard.hpp"
 #include "system/endian.hpp"
+#include "system/frame_scheduler.hpp"
 #include "system/memory.hpp"
 #include "system/platform.hpp"
 #include "system/locale.hpp"
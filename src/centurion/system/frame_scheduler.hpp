@@ -0,0 +1,394 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_SYSTEM_FRAME_SCHEDULER_HPP_
+#define CENTURION_SYSTEM_FRAME_SCHEDULER_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>  // nth_element, max_element
+#include <cmath>      // sqrt, round, abs
+#include <vector>     // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../detail/stdlib.hpp"
+#include "timer.hpp"
+
+namespace cen {
+
+/**
+ * Sleeps with sub-millisecond precision.
+ *
+ * \details The system sleep functions only have millisecond granularity, and usually oversleep
+ * by a bit. This sleeps in whole milliseconds while the remaining time is larger than the
+ * expected duration of such a sleep, and spins for the rest. The expectation is continuously
+ * updated from the observed sleeps, so little time is spent spinning.
+ */
+class precise_sleeper final {
+ public:
+  /// Sleeps until the high-performance counter reaches a deadline.
+  void sleep_until(const uint64 deadline) noexcept
+  {
+    const auto freq = static_cast<double>(frequency());
+
+    auto current = now();
+    while (current < deadline && static_cast<double>(deadline - current) / freq > mEstimate) {
+      SDL_Delay(1);
+
+      const auto after = now();
+      observe(static_cast<double>(after - current) / freq);
+      current = after;
+    }
+
+    while (now() < deadline) {
+      // Spin for the remaining fraction of a millisecond
+    }
+  }
+
+  void sleep_for(const seconds<double> duration) noexcept
+  {
+    if (duration.count() > 0) {
+      const auto ticks = duration.count() * static_cast<double>(frequency());
+      sleep_until(now() + static_cast<uint64>(ticks));
+    }
+  }
+
+  /// Returns the remaining time below which the sleeper spins instead of sleeping.
+  [[nodiscard]] auto spin_threshold() const noexcept -> seconds<double>
+  {
+    return seconds<double> {mEstimate};
+  }
+
+ private:
+  inline constexpr static double weight = 1.0 / 64.0;
+
+  double mMean {0.002};           ///< The mean duration of a 1 ms sleep, in seconds.
+  double mVariance {0.000'001};   ///< The variance of the sleep durations.
+  double mEstimate {0.003};       ///< One standard deviation above the mean.
+
+  void observe(const double duration) noexcept
+  {
+    // Exponentially weighted, so that the estimate follows changes in system load
+    const auto delta = duration - mMean;
+    mMean += weight * delta;
+    mVariance = (1.0 - weight) * (mVariance + weight * delta * delta);
+    mEstimate = mMean + std::sqrt(mVariance);
+  }
+};
+
+/// Options that control the rates of a frame scheduler.
+struct frame_scheduler_options final {
+  double update_rate {60};   ///< The amount of fixed updates per second.
+  double frame_rate {0};     ///< The maximum frame rate, zero leaves pacing to vsync.
+  double refresh_rate {0};   ///< The display refresh rate, zero detects vsync from frame times.
+  int max_updates {5};       ///< The maximum amount of updates per frame.
+};
+
+/// Frame time statistics, the durations are computed from the most recent frames.
+struct frame_stats final {
+  usize frames {};          ///< The total amount of frames.
+  usize updates {};         ///< The total amount of fixed updates.
+  usize dropped_frames {};  ///< Frames that took longer than one and a half target intervals.
+  millis<double> mean {};   ///< The mean frame time.
+  millis<double> p99 {};    ///< The 99th percentile frame time.
+  millis<double> max {};    ///< The longest frame time.
+};
+
+/**
+ * Runs fixed-rate updates with interpolated rendering, and paces the frames.
+ *
+ * \details Each frame runs as many fixed updates as the elapsed time allows, followed by a
+ * render call with the fraction of an update that remains, which can be used to interpolate
+ * between the two latest states. Frames are capped to the frame rate using a precise sleep.
+ *
+ * If presenting blocks on vsync, the frame times become stable without any sleeping, and the
+ * scheduler stops pacing by itself so that it doesn't fight the display. Frame times within a
+ * fraction of a millisecond of a multiple of the refresh interval are then snapped to it,
+ * which avoids uneven amounts of updates from timer jitter.
+ *
+ * \see precise_sleeper
+ */
+class frame_scheduler final {
+ public:
+  /// The amount of recent frames used for the frame time statistics.
+  inline constexpr static usize stats_window = 240;
+
+  /**
+   * Creates a frame scheduler.
+   *
+   * \param options the update and frame rates.
+   *
+   * \throws exception if the update rate or maximum amount of updates is not positive.
+   */
+  explicit frame_scheduler(const frame_scheduler_options& options = {})
+      : mOptions {options}
+  {
+    if (!(mOptions.update_rate > 0) || mOptions.max_updates < 1) {
+      throw exception {"Invalid frame scheduler update rate!"};
+    }
+
+    mStep = 1.0 / mOptions.update_rate;
+    mFrameInterval = (mOptions.frame_rate > 0) ? 1.0 / mOptions.frame_rate : 0.0;
+    mRefreshInterval = (mOptions.refresh_rate > 0) ? 1.0 / mOptions.refresh_rate : 0.0;
+
+    mSamples.reserve(stats_window);
+  }
+
+  /**
+   * Runs a single frame.
+   *
+   * \param update called with the fixed time step, zero or more times.
+   * \param render called once with the interpolation factor, in the range [0, 1).
+   */
+  template <typename Update, typename Render>
+  void tick(Update&& update, Render&& render)
+  {
+    const auto start = now();
+
+    auto delta = 0.0;
+    if (mStarted) {
+      const auto frameTime = to_seconds(start - mPrevious);
+      record(frameTime);
+      delta = absorb(frameTime);
+    }
+    else {
+      mStarted = true;
+      mDeadline = start;
+    }
+
+    mPrevious = start;
+
+    // Drop time that can't be caught up with, rather than spiraling into ever longer frames
+    mAccumulator += detail::min(delta, mStep * mOptions.max_updates);
+
+    while (mAccumulator >= mStep) {
+      update(seconds<double> {mStep});
+      mAccumulator -= mStep;
+      ++mStats.updates;
+    }
+
+    render(mAccumulator / mStep);
+    ++mStats.frames;
+
+    pace();
+  }
+
+  /// Runs frames for as long as the predicate returns true.
+  template <typename Running, typename Update, typename Render>
+  void run(Running&& running, Update&& update, Render&& render)
+  {
+    while (running()) {
+      tick(update, render);
+    }
+  }
+
+  /**
+   * Restarts the clock of the scheduler.
+   *
+   * This should be called after blocking operations such as loading a level, so that the
+   * time spent doing so isn't treated as a dropped frame.
+   */
+  void reset_clock() noexcept
+  {
+    mStarted = false;
+    mAccumulator = 0;
+  }
+
+  /// Returns the statistics of the recent frames.
+  [[nodiscard]] auto stats() const -> frame_stats
+  {
+    auto result = mStats;
+    if (mSamples.empty()) {
+      return result;
+    }
+
+    auto sorted = mSamples;
+
+    double sum {};
+    for (const auto sample : sorted) {
+      sum += sample;
+    }
+
+    const auto percentile = static_cast<usize>(0.99 * static_cast<double>(sorted.size() - 1));
+    std::nth_element(sorted.begin(), sorted.begin() + percentile, sorted.end());
+
+    const auto p99 = sorted[percentile];
+    const auto max = *std::max_element(sorted.begin() + percentile, sorted.end());
+
+    result.mean = millis<double> {sum / static_cast<double>(sorted.size()) * 1'000.0};
+    result.p99 = millis<double> {p99 * 1'000.0};
+    result.max = millis<double> {max * 1'000.0};
+
+    return result;
+  }
+
+  /// Indicates whether the frames are currently paced by vsync.
+  [[nodiscard]] auto vsync_detected() const noexcept -> bool { return mVsync; }
+
+  /// Returns the refresh interval used to absorb jitter, zero if it's unknown.
+  [[nodiscard]] auto refresh_interval() const noexcept -> seconds<double>
+  {
+    return seconds<double> {(mRefreshInterval > 0) ? mRefreshInterval : mVsyncInterval};
+  }
+
+  /// Returns the fixed time step of the updates.
+  [[nodiscard]] auto step() const noexcept -> seconds<double> { return seconds<double> {mStep}; }
+
+  [[nodiscard]] auto options() const noexcept -> const frame_scheduler_options&
+  {
+    return mOptions;
+  }
+
+  [[nodiscard]] auto sleeper() const noexcept -> const precise_sleeper& { return mSleeper; }
+
+ private:
+  /// Frame times within this many seconds of a multiple of the refresh interval are snapped.
+  inline constexpr static double snap_tolerance = 0.000'2;
+
+  /// Frame times within this many seconds of the average are considered stable.
+  inline constexpr static double stable_tolerance = 0.000'5;
+
+  /// The amount of stable frames without pacing before vsync is considered to be active.
+  inline constexpr static int vsync_frames = 60;
+
+  frame_scheduler_options mOptions;
+  precise_sleeper mSleeper;
+  frame_stats mStats;
+  std::vector<double> mSamples;  ///< Recent frame times, in seconds.
+  usize mNextSample {};
+
+  double mStep {};
+  double mFrameInterval {};
+  double mRefreshInterval {};
+  double mAccumulator {};
+
+  bool mStarted {};
+  uint64 mPrevious {};
+  uint64 mDeadline {};
+  double mLastSleep {};
+
+  bool mVsync {};
+  double mAverage {};        ///< A moving average of the frame times.
+  double mVsyncInterval {};  ///< The average frame time when vsync was detected.
+  int mStableFrames {};
+  int mFastFrames {};
+
+  [[nodiscard]] static auto to_seconds(const uint64 ticks) noexcept -> double
+  {
+    return static_cast<double>(ticks) / static_cast<double>(frequency());
+  }
+
+  /// Returns the frame time that is considered on time, zero if there is none.
+  [[nodiscard]] auto target_interval() const noexcept -> double
+  {
+    if (mFrameInterval > 0) {
+      return detail::max(mFrameInterval, refresh_interval().count());
+    }
+    else if (const auto refresh = refresh_interval().count(); refresh > 0) {
+      return refresh;
+    }
+    else {
+      return mStep;
+    }
+  }
+
+  void record(const double frameTime)
+  {
+    if (mSamples.size() < stats_window) {
+      mSamples.push_back(frameTime);
+    }
+    else {
+      mSamples[mNextSample] = frameTime;
+      mNextSample = (mNextSample + 1) % stats_window;
+    }
+
+    if (frameTime > 1.5 * target_interval()) {
+      ++mStats.dropped_frames;
+    }
+
+    mAverage = (mAverage > 0) ? mAverage + (frameTime - mAverage) / 16.0 : frameTime;
+
+    if (!mVsync) {
+      // Frames that were stable without any sleeping must have been paced by something else
+      const auto stable = std::abs(frameTime - mAverage) < stable_tolerance;
+      mStableFrames = (stable && mLastSleep < stable_tolerance) ? mStableFrames + 1 : 0;
+
+      if (mStableFrames >= vsync_frames) {
+        mVsync = true;
+        mVsyncInterval = mAverage;
+        mFastFrames = 0;
+      }
+    }
+    else {
+      // Vsync is usually disabled when a window is hidden, which makes frames much shorter
+      mFastFrames = (frameTime < 0.75 * mVsyncInterval) ? mFastFrames + 1 : 0;
+
+      if (mFastFrames >= 10) {
+        mVsync = false;
+        mVsyncInterval = 0;
+        mStableFrames = 0;
+      }
+    }
+  }
+
+  /// Snaps frame times close to a multiple of the refresh interval to that multiple.
+  [[nodiscard]] auto absorb(const double frameTime) const noexcept -> double
+  {
+    const auto interval = refresh_interval().count();
+    if (interval > 0) {
+      const auto multiple = std::round(frameTime / interval);
+      if (multiple >= 1 && std::abs(frameTime - multiple * interval) < snap_tolerance) {
+        return multiple * interval;
+      }
+    }
+
+    return frameTime;
+  }
+
+  void pace() noexcept
+  {
+    mLastSleep = 0;
+
+    if (mFrameInterval <= 0 || mVsync) {
+      return;
+    }
+
+    mDeadline += static_cast<uint64>(mFrameInterval * static_cast<double>(frequency()));
+
+    // Don't try to catch up after a slow frame by running several frames back to back
+    const auto current = now();
+    if (mDeadline <= current) {
+      mDeadline = current;
+      return;
+    }
+
+    mLastSleep = to_seconds(mDeadline - current);
+    mSleeper.sleep_until(mDeadline);
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_SYSTEM_FRAME_SCHEDULER_HPP_
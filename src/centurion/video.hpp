@@ -23,17 +23,33 @@
  */
 
 #include "video/animation.hpp"
+#include "video/animation_atlas.hpp"
 #include "video/blend.hpp"
 #include "video/color.hpp"
+#include "video/color_ops.hpp"
+#include "video/damage_tracker.hpp"
 #include "video/display.hpp"
 #include "video/flash_op.hpp"
+#include "video/frame_capture.hpp"
 #include "video/message_box.hpp"
 #include "video/opengl.hpp"
+#include "video/palette_ops.hpp"
+#include "video/pixel_kernels.hpp"
 #include "video/pixels.hpp"
+#include "video/render_command_list.hpp"
+#include "video/render_profiler.hpp"
 #include "video/renderer.hpp"
 #include "video/renderer_info.hpp"
+#include "video/resource_pool.hpp"
+#include "video/shapes.hpp"
+#include "video/sprite_batch.hpp"
 #include "video/surface.hpp"
+#include "video/surface_ops.hpp"
 #include "video/texture.hpp"
+#include "video/texture_atlas.hpp"
+#include "video/texture_loader.hpp"
+#include "video/texture_manager.hpp"
+#include "video/tilemap.hpp"
 #include "video/unicode_string.hpp"
 #include "video/vulkan.hpp"
 #include "video/window.hpp"
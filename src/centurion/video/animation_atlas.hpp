@@ -0,0 +1,468 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_ANIMATION_ATLAS_HPP_
+#define CENTURION_VIDEO_ANIMATION_ATLAS_HPP_
+
+#ifndef CENTURION_NO_SDL_IMAGE
+
+#include <SDL.h>
+#include <SDL_image.h>
+
+#include <algorithm>    // upper_bound
+#include <cmath>        // ceil, sqrt
+#include <cstring>      // memset
+#include <numeric>      // gcd
+#include <ostream>      // ostream
+#include <string_view>  // string_view
+#include <utility>      // move
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../detail/stdlib.hpp"
+#include "animation.hpp"
+#include "blend.hpp"
+#include "pixel_kernels.hpp"
+#include "renderer.hpp"
+#include "texture.hpp"
+#include "texture_atlas.hpp"
+
+namespace cen {
+
+#if SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
+
+/**
+ * Represents when the frames of an animation atlas are uploaded to its texture.
+ *
+ * \see animation_atlas
+ */
+enum class frame_upload {
+  eager,  ///< Upload all frames when the atlas is created.
+  lazy    ///< Upload each frame when it's first displayed, which keeps startup fast.
+};
+
+[[nodiscard]] constexpr auto to_string(const frame_upload upload) -> std::string_view
+{
+  switch (upload) {
+    case frame_upload::eager:
+      return "eager";
+
+    case frame_upload::lazy:
+      return "lazy";
+
+    default:
+      throw exception {"Did not recognize frame upload mode!"};
+  }
+}
+
+inline auto operator<<(std::ostream& stream, const frame_upload upload) -> std::ostream&
+{
+  return stream << to_string(upload);
+}
+
+/**
+ * The frames of an animation packed into a single texture, along with their timings.
+ *
+ * \details The frames are laid out in a grid, so every frame is a region of the same texture
+ * and animated sprites can be batched, e.g. with `sprite_batch`. The atlas takes ownership of
+ * the animation, and releases its frames once all of them have been uploaded.
+ *
+ * \see animation_player
+ */
+class animation_atlas final {
+ public:
+  /// The delay used for frames without one, which is what browsers do for GIF images.
+  inline constexpr static int default_delay = 100;
+
+  /**
+   * Creates an atlas from the frames of an animation.
+   *
+   * \param renderer the renderer used to create the atlas texture.
+   * \param source the animation, which will be owned by the atlas until it's fully uploaded.
+   * \param upload determines when the frames are uploaded to the texture.
+   * \param padding the amount of transparent pixels around each frame, avoids bleeding
+   * between neighbouring frames when the atlas is sampled with linear filtering.
+   *
+   * \throws exception if the animation has no frames or doesn't fit in a texture.
+   * \throws sdl_error if the texture could not be created or updated.
+   */
+  template <typename T>
+  animation_atlas(basic_renderer<T>& renderer,
+                  animation source,
+                  const frame_upload upload = frame_upload::lazy,
+                  const int padding = 1)
+      : mFrameSize {source.size()}
+      , mPadding {detail::max(padding, 0)}
+  {
+    const auto count = static_cast<usize>(source.count());
+    if (count == 0) {
+      throw exception {"Cannot create an atlas from an empty animation!"};
+    }
+
+    const iarea cell {mFrameSize.width + 2 * mPadding, mFrameSize.height + 2 * mPadding};
+    const auto grid = grid_size(count, cell, atlas_builder::max_page_size(renderer));
+
+    mTexture.emplace(renderer.make_texture({grid.width * cell.width, grid.height * cell.height},
+                                           pixel_format::argb8888,
+                                           texture_access::non_lockable));
+    mTexture->set_blend_mode(blend_mode::blend);
+
+    mRegions.reserve(count);
+    mFrameEnds.reserve(count);
+
+    int end = 0;
+    for (usize index = 0; index < count; ++index) {
+      const auto column = static_cast<int>(index % static_cast<usize>(grid.width));
+      const auto row = static_cast<int>(index / static_cast<usize>(grid.width));
+
+      mRegions.emplace_back(column * cell.width + mPadding,
+                            row * cell.height + mPadding,
+                            mFrameSize.width,
+                            mFrameSize.height);
+
+      const auto delay = source.delay(index);
+      end += (delay > 0) ? delay : default_delay;
+      mFrameEnds.push_back(end);
+    }
+
+    mUploaded.resize(count);
+    mSource.emplace(std::move(source));
+
+    make_frame_table();
+
+    if (upload == frame_upload::eager && !prepare_all()) {
+      throw sdl_error {};
+    }
+  }
+
+  /**
+   * Uploads a frame to the texture, unless it has already been uploaded.
+   *
+   * \param index the index of the frame.
+   *
+   * \return `success` if the frame is uploaded; `failure` otherwise.
+   */
+  auto prepare(const usize index) -> result
+  {
+    if (index >= mUploaded.size()) {
+      return failure;
+    }
+
+    return mUploaded[index] || upload(index);
+  }
+
+  /// Uploads all frames that haven't been uploaded yet.
+  auto prepare_all() -> result
+  {
+    for (usize index = 0; index < mUploaded.size(); ++index) {
+      if (!prepare(index)) {
+        return failure;
+      }
+    }
+
+    return success;
+  }
+
+  /**
+   * Returns the region of a frame, uploading the frame first if necessary.
+   *
+   * \param index the index of the frame.
+   *
+   * \return the frame region; an empty sub-texture if the frame could not be uploaded.
+   */
+  [[nodiscard]] auto frame(const usize index) -> sub_texture
+  {
+    if (prepare(index)) {
+      return sub_texture {mTexture->get(), mRegions[index]};
+    }
+    else {
+      return sub_texture {};
+    }
+  }
+
+  /**
+   * Returns the index of the frame that is displayed at a point in time.
+   *
+   * \details This is constant time for typical animations, whose delays share a large common
+   * divisor, and logarithmic in the amount of frames otherwise.
+   *
+   * \param elapsed the time since playback started, in milliseconds.
+   * \param loop indicates whether playback wraps around after the last frame.
+   *
+   * \return the index of the frame.
+   */
+  [[nodiscard]] auto frame_at(const double elapsed, const bool loop = true) const noexcept
+      -> usize
+  {
+    if (!(elapsed > 0)) {
+      return 0;
+    }
+
+    const auto duration = static_cast<double>(mFrameEnds.back());
+    if (elapsed >= duration && !loop) {
+      return mFrameEnds.size() - 1;
+    }
+
+    const auto time =
+        static_cast<uint64>(elapsed) % static_cast<uint64>(mFrameEnds.back());
+
+    if (!mFrameTable.empty()) {
+      return mFrameTable[static_cast<usize>(time / mTableStep)];
+    }
+
+    const auto it = std::upper_bound(mFrameEnds.begin(), mFrameEnds.end(), time);
+    return static_cast<usize>(it - mFrameEnds.begin());
+  }
+
+  /// Returns the region of a frame in the texture, whether it has been uploaded or not.
+  [[nodiscard]] auto region(const usize index) const -> const irect&
+  {
+    return mRegions.at(index);
+  }
+
+  /// Returns the delay of a frame in milliseconds.
+  [[nodiscard]] auto delay(const usize index) const -> int
+  {
+    const auto end = mFrameEnds.at(index);
+    return (index == 0) ? end : end - mFrameEnds[index - 1];
+  }
+
+  /// Returns the total duration of the animation in milliseconds.
+  [[nodiscard]] auto duration() const noexcept -> int { return mFrameEnds.back(); }
+
+  [[nodiscard]] auto is_uploaded(const usize index) const -> bool
+  {
+    return mUploaded.at(index);
+  }
+
+  /// Returns the amount of frames that have been uploaded.
+  [[nodiscard]] auto uploaded_count() const noexcept -> usize { return mUploadedCount; }
+
+  [[nodiscard]] auto frame_count() const noexcept -> usize { return mRegions.size(); }
+
+  [[nodiscard]] auto frame_size() const noexcept -> iarea { return mFrameSize; }
+
+  [[nodiscard]] auto padding() const noexcept -> int { return mPadding; }
+
+  [[nodiscard]] auto get_texture() const noexcept -> const texture& { return *mTexture; }
+
+ private:
+  /// Frame tables larger than this fall back to a binary search over the frame end times.
+  inline constexpr static usize max_table_size = 4'096;
+
+  iarea mFrameSize;
+  int mPadding {};
+  maybe<texture> mTexture;
+  maybe<animation> mSource;  ///< Released once all frames have been uploaded.
+  std::vector<irect> mRegions;
+  std::vector<int> mFrameEnds;  ///< The end time of each frame, in milliseconds.
+  std::vector<uint16> mFrameTable;  ///< The frame at each multiple of the table step.
+  uint64 mTableStep {1};
+  std::vector<bool> mUploaded;
+  usize mUploadedCount {};
+  pixel_buffer mStaging;
+
+  /// Returns the amount of columns and rows of the frame grid.
+  [[nodiscard]] static auto grid_size(const usize count, const iarea& cell, const iarea& max)
+      -> iarea
+  {
+    const auto maxColumns = max.width / cell.width;
+    const auto maxRows = max.height / cell.height;
+    const auto frames = static_cast<int>(count);
+
+    // Prefer a square texture, but use wider rows if it would be too tall
+    auto columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(frames))));
+    columns = detail::min(columns, maxColumns);
+
+    if (columns > 0 && (frames + columns - 1) / columns > maxRows) {
+      columns = maxColumns;
+    }
+
+    if (columns < 1 || (frames + columns - 1) / columns > maxRows) {
+      throw exception {"Animation is too large for a single texture!"};
+    }
+
+    return {columns, (frames + columns - 1) / columns};
+  }
+
+  void make_frame_table()
+  {
+    int step = 0;
+    int start = 0;
+    for (const auto end : mFrameEnds) {
+      step = std::gcd(step, end - start);
+      start = end;
+    }
+
+    const auto size = static_cast<usize>(mFrameEnds.back() / step);
+    if (size > max_table_size || mFrameEnds.size() > 0xFFFF) {
+      return;
+    }
+
+    mTableStep = static_cast<uint64>(step);
+    mFrameTable.reserve(size);
+
+    uint16 frame = 0;
+    for (usize slot = 0; slot < size; ++slot) {
+      while (static_cast<int>(slot) * step >= mFrameEnds[frame]) {
+        ++frame;
+      }
+
+      mFrameTable.push_back(frame);
+    }
+  }
+
+  auto upload(const usize index) -> result
+  {
+    auto source = mSource->at(index);
+
+    const iarea cell {mFrameSize.width + 2 * mPadding, mFrameSize.height + 2 * mPadding};
+    mStaging.resize(cell, pixel_format::argb8888);
+
+    // The padding is cleared along with the frame, since new textures are uninitialized
+    auto* pixels = static_cast<uint8*>(mStaging.data());
+    std::memset(pixels, 0, static_cast<usize>(mStaging.pitch()) * static_cast<usize>(cell.height));
+
+    const iarea size {detail::min(source.width(), mFrameSize.width),
+                      detail::min(source.height(), mFrameSize.height)};
+
+    if (!source.lock()) {
+      return failure;
+    }
+
+    const auto converted = convert_pixels(size,
+                                          source.format_info().format(),
+                                          source.pixel_data(),
+                                          source.pitch(),
+                                          pixel_format::argb8888,
+                                          pixels + mPadding * mStaging.pitch() + mPadding * 4,
+                                          mStaging.pitch());
+    source.unlock();
+
+    const auto& region = mRegions[index];
+    const irect area {region.x() - mPadding, region.y() - mPadding, cell.width, cell.height};
+
+    if (!converted || !mTexture->update(area, pixels, mStaging.pitch())) {
+      return failure;
+    }
+
+    mUploaded[index] = true;
+    if (++mUploadedCount == mUploaded.size()) {
+      mSource.reset();
+    }
+
+    return success;
+  }
+};
+
+/// The playback state of an animated sprite, which is small enough to store per instance.
+struct animation_state final {
+  double start {};   ///< The player time when playback started, in milliseconds.
+  float speed {1};   ///< The playback speed, where 1 follows the frame delays.
+  bool loop {true};  ///< Indicates whether playback wraps around after the last frame.
+};
+
+/**
+ * Plays any amount of instances of an animation atlas from a single clock.
+ *
+ * \details Instances don't need to be updated individually, since their frames are derived
+ * from the shared clock and their start times when they are rendered. Instances that should
+ * be out of sync can be started with an earlier start time.
+ *
+ * \see animation_atlas
+ * \see animation_state
+ */
+class animation_player final {
+ public:
+  explicit animation_player(animation_atlas& atlas) noexcept : mAtlas {&atlas} {}
+
+  /// Advances the shared clock.
+  void update(const seconds<double> delta) noexcept { mTime += delta.count() * 1'000.0; }
+
+  /**
+   * Starts playback of an instance at the current time.
+   *
+   * \param speed the playback speed, where 1 follows the frame delays.
+   * \param loop indicates whether playback wraps around after the last frame.
+   *
+   * \return the playback state of the instance.
+   */
+  [[nodiscard]] auto play(const float speed = 1, const bool loop = true) const noexcept
+      -> animation_state
+  {
+    return {mTime, speed, loop};
+  }
+
+  /// Returns the index of the current frame of an instance.
+  [[nodiscard]] auto frame_index(const animation_state& state) const noexcept -> usize
+  {
+    return mAtlas->frame_at(elapsed(state), state.loop);
+  }
+
+  /// Returns the current frame of an instance, uploading it first if necessary.
+  [[nodiscard]] auto frame(const animation_state& state) -> sub_texture
+  {
+    return mAtlas->frame(frame_index(state));
+  }
+
+  /// Indicates whether a non-looping instance has reached the end of its last frame.
+  [[nodiscard]] auto finished(const animation_state& state) const noexcept -> bool
+  {
+    return !state.loop && elapsed(state) >= static_cast<double>(mAtlas->duration());
+  }
+
+  /// Renders the current frame of an instance.
+  template <typename T>
+  auto render(basic_renderer<T>& renderer, const animation_state& state, const frect& dst)
+      -> result
+  {
+    const auto sprite = frame(state);
+    return sprite && sprite.render(renderer, dst);
+  }
+
+  /// Returns the time that an instance has been playing, scaled by its speed, in milliseconds.
+  [[nodiscard]] auto elapsed(const animation_state& state) const noexcept -> double
+  {
+    return (mTime - state.start) * static_cast<double>(state.speed);
+  }
+
+  /// Returns the time of the shared clock, in milliseconds.
+  [[nodiscard]] auto time() const noexcept -> double { return mTime; }
+
+  [[nodiscard]] auto atlas() const noexcept -> animation_atlas& { return *mAtlas; }
+
+ private:
+  animation_atlas* mAtlas {};
+  double mTime {};
+};
+
+#endif  // SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_IMAGE
+#endif  // CENTURION_VIDEO_ANIMATION_ATLAS_HPP_
@@ -0,0 +1,909 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_COLOR_OPS_HPP_
+#define CENTURION_VIDEO_COLOR_OPS_HPP_
+
+#include <algorithm>    // fill
+#include <array>        // array
+#include <cmath>        // pow, ceil, abs
+#include <ostream>      // ostream
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../detail/stdlib.hpp"
+#include "color.hpp"
+#include "pixel_kernels.hpp"
+
+namespace cen {
+
+/**
+ * Represents the color spaces that colors can be blended in.
+ *
+ * \see blend_colors()
+ * \see fill_gradient()
+ */
+enum class blend_space {
+  srgb,   ///< Blend the encoded components directly, which is what blend() does.
+  linear  ///< Blend in linear light, which avoids dark transitions between saturated colors.
+};
+
+[[nodiscard]] constexpr auto to_string(const blend_space space) -> std::string_view
+{
+  switch (space) {
+    case blend_space::srgb:
+      return "srgb";
+
+    case blend_space::linear:
+      return "linear";
+
+    default:
+      throw exception {"Did not recognize blend space!"};
+  }
+}
+
+inline auto operator<<(std::ostream& stream, const blend_space space) -> std::ostream&
+{
+  return stream << to_string(space);
+}
+
+/// An HSV-encoded color, using the same ranges as `color::from_hsv()`.
+struct hsv_color final {
+  float hue {};         ///< The hue, in the range [0, 360].
+  float saturation {};  ///< The saturation, in the range [0, 100].
+  float value {};       ///< The value, in the range [0, 100].
+};
+
+/// An HSL-encoded color, using the same ranges as `color::from_hsl()`.
+struct hsl_color final {
+  float hue {};         ///< The hue, in the range [0, 360].
+  float saturation {};  ///< The saturation, in the range [0, 100].
+  float lightness {};   ///< The lightness, in the range [0, 100].
+};
+
+/// A color at a specific position along a gradient.
+struct gradient_stop final {
+  float position {};  ///< The position of the stop, in the range [0, 1].
+  color value;        ///< The color at the stop.
+};
+
+namespace detail {
+
+static_assert(sizeof(color) == 4, "Colors are processed as arrays of RGBA bytes");
+
+[[nodiscard]] inline auto color_bytes(color* colors) noexcept -> uint8*
+{
+  return reinterpret_cast<uint8*>(colors);
+}
+
+[[nodiscard]] inline auto color_bytes(const color* colors) noexcept -> const uint8*
+{
+  return reinterpret_cast<const uint8*>(colors);
+}
+
+/// Rounds a non-negative component value, truncation is used since it vectorizes well.
+[[nodiscard]] constexpr auto round_component(const float value) noexcept -> uint8
+{
+  return static_cast<uint8>(value + 0.5f);
+}
+
+/// Clamps a value without the assertions of clamp(), which is used with constant bounds.
+[[nodiscard]] constexpr auto clamp_range(const float value,
+                                         const float low,
+                                         const float high) noexcept -> float
+{
+  return detail::min(detail::max(value, low), high);
+}
+
+/**
+ * Converts a blend bias to a weight in the range [0, 256].
+ *
+ * \details The weight is clamped as an integer, since conditionally selected floating-point
+ * values prevent GCC from vectorizing the calling loops.
+ */
+[[nodiscard]] constexpr auto blend_weight(const float bias) noexcept -> uint32
+{
+  const auto weight = static_cast<int32>(bias * 256.0f + 0.5f);
+  return static_cast<uint32>(weight < 0 ? 0 : (weight > 256 ? 256 : weight));
+}
+
+/// Blends two 8-bit values, the result is exact for the weights 0 and 256.
+[[nodiscard]] constexpr auto blend_fixed(const uint32 a, const uint32 b, const uint32 weight)
+    -> uint32
+{
+  return (a * (256u - weight) + b * weight + 128u) >> 8u;
+}
+
+inline constexpr int linear_bits = 12;
+inline constexpr int linear_max = (1 << linear_bits) - 1;
+
+/// Lookup tables between 8-bit sRGB components and 12-bit linear intensities.
+struct srgb_tables final {
+  std::array<uint16, 256> decode {};
+  std::array<uint8, linear_max + 1> encode {};
+};
+
+[[nodiscard]] inline auto make_srgb_tables() -> srgb_tables
+{
+  srgb_tables tables;
+
+  for (int i = 0; i < 256; ++i) {
+    const auto encoded = static_cast<double>(i) / 255.0;
+    const auto linear = (encoded <= 0.04045) ? encoded / 12.92
+                                             : std::pow((encoded + 0.055) / 1.055, 2.4);
+    tables.decode[static_cast<usize>(i)] =
+        static_cast<uint16>(linear * static_cast<double>(linear_max) + 0.5);
+  }
+
+  for (int i = 0; i <= linear_max; ++i) {
+    const auto linear = static_cast<double>(i) / static_cast<double>(linear_max);
+    const auto encoded = (linear <= 0.0031308)
+                             ? linear * 12.92
+                             : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+    tables.encode[static_cast<usize>(i)] = static_cast<uint8>(encoded * 255.0 + 0.5);
+  }
+
+  return tables;
+}
+
+/// Returns the shared sRGB tables, which are created on first use.
+[[nodiscard]] inline auto get_srgb_tables() -> const srgb_tables&
+{
+  static const auto tables = make_srgb_tables();
+  return tables;
+}
+
+/*
+ * The conversions below use the branchless "hue triangle" formulation, where the normalized
+ * RGB components of a fully saturated hue in the range [0, 6] are given by
+ * clamp(|h - 3| - 1), clamp(2 - |h - 2|) and clamp(2 - |h - 4|). The scalar and SSE2 kernels
+ * perform the same operations in the same order, so they produce identical results.
+ */
+
+[[nodiscard]] inline auto hue_components(const float hue) noexcept -> std::array<float, 3>
+{
+  return {clamp_range(std::abs(hue - 3.0f) - 1.0f, 0.0f, 1.0f),
+          clamp_range(2.0f - std::abs(hue - 2.0f), 0.0f, 1.0f),
+          clamp_range(2.0f - std::abs(hue - 4.0f), 0.0f, 1.0f)};
+}
+
+/// Computes the hue of an RGB color in the range [0, 360), given its max and min difference.
+[[nodiscard]] inline auto hue_of(const float red,
+                                 const float green,
+                                 const float blue,
+                                 const float high,
+                                 const float delta) noexcept -> float
+{
+  const auto scale = 60.0f / ((delta > 0.0f) ? delta : 1.0f);
+
+  const auto redHue = (green - blue) * scale;
+  const auto greenHue = (blue - red) * scale + 120.0f;
+  const auto blueHue = (red - green) * scale + 240.0f;
+
+  const auto hue = (high == red) ? redHue : (high == green) ? greenHue : blueHue;
+  return hue + ((hue < 0.0f) ? 360.0f : 0.0f);
+}
+
+inline void hsv_to_rgb_scalar(const hsv_color* hsv, uint8* out, const usize count) noexcept
+{
+  for (usize i = 0; i < count; ++i, out += 4) {
+    const auto hue = clamp_range(hsv[i].hue, 0.0f, 360.0f) / 60.0f;
+    const auto saturation = clamp_range(hsv[i].saturation, 0.0f, 100.0f) / 100.0f;
+    const auto value = clamp_range(hsv[i].value, 0.0f, 100.0f) * (255.0f / 100.0f);
+
+    const auto components = hue_components(hue);
+    for (usize c = 0; c < 3; ++c) {
+      out[c] = round_component(value - value * saturation * (1.0f - components[c]));
+    }
+
+    out[3] = 0xFF;
+  }
+}
+
+inline void hsl_to_rgb_scalar(const hsl_color* hsl, uint8* out, const usize count) noexcept
+{
+  for (usize i = 0; i < count; ++i, out += 4) {
+    const auto hue = clamp_range(hsl[i].hue, 0.0f, 360.0f) / 60.0f;
+    const auto saturation = clamp_range(hsl[i].saturation, 0.0f, 100.0f) / 100.0f;
+    const auto lightness = clamp_range(hsl[i].lightness, 0.0f, 100.0f) / 100.0f;
+
+    const auto chroma = (1.0f - std::abs(2.0f * lightness - 1.0f)) * saturation;
+
+    const auto components = hue_components(hue);
+    for (usize c = 0; c < 3; ++c) {
+      out[c] = round_component((lightness + chroma * (components[c] - 0.5f)) * 255.0f);
+    }
+
+    out[3] = 0xFF;
+  }
+}
+
+inline void rgb_to_hsv_scalar(const uint8* in, hsv_color* hsv, const usize count) noexcept
+{
+  for (usize i = 0; i < count; ++i, in += 4) {
+    const auto red = static_cast<float>(in[0]);
+    const auto green = static_cast<float>(in[1]);
+    const auto blue = static_cast<float>(in[2]);
+
+    const auto high = detail::max(red, detail::max(green, blue));
+    const auto low = detail::min(red, detail::min(green, blue));
+    const auto delta = high - low;
+
+    hsv[i].hue = hue_of(red, green, blue, high, delta);
+    hsv[i].saturation = delta * 100.0f / ((high > 0.0f) ? high : 1.0f);
+    hsv[i].value = high * (100.0f / 255.0f);
+  }
+}
+
+inline void rgb_to_hsl_scalar(const uint8* in, hsl_color* hsl, const usize count) noexcept
+{
+  for (usize i = 0; i < count; ++i, in += 4) {
+    const auto red = static_cast<float>(in[0]);
+    const auto green = static_cast<float>(in[1]);
+    const auto blue = static_cast<float>(in[2]);
+
+    const auto high = detail::max(red, detail::max(green, blue));
+    const auto low = detail::min(red, detail::min(green, blue));
+    const auto delta = high - low;
+
+    // The range is only zero for black and white, which have no chroma
+    const auto sum = high + low;
+    const auto range = 255.0f - detail::max(sum - 255.0f, 255.0f - sum);
+
+    hsl[i].hue = hue_of(red, green, blue, high, delta);
+    hsl[i].saturation = delta * 100.0f / ((range > 0.0f) ? range : 1.0f);
+    hsl[i].lightness = sum * (50.0f / 255.0f);
+  }
+}
+
+#if CENTURION_HAS_SSE2_KERNELS
+
+[[nodiscard]] inline auto clamp_sse2(const __m128 value, const float low, const float high)
+    noexcept -> __m128
+{
+  return _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(low)), _mm_set1_ps(high));
+}
+
+[[nodiscard]] inline auto abs_sse2(const __m128 value) noexcept -> __m128
+{
+  return _mm_andnot_ps(_mm_set1_ps(-0.0f), value);
+}
+
+[[nodiscard]] inline auto select_sse2(const __m128 mask, const __m128 a, const __m128 b) noexcept
+    -> __m128
+{
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline void hue_components_sse2(const __m128 hue, __m128 (&components)[3]) noexcept
+{
+  const auto two = _mm_set1_ps(2.0f);
+  components[0] = clamp_sse2(_mm_sub_ps(abs_sse2(_mm_sub_ps(hue, _mm_set1_ps(3.0f))),
+                                        _mm_set1_ps(1.0f)),
+                             0.0f,
+                             1.0f);
+  components[1] = clamp_sse2(_mm_sub_ps(two, abs_sse2(_mm_sub_ps(hue, two))), 0.0f, 1.0f);
+  components[2] =
+      clamp_sse2(_mm_sub_ps(two, abs_sse2(_mm_sub_ps(hue, _mm_set1_ps(4.0f)))), 0.0f, 1.0f);
+}
+
+/// Rounds and packs the components of four colors, and stores them as opaque RGBA colors.
+inline void store_rgb_sse2(uint8* out, const __m128 (&components)[3]) noexcept
+{
+  const auto half = _mm_set1_ps(0.5f);
+  const auto red = _mm_cvttps_epi32(_mm_add_ps(components[0], half));
+  const auto green = _mm_cvttps_epi32(_mm_add_ps(components[1], half));
+  const auto blue = _mm_cvttps_epi32(_mm_add_ps(components[2], half));
+
+  auto rgba = _mm_or_si128(red, _mm_slli_epi32(green, 8));
+  rgba = _mm_or_si128(rgba, _mm_slli_epi32(blue, 16));
+  rgba = _mm_or_si128(rgba, _mm_set1_epi32(static_cast<int>(0xFF000000u)));
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), rgba);
+}
+
+/// Loads the RGB components of four colors as floats.
+inline void load_rgb_sse2(const uint8* in, __m128 (&components)[3]) noexcept
+{
+  const auto rgba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+  const auto mask = _mm_set1_epi32(0xFF);
+
+  components[0] = _mm_cvtepi32_ps(_mm_and_si128(rgba, mask));
+  components[1] = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(rgba, 8), mask));
+  components[2] = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(rgba, 16), mask));
+}
+
+[[nodiscard]] inline auto hue_of_sse2(const __m128 (&rgb)[3],
+                                      const __m128 high,
+                                      const __m128 delta) noexcept -> __m128
+{
+  const auto zero = _mm_setzero_ps();
+  const auto divisor = select_sse2(_mm_cmpgt_ps(delta, zero), delta, _mm_set1_ps(1.0f));
+  const auto scale = _mm_div_ps(_mm_set1_ps(60.0f), divisor);
+
+  const auto redHue = _mm_mul_ps(_mm_sub_ps(rgb[1], rgb[2]), scale);
+  const auto greenHue =
+      _mm_add_ps(_mm_mul_ps(_mm_sub_ps(rgb[2], rgb[0]), scale), _mm_set1_ps(120.0f));
+  const auto blueHue =
+      _mm_add_ps(_mm_mul_ps(_mm_sub_ps(rgb[0], rgb[1]), scale), _mm_set1_ps(240.0f));
+
+  const auto hue = select_sse2(_mm_cmpeq_ps(high, rgb[0]),
+                               redHue,
+                               select_sse2(_mm_cmpeq_ps(high, rgb[1]), greenHue, blueHue));
+
+  return _mm_add_ps(hue, _mm_and_ps(_mm_cmplt_ps(hue, zero), _mm_set1_ps(360.0f)));
+}
+
+[[nodiscard]] inline auto hsv_to_rgb_sse2(const hsv_color* hsv,
+                                          uint8* out,
+                                          const usize count) noexcept -> usize
+{
+  const auto one = _mm_set1_ps(1.0f);
+
+  usize i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const auto* in = hsv + i;
+
+    auto hue = _mm_setr_ps(in[0].hue, in[1].hue, in[2].hue, in[3].hue);
+    auto saturation =
+        _mm_setr_ps(in[0].saturation, in[1].saturation, in[2].saturation, in[3].saturation);
+    auto value = _mm_setr_ps(in[0].value, in[1].value, in[2].value, in[3].value);
+
+    hue = _mm_div_ps(clamp_sse2(hue, 0.0f, 360.0f), _mm_set1_ps(60.0f));
+    saturation = _mm_div_ps(clamp_sse2(saturation, 0.0f, 100.0f), _mm_set1_ps(100.0f));
+    value = _mm_mul_ps(clamp_sse2(value, 0.0f, 100.0f), _mm_set1_ps(255.0f / 100.0f));
+
+    __m128 components[3];
+    hue_components_sse2(hue, components);
+
+    const auto chroma = _mm_mul_ps(value, saturation);
+    for (auto& component : components) {
+      component = _mm_sub_ps(value, _mm_mul_ps(chroma, _mm_sub_ps(one, component)));
+    }
+
+    store_rgb_sse2(out + 4 * i, components);
+  }
+
+  return i;
+}
+
+[[nodiscard]] inline auto hsl_to_rgb_sse2(const hsl_color* hsl,
+                                          uint8* out,
+                                          const usize count) noexcept -> usize
+{
+  const auto one = _mm_set1_ps(1.0f);
+  const auto half = _mm_set1_ps(0.5f);
+  const auto scale = _mm_set1_ps(255.0f);
+
+  usize i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const auto* in = hsl + i;
+
+    auto hue = _mm_setr_ps(in[0].hue, in[1].hue, in[2].hue, in[3].hue);
+    auto saturation =
+        _mm_setr_ps(in[0].saturation, in[1].saturation, in[2].saturation, in[3].saturation);
+    auto lightness =
+        _mm_setr_ps(in[0].lightness, in[1].lightness, in[2].lightness, in[3].lightness);
+
+    hue = _mm_div_ps(clamp_sse2(hue, 0.0f, 360.0f), _mm_set1_ps(60.0f));
+    saturation = _mm_div_ps(clamp_sse2(saturation, 0.0f, 100.0f), _mm_set1_ps(100.0f));
+    lightness = _mm_div_ps(clamp_sse2(lightness, 0.0f, 100.0f), _mm_set1_ps(100.0f));
+
+    const auto doubled = _mm_sub_ps(_mm_add_ps(lightness, lightness), one);
+    const auto chroma = _mm_mul_ps(_mm_sub_ps(one, abs_sse2(doubled)), saturation);
+
+    __m128 components[3];
+    hue_components_sse2(hue, components);
+
+    for (auto& component : components) {
+      const auto offset = _mm_mul_ps(chroma, _mm_sub_ps(component, half));
+      component = _mm_mul_ps(_mm_add_ps(lightness, offset), scale);
+    }
+
+    store_rgb_sse2(out + 4 * i, components);
+  }
+
+  return i;
+}
+
+[[nodiscard]] inline auto rgb_to_hsv_sse2(const uint8* in,
+                                          hsv_color* hsv,
+                                          const usize count) noexcept -> usize
+{
+  const auto zero = _mm_setzero_ps();
+  const auto one = _mm_set1_ps(1.0f);
+
+  usize i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 rgb[3];
+    load_rgb_sse2(in + 4 * i, rgb);
+
+    const auto high = _mm_max_ps(rgb[0], _mm_max_ps(rgb[1], rgb[2]));
+    const auto low = _mm_min_ps(rgb[0], _mm_min_ps(rgb[1], rgb[2]));
+    const auto delta = _mm_sub_ps(high, low);
+
+    alignas(16) float hue[4];
+    alignas(16) float saturation[4];
+    alignas(16) float value[4];
+
+    _mm_store_ps(hue, hue_of_sse2(rgb, high, delta));
+    _mm_store_ps(saturation,
+                 _mm_div_ps(_mm_mul_ps(delta, _mm_set1_ps(100.0f)),
+                            select_sse2(_mm_cmpgt_ps(high, zero), high, one)));
+    _mm_store_ps(value, _mm_mul_ps(high, _mm_set1_ps(100.0f / 255.0f)));
+
+    for (usize k = 0; k < 4; ++k) {
+      hsv[i + k] = {hue[k], saturation[k], value[k]};
+    }
+  }
+
+  return i;
+}
+
+[[nodiscard]] inline auto rgb_to_hsl_sse2(const uint8* in,
+                                          hsl_color* hsl,
+                                          const usize count) noexcept -> usize
+{
+  const auto zero = _mm_setzero_ps();
+  const auto one = _mm_set1_ps(1.0f);
+  const auto full = _mm_set1_ps(255.0f);
+
+  usize i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 rgb[3];
+    load_rgb_sse2(in + 4 * i, rgb);
+
+    const auto high = _mm_max_ps(rgb[0], _mm_max_ps(rgb[1], rgb[2]));
+    const auto low = _mm_min_ps(rgb[0], _mm_min_ps(rgb[1], rgb[2]));
+    const auto delta = _mm_sub_ps(high, low);
+
+    const auto sum = _mm_add_ps(high, low);
+    const auto range =
+        _mm_sub_ps(full, _mm_max_ps(_mm_sub_ps(sum, full), _mm_sub_ps(full, sum)));
+
+    alignas(16) float hue[4];
+    alignas(16) float saturation[4];
+    alignas(16) float lightness[4];
+
+    _mm_store_ps(hue, hue_of_sse2(rgb, high, delta));
+    _mm_store_ps(saturation,
+                 _mm_div_ps(_mm_mul_ps(delta, _mm_set1_ps(100.0f)),
+                            select_sse2(_mm_cmpgt_ps(range, zero), range, one)));
+    _mm_store_ps(lightness, _mm_mul_ps(sum, _mm_set1_ps(50.0f / 255.0f)));
+
+    for (usize k = 0; k < 4; ++k) {
+      hsl[i + k] = {hue[k], saturation[k], lightness[k]};
+    }
+  }
+
+  return i;
+}
+
+#endif  // CENTURION_HAS_SSE2_KERNELS
+
+/// Indicates whether the SSE2 color kernels should be used, which also covers AVX2.
+[[nodiscard]] inline auto use_sse2_color_kernels() noexcept -> bool
+{
+#if CENTURION_HAS_SSE2_KERNELS
+  return current_simd_level() != simd_level::scalar;
+#else
+  return false;
+#endif  // CENTURION_HAS_SSE2_KERNELS
+}
+
+/**
+ * Fills colors with a linear blend, where the bias of the color at index `i` is
+ * `start + i * step`, clamped to [0, 1].
+ */
+inline void fill_blend(color* colors,
+                       const usize count,
+                       const color& from,
+                       const color& to,
+                       const float start,
+                       const float step,
+                       const blend_space space) noexcept
+{
+  auto* out = color_bytes(colors);
+
+  const uint32 a[4] {from.red(), from.green(), from.blue(), from.alpha()};
+  const uint32 b[4] {to.red(), to.green(), to.blue(), to.alpha()};
+
+  // A signed index is used since unsigned 64-bit integers can't be converted in vector lanes
+  const auto n = static_cast<int32>(count);
+
+  if (space == blend_space::srgb) {
+    for (int32 i = 0; i < n; ++i, out += 4) {
+      const auto weight = blend_weight(start + static_cast<float>(i) * step);
+      for (usize c = 0; c < 4; ++c) {
+        out[c] = static_cast<uint8>(blend_fixed(a[c], b[c], weight));
+      }
+    }
+  }
+  else {
+    const auto& tables = get_srgb_tables();
+
+    uint32 la[3];
+    uint32 lb[3];
+    for (usize c = 0; c < 3; ++c) {
+      la[c] = tables.decode[a[c]];
+      lb[c] = tables.decode[b[c]];
+    }
+
+    for (int32 i = 0; i < n; ++i, out += 4) {
+      const auto weight = blend_weight(start + static_cast<float>(i) * step);
+      for (usize c = 0; c < 3; ++c) {
+        out[c] = tables.encode[blend_fixed(la[c], lb[c], weight)];
+      }
+      out[3] = static_cast<uint8>(blend_fixed(a[3], b[3], weight));
+    }
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Converts HSV-encoded colors to opaque RGBA colors.
+ *
+ * \details This produces the same results as `color::from_hsv()`, within rounding, using
+ * SSE2 when available.
+ *
+ * \param hsv the colors that will be converted.
+ * \param colors the output colors, must be able to hold `count` colors.
+ * \param count the amount of colors to convert.
+ */
+inline void hsv_to_rgb(const hsv_color* hsv, color* colors, const usize count) noexcept
+{
+  auto* out = detail::color_bytes(colors);
+  usize done = 0;
+
+#if CENTURION_HAS_SSE2_KERNELS
+  if (detail::use_sse2_color_kernels()) {
+    done = detail::hsv_to_rgb_sse2(hsv, out, count);
+  }
+#endif  // CENTURION_HAS_SSE2_KERNELS
+
+  detail::hsv_to_rgb_scalar(hsv + done, out + 4 * done, count - done);
+}
+
+/**
+ * Converts HSL-encoded colors to opaque RGBA colors.
+ *
+ * \details This produces the same results as `color::from_hsl()`, within rounding, using
+ * SSE2 when available. Unlike `color::from_hsl()`, a hue of 360 is treated as 0.
+ *
+ * \param hsl the colors that will be converted.
+ * \param colors the output colors, must be able to hold `count` colors.
+ * \param count the amount of colors to convert.
+ */
+inline void hsl_to_rgb(const hsl_color* hsl, color* colors, const usize count) noexcept
+{
+  auto* out = detail::color_bytes(colors);
+  usize done = 0;
+
+#if CENTURION_HAS_SSE2_KERNELS
+  if (detail::use_sse2_color_kernels()) {
+    done = detail::hsl_to_rgb_sse2(hsl, out, count);
+  }
+#endif  // CENTURION_HAS_SSE2_KERNELS
+
+  detail::hsl_to_rgb_scalar(hsl + done, out + 4 * done, count - done);
+}
+
+/**
+ * Converts RGB colors to HSV-encoded colors, the alpha components are ignored.
+ *
+ * \param colors the colors that will be converted.
+ * \param hsv the output colors, must be able to hold `count` colors.
+ * \param count the amount of colors to convert.
+ */
+inline void rgb_to_hsv(const color* colors, hsv_color* hsv, const usize count) noexcept
+{
+  const auto* in = detail::color_bytes(colors);
+  usize done = 0;
+
+#if CENTURION_HAS_SSE2_KERNELS
+  if (detail::use_sse2_color_kernels()) {
+    done = detail::rgb_to_hsv_sse2(in, hsv, count);
+  }
+#endif  // CENTURION_HAS_SSE2_KERNELS
+
+  detail::rgb_to_hsv_scalar(in + 4 * done, hsv + done, count - done);
+}
+
+/**
+ * Converts RGB colors to HSL-encoded colors, the alpha components are ignored.
+ *
+ * \param colors the colors that will be converted.
+ * \param hsl the output colors, must be able to hold `count` colors.
+ * \param count the amount of colors to convert.
+ */
+inline void rgb_to_hsl(const color* colors, hsl_color* hsl, const usize count) noexcept
+{
+  const auto* in = detail::color_bytes(colors);
+  usize done = 0;
+
+#if CENTURION_HAS_SSE2_KERNELS
+  if (detail::use_sse2_color_kernels()) {
+    done = detail::rgb_to_hsl_sse2(in, hsl, count);
+  }
+#endif  // CENTURION_HAS_SSE2_KERNELS
+
+  detail::rgb_to_hsl_scalar(in + 4 * done, hsl + done, count - done);
+}
+
+/**
+ * Linearly interpolates between two arrays of colors.
+ *
+ * \details This is the batch version of `blend()`, using the same floating-point
+ * interpolation. See `blend_colors()` for a faster fixed-point alternative.
+ *
+ * \param a the first colors.
+ * \param b the second colors.
+ * \param colors the output colors, may alias either of the inputs.
+ * \param count the amount of colors in each array.
+ * \param bias the bias that determines how the colors are blended, in the range [0, 1].
+ */
+inline void lerp_colors(const color* a,
+                        const color* b,
+                        color* colors,
+                        const usize count,
+                        const float bias = 0.5f) noexcept
+{
+  const auto* first = detail::color_bytes(a);
+  const auto* second = detail::color_bytes(b);
+  auto* out = detail::color_bytes(colors);
+
+  const auto t = detail::clamp_range(bias, 0.0f, 1.0f);
+  const auto bytes = count * 4u;
+
+  for (usize i = 0; i < bytes; ++i) {
+    const auto x = static_cast<float>(first[i]);
+    const auto y = static_cast<float>(second[i]);
+    out[i] = detail::round_component(x + (y - x) * t);
+  }
+}
+
+/**
+ * Blends two arrays of colors using fixed-point arithmetic.
+ *
+ * \details The bias is quantized to 1/256 steps. When blending in linear space, the color
+ * components are converted with lookup tables, whereas alpha is always blended directly.
+ *
+ * \param a the first colors.
+ * \param b the second colors.
+ * \param colors the output colors, may alias either of the inputs.
+ * \param count the amount of colors in each array.
+ * \param bias the bias that determines how the colors are blended, in the range [0, 1].
+ * \param space the color space that the colors are blended in.
+ */
+inline void blend_colors(const color* a,
+                         const color* b,
+                         color* colors,
+                         const usize count,
+                         const float bias = 0.5f,
+                         const blend_space space = blend_space::srgb) noexcept
+{
+  const auto* first = detail::color_bytes(a);
+  const auto* second = detail::color_bytes(b);
+  auto* out = detail::color_bytes(colors);
+
+  const auto weight = detail::blend_weight(bias);
+
+  if (space == blend_space::srgb) {
+    const auto bytes = count * 4u;
+    for (usize i = 0; i < bytes; ++i) {
+      out[i] = static_cast<uint8>(detail::blend_fixed(first[i], second[i], weight));
+    }
+  }
+  else {
+    const auto& tables = detail::get_srgb_tables();
+
+    for (usize i = 0; i < count; ++i, first += 4, second += 4, out += 4) {
+      for (usize c = 0; c < 3; ++c) {
+        const auto linear = detail::blend_fixed(tables.decode[first[c]],
+                                                tables.decode[second[c]],
+                                                weight);
+        out[c] = tables.encode[linear];
+      }
+      out[3] = static_cast<uint8>(detail::blend_fixed(first[3], second[3], weight));
+    }
+  }
+}
+
+/**
+ * Fills an array of colors with a gradient between two colors.
+ *
+ * \details The first and last colors are exactly `from` and `to`, respectively.
+ *
+ * \param colors the output colors.
+ * \param count the amount of colors to fill.
+ * \param from the color at the start of the gradient.
+ * \param to the color at the end of the gradient.
+ * \param space the color space that the colors are blended in.
+ */
+inline void fill_gradient(color* colors,
+                          const usize count,
+                          const color& from,
+                          const color& to,
+                          const blend_space space = blend_space::srgb) noexcept
+{
+  if (count == 0) {
+    return;
+  }
+
+  const auto step = (count > 1) ? 1.0f / static_cast<float>(count - 1) : 0.0f;
+  detail::fill_blend(colors, count, from, to, 0.0f, step, space);
+
+  colors[count - 1] = (count > 1) ? to : from;
+}
+
+/**
+ * Fills an array of colors with a gradient defined by several color stops.
+ *
+ * \details Colors before the first stop and after the last stop use the color of that stop.
+ * Two stops at the same position create a hard edge.
+ *
+ * \pre The stops must be sorted by their positions.
+ *
+ * \param colors the output colors.
+ * \param count the amount of colors to fill.
+ * \param stops the color stops of the gradient.
+ * \param nStops the amount of color stops.
+ * \param space the color space that the colors are blended in.
+ *
+ * \return `success` if the gradient was created; `failure` if there are no stops or if the
+ * stops are not sorted.
+ */
+inline auto fill_gradient(color* colors,
+                          const usize count,
+                          const gradient_stop* stops,
+                          const usize nStops,
+                          const blend_space space = blend_space::srgb) noexcept -> result
+{
+  if (!stops || nStops == 0) {
+    return failure;
+  }
+
+  for (usize s = 1; s < nStops; ++s) {
+    if (stops[s].position < stops[s - 1].position) {
+      return failure;
+    }
+  }
+
+  if (count == 0) {
+    return success;
+  }
+
+  // A single color is treated as the start of the gradient
+  const auto last = static_cast<float>(detail::max(count - 1, usize {1}));
+
+  // Returns the index of the first color at or after a position along the gradient
+  const auto index_of = [&](const float position) noexcept -> usize {
+    const auto index = detail::clamp_range(position, 0.0f, 1.0f) * last;
+    return detail::min(static_cast<usize>(std::ceil(index)), count);
+  };
+
+  auto begin = index_of(stops[0].position);
+  std::fill(colors, colors + begin, stops[0].value);
+
+  for (usize s = 1; s < nStops; ++s) {
+    const auto& previous = stops[s - 1];
+    const auto& next = stops[s];
+
+    const auto end = (s + 1 == nStops) ? detail::min(index_of(next.position) + 1, count)
+                                       : index_of(next.position);
+    const auto span = next.position - previous.position;
+
+    if (end > begin && span > 0.0f) {
+      const auto step = 1.0f / (span * last);
+      const auto start = (static_cast<float>(begin) / last - previous.position) / span;
+      detail::fill_blend(colors + begin,
+                         end - begin,
+                         previous.value,
+                         next.value,
+                         start,
+                         step,
+                         space);
+    }
+
+    begin = detail::max(begin, end);
+  }
+
+  std::fill(colors + begin, colors + count, stops[nStops - 1].value);
+  return success;
+}
+
+/// Returns the RGBA versions of a container of HSV-encoded colors.
+template <typename Container>
+[[nodiscard]] auto hsv_to_rgb(const Container& hsv) -> std::vector<color>
+{
+  std::vector<color> colors(hsv.size());
+  hsv_to_rgb(hsv.data(), colors.data(), colors.size());
+  return colors;
+}
+
+/// Returns the RGBA versions of a container of HSL-encoded colors.
+template <typename Container>
+[[nodiscard]] auto hsl_to_rgb(const Container& hsl) -> std::vector<color>
+{
+  std::vector<color> colors(hsl.size());
+  hsl_to_rgb(hsl.data(), colors.data(), colors.size());
+  return colors;
+}
+
+/// Returns the HSV versions of a container of colors.
+template <typename Container>
+[[nodiscard]] auto rgb_to_hsv(const Container& colors) -> std::vector<hsv_color>
+{
+  std::vector<hsv_color> hsv(colors.size());
+  rgb_to_hsv(colors.data(), hsv.data(), hsv.size());
+  return hsv;
+}
+
+/// Returns the HSL versions of a container of colors.
+template <typename Container>
+[[nodiscard]] auto rgb_to_hsl(const Container& colors) -> std::vector<hsl_color>
+{
+  std::vector<hsl_color> hsl(colors.size());
+  rgb_to_hsl(colors.data(), hsl.data(), hsl.size());
+  return hsl;
+}
+
+/// Returns a gradient of the specified length between two colors.
+[[nodiscard]] inline auto make_gradient(const usize count,
+                                        const color& from,
+                                        const color& to,
+                                        const blend_space space = blend_space::srgb)
+    -> std::vector<color>
+{
+  std::vector<color> colors(count);
+  fill_gradient(colors.data(), count, from, to, space);
+  return colors;
+}
+
+/**
+ * Returns a gradient of the specified length, defined by a container of color stops.
+ *
+ * \return the gradient colors; an empty vector if the stops are invalid.
+ */
+template <typename Container>
+[[nodiscard]] auto make_gradient(const usize count,
+                                 const Container& stops,
+                                 const blend_space space = blend_space::srgb)
+    -> std::vector<color>
+{
+  std::vector<color> colors(count);
+  if (!fill_gradient(colors.data(), count, stops.data(), stops.size(), space)) {
+    colors.clear();
+  }
+
+  return colors;
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_COLOR_OPS_HPP_
@@ -0,0 +1,330 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef CENTURION_VIDEO_DAMAGE_TRACKER_HPP_
+#define CENTURION_VIDEO_DAMAGE_TRACKER_HPP_
+
+#include <SDL.h>
+
+#include <cassert>  // assert
+#include <cmath>    // floor, ceil
+#include <vector>   // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+
+namespace cen {
+
+/**
+ * Keeps track of the damaged areas of a window, to present only the parts that changed.
+ *
+ * This is intended to be used with software renderers, which render directly to the window
+ * surface. A frame is drawn as follows.
+ *
+ * 1. Areas that need to be redrawn are marked with `invalidate()`, e.g. a label that changed.
+ * 2. `begin_frame()` clips the renderer to the invalidated region and starts recording the
+ *    areas touched by draw calls.
+ * 3. The scene is drawn as usual, rendering outside of the clip region is cheap.
+ * 4. `end_frame()` updates only the damaged areas of the window surface, instead of calling
+ *    `basic_renderer::present()`.
+ *
+ * Damaged areas are merged when they overlap, and the closest areas are merged when there
+ * are more than the maximum amount of areas, to keep the amount of window updates bounded.
+ *
+ * \note Areas are expressed in window pixels, so draw calls are only recorded correctly if the
+ *       renderer does not use logical sizes, scaling or viewports.
+ *
+ * \see basic_renderer::set_damage_tracker
+ */
+class damage_tracker final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates a damage tracker, where the entire window is initially invalidated.
+   *
+   * \param bounds the size of the window surface.
+   * \param maxRects the maximum amount of separate damaged areas, must be greater than zero.
+   */
+  explicit damage_tracker(const iarea& bounds, const size_type maxRects = 16)
+      : mBounds {bounds}
+      , mMaxRects {maxRects}
+  {
+    assert(mMaxRects > 0);
+
+    mInvalid.reserve(mMaxRects + 1);
+    mDamage.reserve(mMaxRects + 1);
+
+    invalidate();
+  }
+
+  /// Changes the size of the window surface, which invalidates the entire window.
+  void set_bounds(const iarea& bounds) noexcept
+  {
+    mBounds = bounds;
+    mInvalid.clear();
+    invalidate();
+  }
+
+  /// Marks the entire window as in need of being redrawn.
+  void invalidate() noexcept { invalidate(irect {{0, 0}, mBounds}); }
+
+  /// Marks an area as in need of being redrawn in the next frame.
+  void invalidate(const irect& area) noexcept
+  {
+    merge_into(mInvalid, clamp(area, irect {{0, 0}, mBounds}));
+  }
+
+  /// Indicates whether there are invalidated areas that have not been redrawn.
+  [[nodiscard]] auto needs_redraw() const noexcept -> bool { return !mInvalid.empty(); }
+
+  /**
+   * Records an area that has been drawn to in the current frame.
+   *
+   * This is usually called by a renderer that the tracker is attached to. The area is clipped
+   * to the region of the current frame.
+   */
+  void add(const irect& area) noexcept
+  {
+    merge_into(mDamage, clamp(area, mClip));
+  }
+
+  /// Records an area that has been drawn to, expanded to whole pixels.
+  void add(const frect& area) noexcept
+  {
+    const auto x = static_cast<int>(std::floor(area.x()));
+    const auto y = static_cast<int>(std::floor(area.y()));
+    const auto maxX = static_cast<int>(std::ceil(area.max_x()));
+    const auto maxY = static_cast<int>(std::ceil(area.max_y()));
+    add(irect {x, y, maxX - x, maxY - y});
+  }
+
+  /**
+   * Starts recording a frame.
+   *
+   * The renderer is clipped to the union of the invalidated areas, or the entire window if
+   * nothing has been invalidated, and draw calls are recorded until `end_frame()` is called.
+   *
+   * \param renderer the software renderer of the window.
+   */
+  template <typename Renderer>
+  void begin_frame(Renderer& renderer) noexcept
+  {
+    assert(!mRecording);
+
+    mPreviousClip = renderer.clip();
+    mClip = {};
+
+    for (const auto& area : mInvalid) {
+      mClip = get_union(mClip, area);
+    }
+
+    if (mClip.has_area()) {
+      renderer.set_clip(mClip);
+    }
+    else {
+      mClip = irect {{0, 0}, mBounds};
+    }
+
+    mInvalid.clear();
+    mDamage.clear();
+
+    renderer.set_damage_tracker(this);
+    mRecording = true;
+  }
+
+  /**
+   * Finishes a frame by presenting the damaged areas of the window surface.
+   *
+   * This function should be called instead of `basic_renderer::present()`.
+   *
+   * \param renderer the renderer that was passed to `begin_frame()`.
+   * \param window the window that owns the renderer.
+   *
+   * \return `success` if the window surface was updated; `failure` otherwise.
+   */
+  template <typename Renderer, typename Window>
+  auto end_frame(Renderer& renderer, Window& window) noexcept -> result
+  {
+    assert(mRecording);
+
+    renderer.set_damage_tracker(nullptr);
+    mRecording = false;
+
+    /* Make sure that all queued draw calls have reached the window surface */
+    SDL_RenderFlush(renderer.get());
+
+    if (mPreviousClip) {
+      renderer.set_clip(*mPreviousClip);
+    }
+    else {
+      renderer.reset_clip();
+    }
+
+    mDamagedPixels = 0;
+    for (const auto& area : mDamage) {
+      mDamagedPixels += static_cast<uint64>(area.width()) * static_cast<uint64>(area.height());
+    }
+
+    const auto total = static_cast<uint64>(mBounds.width) * static_cast<uint64>(mBounds.height);
+    mRedrawFraction = (total != 0) ? static_cast<float>(static_cast<double>(mDamagedPixels) /
+                                                        static_cast<double>(total))
+                                   : 0.0f;
+
+    if (mDamage.empty()) {
+      return success;
+    }
+
+    return SDL_UpdateWindowSurfaceRects(window.get(),
+                                        mDamage.front().data(),
+                                        static_cast<int>(mDamage.size())) == 0;
+  }
+
+  /// Returns the damaged areas recorded in the current (or last) frame.
+  [[nodiscard]] auto rects() const noexcept -> const std::vector<irect>& { return mDamage; }
+
+  /// Returns the invalidated areas that will be redrawn in the next frame.
+  [[nodiscard]] auto invalid_rects() const noexcept -> const std::vector<irect>&
+  {
+    return mInvalid;
+  }
+
+  /// Returns the amount of pixels that were presented in the last frame.
+  [[nodiscard]] auto damaged_pixels() const noexcept -> uint64 { return mDamagedPixels; }
+
+  /// Returns the fraction of the window that was presented in the last frame, in [0, 1].
+  [[nodiscard]] auto redraw_fraction() const noexcept -> float { return mRedrawFraction; }
+
+  [[nodiscard]] auto bounds() const noexcept -> const iarea& { return mBounds; }
+
+  [[nodiscard]] auto max_rects() const noexcept -> size_type { return mMaxRects; }
+
+  /// Indicates whether a frame is currently being recorded.
+  [[nodiscard]] auto is_recording() const noexcept -> bool { return mRecording; }
+
+ private:
+  iarea mBounds;
+  size_type mMaxRects {};
+  std::vector<irect> mInvalid;
+  std::vector<irect> mDamage;
+  irect mClip;
+  maybe<irect> mPreviousClip;
+  uint64 mDamagedPixels {};
+  float mRedrawFraction {};
+  bool mRecording {};
+
+  [[nodiscard]] static auto clamp(const irect& area, const irect& region) noexcept -> irect
+  {
+    const auto x = detail::max(area.x(), region.x());
+    const auto y = detail::max(area.y(), region.y());
+    const auto maxX = detail::min(area.max_x(), region.max_x());
+    const auto maxY = detail::min(area.max_y(), region.max_y());
+
+    if (maxX <= x || maxY <= y) {
+      return {};
+    }
+
+    return irect {x, y, maxX - x, maxY - y};
+  }
+
+  [[nodiscard]] static auto area_of(const irect& rect) noexcept -> uint64
+  {
+    return static_cast<uint64>(rect.width()) * static_cast<uint64>(rect.height());
+  }
+
+  /// Adds an area to a set of disjoint areas, merging overlapping and adjacent areas.
+  void merge_into(std::vector<irect>& rects, irect area) noexcept
+  {
+    if (!area.has_area()) {
+      return;
+    }
+
+    for (usize index = 0; index < rects.size();) {
+      const auto& other = rects[index];
+
+      if (other.x() <= area.x() && other.y() <= area.y() && other.max_x() >= area.max_x() &&
+          other.max_y() >= area.max_y()) {
+        return; /* Already covered */
+      }
+
+      if (overlaps(area, other)) {
+        area = get_union(area, other);
+        rects[index] = rects.back();
+        rects.pop_back();
+        index = 0; /* The larger area might overlap areas that were already checked */
+      }
+      else {
+        ++index;
+      }
+    }
+
+    if (rects.size() < mMaxRects) {
+      rects.push_back(area);
+    }
+    else {
+      rects.push_back(area);
+
+      /* The merged area may overlap other areas, so it is added again */
+      merge_into(rects, take_closest(rects));
+    }
+  }
+
+  /// Removes the two areas whose union wastes the least amount of pixels, returns the union.
+  [[nodiscard]] static auto take_closest(std::vector<irect>& rects) noexcept -> irect
+  {
+    usize first = 0;
+    usize second = 1;
+    auto bestWaste = ~uint64 {0};
+
+    for (usize i = 0; i < rects.size(); ++i) {
+      for (usize j = i + 1; j < rects.size(); ++j) {
+        const auto merged = area_of(get_union(rects[i], rects[j]));
+        const auto waste = merged - detail::min(merged, area_of(rects[i]) + area_of(rects[j]));
+
+        if (waste < bestWaste) {
+          bestWaste = waste;
+          first = i;
+          second = j;
+        }
+      }
+    }
+
+    const auto merged = get_union(rects[first], rects[second]);
+
+    /* Remove the second area first, since it is the one with the larger index */
+    rects[second] = rects.back();
+    rects.pop_back();
+
+    rects[first] = rects.back();
+    rects.pop_back();
+
+    return merged;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_DAMAGE_TRACKER_HPP_
@@ -0,0 +1,369 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef CENTURION_VIDEO_FRAME_CAPTURE_HPP_
+#define CENTURION_VIDEO_FRAME_CAPTURE_HPP_
+
+#include <SDL.h>
+
+#include <cassert>      // assert
+#include <functional>   // function
+#include <ostream>      // ostream
+#include <string>       // string, to_string
+#include <string_view>  // string_view
+#include <utility>      // move
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/locks.hpp"
+#include "../concurrency/mutex.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../io/file.hpp"
+#include "pixels.hpp"
+#include "renderer.hpp"
+#include "surface.hpp"
+
+namespace cen {
+
+/// The file formats that captured frames can be saved as.
+enum class capture_format {
+  png,  ///< PNG images, requires SDL_image.
+  bmp,  ///< BMP images.
+  raw   ///< Tightly packed pixel data, without any header.
+};
+
+[[nodiscard]] constexpr auto to_string(const capture_format format) -> std::string_view
+{
+  switch (format) {
+    case capture_format::png:
+      return "png";
+
+    case capture_format::bmp:
+      return "bmp";
+
+    case capture_format::raw:
+      return "raw";
+
+    default:
+      throw exception {"Did not recognize capture format!"};
+  }
+}
+
+inline auto operator<<(std::ostream& stream, const capture_format format) -> std::ostream&
+{
+  return stream << to_string(format);
+}
+
+/// Configures a frame capture that saves frames to files.
+struct frame_capture_cfg final {
+  std::string prefix {"frame_"};                  ///< Prepended to the frame index.
+  capture_format format {capture_format::png};  ///< The format of the saved files.
+  usize buffers {3};                              ///< The amount of reused frame buffers.
+  pixel_format pixels {pixel_format::argb8888};  ///< The pixel format of captured frames.
+};
+
+/// Provides statistics about the frames handled by a frame capture.
+struct capture_stats final {
+  usize captured {};  ///< The amount of frames that were read from the renderer.
+  usize dropped {};   ///< The amount of frames that were skipped since no buffer was free.
+  usize encoded {};   ///< The amount of frames that were successfully handed to the sink.
+  usize failed {};    ///< The amount of frames that could not be read or encoded.
+};
+
+/**
+ * Captures rendered frames without blocking the render loop on encoding.
+ *
+ * Frames are read into a ring of surfaces that are allocated by the first captures and then
+ * reused, which avoids allocating a surface for every captured frame. Completed frames are then encoded by a background thread. If all
+ * buffers are still being encoded when a frame is captured, the frame is dropped instead of
+ * stalling the render thread.
+ *
+ * \note Reading the pixels of the renderer is still done on the render thread, since SDL
+ *       renderers may only be used by the thread that created them.
+ *
+ * \see basic_renderer::capture
+ */
+class frame_capture final {
+ public:
+  using size_type = usize;
+
+  /**
+   * The function that consumes captured frames, invoked on the background thread.
+   *
+   * The frame may not be used after the function returns, since its buffer is reused.
+   */
+  using sink_type = std::function<result(const surface& frame, size_type index)>;
+
+  /**
+   * Creates a frame capture that saves frames to files.
+   *
+   * Files are named after the configured prefix, followed by a zero-padded frame index and
+   * the file extension, e.g. "frame_000042.png".
+   *
+   * \param cfg the capture configuration.
+   */
+  explicit frame_capture(const frame_capture_cfg& cfg = {})
+      : frame_capture {make_file_sink(cfg.prefix, cfg.format), cfg.buffers, cfg.pixels}
+  {
+  }
+
+  /**
+   * Creates a frame capture that hands frames to a custom sink.
+   *
+   * \param sink the function that consumes captured frames.
+   * \param buffers the amount of reused frame buffers, must be greater than zero.
+   * \param format the pixel format of captured frames.
+   */
+  frame_capture(sink_type sink,
+                const size_type buffers,
+                const pixel_format format = pixel_format::argb8888)
+      : mSink {std::move(sink)}
+      , mFormat {format}
+      , mSlots(buffers)
+  {
+    assert(mSink);
+    assert(buffers > 0);
+  }
+
+  CENTURION_DISABLE_COPY(frame_capture)
+  CENTURION_DISABLE_MOVE(frame_capture)
+
+  /// Blocks until all captured frames have been encoded.
+  ~frame_capture() noexcept { mEncoder.wait(); }
+
+  /**
+   * Captures the current contents of a renderer.
+   *
+   * This should be called before the renderer is presented.
+   *
+   * \param renderer the renderer that will be read.
+   * \param area the area that will be captured, the entire output is captured by default.
+   *
+   * \return `true` if the frame was captured; `false` if it was dropped or failed.
+   */
+  template <typename T>
+  auto capture(basic_renderer<T>& renderer, const maybe<irect>& area = nothing) -> bool
+  {
+    const auto size = area ? area->size() : renderer.output_size();
+
+    size_type slot = 0;
+    if (!acquire_slot(slot)) {
+      return false;
+    }
+
+    /* Releases the slot unless the frame is handed to the encoder, also if this throws */
+    struct slot_guard final {
+      frame_capture& capture;
+      size_type slot;
+      bool active {true};
+
+      ~slot_guard() noexcept
+      {
+        if (active) {
+          capture.release_slot(slot);
+        }
+      }
+    } guard {*this, slot};
+
+    auto& image = mSlots[slot].image;
+    if (!image || image->size() != size) {
+      image.emplace(size, mFormat);
+    }
+
+    auto read = false;
+    if (image->lock()) {
+      read = SDL_RenderReadPixels(renderer.get(),
+                                  area ? area->data() : nullptr,
+                                  to_underlying(mFormat),
+                                  image->pixel_data(),
+                                  image->pitch()) == 0;
+      image->unlock();
+    }
+
+    scoped_lock lock {mMutex};
+
+    if (!read) {
+      ++mStats.failed;
+      return false;
+    }
+
+    const auto index = mNextIndex;
+    mEncoder.submit([this, slot, index] { encode(slot, index); });
+
+    guard.active = false;
+    ++mStats.captured;
+    ++mNextIndex;
+
+    return true;
+  }
+
+  /// Blocks until all captured frames have been encoded.
+  void wait() { mEncoder.wait(); }
+
+  [[nodiscard]] auto stats() -> capture_stats
+  {
+    scoped_lock lock {mMutex};
+    return mStats;
+  }
+
+  /// Returns the amount of frames that are waiting to be, or are being, encoded.
+  [[nodiscard]] auto pending() -> size_type
+  {
+    scoped_lock lock {mMutex};
+
+    size_type count = 0;
+    for (const auto& slot : mSlots) {
+      count += slot.busy ? 1 : 0;
+    }
+
+    return count;
+  }
+
+  [[nodiscard]] auto buffer_count() const noexcept -> size_type { return mSlots.size(); }
+
+  [[nodiscard]] auto format() const noexcept -> pixel_format { return mFormat; }
+
+  /// Creates a sink that saves frames as files, named after the prefix and frame index.
+  [[nodiscard]] static auto make_file_sink(std::string prefix, const capture_format format)
+      -> sink_type
+  {
+    return [prefix = std::move(prefix), format](const surface& frame,
+                                                const size_type index) -> result {
+      auto path = prefix;
+
+      const auto number = std::to_string(index);
+      if (number.size() < 6) {
+        path.append(6 - number.size(), '0');
+      }
+
+      path += number;
+      path += '.';
+      path += to_string(format);
+
+      switch (format) {
+        case capture_format::png:
+#ifndef CENTURION_NO_SDL_IMAGE
+          return frame.save_as_png(path);
+#else
+          return failure;
+#endif  // CENTURION_NO_SDL_IMAGE
+
+        case capture_format::bmp:
+          return frame.save_as_bmp(path);
+
+        case capture_format::raw:
+          return write_raw(frame, path);
+
+        default:
+          return failure;
+      }
+    };
+  }
+
+ private:
+  struct frame_slot final {
+    maybe<surface> image;  ///< Allocated once, and reallocated if the output size changes.
+    bool busy {};          ///< Indicates whether the frame is waiting to be encoded.
+  };
+
+  sink_type mSink;
+  pixel_format mFormat;
+  mutex mMutex;
+  std::vector<frame_slot> mSlots;
+  capture_stats mStats;
+  size_type mNextIndex {};
+  thread_pool mEncoder {1};  ///< Declared last, so that it is joined first.
+
+  auto acquire_slot(size_type& slot) -> bool
+  {
+    scoped_lock lock {mMutex};
+
+    for (size_type index = 0; index < mSlots.size(); ++index) {
+      if (!mSlots[index].busy) {
+        mSlots[index].busy = true;
+        slot = index;
+        return true;
+      }
+    }
+
+    ++mStats.dropped;
+    return false;
+  }
+
+  void release_slot(const size_type slot) noexcept
+  {
+    scoped_lock lock {mMutex};
+    mSlots[slot].busy = false;
+  }
+
+  void encode(const size_type slot, const size_type index)
+  {
+    auto encoded = false;
+
+    try {
+      encoded = static_cast<bool>(mSink(*mSlots[slot].image, index));
+    }
+    catch (...) {
+      // The pool would swallow the exception, so a throwing sink counts as a failed frame
+    }
+
+    scoped_lock lock {mMutex};
+    mSlots[slot].busy = false;
+
+    if (encoded) {
+      ++mStats.encoded;
+    }
+    else {
+      ++mStats.failed;
+    }
+  }
+
+  [[nodiscard]] static auto write_raw(const surface& frame, const std::string& path) -> result
+  {
+    file output {path, file_mode::wb};
+    if (!output) {
+      return failure;
+    }
+
+    const auto rowSize = static_cast<usize>(frame.width()) *
+                         static_cast<usize>(frame.get()->format->BytesPerPixel);
+    const auto* pixels = static_cast<const uint8*>(frame.pixel_data());
+
+    for (int y = 0; y < frame.height(); ++y) {
+      if (output.write(pixels + static_cast<usize>(y) * static_cast<usize>(frame.pitch()),
+                       rowSize) != rowSize) {
+        return failure;
+      }
+    }
+
+    return success;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_FRAME_CAPTURE_HPP_
@@ -0,0 +1,914 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_PALETTE_OPS_HPP_
+#define CENTURION_VIDEO_PALETTE_OPS_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>    // rotate_copy
+#include <array>        // array
+#include <cmath>        // cbrt, fmod
+#include <cstring>      // memcpy
+#include <ostream>      // ostream
+#include <string_view>  // string_view
+#include <utility>      // move, exchange
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../detail/stdlib.hpp"
+#include "color.hpp"
+#include "pixel_kernels.hpp"
+#include "pixels.hpp"
+#include "surface.hpp"
+
+namespace cen {
+
+/**
+ * Represents the dithering algorithms that can be used when quantizing images.
+ *
+ * \see quantize()
+ */
+enum class dither_mode {
+  none,            ///< Map every pixel to the closest palette color.
+  ordered,         ///< Use a 4x4 Bayer matrix, which doesn't crawl when the image changes.
+  floyd_steinberg  ///< Diffuse the quantization error, which gives the smoothest gradients.
+};
+
+[[nodiscard]] constexpr auto to_string(const dither_mode mode) -> std::string_view
+{
+  switch (mode) {
+    case dither_mode::none:
+      return "none";
+
+    case dither_mode::ordered:
+      return "ordered";
+
+    case dither_mode::floyd_steinberg:
+      return "floyd_steinberg";
+
+    default:
+      throw exception {"Did not recognize dither mode!"};
+  }
+}
+
+inline auto operator<<(std::ostream& stream, const dither_mode mode) -> std::ostream&
+{
+  return stream << to_string(mode);
+}
+
+/// Options that control how palettes are generated for true-color images.
+struct quantize_options final {
+  int max_colors {256};                    ///< The palette size, clamped to [2, 256].
+  int refine_passes {2};                   ///< The amount of k-means refinement passes.
+  dither_mode dither {dither_mode::none};  ///< The dithering used when mapping pixels.
+  uint8 alpha_threshold {0x80};            ///< Pixels with less alpha become transparent.
+};
+
+/// An 8-bit indexed image, along with its palette.
+struct indexed_image final {
+  surface image;                 ///< The indexed surface, which uses the palette.
+  palette colors;                ///< The palette, which is shared with the surface.
+  maybe<int> transparent_index;  ///< The palette index of transparent pixels, if any.
+};
+
+namespace detail {
+
+/*
+ * Palettes are generated from a histogram with 5 bits per color channel. Median cut
+ * recursively splits the box of colors with the most pixels and the widest range at its
+ * median, and a few k-means passes then move each palette color to the mean of the pixels
+ * that are closest to it.
+ */
+
+inline constexpr int histogram_bits = 5;
+inline constexpr int histogram_levels = 1 << histogram_bits;
+inline constexpr int histogram_shift = 8 - histogram_bits;
+inline constexpr usize histogram_size = usize {1} << (3 * histogram_bits);
+
+[[nodiscard]] constexpr auto histogram_index(const int red,
+                                             const int green,
+                                             const int blue) noexcept -> usize
+{
+  return (static_cast<usize>(red) << (2 * histogram_bits)) |
+         (static_cast<usize>(green) << histogram_bits) | static_cast<usize>(blue);
+}
+
+[[nodiscard]] constexpr auto histogram_index_of(const uint8* rgb) noexcept -> usize
+{
+  return histogram_index(rgb[0] >> histogram_shift,
+                         rgb[1] >> histogram_shift,
+                         rgb[2] >> histogram_shift);
+}
+
+struct histogram_bin final {
+  uint64 count {};
+  std::array<uint64, 3> sums {};
+
+  void add(const histogram_bin& other) noexcept
+  {
+    count += other.count;
+    for (usize c = 0; c < 3; ++c) {
+      sums[c] += other.sums[c];
+    }
+  }
+
+  [[nodiscard]] auto mean() const noexcept -> color
+  {
+    const auto average = [this](const uint64 sum) {
+      return static_cast<uint8>((sum + count / 2) / count);
+    };
+
+    return {average(sums[0]), average(sums[1]), average(sums[2])};
+  }
+};
+
+struct color_histogram final {
+  std::vector<histogram_bin> bins;
+  usize transparent {};  ///< The amount of pixels below the alpha threshold.
+};
+
+/// Returns the pixels of a surface in the RGBA32 format, i.e. in RGBA byte order.
+template <typename T>
+[[nodiscard]] auto read_rgba_pixels(const basic_surface<T>& source) -> pixel_buffer
+{
+  pixel_buffer pixels;
+  if (!source.convert_into(pixels, pixel_format::rgba32)) {
+    throw exception {"Failed to read surface pixels!"};
+  }
+
+  return pixels;
+}
+
+[[nodiscard]] inline auto make_histogram(const pixel_buffer& pixels,
+                                         const uint8 alphaThreshold) -> color_histogram
+{
+  color_histogram histogram;
+  histogram.bins.resize(histogram_size);
+
+  const auto& size = pixels.size();
+  for (int y = 0; y < size.height; ++y) {
+    const auto* pixel = static_cast<const uint8*>(pixels.data()) + y * pixels.pitch();
+
+    for (int x = 0; x < size.width; ++x, pixel += 4) {
+      if (pixel[3] < alphaThreshold) {
+        ++histogram.transparent;
+        continue;
+      }
+
+      auto& bin = histogram.bins[histogram_index_of(pixel)];
+      ++bin.count;
+      for (usize c = 0; c < 3; ++c) {
+        bin.sums[c] += pixel[c];
+      }
+    }
+  }
+
+  return histogram;
+}
+
+/// A box of histogram bins, the upper bounds are inclusive.
+struct color_box final {
+  std::array<int, 3> low {};
+  std::array<int, 3> high {};
+  histogram_bin total;
+};
+
+template <typename Fn>
+void for_each_bin(const color_box& box, Fn&& fn)
+{
+  for (int red = box.low[0]; red <= box.high[0]; ++red) {
+    for (int green = box.low[1]; green <= box.high[1]; ++green) {
+      for (int blue = box.low[2]; blue <= box.high[2]; ++blue) {
+        fn(std::array<int, 3> {red, green, blue}, histogram_index(red, green, blue));
+      }
+    }
+  }
+}
+
+/// Shrinks a box to the bounds of its populated bins, and updates its pixel statistics.
+inline void shrink_box(color_box& box, const color_histogram& histogram)
+{
+  std::array<int, 3> low {histogram_levels, histogram_levels, histogram_levels};
+  std::array<int, 3> high {-1, -1, -1};
+  histogram_bin total;
+
+  for_each_bin(box, [&](const std::array<int, 3>& position, const usize index) {
+    const auto& bin = histogram.bins[index];
+    if (bin.count != 0) {
+      total.add(bin);
+      for (usize c = 0; c < 3; ++c) {
+        low[c] = detail::min(low[c], position[c]);
+        high[c] = detail::max(high[c], position[c]);
+      }
+    }
+  });
+
+  if (total.count != 0) {
+    box.low = low;
+    box.high = high;
+  }
+
+  box.total = total;
+}
+
+[[nodiscard]] inline auto longest_axis(const color_box& box) noexcept -> usize
+{
+  usize axis = 0;
+  for (usize c = 1; c < 3; ++c) {
+    if (box.high[c] - box.low[c] > box.high[axis] - box.low[axis]) {
+      axis = c;
+    }
+  }
+
+  return axis;
+}
+
+/// Splits a box at the median of its longest axis, the box keeps the lower half.
+[[nodiscard]] inline auto split_box(color_box& box, const color_histogram& histogram)
+    -> color_box
+{
+  const auto axis = longest_axis(box);
+
+  std::array<uint64, histogram_levels> slices {};
+  for_each_bin(box, [&](const std::array<int, 3>& position, const usize index) {
+    slices[static_cast<usize>(position[axis])] += histogram.bins[index].count;
+  });
+
+  // The cut is always below the upper bound, so that both halves are populated
+  auto cut = box.low[axis];
+  uint64 sum {};
+  for (; cut < box.high[axis] - 1; ++cut) {
+    sum += slices[static_cast<usize>(cut)];
+    if (sum * 2 >= box.total.count) {
+      break;
+    }
+  }
+
+  auto upper = box;
+  box.high[axis] = cut;
+  upper.low[axis] = cut + 1;
+
+  shrink_box(box, histogram);
+  shrink_box(upper, histogram);
+
+  return upper;
+}
+
+[[nodiscard]] inline auto median_cut(const color_histogram& histogram, const usize maxColors)
+    -> std::vector<color>
+{
+  std::vector<color_box> boxes;
+
+  color_box all;
+  all.high = {histogram_levels - 1, histogram_levels - 1, histogram_levels - 1};
+  shrink_box(all, histogram);
+
+  if (all.total.count == 0 || maxColors == 0) {
+    return {};
+  }
+
+  boxes.push_back(all);
+  while (boxes.size() < maxColors) {
+    // Prefer boxes with many pixels spread over a wide range of colors
+    auto best = boxes.size();
+    uint64 bestScore {};
+
+    for (usize i = 0; i < boxes.size(); ++i) {
+      const auto& box = boxes[i];
+      const auto axis = longest_axis(box);
+      const auto extent = static_cast<uint64>(box.high[axis] - box.low[axis]);
+
+      if (const auto score = box.total.count * extent; score > bestScore) {
+        best = i;
+        bestScore = score;
+      }
+    }
+
+    if (best == boxes.size()) {
+      break;  // Every box is a single histogram bin
+    }
+
+    auto upper = split_box(boxes[best], histogram);
+    boxes.push_back(upper);
+  }
+
+  std::vector<color> colors;
+  colors.reserve(boxes.size());
+
+  for (const auto& box : boxes) {
+    colors.push_back(box.total.mean());
+  }
+
+  return colors;
+}
+
+[[nodiscard]] constexpr auto color_distance(const color& a,
+                                           const int red,
+                                           const int green,
+                                           const int blue) noexcept -> int
+{
+  const auto dr = a.red() - red;
+  const auto dg = a.green() - green;
+  const auto db = a.blue() - blue;
+  return dr * dr + dg * dg + db * db;
+}
+
+[[nodiscard]] inline auto nearest_color(const std::vector<color>& colors,
+                                        const int red,
+                                        const int green,
+                                        const int blue) noexcept -> usize
+{
+  usize nearest = 0;
+  auto nearestDistance = color_distance(colors.front(), red, green, blue);
+
+  for (usize i = 1; i < colors.size() && nearestDistance != 0; ++i) {
+    if (const auto distance = color_distance(colors[i], red, green, blue);
+        distance < nearestDistance) {
+      nearest = i;
+      nearestDistance = distance;
+    }
+  }
+
+  return nearest;
+}
+
+/// Moves each color to the mean of the histogram bins that are closest to it.
+inline void refine_palette(const color_histogram& histogram,
+                           std::vector<color>& colors,
+                           const int passes)
+{
+  if (colors.empty() || passes < 1) {
+    return;
+  }
+
+  std::vector<const histogram_bin*> populated;
+  for (const auto& bin : histogram.bins) {
+    if (bin.count != 0) {
+      populated.push_back(&bin);
+    }
+  }
+
+  std::vector<histogram_bin> clusters;
+  for (int pass = 0; pass < passes; ++pass) {
+    clusters.assign(colors.size(), histogram_bin {});
+
+    for (const auto* bin : populated) {
+      const auto mean = bin->mean();
+      clusters[nearest_color(colors, mean.red(), mean.green(), mean.blue())].add(*bin);
+    }
+
+    for (usize i = 0; i < colors.size(); ++i) {
+      if (clusters[i].count != 0) {
+        colors[i] = clusters[i].mean();
+      }
+    }
+  }
+}
+
+/// Finds the closest palette entries of colors, with a lazily filled cache per histogram bin.
+class palette_lookup final {
+ public:
+  palette_lookup(std::vector<color> colors, std::vector<uint8> indices)
+      : mColors {std::move(colors)}
+      , mIndices {std::move(indices)}
+      , mCache(histogram_size, unknown)
+  {}
+
+  /// Returns the palette index of the entry that is closest to an RGB color.
+  [[nodiscard]] auto find(const uint8* rgb) -> uint8
+  {
+    auto& cached = mCache[histogram_index_of(rgb)];
+    if (cached == unknown) {
+      // Use the center of the bin, so that the cache is independent of the lookup order
+      const auto center = [](const uint8 value) {
+        return ((value >> histogram_shift) << histogram_shift) + (1 << (histogram_shift - 1));
+      };
+
+      const auto nearest = nearest_color(mColors, center(rgb[0]), center(rgb[1]), center(rgb[2]));
+      cached = mIndices[nearest];
+    }
+
+    return static_cast<uint8>(cached);
+  }
+
+ private:
+  inline constexpr static uint16 unknown = 0xFFFF;
+
+  std::vector<color> mColors;
+  std::vector<uint8> mIndices;
+  std::vector<uint16> mCache;
+};
+
+/// Writes the palette indices of RGBA32 pixels into an indexed surface.
+inline void map_pixels(const pixel_buffer& pixels,
+                       SDL_Surface* target,
+                       const SDL_Palette* entries,
+                       palette_lookup& lookup,
+                       const maybe<int> transparentIndex,
+                       const uint8 alphaThreshold,
+                       const dither_mode dither)
+{
+  const auto width = pixels.size().width;
+  const auto height = pixels.size().height;
+  const auto* source = static_cast<const uint8*>(pixels.data());
+  auto* indices = static_cast<uint8*>(target->pixels);
+
+  const auto is_transparent = [&](const uint8* pixel) noexcept {
+    return transparentIndex.has_value() && pixel[3] < alphaThreshold;
+  };
+
+  const auto transparent = static_cast<uint8>(transparentIndex.value_or(0));
+
+  if (dither == dither_mode::none) {
+    for (int y = 0; y < height; ++y) {
+      const auto* pixel = source + y * pixels.pitch();
+      auto* out = indices + y * target->pitch;
+
+      for (int x = 0; x < width; ++x, pixel += 4) {
+        out[x] = is_transparent(pixel) ? transparent : lookup.find(pixel);
+      }
+    }
+  }
+  else if (dither == dither_mode::ordered) {
+    constexpr std::array<int, 16> bayer {0, 8, 2, 10, 12, 4, 14, 6, 3, 11, 1, 9, 15, 7, 13, 5};
+
+    // The threshold spread matches the typical distance between neighboring palette colors
+    const auto spread = 255.0f / std::cbrt(static_cast<float>(entries->ncolors));
+
+    std::array<int, 16> offsets {};
+    for (usize i = 0; i < bayer.size(); ++i) {
+      offsets[i] = static_cast<int>((static_cast<float>(bayer[i]) + 0.5f) / 16.0f * spread -
+                                    spread / 2.0f);
+    }
+
+    for (int y = 0; y < height; ++y) {
+      const auto* pixel = source + y * pixels.pitch();
+      auto* out = indices + y * target->pitch;
+      const auto* row = offsets.data() + 4 * (y & 3);
+
+      for (int x = 0; x < width; ++x, pixel += 4) {
+        if (is_transparent(pixel)) {
+          out[x] = transparent;
+          continue;
+        }
+
+        const auto offset = row[x & 3];
+        uint8 rgb[3];
+        for (usize c = 0; c < 3; ++c) {
+          rgb[c] = static_cast<uint8>(detail::clamp(pixel[c] + offset, 0, 255));
+        }
+
+        out[x] = lookup.find(rgb);
+      }
+    }
+  }
+  else {
+    // Errors are stored in sixteenths, with a padding pixel on each side of the rows
+    const auto rowSize = static_cast<usize>(width + 2) * 3;
+    std::vector<int> current(rowSize);
+    std::vector<int> next(rowSize);
+
+    for (int y = 0; y < height; ++y) {
+      const auto* pixel = source + y * pixels.pitch();
+      auto* out = indices + y * target->pitch;
+
+      for (int x = 0; x < width; ++x, pixel += 4) {
+        if (is_transparent(pixel)) {
+          out[x] = transparent;
+          continue;
+        }
+
+        const auto base = static_cast<usize>(x + 1) * 3;
+
+        uint8 rgb[3];
+        for (usize c = 0; c < 3; ++c) {
+          const auto error = current[base + c];
+          const auto rounded = (error + (error < 0 ? -8 : 8)) / 16;
+          rgb[c] = static_cast<uint8>(detail::clamp(pixel[c] + rounded, 0, 255));
+        }
+
+        const auto index = lookup.find(rgb);
+        out[x] = index;
+
+        const auto& chosen = entries->colors[index];
+        const int diff[3] {rgb[0] - chosen.r, rgb[1] - chosen.g, rgb[2] - chosen.b};
+
+        for (usize c = 0; c < 3; ++c) {
+          current[base + 3 + c] += diff[c] * 7;
+          next[base - 3 + c] += diff[c] * 3;
+          next[base + c] += diff[c] * 5;
+          next[base + 3 + c] += diff[c];
+        }
+      }
+
+      current.swap(next);
+      std::fill(next.begin(), next.end(), 0);
+    }
+  }
+}
+
+/// Creates an indexed surface that shares a palette, and fills it with mapped pixels.
+inline auto make_indexed_surface(const pixel_buffer& pixels,
+                                 const palette& colors,
+                                 palette_lookup& lookup,
+                                 const maybe<int> transparentIndex,
+                                 const uint8 alphaThreshold,
+                                 const dither_mode dither) -> surface
+{
+  surface image {pixels.size(), pixel_format::index8};
+
+  if (SDL_SetSurfacePalette(image.get(), colors.get()) != 0) {
+    throw sdl_error {};
+  }
+
+  if (transparentIndex) {
+    SDL_SetColorKey(image.get(), SDL_TRUE, static_cast<uint32>(*transparentIndex));
+  }
+
+  map_pixels(pixels, image.get(), colors.get(), lookup, transparentIndex, alphaThreshold, dither);
+  return image;
+}
+
+}  // namespace detail
+
+/**
+ * Generates a palette that approximates the colors of a surface.
+ *
+ * \details The palette is created with median cut and refined with k-means. Pixels with alpha
+ * values below the threshold of the options are ignored, and all of the generated colors are
+ * opaque.
+ *
+ * \param source the surface that will be analyzed.
+ * \param options the palette size and refinement options, the dithering mode is ignored.
+ *
+ * \return the palette colors, which may be fewer than requested; an empty vector if the
+ * surface has no opaque pixels.
+ *
+ * \throws exception if the pixels of the surface could not be read.
+ */
+template <typename T>
+[[nodiscard]] auto generate_palette(const basic_surface<T>& source,
+                                    const quantize_options& options = {})
+    -> std::vector<color>
+{
+  const auto pixels = detail::read_rgba_pixels(source);
+  const auto histogram = detail::make_histogram(pixels, options.alpha_threshold);
+
+  const auto maxColors = static_cast<usize>(detail::clamp(options.max_colors, 2, 256));
+
+  auto colors = detail::median_cut(histogram, maxColors);
+  detail::refine_palette(histogram, colors, options.refine_passes);
+
+  return colors;
+}
+
+/**
+ * Converts a surface to an 8-bit indexed surface with a generated palette.
+ *
+ * \details This reduces the size of the pixel data to a quarter of 32-bit formats, which is
+ * well suited for large backgrounds with few distinct colors. If any pixels have alpha values
+ * below the threshold, the first palette entry is reserved for them and used as color key.
+ * Otherwise, all pixels become opaque.
+ *
+ * \param source the surface that will be quantized.
+ * \param options the palette size, refinement and dithering options.
+ *
+ * \return the indexed surface and its palette.
+ *
+ * \throws exception if the pixels of the surface could not be read.
+ * \throws sdl_error if the indexed surface or palette could not be created.
+ */
+template <typename T>
+[[nodiscard]] auto quantize(const basic_surface<T>& source,
+                            const quantize_options& options = {}) -> indexed_image
+{
+  const auto pixels = detail::read_rgba_pixels(source);
+  const auto histogram = detail::make_histogram(pixels, options.alpha_threshold);
+
+  const auto maxColors = static_cast<usize>(detail::clamp(options.max_colors, 2, 256));
+  const auto transparent = histogram.transparent != 0;
+
+  auto opaque = detail::median_cut(histogram, maxColors - (transparent ? 1u : 0u));
+  detail::refine_palette(histogram, opaque, options.refine_passes);
+
+  std::vector<color> entries;
+  std::vector<uint8> indices;
+
+  if (transparent) {
+    entries.push_back(colors::transparent);
+  }
+
+  for (const auto& entry : opaque) {
+    indices.push_back(static_cast<uint8>(entries.size()));
+    entries.push_back(entry);
+  }
+
+  if (opaque.empty()) {
+    // Every pixel is transparent, but the lookup needs at least one candidate
+    opaque.push_back(colors::black);
+    indices.push_back(static_cast<uint8>(entries.size()));
+    entries.push_back(colors::black);
+  }
+
+  palette generated {static_cast<int>(entries.size())};
+  generated.set_colors(0, entries.data(), generated.size());
+
+  const maybe<int> transparentIndex = transparent ? maybe<int> {0} : nothing;
+
+  detail::palette_lookup lookup {std::move(opaque), std::move(indices)};
+  auto image = detail::make_indexed_surface(pixels,
+                                            generated,
+                                            lookup,
+                                            transparentIndex,
+                                            options.alpha_threshold,
+                                            options.dither);
+
+  return {std::move(image), std::move(generated), transparentIndex};
+}
+
+/**
+ * Converts a surface to an 8-bit indexed surface that uses an existing palette.
+ *
+ * \details This is useful when several images should share a palette, e.g. one created with
+ * `generate_palette()` from a representative image. If the palette has an entry with an alpha
+ * value of zero, pixels with alpha values below the threshold are mapped to it, and it's used
+ * as color key.
+ *
+ * \param source the surface that will be converted.
+ * \param colors the palette that the surface will share.
+ * \param dither the dithering that will be used.
+ * \param alphaThreshold pixels with lower alpha values are considered transparent.
+ *
+ * \return the indexed surface.
+ *
+ * \throws exception if the pixels of the surface could not be read.
+ * \throws sdl_error if the indexed surface could not be created.
+ */
+template <typename T>
+[[nodiscard]] auto remap_to_palette(const basic_surface<T>& source,
+                                    const palette& colors,
+                                    const dither_mode dither = dither_mode::none,
+                                    const uint8 alphaThreshold = 0x80) -> surface
+{
+  if (colors.size() > 256) {
+    throw exception {"Palette is too large for an indexed surface!"};
+  }
+
+  const auto pixels = detail::read_rgba_pixels(source);
+
+  maybe<int> transparentIndex;
+  std::vector<color> candidates;
+  std::vector<uint8> indices;
+
+  for (int i = 0; i < colors.size(); ++i) {
+    const auto entry = colors.at(i);
+    if (entry.alpha() == 0 && !transparentIndex) {
+      transparentIndex = i;
+    }
+    else {
+      candidates.push_back(entry);
+      indices.push_back(static_cast<uint8>(i));
+    }
+  }
+
+  if (candidates.empty()) {
+    throw exception {"Palette has no opaque colors!"};
+  }
+
+  detail::palette_lookup lookup {std::move(candidates), std::move(indices)};
+  return detail::make_indexed_surface(pixels,
+                                      colors,
+                                      lookup,
+                                      transparentIndex,
+                                      alphaThreshold,
+                                      dither);
+}
+
+/**
+ * Expands an 8-bit indexed surface into 32-bit pixels.
+ *
+ * \details SDL textures don't support palettes, so palette animations have to be re-uploaded
+ * to streaming textures. This expands the pixels through a lookup table built from the
+ * palette, which is much cheaper than a general surface conversion. The color key of the
+ * surface is expanded to fully transparent pixels.
+ *
+ * \param indexed the indexed surface.
+ * \param format the 32-bit format of the destination pixels.
+ * \param pixels the destination pixels, which must be as large as the surface.
+ * \param pitch the size of a destination row, in bytes.
+ *
+ * \return `success` if the pixels were expanded; `failure` if the surface isn't indexed or if
+ * the format isn't a 32-bit RGB format.
+ */
+template <typename T>
+auto expand_indexed(const basic_surface<T>& indexed,
+                    const pixel_format format,
+                    void* pixels,
+                    const int pitch) noexcept -> result
+{
+  auto* source = indexed.get();
+  const auto* entries = source->format->palette;
+  const auto layout = detail::layout_of(format);
+
+  if (source->format->format != SDL_PIXELFORMAT_INDEX8 || !entries || !pixels ||
+      layout.bytes != 4) {
+    return failure;
+  }
+
+  uint32 key {};
+  const auto hasKey = SDL_GetColorKey(source, &key) == 0;
+
+  std::array<std::array<uint8, 4>, 256> lookup {};
+  for (usize i = 0; i < lookup.size(); ++i) {
+    auto& entry = lookup[i];
+    entry.fill(0xFF);
+
+    // Indices beyond the palette are invalid, but shouldn't read out of bounds
+    const auto& value = entries->colors[i < static_cast<usize>(entries->ncolors) ? i : 0];
+    const uint8 channels[4] {value.r,
+                             value.g,
+                             value.b,
+                             (hasKey && i == key) ? uint8 {0} : value.a};
+
+    for (usize c = 0; c < 4; ++c) {
+      if (const auto offset = layout.channels[c]; offset != -1) {
+        entry[static_cast<usize>(offset)] = channels[c];
+      }
+    }
+  }
+
+  if (SDL_MUSTLOCK(source) && SDL_LockSurface(source) != 0) {
+    return failure;
+  }
+
+  for (int y = 0; y < source->h; ++y) {
+    const auto* in = static_cast<const uint8*>(source->pixels) + y * source->pitch;
+    auto* out = static_cast<uint8*>(pixels) + y * pitch;
+
+    for (int x = 0; x < source->w; ++x) {
+      std::memcpy(out + 4 * x, lookup[in[x]].data(), 4);
+    }
+  }
+
+  if (SDL_MUSTLOCK(source)) {
+    SDL_UnlockSurface(source);
+  }
+
+  return success;
+}
+
+/// Describes a range of palette entries that are cycled at a constant rate.
+struct color_cycle final {
+  int first {};  ///< The index of the first palette entry in the range.
+  int count {};  ///< The amount of palette entries in the range.
+  float rate {};  ///< The amount of steps per second, negative rates cycle in reverse.
+};
+
+/**
+ * Animates ranges of palette entries, in the style of classic color cycling.
+ *
+ * \details The original colors of the palette are captured on construction, so the cycles
+ * never accumulate drift. Each update only rewrites the ranges whose offsets changed, and
+ * leaves every other palette entry alone.
+ */
+class palette_cycler final {
+ public:
+  /// Creates a cycler that captures the current colors of a palette.
+  explicit palette_cycler(const palette& colors) : mBase(colors.begin(), colors.end()) {}
+
+  /**
+   * Adds a range of palette entries that will be cycled.
+   *
+   * \param cycle the range and rate of the cycle.
+   *
+   * \return `success` if the cycle was added; `failure` if the range is out of bounds.
+   */
+  auto add(const color_cycle& cycle) -> result
+  {
+    if (cycle.first < 0 || cycle.count < 1 ||
+        cycle.first + cycle.count > static_cast<int>(mBase.size())) {
+      return failure;
+    }
+
+    mScratch.resize(detail::max(mScratch.size(), static_cast<usize>(cycle.count)));
+    mCycles.push_back({cycle, 0.0, 0});
+
+    return success;
+  }
+
+  /**
+   * Advances the cycles and updates the affected palette entries.
+   *
+   * \param colors the palette that the cycler was created from.
+   * \param delta the elapsed time since the last update.
+   *
+   * \return the amount of palette entries that were rewritten. Ranges that could not be
+   * written are not counted, and are written again by the next update.
+   */
+  auto update(palette& colors, const seconds<double> delta) noexcept -> int
+  {
+    int changed = 0;
+
+    for (auto& state : mCycles) {
+      const auto count = static_cast<double>(state.cycle.count);
+
+      state.phase = std::fmod(state.phase + state.cycle.rate * delta.count(), count);
+      if (state.phase < 0) {
+        state.phase += count;
+      }
+
+      if (const auto offset = static_cast<int>(state.phase); offset != state.offset) {
+        const auto previous = std::exchange(state.offset, offset % state.cycle.count);
+
+        if (write(colors, state)) {
+          changed += state.cycle.count;
+        }
+        else {
+          state.offset = previous;
+        }
+      }
+    }
+
+    return changed;
+  }
+
+  /**
+   * Restores the original colors of the cycled palette entries.
+   *
+   * \param colors the palette that the cycler was created from.
+   *
+   * \return `success` if all entries were restored; `failure` otherwise.
+   */
+  auto reset(palette& colors) noexcept -> result
+  {
+    bool ok = true;
+
+    for (auto& state : mCycles) {
+      state.phase = 0;
+      state.offset = 0;
+
+      if (!write(colors, state)) {
+        state.offset = -1;  // Makes the next update write the range again
+        ok = false;
+      }
+    }
+
+    return ok;
+  }
+
+  /// Removes all cycles, without changing the palette.
+  void clear() noexcept { mCycles.clear(); }
+
+  /// Returns the amount of cycles.
+  [[nodiscard]] auto count() const noexcept -> usize { return mCycles.size(); }
+
+ private:
+  struct cycle_state final {
+    color_cycle cycle;
+    double phase {};  ///< The current position of the cycle, in the range [0, count).
+    int offset {};    ///< The amount of steps that the entries are currently shifted.
+  };
+
+  std::vector<color> mBase;
+  std::vector<cycle_state> mCycles;
+  std::vector<color> mScratch;
+
+  auto write(palette& colors, const cycle_state& state) noexcept -> result
+  {
+    const auto& [first, count, rate] = state.cycle;
+    const auto begin = mBase.begin() + first;
+
+    // Entries move towards higher indices as the offset grows
+    const auto middle = begin + (count - state.offset) % count;
+    std::rotate_copy(begin, middle, begin + count, mScratch.begin());
+    return colors.set_colors(first, mScratch.data(), count);
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_PALETTE_OPS_HPP_
@@ -0,0 +1,1236 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_PIXEL_KERNELS_HPP_
+#define CENTURION_VIDEO_PIXEL_KERNELS_HPP_
+
+#include <SDL.h>
+
+#include <array>        // array
+#include <atomic>       // atomic
+#include <cstring>      // memcpy
+#include <ostream>      // ostream
+#include <string_view>  // string_view
+#include <utility>      // move
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/memory.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "color.hpp"
+#include "pixels.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CENTURION_HAS_SSE2_KERNELS 1
+#define CENTURION_HAS_AVX2_KERNELS 1
+#include <immintrin.h>
+#else
+#define CENTURION_HAS_SSE2_KERNELS 0
+#define CENTURION_HAS_AVX2_KERNELS 0
+#endif  // SSE2
+
+#if (defined(__ARM_NEON) || defined(__ARM_NEON__)) && SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define CENTURION_HAS_NEON_KERNELS 1
+#include <arm_neon.h>
+#else
+#define CENTURION_HAS_NEON_KERNELS 0
+#endif  // __ARM_NEON
+
+/// Enables AVX2 code generation for a single function, without requiring -mavx2.
+#if defined(__GNUC__) || defined(__clang__)
+#define CENTURION_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CENTURION_TARGET_AVX2
+#endif  // defined(__GNUC__) || defined(__clang__)
+
+namespace cen {
+
+/**
+ * Represents the instruction sets that the pixel kernels can be dispatched to.
+ *
+ * \see best_simd_level()
+ * \see set_simd_level()
+ */
+enum class simd_level {
+  scalar,  ///< Portable code, always available.
+  sse2,
+  avx2,
+  neon
+};
+
+[[nodiscard]] constexpr auto to_string(const simd_level level) -> std::string_view
+{
+  switch (level) {
+    case simd_level::scalar:
+      return "scalar";
+
+    case simd_level::sse2:
+      return "sse2";
+
+    case simd_level::avx2:
+      return "avx2";
+
+    case simd_level::neon:
+      return "neon";
+
+    default:
+      throw exception {"Did not recognize SIMD level!"};
+  }
+}
+
+inline auto operator<<(std::ostream& stream, const simd_level level) -> std::ostream&
+{
+  return stream << to_string(level);
+}
+
+namespace detail {
+
+/// Byte offsets of the red, green, blue and alpha channels in a pixel, -1 if absent.
+using channel_offsets = std::array<int, 4>;
+
+/// Maps each byte of a destination pixel to a source byte offset, -1 yields 0xFF.
+using byte_map = std::array<int, 4>;
+
+struct pixel_layout final {
+  int bytes {};  ///< Bytes per pixel, zero if the format has no dedicated kernels.
+  channel_offsets channels {-1, -1, -1, -1};
+};
+
+/// Creates the layout of a packed 32-bit format, from the byte indices in a pixel value.
+[[nodiscard]] constexpr auto packed_layout(const int red,
+                                           const int green,
+                                           const int blue,
+                                           const int alpha) noexcept -> pixel_layout
+{
+  pixel_layout layout {4, {red, green, blue, alpha}};
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+  for (auto& offset : layout.channels) {
+    if (offset != -1) {
+      offset = 3 - offset;
+    }
+  }
+#endif  // SDL_BYTEORDER == SDL_BIG_ENDIAN
+
+  return layout;
+}
+
+[[nodiscard]] constexpr auto layout_of(const pixel_format format) noexcept -> pixel_layout
+{
+  switch (format) {
+    case pixel_format::rgba8888:
+      return packed_layout(3, 2, 1, 0);
+
+    case pixel_format::argb8888:
+      return packed_layout(2, 1, 0, 3);
+
+    case pixel_format::bgra8888:
+      return packed_layout(1, 2, 3, 0);
+
+    case pixel_format::abgr8888:
+      return packed_layout(0, 1, 2, 3);
+
+    case pixel_format::rgbx8888:
+      return packed_layout(3, 2, 1, -1);
+
+    case pixel_format::bgrx8888:
+      return packed_layout(1, 2, 3, -1);
+
+    case pixel_format::rgb888:
+      return packed_layout(2, 1, 0, -1);
+
+    case pixel_format::bgr888:
+      return packed_layout(0, 1, 2, -1);
+
+    case pixel_format::rgb24:
+      return {3, {0, 1, 2, -1}};
+
+    case pixel_format::bgr24:
+      return {3, {2, 1, 0, -1}};
+
+    default:
+      return {};
+  }
+}
+
+[[nodiscard]] constexpr auto make_byte_map(const pixel_layout& from,
+                                           const pixel_layout& to) noexcept -> byte_map
+{
+  byte_map map {-1, -1, -1, -1};
+
+  for (usize channel = 0; channel < 4; ++channel) {
+    if (const auto offset = to.channels[channel]; offset != -1) {
+      map[static_cast<usize>(offset)] = from.channels[channel];
+    }
+  }
+
+  return map;
+}
+
+/// Returns floor(value / 255) for products of two 8-bit values, without a division.
+[[nodiscard]] constexpr auto div255(const uint32 value) noexcept -> uint32
+{
+  return (value + 1u + (value >> 8u)) >> 8u;
+}
+
+/* The kernels below process as many pixels as they can and return that amount, the
+   remaining pixels of a row are handled by the scalar kernels. All kernels support
+   operating in place, since every pixel is read before it is written. */
+
+inline void remap_scalar(const uint8* src,
+                         const int srcBytes,
+                         uint8* dst,
+                         const int dstBytes,
+                         const byte_map& map,
+                         const int count) noexcept
+{
+  for (int i = 0; i < count; ++i, src += srcBytes, dst += dstBytes) {
+    uint8 pixel[4] {};
+    std::memcpy(pixel, src, static_cast<usize>(srcBytes));
+
+    for (int k = 0; k < dstBytes; ++k) {
+      const auto offset = map[static_cast<usize>(k)];
+      dst[k] = (offset != -1) ? pixel[offset] : uint8 {0xFF};
+    }
+  }
+}
+
+inline void modulate_scalar(const uint8* src,
+                            uint8* dst,
+                            const int bytes,
+                            const std::array<uint32, 4>& factors,
+                            const int count) noexcept
+{
+  for (int i = 0; i < count; ++i, src += bytes, dst += bytes) {
+    for (int k = 0; k < bytes; ++k) {
+      dst[k] = static_cast<uint8>(div255(src[k] * factors[static_cast<usize>(k)]));
+    }
+  }
+}
+
+inline void premultiply_scalar(const uint8* src,
+                               uint8* dst,
+                               const int alpha,
+                               const int count) noexcept
+{
+  for (int i = 0; i < count; ++i, src += 4, dst += 4) {
+    const uint32 a = src[alpha];
+    for (int k = 0; k < 4; ++k) {
+      dst[k] = (k == alpha) ? src[k] : static_cast<uint8>(div255(src[k] * a));
+    }
+  }
+}
+
+inline void unpremultiply_scalar(const uint8* src,
+                                 uint8* dst,
+                                 const int alpha,
+                                 const int count) noexcept
+{
+  for (int i = 0; i < count; ++i, src += 4, dst += 4) {
+    const uint32 a = src[alpha];
+    for (int k = 0; k < 4; ++k) {
+      if (k == alpha) {
+        dst[k] = src[k];
+      }
+      else if (a == 0) {
+        dst[k] = 0;
+      }
+      else {
+        dst[k] = static_cast<uint8>(detail::min((src[k] * 255u + a / 2u) / a, 255u));
+      }
+    }
+  }
+}
+
+#if CENTURION_HAS_SSE2_KERNELS
+
+[[nodiscard]] inline auto mul_div255_sse2(const __m128i value, const __m128i factor) noexcept
+    -> __m128i
+{
+  const auto product = _mm_mullo_epi16(value, factor);
+  const auto sum = _mm_add_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)),
+                                 _mm_set1_epi16(1));
+  return _mm_srli_epi16(sum, 8);
+}
+
+/// Swizzles 32-bit pixels with shifts and masks, since SSE2 lacks byte shuffles.
+[[nodiscard]] inline auto remap32_sse2(const uint8* src,
+                                       uint8* dst,
+                                       const byte_map& map,
+                                       const int count) noexcept -> int
+{
+  uint32 fill {};
+  __m128i masks[4] {};
+  __m128i shifts[4] {};
+  bool right[4] {};
+
+  for (int k = 0; k < 4; ++k) {
+    const auto offset = map[static_cast<usize>(k)];
+    if (offset == -1) {
+      fill |= 0xFFu << (8 * k);
+    }
+    else {
+      masks[k] = _mm_set1_epi32(static_cast<int>(0xFFu << (8 * k)));
+      shifts[k] = _mm_cvtsi32_si128(8 * ((offset > k) ? (offset - k) : (k - offset)));
+      right[k] = offset > k;
+    }
+  }
+
+  const auto fillBytes = _mm_set1_epi32(static_cast<int>(fill));
+
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i));
+
+    auto out = fillBytes;
+    for (int k = 0; k < 4; ++k) {
+      if (map[static_cast<usize>(k)] != -1) {
+        const auto moved = right[k] ? _mm_srl_epi32(in, shifts[k]) : _mm_sll_epi32(in, shifts[k]);
+        out = _mm_or_si128(out, _mm_and_si128(moved, masks[k]));
+      }
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), out);
+  }
+
+  return i;
+}
+
+[[nodiscard]] inline auto modulate32_sse2(const uint8* src,
+                                          uint8* dst,
+                                          const std::array<uint32, 4>& factors,
+                                          const int count) noexcept -> int
+{
+  const auto zero = _mm_setzero_si128();
+  const auto f0 = static_cast<short>(factors[0]);
+  const auto f1 = static_cast<short>(factors[1]);
+  const auto f2 = static_cast<short>(factors[2]);
+  const auto f3 = static_cast<short>(factors[3]);
+  const auto factor = _mm_setr_epi16(f0, f1, f2, f3, f0, f1, f2, f3);
+
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i));
+    const auto lo = mul_div255_sse2(_mm_unpacklo_epi8(in, zero), factor);
+    const auto hi = mul_div255_sse2(_mm_unpackhi_epi8(in, zero), factor);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), _mm_packus_epi16(lo, hi));
+  }
+
+  return i;
+}
+
+template <int Alpha>
+[[nodiscard]] auto premultiply32_sse2(const uint8* src, uint8* dst, const int count) noexcept
+    -> int
+{
+  constexpr int select = Alpha * 0x55;  // Broadcasts the alpha lane of each pixel
+
+  alignas(16) short alphaLanes[8] {};
+  alignas(16) short colorLanes[8] {};
+  for (int lane = 0; lane < 8; ++lane) {
+    alphaLanes[lane] = (lane % 4 == Alpha) ? 0xFF : 0;
+    colorLanes[lane] = (lane % 4 == Alpha) ? 0 : -1;
+  }
+
+  const auto zero = _mm_setzero_si128();
+  const auto alphaMask = _mm_load_si128(reinterpret_cast<const __m128i*>(alphaLanes));
+  const auto colorMask = _mm_load_si128(reinterpret_cast<const __m128i*>(colorLanes));
+
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i));
+
+    auto lo = _mm_unpacklo_epi8(in, zero);
+    auto hi = _mm_unpackhi_epi8(in, zero);
+
+    auto loFactor = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, select), select);
+    auto hiFactor = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, select), select);
+    loFactor = _mm_or_si128(_mm_and_si128(loFactor, colorMask), alphaMask);
+    hiFactor = _mm_or_si128(_mm_and_si128(hiFactor, colorMask), alphaMask);
+
+    lo = mul_div255_sse2(lo, loFactor);
+    hi = mul_div255_sse2(hi, hiFactor);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), _mm_packus_epi16(lo, hi));
+  }
+
+  return i;
+}
+
+#endif  // CENTURION_HAS_SSE2_KERNELS
+
+#if CENTURION_HAS_AVX2_KERNELS
+
+[[nodiscard]] CENTURION_TARGET_AVX2 inline auto mul_div255_avx2(const __m256i value,
+                                                                 const __m256i factor) noexcept
+    -> __m256i
+{
+  const auto product = _mm256_mullo_epi16(value, factor);
+  const auto sum = _mm256_add_epi16(_mm256_add_epi16(product, _mm256_srli_epi16(product, 8)),
+                                    _mm256_set1_epi16(1));
+  return _mm256_srli_epi16(sum, 8);
+}
+
+CENTURION_TARGET_AVX2 inline void store12_avx2(uint8* dst, const __m128i value) noexcept
+{
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), value);
+
+  const auto tail = _mm_cvtsi128_si32(_mm_srli_si128(value, 8));
+  std::memcpy(dst + 8, &tail, sizeof tail);
+}
+
+[[nodiscard]] CENTURION_TARGET_AVX2 inline auto remap32_avx2(const uint8* src,
+                                                              uint8* dst,
+                                                              const byte_map& map,
+                                                              const int count) noexcept -> int
+{
+  alignas(32) uint8 shuffle[32] {};
+  alignas(32) uint8 fill[32] {};
+
+  for (int b = 0; b < 32; ++b) {
+    const auto offset = map[static_cast<usize>(b % 4)];
+    const auto pixel = (b % 16) - (b % 4);  // Shuffles only work within 128-bit lanes
+    shuffle[b] = (offset != -1) ? static_cast<uint8>(pixel + offset) : uint8 {0x80};
+    fill[b] = (offset != -1) ? uint8 {0} : uint8 {0xFF};
+  }
+
+  const auto mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(shuffle));
+  const auto fillBytes = _mm256_load_si256(reinterpret_cast<const __m256i*>(fill));
+
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const auto in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i));
+    const auto out = _mm256_or_si256(_mm256_shuffle_epi8(in, mask), fillBytes);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), out);
+  }
+
+  return i;
+}
+
+/// Converts 24-bit pixels to 32-bit pixels, eight at a time.
+[[nodiscard]] CENTURION_TARGET_AVX2 inline auto expand24_avx2(const uint8* src,
+                                                               uint8* dst,
+                                                               const byte_map& map,
+                                                               const int count) noexcept -> int
+{
+  alignas(32) uint8 shuffle[32] {};
+  alignas(32) uint8 fill[32] {};
+
+  for (int b = 0; b < 32; ++b) {
+    const auto offset = map[static_cast<usize>(b % 4)];
+    const auto pixel = (b % 16) / 4;
+    shuffle[b] = (offset != -1) ? static_cast<uint8>(3 * pixel + offset) : uint8 {0x80};
+    fill[b] = (offset != -1) ? uint8 {0} : uint8 {0xFF};
+  }
+
+  const auto mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(shuffle));
+  const auto fillBytes = _mm256_load_si256(reinterpret_cast<const __m256i*>(fill));
+
+  int i = 0;
+
+  // Each half loads 16 bytes but only uses 12, so we stop early to avoid reading past the row
+  for (; i + 10 <= count; i += 8) {
+    const auto* in = src + 3 * i;
+    const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 12));
+
+    const auto pixels = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    const auto out = _mm256_or_si256(_mm256_shuffle_epi8(pixels, mask), fillBytes);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), out);
+  }
+
+  return i;
+}
+
+/// Converts 32-bit pixels to 24-bit pixels, eight at a time.
+[[nodiscard]] CENTURION_TARGET_AVX2 inline auto pack24_avx2(const uint8* src,
+                                                             uint8* dst,
+                                                             const byte_map& map,
+                                                             const int count) noexcept -> int
+{
+  alignas(32) uint8 shuffle[32] {};
+
+  for (int b = 0; b < 32; ++b) {
+    const auto index = b % 16;
+    const auto offset = (index < 12) ? map[static_cast<usize>(index % 3)] : -1;
+    shuffle[b] = (offset != -1) ? static_cast<uint8>(4 * (index / 3) + offset) : uint8 {0x80};
+  }
+
+  const auto mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(shuffle));
+
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const auto in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i));
+    const auto out = _mm256_shuffle_epi8(in, mask);
+
+    store12_avx2(dst + 3 * i, _mm256_castsi256_si128(out));
+    store12_avx2(dst + 3 * i + 12, _mm256_extracti128_si256(out, 1));
+  }
+
+  return i;
+}
+
+[[nodiscard]] CENTURION_TARGET_AVX2 inline auto modulate32_avx2(
+    const uint8* src,
+    uint8* dst,
+    const std::array<uint32, 4>& factors,
+    const int count) noexcept -> int
+{
+  const auto zero = _mm256_setzero_si256();
+  const auto packed = factors[0] | (factors[1] << 16u);
+  const auto packedHigh = factors[2] | (factors[3] << 16u);
+  const auto factor = _mm256_set_epi32(static_cast<int>(packedHigh),
+                                       static_cast<int>(packed),
+                                       static_cast<int>(packedHigh),
+                                       static_cast<int>(packed),
+                                       static_cast<int>(packedHigh),
+                                       static_cast<int>(packed),
+                                       static_cast<int>(packedHigh),
+                                       static_cast<int>(packed));
+
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const auto in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i));
+    const auto lo = mul_div255_avx2(_mm256_unpacklo_epi8(in, zero), factor);
+    const auto hi = mul_div255_avx2(_mm256_unpackhi_epi8(in, zero), factor);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), _mm256_packus_epi16(lo, hi));
+  }
+
+  return i;
+}
+
+template <int Alpha>
+[[nodiscard]] CENTURION_TARGET_AVX2 auto premultiply32_avx2(const uint8* src,
+                                                             uint8* dst,
+                                                             const int count) noexcept -> int
+{
+  constexpr int select = Alpha * 0x55;
+
+  alignas(32) short alphaLanes[16] {};
+  alignas(32) short colorLanes[16] {};
+  for (int lane = 0; lane < 16; ++lane) {
+    alphaLanes[lane] = (lane % 4 == Alpha) ? 0xFF : 0;
+    colorLanes[lane] = (lane % 4 == Alpha) ? 0 : -1;
+  }
+
+  const auto zero = _mm256_setzero_si256();
+  const auto alphaMask = _mm256_load_si256(reinterpret_cast<const __m256i*>(alphaLanes));
+  const auto colorMask = _mm256_load_si256(reinterpret_cast<const __m256i*>(colorLanes));
+
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const auto in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i));
+
+    auto lo = _mm256_unpacklo_epi8(in, zero);
+    auto hi = _mm256_unpackhi_epi8(in, zero);
+
+    auto loFactor = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, select), select);
+    auto hiFactor = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, select), select);
+    loFactor = _mm256_or_si256(_mm256_and_si256(loFactor, colorMask), alphaMask);
+    hiFactor = _mm256_or_si256(_mm256_and_si256(hiFactor, colorMask), alphaMask);
+
+    lo = mul_div255_avx2(lo, loFactor);
+    hi = mul_div255_avx2(hi, hiFactor);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), _mm256_packus_epi16(lo, hi));
+  }
+
+  return i;
+}
+
+#endif  // CENTURION_HAS_AVX2_KERNELS
+
+#if CENTURION_HAS_NEON_KERNELS
+
+[[nodiscard]] inline auto mul_div255_neon(const uint8x16_t value,
+                                          const uint8x16_t factor) noexcept -> uint8x16_t
+{
+  const auto one = vdupq_n_u16(1);
+
+  const auto lo = vmull_u8(vget_low_u8(value), vget_low_u8(factor));
+  const auto hi = vmull_u8(vget_high_u8(value), vget_high_u8(factor));
+
+  const auto loSum = vaddq_u16(vaddq_u16(lo, vshrq_n_u16(lo, 8)), one);
+  const auto hiSum = vaddq_u16(vaddq_u16(hi, vshrq_n_u16(hi, 8)), one);
+
+  return vcombine_u8(vshrn_n_u16(loSum, 8), vshrn_n_u16(hiSum, 8));
+}
+
+/// Handles all combinations of 24-bit and 32-bit pixels with (de)interleaving loads and stores.
+[[nodiscard]] inline auto remap_neon(const uint8* src,
+                                     const int srcBytes,
+                                     uint8* dst,
+                                     const int dstBytes,
+                                     const byte_map& map,
+                                     const int count) noexcept -> int
+{
+  const auto opaque = vdupq_n_u8(0xFF);
+
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    uint8x16_t channels[4] {opaque, opaque, opaque, opaque};
+
+    if (srcBytes == 4) {
+      const auto in = vld4q_u8(src + 4 * i);
+      for (int k = 0; k < 4; ++k) {
+        channels[k] = in.val[k];
+      }
+    }
+    else {
+      const auto in = vld3q_u8(src + 3 * i);
+      for (int k = 0; k < 3; ++k) {
+        channels[k] = in.val[k];
+      }
+    }
+
+    if (dstBytes == 4) {
+      uint8x16x4_t out;
+      for (int k = 0; k < 4; ++k) {
+        const auto offset = map[static_cast<usize>(k)];
+        out.val[k] = (offset != -1) ? channels[offset] : opaque;
+      }
+      vst4q_u8(dst + 4 * i, out);
+    }
+    else {
+      uint8x16x3_t out;
+      for (int k = 0; k < 3; ++k) {
+        const auto offset = map[static_cast<usize>(k)];
+        out.val[k] = (offset != -1) ? channels[offset] : opaque;
+      }
+      vst3q_u8(dst + 3 * i, out);
+    }
+  }
+
+  return i;
+}
+
+[[nodiscard]] inline auto modulate32_neon(const uint8* src,
+                                          uint8* dst,
+                                          const std::array<uint32, 4>& factors,
+                                          const int count) noexcept -> int
+{
+  uint8x16_t factor[4];
+  for (int k = 0; k < 4; ++k) {
+    factor[k] = vdupq_n_u8(static_cast<uint8>(factors[static_cast<usize>(k)]));
+  }
+
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    auto pixels = vld4q_u8(src + 4 * i);
+    for (int k = 0; k < 4; ++k) {
+      pixels.val[k] = mul_div255_neon(pixels.val[k], factor[k]);
+    }
+    vst4q_u8(dst + 4 * i, pixels);
+  }
+
+  return i;
+}
+
+[[nodiscard]] inline auto premultiply32_neon(const uint8* src,
+                                             uint8* dst,
+                                             const int alpha,
+                                             const int count) noexcept -> int
+{
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    auto pixels = vld4q_u8(src + 4 * i);
+    const auto a = pixels.val[alpha];
+    for (int k = 0; k < 4; ++k) {
+      if (k != alpha) {
+        pixels.val[k] = mul_div255_neon(pixels.val[k], a);
+      }
+    }
+    vst4q_u8(dst + 4 * i, pixels);
+  }
+
+  return i;
+}
+
+#endif  // CENTURION_HAS_NEON_KERNELS
+
+[[nodiscard]] inline auto detect_simd_level() noexcept -> simd_level
+{
+#if CENTURION_HAS_AVX2_KERNELS
+  if (SDL_HasAVX2()) {
+    return simd_level::avx2;
+  }
+#endif  // CENTURION_HAS_AVX2_KERNELS
+
+#if CENTURION_HAS_SSE2_KERNELS
+  if (SDL_HasSSE2()) {
+    return simd_level::sse2;
+  }
+#endif  // CENTURION_HAS_SSE2_KERNELS
+
+#if CENTURION_HAS_NEON_KERNELS
+  if (SDL_HasNEON()) {
+    return simd_level::neon;
+  }
+#endif  // CENTURION_HAS_NEON_KERNELS
+
+  return simd_level::scalar;
+}
+
+[[nodiscard]] inline auto simd_level_state() noexcept -> std::atomic<simd_level>&
+{
+  static std::atomic<simd_level> level {detect_simd_level()};
+  return level;
+}
+
+inline void remap_row(const simd_level level,
+                      const uint8* src,
+                      const int srcBytes,
+                      uint8* dst,
+                      const int dstBytes,
+                      const byte_map& map,
+                      const int count) noexcept
+{
+  int done = 0;
+
+  switch (level) {
+#if CENTURION_HAS_AVX2_KERNELS
+    case simd_level::avx2:
+      if (srcBytes == 4 && dstBytes == 4) {
+        done = remap32_avx2(src, dst, map, count);
+      }
+      else if (srcBytes == 3 && dstBytes == 4) {
+        done = expand24_avx2(src, dst, map, count);
+      }
+      else if (srcBytes == 4 && dstBytes == 3) {
+        done = pack24_avx2(src, dst, map, count);
+      }
+      break;
+#endif  // CENTURION_HAS_AVX2_KERNELS
+
+#if CENTURION_HAS_SSE2_KERNELS
+    case simd_level::sse2:
+      if (srcBytes == 4 && dstBytes == 4) {
+        done = remap32_sse2(src, dst, map, count);
+      }
+      break;
+#endif  // CENTURION_HAS_SSE2_KERNELS
+
+#if CENTURION_HAS_NEON_KERNELS
+    case simd_level::neon:
+      done = remap_neon(src, srcBytes, dst, dstBytes, map, count);
+      break;
+#endif  // CENTURION_HAS_NEON_KERNELS
+
+    default:
+      break;
+  }
+
+  remap_scalar(src + done * srcBytes, srcBytes, dst + done * dstBytes, dstBytes, map, count - done);
+}
+
+inline void modulate_row(const simd_level level,
+                         const uint8* src,
+                         uint8* dst,
+                         const int bytes,
+                         const std::array<uint32, 4>& factors,
+                         const int count) noexcept
+{
+  int done = 0;
+
+  if (bytes == 4) {
+    switch (level) {
+#if CENTURION_HAS_AVX2_KERNELS
+      case simd_level::avx2:
+        done = modulate32_avx2(src, dst, factors, count);
+        break;
+#endif  // CENTURION_HAS_AVX2_KERNELS
+
+#if CENTURION_HAS_SSE2_KERNELS
+      case simd_level::sse2:
+        done = modulate32_sse2(src, dst, factors, count);
+        break;
+#endif  // CENTURION_HAS_SSE2_KERNELS
+
+#if CENTURION_HAS_NEON_KERNELS
+      case simd_level::neon:
+        done = modulate32_neon(src, dst, factors, count);
+        break;
+#endif  // CENTURION_HAS_NEON_KERNELS
+
+      default:
+        break;
+    }
+  }
+
+  modulate_scalar(src + done * bytes, dst + done * bytes, bytes, factors, count - done);
+}
+
+#if CENTURION_HAS_SSE2_KERNELS
+
+[[nodiscard]] inline auto premultiply32_sse2(const uint8* src,
+                                             uint8* dst,
+                                             const int alpha,
+                                             const int count) noexcept -> int
+{
+  switch (alpha) {
+    case 0:
+      return premultiply32_sse2<0>(src, dst, count);
+
+    case 1:
+      return premultiply32_sse2<1>(src, dst, count);
+
+    case 2:
+      return premultiply32_sse2<2>(src, dst, count);
+
+    default:
+      return premultiply32_sse2<3>(src, dst, count);
+  }
+}
+
+#endif  // CENTURION_HAS_SSE2_KERNELS
+
+#if CENTURION_HAS_AVX2_KERNELS
+
+[[nodiscard]] inline auto premultiply32_avx2(const uint8* src,
+                                             uint8* dst,
+                                             const int alpha,
+                                             const int count) noexcept -> int
+{
+  switch (alpha) {
+    case 0:
+      return premultiply32_avx2<0>(src, dst, count);
+
+    case 1:
+      return premultiply32_avx2<1>(src, dst, count);
+
+    case 2:
+      return premultiply32_avx2<2>(src, dst, count);
+
+    default:
+      return premultiply32_avx2<3>(src, dst, count);
+  }
+}
+
+#endif  // CENTURION_HAS_AVX2_KERNELS
+
+inline void premultiply_row(const simd_level level,
+                            const uint8* src,
+                            uint8* dst,
+                            const int alpha,
+                            const int count) noexcept
+{
+  int done = 0;
+
+  switch (level) {
+#if CENTURION_HAS_AVX2_KERNELS
+    case simd_level::avx2:
+      done = premultiply32_avx2(src, dst, alpha, count);
+      break;
+#endif  // CENTURION_HAS_AVX2_KERNELS
+
+#if CENTURION_HAS_SSE2_KERNELS
+    case simd_level::sse2:
+      done = premultiply32_sse2(src, dst, alpha, count);
+      break;
+#endif  // CENTURION_HAS_SSE2_KERNELS
+
+#if CENTURION_HAS_NEON_KERNELS
+    case simd_level::neon:
+      done = premultiply32_neon(src, dst, alpha, count);
+      break;
+#endif  // CENTURION_HAS_NEON_KERNELS
+
+    default:
+      break;
+  }
+
+  premultiply_scalar(src + 4 * done, dst + 4 * done, alpha, count - done);
+}
+
+[[nodiscard]] inline auto valid_pixel_args(const iarea& size,
+                                           const void* src,
+                                           const int srcPitch,
+                                           const void* dst,
+                                           const int dstPitch) noexcept -> bool
+{
+  return src && dst && size.width >= 0 && size.height >= 0 &&
+         (src != dst || srcPitch == dstPitch);
+}
+
+template <typename Fn>
+void for_each_row(const iarea& size,
+                  const void* src,
+                  const int srcPitch,
+                  void* dst,
+                  const int dstPitch,
+                  Fn&& fn)
+{
+  const auto* in = static_cast<const uint8*>(src);
+  auto* out = static_cast<uint8*>(dst);
+
+  for (int row = 0; row < size.height; ++row, in += srcPitch, out += dstPitch) {
+    fn(in, out);
+  }
+}
+
+}  // namespace detail
+
+/// Returns the most capable instruction set supported by the current CPU.
+[[nodiscard]] inline auto best_simd_level() noexcept -> simd_level
+{
+  static const auto level = detail::detect_simd_level();
+  return level;
+}
+
+/// Indicates whether the pixel kernels can be dispatched to an instruction set.
+[[nodiscard]] inline auto has_simd_level(const simd_level level) noexcept -> bool
+{
+  switch (level) {
+    case simd_level::scalar:
+      return true;
+
+#if CENTURION_HAS_AVX2_KERNELS
+    case simd_level::avx2:
+      return SDL_HasAVX2() == SDL_TRUE;
+#endif  // CENTURION_HAS_AVX2_KERNELS
+
+#if CENTURION_HAS_SSE2_KERNELS
+    case simd_level::sse2:
+      return SDL_HasSSE2() == SDL_TRUE;
+#endif  // CENTURION_HAS_SSE2_KERNELS
+
+#if CENTURION_HAS_NEON_KERNELS
+    case simd_level::neon:
+      return SDL_HasNEON() == SDL_TRUE;
+#endif  // CENTURION_HAS_NEON_KERNELS
+
+    default:
+      return false;
+  }
+}
+
+/// Returns the instruction set that the pixel kernels are currently dispatched to.
+[[nodiscard]] inline auto current_simd_level() noexcept -> simd_level
+{
+  return detail::simd_level_state().load(std::memory_order_relaxed);
+}
+
+/**
+ * Overrides the instruction set that the pixel kernels are dispatched to.
+ *
+ * This is mostly useful for testing and benchmarking, the best supported instruction set
+ * is used by default.
+ *
+ * \param level the instruction set that will be used.
+ *
+ * \return `success` if the level was changed; `failure` if it isn't supported.
+ */
+inline auto set_simd_level(const simd_level level) noexcept -> result
+{
+  if (!has_simd_level(level)) {
+    return failure;
+  }
+
+  detail::simd_level_state().store(level, std::memory_order_relaxed);
+  return success;
+}
+
+/**
+ * Indicates whether conversions between two pixel formats use the dedicated kernels.
+ *
+ * The kernels cover the 32-bit RGBA/ARGB/BGRA/ABGR formats (and their padded variants), along
+ * with RGB24 and BGR24. Other conversions are forwarded to `SDL_ConvertPixels()`.
+ */
+[[nodiscard]] constexpr auto has_pixel_kernel(const pixel_format from,
+                                              const pixel_format to) noexcept -> bool
+{
+  return detail::layout_of(from).bytes != 0 && detail::layout_of(to).bytes != 0;
+}
+
+/**
+ * Converts a block of pixels between two pixel formats.
+ *
+ * The source and destination may be the same buffer if the formats have the same amount of
+ * bytes per pixel and the pitches are equal. Other overlapping buffers are not supported.
+ *
+ * \param size the size of the block, in pixels.
+ * \param srcFormat the format of the source pixels.
+ * \param src the source pixels.
+ * \param srcPitch the size of a source row, in bytes.
+ * \param dstFormat the format of the destination pixels.
+ * \param dst the destination buffer.
+ * \param dstPitch the size of a destination row, in bytes.
+ *
+ * \return `success` if the pixels were converted; `failure` otherwise.
+ */
+inline auto convert_pixels(const iarea& size,
+                           const pixel_format srcFormat,
+                           const void* src,
+                           const int srcPitch,
+                           const pixel_format dstFormat,
+                           void* dst,
+                           const int dstPitch) noexcept -> result
+{
+  if (!detail::valid_pixel_args(size, src, srcPitch, dst, dstPitch)) {
+    return failure;
+  }
+
+  const auto from = detail::layout_of(srcFormat);
+  const auto to = detail::layout_of(dstFormat);
+
+  if (from.bytes == 0 || to.bytes == 0) {
+    return SDL_ConvertPixels(size.width,
+                             size.height,
+                             to_underlying(srcFormat),
+                             src,
+                             srcPitch,
+                             to_underlying(dstFormat),
+                             dst,
+                             dstPitch) == 0;
+  }
+  else if (src == dst && from.bytes != to.bytes) {
+    return failure;
+  }
+
+  const auto map = detail::make_byte_map(from, to);
+  const auto level = current_simd_level();
+
+  detail::for_each_row(size, src, srcPitch, dst, dstPitch, [&](const uint8* in, uint8* out) {
+    detail::remap_row(level, in, from.bytes, out, to.bytes, map, size.width);
+  });
+
+  return success;
+}
+
+/**
+ * Multiplies the color channels of a block of pixels by their alpha values.
+ *
+ * \details The results match `SDL_PremultiplyAlpha()`, but the kernels don't require SDL
+ * 2.0.18 and may operate in place.
+ *
+ * \param size the size of the block, in pixels.
+ * \param format the pixel format, which must have an alpha channel.
+ * \param src the source pixels.
+ * \param srcPitch the size of a source row, in bytes.
+ * \param dst the destination buffer, may be the same as the source.
+ * \param dstPitch the size of a destination row, in bytes.
+ *
+ * \return `success` if the pixels were premultiplied; `failure` otherwise.
+ */
+inline auto premultiply_alpha(const iarea& size,
+                              const pixel_format format,
+                              const void* src,
+                              const int srcPitch,
+                              void* dst,
+                              const int dstPitch) noexcept -> result
+{
+  const auto alpha = detail::layout_of(format).channels[3];
+  if (alpha == -1 || !detail::valid_pixel_args(size, src, srcPitch, dst, dstPitch)) {
+    return failure;
+  }
+
+  const auto level = current_simd_level();
+  detail::for_each_row(size, src, srcPitch, dst, dstPitch, [&](const uint8* in, uint8* out) {
+    detail::premultiply_row(level, in, out, alpha, size.width);
+  });
+
+  return success;
+}
+
+inline auto premultiply_alpha(const iarea& size,
+                              const pixel_format format,
+                              void* pixels,
+                              const int pitch) noexcept -> result
+{
+  return premultiply_alpha(size, format, pixels, pitch, pixels, pitch);
+}
+
+/**
+ * Divides the color channels of a block of premultiplied pixels by their alpha values.
+ *
+ * \details This is the inverse of `premultiply_alpha()`, but it is lossy for low alpha
+ * values. There are no SIMD kernels for this operation.
+ *
+ * \return `success` if the pixels were unpremultiplied; `failure` otherwise.
+ */
+inline auto unpremultiply_alpha(const iarea& size,
+                                const pixel_format format,
+                                const void* src,
+                                const int srcPitch,
+                                void* dst,
+                                const int dstPitch) noexcept -> result
+{
+  const auto alpha = detail::layout_of(format).channels[3];
+  if (alpha == -1 || !detail::valid_pixel_args(size, src, srcPitch, dst, dstPitch)) {
+    return failure;
+  }
+
+  detail::for_each_row(size, src, srcPitch, dst, dstPitch, [&](const uint8* in, uint8* out) {
+    detail::unpremultiply_scalar(in, out, alpha, size.width);
+  });
+
+  return success;
+}
+
+inline auto unpremultiply_alpha(const iarea& size,
+                                const pixel_format format,
+                                void* pixels,
+                                const int pitch) noexcept -> result
+{
+  return unpremultiply_alpha(size, format, pixels, pitch, pixels, pitch);
+}
+
+/**
+ * Applies a color modulation to a block of pixels.
+ *
+ * \details Every channel is multiplied by the corresponding channel of the modulation color,
+ * which produces the same result as rendering with the equivalent color and alpha mods.
+ *
+ * \param size the size of the block, in pixels.
+ * \param format the pixel format.
+ * \param src the source pixels.
+ * \param srcPitch the size of a source row, in bytes.
+ * \param dst the destination buffer, may be the same as the source.
+ * \param dstPitch the size of a destination row, in bytes.
+ * \param mod the modulation color, the alpha component is used as the alpha modulation.
+ *
+ * \return `success` if the pixels were modulated; `failure` otherwise.
+ */
+inline auto bake_color_mod(const iarea& size,
+                           const pixel_format format,
+                           const void* src,
+                           const int srcPitch,
+                           void* dst,
+                           const int dstPitch,
+                           const color& mod) noexcept -> result
+{
+  const auto layout = detail::layout_of(format);
+  if (layout.bytes == 0 || !detail::valid_pixel_args(size, src, srcPitch, dst, dstPitch)) {
+    return failure;
+  }
+
+  const std::array<uint32, 4> channels {mod.red(), mod.green(), mod.blue(), mod.alpha()};
+
+  std::array<uint32, 4> factors {0xFF, 0xFF, 0xFF, 0xFF};  // Padding bytes are left as-is
+  for (usize channel = 0; channel < 4; ++channel) {
+    if (const auto offset = layout.channels[channel]; offset != -1) {
+      factors[static_cast<usize>(offset)] = channels[channel];
+    }
+  }
+
+  const auto level = current_simd_level();
+  detail::for_each_row(size, src, srcPitch, dst, dstPitch, [&](const uint8* in, uint8* out) {
+    detail::modulate_row(level, in, out, layout.bytes, factors, size.width);
+  });
+
+  return success;
+}
+
+inline auto bake_color_mod(const iarea& size,
+                           const pixel_format format,
+                           void* pixels,
+                           const int pitch,
+                           const color& mod) noexcept -> result
+{
+  return bake_color_mod(size, format, pixels, pitch, pixels, pitch, mod);
+}
+
+/**
+ * An aligned pixel buffer, suitable as a destination for the pixel kernels.
+ *
+ * Rows are padded to a multiple of 64 bytes, and the storage is only reallocated when a
+ * buffer is resized beyond its current capacity.
+ *
+ * \see convert_pixels()
+ */
+class pixel_buffer final {
+ public:
+  inline constexpr static int alignment = 64;
+
+  pixel_buffer() noexcept = default;
+
+  CENTURION_NODISCARD_CTOR pixel_buffer(const iarea& size, const pixel_format format)
+  {
+    resize(size, format);
+  }
+
+  /**
+   * Changes the size and format of the buffer.
+   *
+   * \note The contents of the buffer are unspecified after this call.
+   *
+   * \param size the new size of the buffer, in pixels.
+   * \param format the new pixel format, which must not be a FourCC format.
+   */
+  void resize(const iarea& size, const pixel_format format)
+  {
+    const auto bytesPerPixel = SDL_BYTESPERPIXEL(to_underlying(format));
+    if (size.width < 0 || size.height < 0 || bytesPerPixel == 0 ||
+        SDL_ISPIXELFORMAT_FOURCC(to_underlying(format))) {
+      throw exception {"Invalid pixel buffer size or format!"};
+    }
+
+    const auto rowBytes = size.width * static_cast<int>(bytesPerPixel);
+    const auto pitch = (rowBytes + alignment - 1) / alignment * alignment;
+    const auto bytes = static_cast<usize>(pitch) * static_cast<usize>(size.height);
+
+    if (!mBlock || bytes > mCapacity) {
+      simd_block block {detail::max(bytes, usize {1})};
+      if (!block) {
+        throw sdl_error {};
+      }
+
+      mBlock.emplace(std::move(block));
+      mCapacity = bytes;
+    }
+
+    mSize = size;
+    mFormat = format;
+    mPitch = pitch;
+  }
+
+  [[nodiscard]] auto data() noexcept -> void* { return mBlock ? mBlock->data() : nullptr; }
+
+  [[nodiscard]] auto data() const noexcept -> const void*
+  {
+    return mBlock ? mBlock->data() : nullptr;
+  }
+
+  /// Returns the size of a row of pixels in bytes.
+  [[nodiscard]] auto pitch() const noexcept -> int { return mPitch; }
+
+  [[nodiscard]] auto size() const noexcept -> const iarea& { return mSize; }
+
+  [[nodiscard]] auto format() const noexcept -> pixel_format { return mFormat; }
+
+  /// Returns the size of the allocated storage in bytes.
+  [[nodiscard]] auto capacity() const noexcept -> usize { return mCapacity; }
+
+ private:
+  maybe<simd_block> mBlock;
+  usize mCapacity {};
+  iarea mSize {};
+  pixel_format mFormat {pixel_format::unknown};
+  int mPitch {};
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_PIXEL_KERNELS_HPP_
@@ -27,6 +27,7 @@
 
 #include <SDL.h>
 
+#include <algorithm>    // rotate
 #include <cassert>      // assert
 #include <memory>       // unique_ptr
 #include <ostream>      // ostream
@@ -287,6 +288,55 @@ class palette final {
     return SDL_SetPaletteColors(mPalette.get(), color.data(), index, 1) == 0;
   }
 
+  /**
+   * Replaces a range of palette entries with a single update.
+   *
+   * \param first the index of the first entry that will be replaced.
+   * \param colors the new colors.
+   * \param count the amount of entries that will be replaced.
+   *
+   * \return `success` if the entries were replaced; `failure` if the range is invalid.
+   */
+  auto set_colors(const int first, const color* colors, const int count) noexcept -> result
+  {
+    static_assert(sizeof(color) == sizeof(SDL_Color));
+
+    if (!colors || first < 0 || count < 0 || first + count > size()) {
+      return failure;
+    }
+
+    const auto* data = reinterpret_cast<const SDL_Color*>(colors);
+    return SDL_SetPaletteColors(mPalette.get(), data, first, count) == 0;
+  }
+
+  /**
+   * Rotates a range of palette entries in place, which is used for palette cycling.
+   *
+   * \details Only the specified entries are modified, and the version of the palette is
+   * updated so that surfaces using the palette are remapped when blitted.
+   *
+   * \param first the index of the first entry in the range.
+   * \param count the amount of entries in the range.
+   * \param shift the amount of steps that the entries are moved towards higher indices,
+   * negative values move the entries towards lower indices.
+   *
+   * \return `success` if the entries were rotated; `failure` if the range is invalid.
+   */
+  auto rotate(const int first, const int count, const int shift) noexcept -> result
+  {
+    if (first < 0 || count < 1 || first + count > size()) {
+      return failure;
+    }
+
+    auto* range = mPalette->colors + first;
+
+    const auto steps = ((shift % count) + count) % count;
+    std::rotate(range, range + (count - steps), range + count);
+
+    // SDL detects that the colors are already in place and only bumps the palette version
+    return SDL_SetPaletteColors(mPalette.get(), range, first, count) == 0;
+  }
+
   [[nodiscard]] auto at(const int index) const -> color
   {
     if (index >= 0 && index < size()) {
@@ -0,0 +1,501 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef CENTURION_VIDEO_RENDER_COMMAND_LIST_HPP_
+#define CENTURION_VIDEO_RENDER_COMMAND_LIST_HPP_
+
+#include <SDL.h>
+
+#include <cassert>  // assert
+#include <vector>   // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "blend.hpp"
+#include "color.hpp"
+#include "renderer.hpp"
+#include "texture.hpp"
+
+namespace cen {
+
+/// Provides statistics about the replay of a render command list.
+struct replay_stats final {
+  usize executed {};  ///< The amount of commands that were submitted to the renderer.
+  usize elided {};    ///< The amount of redundant state changes that were skipped.
+  usize failed {};    ///< The amount of commands that the renderer reported as failed.
+};
+
+/**
+ * Records rendering operations, so that they can be executed later by a renderer.
+ *
+ * Renderers may only be used by the thread that created them. A command list makes it
+ * possible to build the contents of a frame on another thread, and then hand the list over to
+ * the render thread for replay. A typical setup uses two lists that are swapped every frame,
+ * so that frame N+1 can be recorded while frame N is rendered.
+ *
+ * Commands are stored as plain data in a buffer that keeps its capacity when the list is
+ * reset, so recording does not allocate memory in the steady state.
+ *
+ * \note Only the texture pointers are recorded, so textures must outlive the replay.
+ *
+ * \see basic_renderer
+ */
+class render_command_list final {
+ public:
+  using size_type = usize;
+
+  /// Reserves memory for a number of commands.
+  void reserve(const size_type commands) { mCommands.reserve(commands); }
+
+  /// Removes all recorded commands, without releasing any memory.
+  void reset() noexcept
+  {
+    mCommands.clear();
+    mPoints.clear();
+  }
+
+  /// Records clearing the render target with the current color.
+  void clear() { push(op::clear); }
+
+  /// Records clearing the render target with a color, without changing the current color.
+  void clear_with(const color& color)
+  {
+    auto& cmd = push(op::clear);
+    cmd.color = color.get();
+    cmd.flags = has_color;
+  }
+
+  /// Records filling the render target with the current color.
+  void fill() { push(op::fill); }
+
+  /// Records filling the render target with a color, without changing the current color.
+  void fill_with(const color& color)
+  {
+    auto& cmd = push(op::fill);
+    cmd.color = color.get();
+    cmd.flags = has_color;
+  }
+
+  void set_color(const color& color) { push(op::set_color).color = color.get(); }
+
+  void set_blend_mode(const blend_mode mode)
+  {
+    push(op::set_blend_mode).aux = static_cast<uint32>(mode);
+  }
+
+  void set_clip(const irect& area) { push(op::set_clip).src = area.get(); }
+
+  void reset_clip() { push(op::reset_clip); }
+
+  template <typename T>
+  void set_target(const basic_texture<T>& target)
+  {
+    assert(target.get());
+    push(op::set_target).texture = target.get();
+  }
+
+  void reset_target() { push(op::reset_target); }
+
+  template <typename T>
+  void draw_rect(const basic_rect<T>& rect)
+  {
+    push(op::draw_rect).dst = to_frect(rect);
+  }
+
+  template <typename T>
+  void fill_rect(const basic_rect<T>& rect)
+  {
+    push(op::fill_rect).dst = to_frect(rect);
+  }
+
+  template <typename T>
+  void draw_line(const basic_point<T>& start, const basic_point<T>& end)
+  {
+    /* The line is stored as (x1, y1, x2, y2) */
+    push(op::draw_line).dst = {static_cast<float>(start.x()),
+                               static_cast<float>(start.y()),
+                               static_cast<float>(end.x()),
+                               static_cast<float>(end.y())};
+  }
+
+  template <typename Container>
+  void draw_lines(const Container& container)
+  {
+    if (container.empty()) {
+      return;
+    }
+
+    auto& cmd = push(op::draw_lines);
+    cmd.aux = static_cast<uint32>(mPoints.size());
+    cmd.count = static_cast<uint32>(container.size());
+
+    for (const auto& point : container) {
+      mPoints.push_back({static_cast<float>(point.x()), static_cast<float>(point.y())});
+    }
+  }
+
+  template <typename T>
+  void draw_point(const basic_point<T>& point)
+  {
+    auto& cmd = push(op::draw_point);
+    cmd.dst.x = static_cast<float>(point.x());
+    cmd.dst.y = static_cast<float>(point.y());
+  }
+
+  /// Records rendering a texture at its own size, which is looked up when the list is replayed.
+  template <typename T, typename P>
+  void render(const basic_texture<T>& texture, const basic_point<P>& position)
+  {
+    auto& cmd = push_render(texture);
+    cmd.dst.x = static_cast<float>(position.x());
+    cmd.dst.y = static_cast<float>(position.y());
+    cmd.flags = has_position;
+  }
+
+  template <typename T, typename R>
+  void render(const basic_texture<T>& texture, const basic_rect<R>& dst)
+  {
+    auto& cmd = push_render(texture);
+    cmd.dst = to_frect(dst);
+  }
+
+  template <typename T, typename R>
+  void render(const basic_texture<T>& texture, const irect& src, const basic_rect<R>& dst)
+  {
+    auto& cmd = push_render(texture);
+    cmd.src = src.get();
+    cmd.dst = to_frect(dst);
+    cmd.flags = has_source;
+  }
+
+  template <typename T, typename R>
+  void render(const basic_texture<T>& texture,
+              const irect& src,
+              const basic_rect<R>& dst,
+              const double angle)
+  {
+    auto& cmd = push_render(texture);
+    cmd.src = src.get();
+    cmd.dst = to_frect(dst);
+    cmd.angle = angle;
+    cmd.flags = has_source | has_angle;
+  }
+
+  template <typename T, typename R, typename P>
+  void render(const basic_texture<T>& texture,
+              const irect& src,
+              const basic_rect<R>& dst,
+              const double angle,
+              const basic_point<P>& center,
+              const renderer_flip flip)
+  {
+    auto& cmd = push_render(texture);
+    cmd.src = src.get();
+    cmd.dst = to_frect(dst);
+    cmd.angle = angle;
+    cmd.center = {static_cast<float>(center.x()), static_cast<float>(center.y())};
+    cmd.flip = static_cast<uint8>(flip);
+    cmd.flags = has_source | has_angle | has_center;
+  }
+
+  /**
+   * Executes the recorded commands.
+   *
+   * Redundant color, blend mode and clip changes are skipped, where the first change of
+   * each state is always applied since the initial state of the renderer is unknown. The
+   * recorded commands are kept, so the same list can be replayed several times.
+   *
+   * \param renderer the renderer that will execute the commands.
+   *
+   * \return statistics about the replay.
+   */
+  template <typename T>
+  auto replay(basic_renderer<T>& renderer) const -> replay_stats
+  {
+    replay_stats stats;
+    replay_state state;
+
+    const auto submit = [&stats](const result res) {
+      ++stats.executed;
+      if (!res) {
+        ++stats.failed;
+      }
+    };
+
+    for (const auto& cmd : mCommands) {
+      switch (cmd.type) {
+        case op::set_color:
+          if (state.hasColor && equal(state.color, cmd.color)) {
+            ++stats.elided;
+          }
+          else {
+            submit(renderer.set_color(color {cmd.color}));
+            state.color = cmd.color;
+            state.hasColor = true;
+          }
+          break;
+
+        case op::set_blend_mode:
+          if (state.hasBlendMode && state.blendMode == cmd.aux) {
+            ++stats.elided;
+          }
+          else {
+            submit(renderer.set_blend_mode(static_cast<blend_mode>(cmd.aux)));
+            state.blendMode = cmd.aux;
+            state.hasBlendMode = true;
+          }
+          break;
+
+        case op::set_clip:
+          if (state.hasClip && state.clipEnabled && equal(state.clip, cmd.src)) {
+            ++stats.elided;
+          }
+          else {
+            submit(renderer.set_clip(irect {cmd.src}));
+            state.clip = cmd.src;
+            state.clipEnabled = true;
+            state.hasClip = true;
+          }
+          break;
+
+        case op::reset_clip:
+          if (state.hasClip && !state.clipEnabled) {
+            ++stats.elided;
+          }
+          else {
+            submit(renderer.reset_clip());
+            state.clipEnabled = false;
+            state.hasClip = true;
+          }
+          break;
+
+        case op::set_target: {
+          texture_handle target {cmd.texture};
+          submit(renderer.set_target(target));
+
+          /* The clip is stored separately for each render target */
+          state.hasClip = false;
+          break;
+        }
+        case op::reset_target:
+          submit(renderer.reset_target());
+          state.hasClip = false;
+          break;
+
+        case op::clear:
+        case op::fill:
+          submit(replay_fill(renderer, cmd, state));
+          break;
+
+        case op::draw_rect:
+          submit(renderer.draw_rect(frect {cmd.dst}));
+          break;
+
+        case op::fill_rect:
+          submit(renderer.fill_rect(frect {cmd.dst}));
+          break;
+
+        case op::draw_line:
+          submit(renderer.draw_line(fpoint {cmd.dst.x, cmd.dst.y},
+                                    fpoint {cmd.dst.w, cmd.dst.h}));
+          break;
+
+        case op::draw_lines:
+          submit(renderer.draw_lines(mPoints.data() + cmd.aux, cmd.count));
+          break;
+
+        case op::draw_point:
+          submit(renderer.draw_point(fpoint {cmd.dst.x, cmd.dst.y}));
+          break;
+
+        case op::render:
+          submit(replay_render(renderer, cmd));
+          break;
+      }
+    }
+
+    return stats;
+  }
+
+  /// Returns the amount of recorded commands.
+  [[nodiscard]] auto size() const noexcept -> size_type { return mCommands.size(); }
+
+  /// Returns the amount of commands that can be recorded without allocating memory.
+  [[nodiscard]] auto capacity() const noexcept -> size_type { return mCommands.capacity(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mCommands.empty(); }
+
+ private:
+  enum class op : uint8 {
+    clear,
+    fill,
+    set_color,
+    set_blend_mode,
+    set_clip,
+    reset_clip,
+    set_target,
+    reset_target,
+    draw_rect,
+    fill_rect,
+    draw_line,
+    draw_lines,
+    draw_point,
+    render
+  };
+
+  enum command_flags : uint8 {
+    has_color = 1u << 0u,   ///< Clear or fill with an explicit color.
+    has_source = 1u << 1u,  ///< Render a part of a texture.
+    has_angle = 1u << 2u,   ///< Render a rotated texture.
+    has_center = 1u << 3u,  ///< Render with an explicit rotation center and flip.
+    has_position = 1u << 4u  ///< Render at a position, with the size of the texture.
+  };
+
+  /// A single recorded operation, where the meaning of the fields depends on the type.
+  struct command final {
+    SDL_Texture* texture {};  ///< The rendered texture or render target.
+    double angle {};          ///< The rotation in degrees.
+    SDL_FRect dst {};         ///< The destination, rectangle, line endpoints or point.
+    SDL_Rect src {};          ///< The texture source or clip area.
+    SDL_FPoint center {};     ///< The rotation center.
+    SDL_Color color {};       ///< The draw color.
+    uint32 aux {};            ///< The blend mode or first point of a polyline.
+    uint32 count {};          ///< The amount of points in a polyline.
+    op type {};
+    uint8 flags {};
+    uint8 flip {};
+  };
+
+  /// The renderer state that is known during a replay.
+  struct replay_state final {
+    SDL_Color color {};
+    uint32 blendMode {};
+    SDL_Rect clip {};
+    bool hasColor {};
+    bool hasBlendMode {};
+    bool hasClip {};
+    bool clipEnabled {};
+  };
+
+  std::vector<command> mCommands;
+  std::vector<fpoint> mPoints;
+
+  auto push(const op type) -> command&
+  {
+    auto& cmd = mCommands.emplace_back();
+    cmd.type = type;
+    return cmd;
+  }
+
+  template <typename T>
+  auto push_render(const basic_texture<T>& texture) -> command&
+  {
+    assert(texture.get());
+
+    auto& cmd = push(op::render);
+    cmd.texture = texture.get();
+
+    return cmd;
+  }
+
+  template <typename T>
+  [[nodiscard]] static auto to_frect(const basic_rect<T>& rect) noexcept -> SDL_FRect
+  {
+    return {static_cast<float>(rect.x()),
+            static_cast<float>(rect.y()),
+            static_cast<float>(rect.width()),
+            static_cast<float>(rect.height())};
+  }
+
+  [[nodiscard]] static auto equal(const SDL_Color& a, const SDL_Color& b) noexcept -> bool
+  {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+  }
+
+  [[nodiscard]] static auto equal(const SDL_Rect& a, const SDL_Rect& b) noexcept -> bool
+  {
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+  }
+
+  template <typename T>
+  static auto replay_fill(basic_renderer<T>& renderer,
+                          const command& cmd,
+                          const replay_state& state) -> result
+  {
+    const auto run = [&] {
+      if (cmd.type == op::clear) {
+        return renderer.clear();
+      }
+      else {
+        renderer.fill();
+        return result {success};
+      }
+    };
+
+    if (!(cmd.flags & has_color) || (state.hasColor && equal(state.color, cmd.color))) {
+      return run();
+    }
+
+    const auto previous = renderer.get_color();
+
+    renderer.set_color(color {cmd.color});
+    const auto res = run();
+    renderer.set_color(previous);
+
+    return res;
+  }
+
+  template <typename T>
+  static auto replay_render(basic_renderer<T>& renderer, const command& cmd) -> result
+  {
+    const texture_handle texture {cmd.texture};
+    const frect dst {cmd.dst};
+
+    if (cmd.flags & has_center) {
+      return renderer.render(texture,
+                             irect {cmd.src},
+                             dst,
+                             cmd.angle,
+                             fpoint {cmd.center.x, cmd.center.y},
+                             static_cast<renderer_flip>(cmd.flip));
+    }
+    else if (cmd.flags & has_angle) {
+      return renderer.render(texture, irect {cmd.src}, dst, cmd.angle);
+    }
+    else if (cmd.flags & has_source) {
+      return renderer.render(texture, irect {cmd.src}, dst);
+    }
+    else if (cmd.flags & has_position) {
+      return renderer.render(texture, fpoint {cmd.dst.x, cmd.dst.y});
+    }
+    else {
+      return renderer.render(texture, dst);
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_RENDER_COMMAND_LIST_HPP_
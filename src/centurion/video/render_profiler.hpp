@@ -0,0 +1,312 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_RENDER_PROFILER_HPP_
+#define CENTURION_VIDEO_RENDER_PROFILER_HPP_
+
+#include <SDL.h>
+
+#include <cassert>  // assert
+#include <iomanip>  // setprecision
+#include <ios>      // fixed
+#include <ostream>  // ostream
+#include <sstream>  // ostringstream
+#include <string>   // string
+#include <vector>   // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../io/file.hpp"
+#include "../system/timer.hpp"
+#include "blend.hpp"
+#include "color.hpp"
+
+namespace cen {
+
+/// Provides the amount of work submitted to a renderer during a single frame.
+struct render_frame_stats final {
+  uint64 index {};                 ///< The index of the frame, starting at zero.
+  uint64 start {};                 ///< The performance counter value when the frame started.
+  uint64 end {};                   ///< The performance counter value when it was presented.
+  usize draw_calls {};             ///< The amount of submitted draw calls, including clears.
+  usize primitives {};             ///< The amount of points, lines, rects, quads and triangles.
+  usize texture_binds {};          ///< The amount of draw calls that used another texture.
+  usize target_switches {};        ///< The amount of times the render target changed.
+  usize color_sets {};             ///< The amount of draw color changes.
+  usize redundant_color_sets {};   ///< Color changes that set the color already in use.
+  usize blend_sets {};             ///< The amount of blend mode changes.
+  usize redundant_blend_sets {};   ///< Blend mode changes that set the mode already in use.
+  usize bytes_uploaded {};         ///< The amount of pixel data uploaded to new textures.
+
+  /// Returns the duration of the frame, in milliseconds.
+  [[nodiscard]] auto duration() const noexcept -> double
+  {
+    return static_cast<double>(end - start) * 1'000.0 / static_cast<double>(frequency());
+  }
+};
+
+/**
+ * Records the work submitted to a renderer, aggregated per frame.
+ *
+ * A profiler is attached to a renderer with `basic_renderer::set_profiler()`, after which
+ * draw calls, render target changes, draw state changes and texture uploads are recorded into
+ * the current frame. `basic_renderer::present()` ends the current frame and starts the next.
+ *
+ * Texture binds are counted when a textured draw call uses another texture than the previous
+ * textured draw call, which is what most backends need to rebind.
+ *
+ * \note The renderer only reports to profilers when `CENTURION_ENABLE_RENDER_PROFILER` is
+ *       defined, otherwise the instrumentation is compiled out entirely. The record functions
+ *       can still be called manually, e.g. to account for work done through raw SDL calls.
+ *
+ * \see basic_renderer::set_profiler
+ */
+class render_profiler final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates a render profiler.
+   *
+   * \param history the maximum amount of finished frames that are kept, the oldest frames are
+   *        discarded first. Must be greater than zero.
+   */
+  explicit render_profiler(const size_type history = 600) : mFrames(history)
+  {
+    assert(history > 0);
+    clear();
+  }
+
+  /**
+   * Records a draw call.
+   *
+   * \param texture the texture used by the draw call, may be null.
+   * \param primitives the amount of primitives submitted by the draw call.
+   */
+  void record_draw(const SDL_Texture* texture, const size_type primitives) noexcept
+  {
+    ++mCurrent.draw_calls;
+    mCurrent.primitives += primitives;
+
+    if (texture && texture != mTexture) {
+      ++mCurrent.texture_binds;
+      mTexture = texture;
+    }
+  }
+
+  /// Records a change of the render target, where null denotes the default target.
+  void record_target(const SDL_Texture* target) noexcept
+  {
+    if (target != mTarget) {
+      ++mCurrent.target_switches;
+      mTarget = target;
+    }
+  }
+
+  void record_color(const color& color) noexcept
+  {
+    ++mCurrent.color_sets;
+
+    if (mColor == color) {
+      ++mCurrent.redundant_color_sets;
+    }
+
+    mColor = color;
+  }
+
+  void record_blend_mode(const blend_mode mode) noexcept
+  {
+    ++mCurrent.blend_sets;
+
+    if (mBlendMode == mode) {
+      ++mCurrent.redundant_blend_sets;
+    }
+
+    mBlendMode = mode;
+  }
+
+  /// Records the upload of pixel data to a texture.
+  void record_upload(const size_type bytes) noexcept { mCurrent.bytes_uploaded += bytes; }
+
+  /**
+   * Ends the current frame and starts the next one.
+   *
+   * This is called by `basic_renderer::present()`. Frames are stored in a preallocated ring
+   * buffer, so this function never allocates.
+   */
+  void end_frame() noexcept
+  {
+    mCurrent.end = now();
+
+    mFrames[(mFirst + mCount) % mFrames.size()] = mCurrent;
+    if (mCount == mFrames.size()) {
+      mFirst = (mFirst + 1) % mFrames.size();
+    }
+    else {
+      ++mCount;
+    }
+
+    const auto index = mCurrent.index + 1;
+    mCurrent = render_frame_stats {};
+    mCurrent.index = index;
+    mCurrent.start = now();
+  }
+
+  /// Discards all recorded frames and resets the tracked draw state.
+  void clear() noexcept
+  {
+    mFirst = 0;
+    mCount = 0;
+
+    mCurrent = render_frame_stats {};
+    mCurrent.start = now();
+    mEpoch = mCurrent.start;
+
+    mTexture = nullptr;
+    mTarget = nullptr;
+    mColor = nothing;
+    mBlendMode = nothing;
+  }
+
+  /**
+   * Writes the recorded frames as a Chrome trace, as used by `chrome://tracing` and Perfetto.
+   *
+   * Every frame is written as a complete event with the frame statistics as arguments, along
+   * with counter events for the draw calls, texture binds and uploaded bytes.
+   */
+  void write_chrome_trace(std::ostream& stream) const
+  {
+    const auto toMicros = [this](const uint64 ticks) {
+      return static_cast<double>(ticks - mEpoch) * 1'000'000.0 /
+             static_cast<double>(frequency());
+    };
+
+    const auto flags = stream.flags();
+    const auto precision = stream.precision();
+
+    stream << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+
+    auto first = true;
+    for (size_type index = 0; index < mCount; ++index) {
+      const auto& frame = at(index);
+      const auto ts = toMicros(frame.start);
+      const auto dur = toMicros(frame.end) - ts;
+
+      stream << (first ? "\n" : ",\n");
+      first = false;
+
+      stream << "{\"name\":\"frame " << frame.index << "\",\"cat\":\"render\",\"ph\":\"X\""
+             << ",\"pid\":1,\"tid\":1,\"ts\":" << ts << ",\"dur\":" << dur << ",\"args\":{"
+             << "\"draw_calls\":" << frame.draw_calls << ",\"primitives\":" << frame.primitives
+             << ",\"texture_binds\":" << frame.texture_binds
+             << ",\"target_switches\":" << frame.target_switches
+             << ",\"color_sets\":" << frame.color_sets
+             << ",\"redundant_color_sets\":" << frame.redundant_color_sets
+             << ",\"blend_sets\":" << frame.blend_sets
+             << ",\"redundant_blend_sets\":" << frame.redundant_blend_sets
+             << ",\"bytes_uploaded\":" << frame.bytes_uploaded << "}},\n";
+
+      stream << "{\"name\":\"render\",\"ph\":\"C\",\"pid\":1,\"ts\":" << ts << ",\"args\":{"
+             << "\"draw_calls\":" << frame.draw_calls
+             << ",\"texture_binds\":" << frame.texture_binds
+             << ",\"bytes_uploaded\":" << frame.bytes_uploaded << "}}";
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    stream.flags(flags);
+    stream.precision(precision);
+  }
+
+  /// Saves the recorded frames as a Chrome trace JSON file.
+  [[nodiscard]] auto save_chrome_trace(const std::string& path) const -> result
+  {
+    std::ostringstream stream;
+    write_chrome_trace(stream);
+
+    file output {path, file_mode::w};
+    if (!output) {
+      return failure;
+    }
+
+    const auto json = stream.str();
+    return output.write(json.data(), json.size()) == json.size();
+  }
+
+  /// Returns the statistics of the frame that is currently being recorded.
+  [[nodiscard]] auto current() const noexcept -> const render_frame_stats& { return mCurrent; }
+
+  /// Returns the statistics of the most recently presented frame, if there is one.
+  [[nodiscard]] auto last_frame() const -> maybe<render_frame_stats>
+  {
+    if (mCount != 0) {
+      return at(mCount - 1);
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  /**
+   * Returns a recorded frame.
+   *
+   * \param index the index of the frame among the recorded frames, where zero is the oldest.
+   *
+   * \throws exception if the index is out of bounds.
+   */
+  [[nodiscard]] auto frame(const size_type index) const -> const render_frame_stats&
+  {
+    if (index < mCount) {
+      return at(index);
+    }
+    else {
+      throw exception {"Invalid render profiler frame index!"};
+    }
+  }
+
+  [[nodiscard]] auto frame_count() const noexcept -> size_type { return mCount; }
+
+  [[nodiscard]] auto history() const noexcept -> size_type { return mFrames.size(); }
+
+ private:
+  std::vector<render_frame_stats> mFrames;  ///< Ring buffer of the recorded frames.
+  size_type mFirst {};                      ///< The position of the oldest recorded frame.
+  size_type mCount {};
+  render_frame_stats mCurrent;
+  uint64 mEpoch {};
+  const SDL_Texture* mTexture {};  ///< The texture used by the last textured draw call.
+  const SDL_Texture* mTarget {};   ///< The current render target, null for the default one.
+  maybe<color> mColor;
+  maybe<blend_mode> mBlendMode;
+
+  [[nodiscard]] auto at(const size_type index) const noexcept -> const render_frame_stats&
+  {
+    return mFrames[(mFirst + index) % mFrames.size()];
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_RENDER_PROFILER_HPP_
@@ -32,24 +32,30 @@
 #endif  // CENTURION_NO_SDL_IMAGE
 
 #include <cassert>      // assert
-#include <cmath>        // floor, sqrt
+#include <cmath>        // floor, sqrt, cos, sin
 #include <cstddef>      // size_t
+#include <new>          // bad_alloc
 #include <optional>     // optional
 #include <ostream>      // ostream
 #include <string>       // string, to_string
 #include <string>       // string, string_literals
 #include <string_view>  // string_view
+#include <type_traits>  // is_integral_v
 #include <utility>      // pair
+#include <vector>       // vector
 
 #include "../common/errors.hpp"
 #include "../common/math.hpp"
 #include "../common/primitives.hpp"
 #include "../common/result.hpp"
+#include "../detail/array_utils.hpp"
 #include "../detail/owner_handle_api.hpp"
 #include "../detail/stdlib.hpp"
 #include "../features.hpp"
 #include "../io/file.hpp"
 #include "color.hpp"
+#include "damage_tracker.hpp"
+#include "render_profiler.hpp"
 #include "surface.hpp"
 #include "texture.hpp"
 #include "unicode_string.hpp"
@@ -95,6 +101,175 @@ struct renderer_scale final {
   float y {};
 };
 
+namespace detail {
+
+/// Returns the scratch buffer for generated shape outlines, shared by the current thread.
+[[nodiscard]] inline auto shape_points() -> std::vector<fpoint>&
+{
+  thread_local std::vector<fpoint> points;
+  return points;
+}
+
+/// Returns the scratch buffer for generated shape spans, shared by the current thread.
+[[nodiscard]] inline auto shape_spans() -> std::vector<frect>&
+{
+  thread_local std::vector<frect> spans;
+  return spans;
+}
+
+/// Generates the points of a circle outline, rounded to the value type of the center.
+template <typename T>
+void make_circle_outline(const float x0,
+                         const float y0,
+                         const float radius,
+                         std::vector<fpoint>& points)
+{
+  const auto cx = x0 - 0.5f;
+  const auto cy = y0 - 0.5f;
+
+  auto add = [&points](const float x, const float y) {
+    points.push_back({static_cast<float>(static_cast<T>(x)),
+                      static_cast<float>(static_cast<T>(y))});
+  };
+
+  auto error = -radius;
+  auto x = radius - 0.5f;
+  auto y = 0.5f;
+
+  points.clear();
+  while (x >= y) {
+    add(cx + x, cy + y);
+    add(cx + y, cy + x);
+
+    if (x != 0) {
+      add(cx - x, cy + y);
+      add(cx + y, cy - x);
+    }
+
+    if (y != 0) {
+      add(cx + x, cy - y);
+      add(cx - y, cy + x);
+    }
+
+    if (x != 0 && y != 0) {
+      add(cx - x, cy - y);
+      add(cx - y, cy - x);
+    }
+
+    error += y;
+    ++y;
+    error += y;
+
+    if (error >= 0) {
+      --x;
+      error -= x;
+      error -= x;
+    }
+  }
+}
+
+/// Generates the one-pixel tall spans of a filled circle.
+inline void make_circle_spans(const float cx,
+                              const float cy,
+                              const float radius,
+                              std::vector<frect>& spans)
+{
+  spans.clear();
+  for (auto dy = 1.0f; dy <= radius; dy += 1.0f) {
+    const auto dx = std::floor(std::sqrt((2.0f * radius * dy) - (dy * dy)));
+    spans.emplace_back(cx - dx, cy + dy - radius, 2 * dx + 1, 1.0f);
+    spans.emplace_back(cx - dx, cy - dy + radius, 2 * dx + 1, 1.0f);
+  }
+}
+
+/// Generates the points of an ellipse outline, the radii must not be negative.
+inline void make_ellipse_outline(const float cx,
+                                 const float cy,
+                                 const float rx,
+                                 const float ry,
+                                 std::vector<fpoint>& points)
+{
+  /* Points on the axes are only added once, to avoid blending them twice */
+  auto add = [&](const float x, const float y) {
+    points.push_back({cx + x, cy + y});
+
+    if (x != 0) {
+      points.push_back({cx - x, cy + y});
+    }
+
+    if (y != 0) {
+      points.push_back({cx + x, cy - y});
+    }
+
+    if (x != 0 && y != 0) {
+      points.push_back({cx - x, cy - y});
+    }
+  };
+
+  const auto rx2 = rx * rx;
+  const auto ry2 = ry * ry;
+
+  auto x = 0.0f;
+  auto y = ry;
+  auto dx = 0.0f;
+  auto dy = 2 * rx2 * y;
+
+  points.clear();
+
+  /* Region where the slope is less than one */
+  auto decision = ry2 - (rx2 * ry) + (0.25f * rx2);
+  while (dx < dy) {
+    add(x, y);
+
+    ++x;
+    dx += 2 * ry2;
+
+    if (decision < 0) {
+      decision += dx + ry2;
+    }
+    else {
+      --y;
+      dy -= 2 * rx2;
+      decision += dx - dy + ry2;
+    }
+  }
+
+  /* Region where the slope is greater than one */
+  decision = (ry2 * (x + 0.5f) * (x + 0.5f)) + (rx2 * (y - 1) * (y - 1)) - (rx2 * ry2);
+  while (y >= 0) {
+    add(x, y);
+
+    --y;
+    dy -= 2 * rx2;
+
+    if (decision > 0) {
+      decision += rx2 - dy;
+    }
+    else {
+      ++x;
+      dx += 2 * ry2;
+      decision += dx - dy + rx2;
+    }
+  }
+}
+
+/// Generates the one-pixel tall spans of a filled ellipse, the radii must not be negative.
+inline void make_ellipse_spans(const float cx,
+                               const float cy,
+                               const float rx,
+                               const float ry,
+                               std::vector<frect>& spans)
+{
+  spans.clear();
+  for (auto dy = -ry; dy <= ry; dy += 1.0f) {
+    const auto ratio = (ry > 0) ? dy / ry : 0.0f;
+    const auto dx = std::floor(rx * std::sqrt(detail::max(0.0f, 1.0f - ratio * ratio)));
+    spans.emplace_back(cx - dx, cy + dy, 2 * dx + 1, 1.0f);
+  }
+}
+
+}  // namespace detail
+
 template <typename T>
 class basic_renderer;
 
@@ -128,10 +303,14 @@ class basic_renderer final {
         throw exception {"Cannot create renderer from null pointer!"};
       }
     }
+
+    mRenderingToWindow = !get() || !SDL_GetRenderTarget(get());
   }
 
   template <typename TT = T, detail::enable_for_handle<TT> = 0>
-  explicit basic_renderer(const renderer& owner) noexcept : mRenderer {owner.get()}
+  explicit basic_renderer(const renderer& owner) noexcept
+      : mRenderer {owner.get()}
+      , mRenderingToWindow {!SDL_GetRenderTarget(owner.get())}
   {
   }
 
@@ -139,6 +318,7 @@ class basic_renderer final {
   [[nodiscard]] auto make_texture(const basic_surface<X>& surface) const -> texture
   {
     if (auto* ptr = SDL_CreateTextureFromSurface(get(), surface.get())) {
+      profile_upload(surface.get());
       return texture {ptr};
     }
     else {
@@ -168,6 +348,7 @@ class basic_renderer final {
   {
     assert(path);
     if (auto* ptr = IMG_LoadTexture(get(), path)) {
+      profile_upload(ptr);
       return texture {ptr};
     }
     else {
@@ -183,6 +364,7 @@ class basic_renderer final {
   [[nodiscard]] auto make_texture(file& file) const -> texture
   {
     if (auto* ptr = IMG_LoadTextureRW(get(), file.data(), SDL_FALSE)) {
+      profile_upload(ptr);
       return texture {ptr};
     }
     else {
@@ -192,7 +374,15 @@ class basic_renderer final {
 
 #endif  // CENTURION_NO_SDL_IMAGE
 
-  auto clear() noexcept -> result { return SDL_RenderClear(get()) == 0; }
+  auto clear() noexcept -> result
+  {
+    if (mDamage) {
+      mark_damaged(irect {{0, 0}, output_size()});
+    }
+
+    profile_draw(nullptr, 0);
+    return SDL_RenderClear(get()) == 0;
+  }
 
   void clear_with(const color& color) noexcept
   {
@@ -202,7 +392,11 @@ class basic_renderer final {
     set_color(previous);
   }
 
-  void present() noexcept { SDL_RenderPresent(get()); }
+  void present() noexcept
+  {
+    SDL_RenderPresent(get());
+    profile_frame();
+  }
 
   void fill() noexcept
   {
@@ -224,6 +418,9 @@ class basic_renderer final {
   template <typename X>
   auto draw_rect(const basic_rect<X>& rect) noexcept -> result
   {
+    mark_damaged(rect);
+    profile_draw(nullptr, 1);
+
     if constexpr (basic_rect<X>::integral) {
       return SDL_RenderDrawRect(get(), rect.data()) == 0;
     }
@@ -235,6 +432,9 @@ class basic_renderer final {
   template <typename X>
   auto fill_rect(const basic_rect<X>& rect) noexcept -> result
   {
+    mark_damaged(rect);
+    profile_draw(nullptr, 1);
+
     if constexpr (basic_rect<X>::integral) {
       return SDL_RenderFillRect(get(), rect.data()) == 0;
     }
@@ -246,6 +446,13 @@ class basic_renderer final {
   template <typename X>
   auto draw_line(const basic_point<X>& start, const basic_point<X>& end) noexcept -> result
   {
+    if (mDamage) {
+      const basic_point<X> points[] {start, end};
+      mark_damaged_points(points, 2);
+    }
+
+    profile_draw(nullptr, 1);
+
     if constexpr (basic_point<X>::integral) {
       return SDL_RenderDrawLine(get(), start.x(), start.y(), end.x(), end.y()) == 0;
     }
@@ -254,22 +461,33 @@ class basic_renderer final {
     }
   }
 
+  /// Renders a sequence of connected lines, where each point is connected to the next.
+  template <typename X>
+  auto draw_lines(const basic_point<X>* points, const usize count) noexcept -> result
+  {
+    if (!points || count == 0) {
+      return failure;
+    }
+
+    if (mDamage) {
+      mark_damaged_points(points, count);
+    }
+
+    profile_draw(nullptr, count - 1);
+
+    if constexpr (basic_point<X>::integral) {
+      return SDL_RenderDrawLines(get(), points->data(), static_cast<int>(count)) == 0;
+    }
+    else {
+      return SDL_RenderDrawLinesF(get(), points->data(), static_cast<int>(count)) == 0;
+    }
+  }
+
   template <typename Container>
   auto draw_lines(const Container& container) noexcept -> result
   {
-    using point_t = typename Container::value_type;  // a point of int or float
-    using value_t = typename point_t::value_type;    // either int or float
-
     if (!container.empty()) {
-      const auto& front = container.front();
-      const auto* first = front.data();
-
-      if constexpr (std::is_same_v<value_t, int>) {
-        return SDL_RenderDrawLines(get(), first, isize(container)) == 0;
-      }
-      else {
-        return SDL_RenderDrawLinesF(get(), first, isize(container)) == 0;
-      }
+      return draw_lines(&container.front(), container.size());
     }
     else {
       return failure;
@@ -279,6 +497,12 @@ class basic_renderer final {
   template <typename X>
   auto draw_point(const basic_point<X>& point) noexcept -> result
   {
+    if (mDamage) {
+      mark_damaged_points(&point, 1);
+    }
+
+    profile_draw(nullptr, 1);
+
     if constexpr (basic_point<X>::integral) {
       return SDL_RenderDrawPoint(get(), point.x(), point.y()) == 0;
     }
@@ -287,72 +511,240 @@ class basic_renderer final {
     }
   }
 
+  /// Renders a batch of points with a single call.
   template <typename X>
-  void draw_circle(const basic_point<X>& position, const float radius) noexcept
+  auto draw_points(const basic_point<X>* points, const usize count) noexcept -> result
   {
-    using value_t = typename basic_point<X>::value_type;
+    if (!points || count == 0) {
+      return failure;
+    }
 
-    auto error = -radius;
-    auto x = radius - 0.5f;
-    auto y = 0.5f;
+    if (mDamage) {
+      mark_damaged_points(points, count);
+    }
 
-    const auto cx = static_cast<float>(position.x()) - 0.5f;
-    const auto cy = static_cast<float>(position.y()) - 0.5f;
+    profile_draw(nullptr, count);
 
-    while (x >= y) {
-      draw_point<value_t>({static_cast<value_t>(cx + x), static_cast<value_t>(cy + y)});
-      draw_point<value_t>({static_cast<value_t>(cx + y), static_cast<value_t>(cy + x)});
+    if constexpr (basic_point<X>::integral) {
+      return SDL_RenderDrawPoints(get(), points->data(), static_cast<int>(count)) == 0;
+    }
+    else {
+      return SDL_RenderDrawPointsF(get(), points->data(), static_cast<int>(count)) == 0;
+    }
+  }
 
-      if (x != 0) {
-        draw_point<value_t>({static_cast<value_t>(cx - x), static_cast<value_t>(cy + y)});
-        draw_point<value_t>({static_cast<value_t>(cx + y), static_cast<value_t>(cy - x)});
-      }
+  template <typename Container>
+  auto draw_points(const Container& container) noexcept -> result
+  {
+    if (!container.empty()) {
+      return draw_points(&container.front(), container.size());
+    }
+    else {
+      return failure;
+    }
+  }
 
-      if (y != 0) {
-        draw_point<value_t>({static_cast<value_t>(cx + x), static_cast<value_t>(cy - y)});
-        draw_point<value_t>({static_cast<value_t>(cx - y), static_cast<value_t>(cy + x)});
-      }
+  /// Renders the outlines of a batch of rectangles with a single call.
+  template <typename X>
+  auto draw_rects(const basic_rect<X>* rects, const usize count) noexcept -> result
+  {
+    if (!rects || count == 0) {
+      return failure;
+    }
 
-      if (x != 0 && y != 0) {
-        draw_point<value_t>({static_cast<value_t>(cx - x), static_cast<value_t>(cy - y)});
-        draw_point<value_t>({static_cast<value_t>(cx - y), static_cast<value_t>(cy - x)});
-      }
+    if (mDamage) {
+      mark_damaged_rects(rects, count);
+    }
 
-      error += y;
-      ++y;
-      error += y;
+    profile_draw(nullptr, count);
 
-      if (error >= 0) {
-        --x;
-        error -= x;
-        error -= x;
-      }
+    if constexpr (basic_rect<X>::integral) {
+      return SDL_RenderDrawRects(get(), rects->data(), static_cast<int>(count)) == 0;
+    }
+    else {
+      return SDL_RenderDrawRectsF(get(), rects->data(), static_cast<int>(count)) == 0;
+    }
+  }
+
+  template <typename Container>
+  auto draw_rects(const Container& container) noexcept -> result
+  {
+    if (!container.empty()) {
+      return draw_rects(&container.front(), container.size());
+    }
+    else {
+      return failure;
     }
   }
 
+  /// Fills a batch of rectangles with a single call.
   template <typename X>
-  void fill_circle(const basic_point<X>& center, const float radius)
+  auto fill_rects(const basic_rect<X>* rects, const usize count) noexcept -> result
   {
-    const auto cx = static_cast<float>(center.x());
-    const auto cy = static_cast<float>(center.y());
+    if (!rects || count == 0) {
+      return failure;
+    }
 
-    for (auto dy = 1.0f; dy <= radius; dy += 1.0f) {
-      const auto dx = std::floor(std::sqrt((2.0f * radius * dy) - (dy * dy)));
-      draw_line<float>({cx - dx, cy + dy - radius}, {cx + dx, cy + dy - radius});
-      draw_line<float>({cx - dx, cy - dy + radius}, {cx + dx, cy - dy + radius});
+    if (mDamage) {
+      mark_damaged_rects(rects, count);
+    }
+
+    profile_draw(nullptr, count);
+
+    if constexpr (basic_rect<X>::integral) {
+      return SDL_RenderFillRects(get(), rects->data(), static_cast<int>(count)) == 0;
+    }
+    else {
+      return SDL_RenderFillRectsF(get(), rects->data(), static_cast<int>(count)) == 0;
     }
   }
 
+  template <typename Container>
+  auto fill_rects(const Container& container) noexcept -> result
+  {
+    if (!container.empty()) {
+      return fill_rects(&container.front(), container.size());
+    }
+    else {
+      return failure;
+    }
+  }
+
+  /**
+   * Renders the outline of a circle.
+   *
+   * The points of the circle are generated into a scratch buffer that is reused between
+   * calls, and then submitted with a single draw call.
+   *
+   * \return `success` if the circle was rendered, or if it is too small to cover any pixels.
+   */
+  template <typename X>
+  auto draw_circle(const basic_point<X>& position, const float radius) noexcept -> result
+  {
+    using value_t = typename basic_point<X>::value_type;
+
+    auto& points = detail::shape_points();
+    try {
+      detail::make_circle_outline<value_t>(static_cast<float>(position.x()),
+                                           static_cast<float>(position.y()),
+                                           radius,
+                                           points);
+    }
+    catch (const std::bad_alloc&) {
+      return failure;
+    }
+
+    return points.empty() ? success : draw_points(points);
+  }
+
+  /**
+   * Renders a filled circle.
+   *
+   * The circle is decomposed into one-pixel tall spans, which are submitted with a single
+   * draw call.
+   *
+   * \return `success` if the circle was rendered, or if it is too small to cover any pixels.
+   */
+  template <typename X>
+  auto fill_circle(const basic_point<X>& center, const float radius) noexcept -> result
+  {
+    auto& spans = detail::shape_spans();
+    try {
+      detail::make_circle_spans(static_cast<float>(center.x()),
+                                static_cast<float>(center.y()),
+                                radius,
+                                spans);
+    }
+    catch (const std::bad_alloc&) {
+      return failure;
+    }
+
+    return spans.empty() ? success : fill_rects(spans);
+  }
+
+  /**
+   * Renders the outline of an axis-aligned ellipse.
+   *
+   * Like `draw_circle()`, the points are generated into a reused buffer and submitted with a
+   * single draw call.
+   *
+   * \param center the center of the ellipse.
+   * \param radii the horizontal and vertical radii of the ellipse.
+   *
+   * \return `failure` if any of the radii are negative; `success` otherwise.
+   */
+  template <typename X>
+  auto draw_ellipse(const basic_point<X>& center, const farea& radii) noexcept -> result
+  {
+    const auto rx = std::floor(radii.width);
+    const auto ry = std::floor(radii.height);
+
+    if (rx < 0 || ry < 0) {
+      return failure;
+    }
+
+    auto& points = detail::shape_points();
+    try {
+      detail::make_ellipse_outline(static_cast<float>(center.x()),
+                                   static_cast<float>(center.y()),
+                                   rx,
+                                   ry,
+                                   points);
+    }
+    catch (const std::bad_alloc&) {
+      return failure;
+    }
+
+    return points.empty() ? success : draw_points(points);
+  }
+
+  /**
+   * Renders a filled axis-aligned ellipse, as a batch of one-pixel tall spans.
+   *
+   * \param center the center of the ellipse.
+   * \param radii the horizontal and vertical radii of the ellipse.
+   *
+   * \return `failure` if any of the radii are negative; `success` otherwise.
+   */
+  template <typename X>
+  auto fill_ellipse(const basic_point<X>& center, const farea& radii) noexcept -> result
+  {
+    const auto rx = std::floor(radii.width);
+    const auto ry = std::floor(radii.height);
+
+    if (rx < 0 || ry < 0) {
+      return failure;
+    }
+
+    auto& spans = detail::shape_spans();
+    try {
+      detail::make_ellipse_spans(static_cast<float>(center.x()),
+                                 static_cast<float>(center.y()),
+                                 rx,
+                                 ry,
+                                 spans);
+    }
+    catch (const std::bad_alloc&) {
+      return failure;
+    }
+
+    return spans.empty() ? success : fill_rects(spans);
+  }
+
   template <typename X, typename Y>
   auto render(const basic_texture<X>& texture, const basic_point<Y>& pos) noexcept -> result
   {
+    profile_draw(texture.get(), 1);
+
     if constexpr (basic_point<Y>::floating) {
       const auto size = texture.size().as_f();
       const SDL_FRect dst {pos.x(), pos.y(), size.width, size.height};
+      mark_damaged(frect {dst});
       return SDL_RenderCopyF(get(), texture.get(), nullptr, &dst) == 0;
     }
     else {
       const SDL_Rect dst {pos.x(), pos.y(), texture.width(), texture.height()};
+      mark_damaged(irect {dst});
       return SDL_RenderCopy(get(), texture.get(), nullptr, &dst) == 0;
     }
   }
@@ -360,6 +752,9 @@ class basic_renderer final {
   template <typename X, typename Y>
   auto render(const basic_texture<X>& texture, const basic_rect<Y>& dst) noexcept -> result
   {
+    mark_damaged(dst);
+    profile_draw(texture.get(), 1);
+
     if constexpr (basic_rect<Y>::floating) {
       return SDL_RenderCopyF(get(), texture.get(), nullptr, dst.data()) == 0;
     }
@@ -373,6 +768,9 @@ class basic_renderer final {
               const irect& src,
               const basic_rect<Y>& dst) noexcept -> result
   {
+    mark_damaged(dst);
+    profile_draw(texture.get(), 1);
+
     if constexpr (basic_rect<Y>::floating) {
       return SDL_RenderCopyF(get(), texture.get(), src.data(), dst.data()) == 0;
     }
@@ -387,6 +785,13 @@ class basic_renderer final {
               const basic_rect<Y>& dst,
               const double angle) noexcept -> result
   {
+    if (mDamage) {
+      const auto center = dst.center();
+      mark_damaged_rotated(dst, angle, center.x(), center.y());
+    }
+
+    profile_draw(texture.get(), 1);
+
     if constexpr (basic_rect<Y>::floating) {
       return SDL_RenderCopyExF(get(),
                                texture.get(),
@@ -420,6 +825,12 @@ class basic_renderer final {
                   "Destination rectangle and center point must have the same "
                   "value types (int or float)!");
 
+    if (mDamage) {
+      mark_damaged_rotated(dst, angle, dst.x() + center.x(), dst.y() + center.y());
+    }
+
+    profile_draw(texture.get(), 1);
+
     if constexpr (basic_rect<Y>::floating) {
       return SDL_RenderCopyExF(get(),
                                texture.get(),
@@ -445,62 +856,209 @@ class basic_renderer final {
   template <usize Size>
   auto render_geo(bounded_array_ref<const SDL_Vertex, Size> vertices) noexcept -> result
   {
-    return SDL_RenderGeometry(mRenderer,
-                              nullptr,
-                              vertices,
-                              static_cast<int>(Size),
-                              nullptr,
-                              0) == 0;
+    return render_geo(vertices, Size);
   }
 
   template <usize VertexCount, usize IndexCount>
   auto render_geo(bounded_array_ref<const SDL_Vertex, VertexCount> vertices,
                   bounded_array_ref<const int, IndexCount> indices) noexcept -> result
   {
-    static_assert(IndexCount <= VertexCount);
-    return SDL_RenderGeometry(mRenderer,
-                              nullptr,
-                              vertices,
-                              static_cast<int>(VertexCount),
-                              indices,
-                              static_cast<int>(IndexCount)) == 0;
+    return render_geo(vertices, VertexCount, indices, IndexCount);
   }
 
   template <typename X, usize Size>
   auto render_geo(const basic_texture<X>& texture,
                   bounded_array_ref<const SDL_Vertex, Size> vertices) noexcept -> result
   {
+    return render_geo(texture, vertices, Size);
+  }
+
+  template <typename X, usize VertexCount, usize IndexCount>
+  auto render_geo(const basic_texture<X>& texture,
+                  bounded_array_ref<const SDL_Vertex, VertexCount> vertices,
+                  bounded_array_ref<const int, IndexCount> indices) noexcept -> result
+  {
+    return render_geo(texture, vertices, VertexCount, indices, IndexCount);
+  }
+
+  /**
+   * Renders a runtime-sized list of vertices, optionally indexed.
+   *
+   * \param vertices the vertices, interpreted as triangles.
+   * \param vertexCount the amount of vertices.
+   * \param indices optional vertex indices, may be null.
+   * \param indexCount the amount of indices, ignored if there are no indices.
+   */
+  auto render_geo(const SDL_Vertex* vertices,
+                  const usize vertexCount,
+                  const int* indices = nullptr,
+                  const usize indexCount = 0) noexcept -> result
+  {
+    if (mDamage) {
+      mark_damaged_xy(&vertices->position.x, sizeof(SDL_Vertex), vertexCount);
+    }
+
+    profile_draw(nullptr, (indices ? indexCount : vertexCount) / 3);
+
     return SDL_RenderGeometry(mRenderer,
-                              texture.get(),
-                              vertices,
-                              static_cast<int>(Size),
                               nullptr,
-                              0) == 0;
+                              vertices,
+                              static_cast<int>(vertexCount),
+                              indices,
+                              indices ? static_cast<int>(indexCount) : 0) == 0;
   }
 
-  template <typename X, usize VertexCount, usize IndexCount>
+  template <typename X>
   auto render_geo(const basic_texture<X>& texture,
-                  bounded_array_ref<const SDL_Vertex, VertexCount>& vertices,
-                  bounded_array_ref<const int, IndexCount>& indices) noexcept -> result
+                  const SDL_Vertex* vertices,
+                  const usize vertexCount,
+                  const int* indices = nullptr,
+                  const usize indexCount = 0) noexcept -> result
   {
-    static_assert(IndexCount <= VertexCount);
+    if (mDamage) {
+      mark_damaged_xy(&vertices->position.x, sizeof(SDL_Vertex), vertexCount);
+    }
+
+    profile_draw(texture.get(), (indices ? indexCount : vertexCount) / 3);
+
     return SDL_RenderGeometry(mRenderer,
                               texture.get(),
                               vertices,
-                              static_cast<int>(VertexCount),
+                              static_cast<int>(vertexCount),
                               indices,
-                              static_cast<int>(IndexCount)) == 0;
+                              indices ? static_cast<int>(indexCount) : 0) == 0;
+  }
+
+  /// Renders a contiguous container of vertices, such as `std::vector<SDL_Vertex>`.
+  template <typename Container, detail::enable_for_container_of<Container, SDL_Vertex> = 0>
+  auto render_geo(const Container& vertices) noexcept -> result
+  {
+    return render_geo(vertices.data(), vertices.size());
+  }
+
+  template <typename Container,
+            typename Indices,
+            detail::enable_for_container_of<Container, SDL_Vertex> = 0,
+            detail::enable_for_container_of<Indices, int> = 0>
+  auto render_geo(const Container& vertices, const Indices& indices) noexcept -> result
+  {
+    return render_geo(vertices.data(), vertices.size(), indices.data(), indices.size());
+  }
+
+  template <typename X, typename Container, detail::enable_for_container_of<Container, SDL_Vertex> = 0>
+  auto render_geo(const basic_texture<X>& texture, const Container& vertices) noexcept
+      -> result
+  {
+    return render_geo(texture, vertices.data(), vertices.size());
+  }
+
+  template <typename X,
+            typename Container,
+            typename Indices,
+            detail::enable_for_container_of<Container, SDL_Vertex> = 0,
+            detail::enable_for_container_of<Indices, int> = 0>
+  auto render_geo(const basic_texture<X>& texture,
+                  const Container& vertices,
+                  const Indices& indices) noexcept -> result
+  {
+    return render_geo(texture,
+                      vertices.data(),
+                      vertices.size(),
+                      indices.data(),
+                      indices.size());
+  }
+
+  /**
+   * Renders untextured geometry stored in separate, strided arrays.
+   *
+   * Strides are specified in bytes, which makes it possible to submit struct-of-arrays
+   * buffers (or interleaved vertex structs) without copying them into `SDL_Vertex` objects.
+   *
+   * \param xy the first vertex position, stored as two consecutive floats.
+   * \param xyStride the distance between two positions, in bytes.
+   * \param colors the first vertex color.
+   * \param colorStride the distance between two colors, in bytes, may be zero.
+   * \param vertexCount the amount of vertices.
+   * \param indices optional vertex indices, may be null.
+   * \param indexCount the amount of indices, ignored if there are no indices.
+   */
+  template <typename Index = int>
+  auto render_geo_raw(const float* xy,
+                      const int xyStride,
+                      const SDL_Color* colors,
+                      const int colorStride,
+                      const usize vertexCount,
+                      const Index* indices = nullptr,
+                      const usize indexCount = 0) noexcept -> result
+  {
+    return submit_geo_raw(nullptr,
+                          xy,
+                          xyStride,
+                          colors,
+                          colorStride,
+                          nullptr,
+                          0,
+                          vertexCount,
+                          indices,
+                          indexCount);
+  }
+
+  /**
+   * Renders textured geometry stored in separate, strided arrays.
+   *
+   * \param uv the first texture coordinate, stored as two consecutive normalized floats.
+   * \param uvStride the distance between two texture coordinates, in bytes.
+   *
+   * \see render_geo_raw()
+   */
+  template <typename X, typename Index = int>
+  auto render_geo_raw(const basic_texture<X>& texture,
+                      const float* xy,
+                      const int xyStride,
+                      const SDL_Color* colors,
+                      const int colorStride,
+                      const float* uv,
+                      const int uvStride,
+                      const usize vertexCount,
+                      const Index* indices = nullptr,
+                      const usize indexCount = 0) noexcept -> result
+  {
+    return submit_geo_raw(texture.get(),
+                          xy,
+                          xyStride,
+                          colors,
+                          colorStride,
+                          uv,
+                          uvStride,
+                          vertexCount,
+                          indices,
+                          indexCount);
   }
 
 #endif  // SDL_VERSION_ATLEAST(2, 0, 18)
 
-  auto reset_target() noexcept -> result { return SDL_SetRenderTarget(get(), nullptr) == 0; }
+  auto reset_target() noexcept -> result
+  {
+    profile_target(nullptr);
+    const auto result = SDL_SetRenderTarget(get(), nullptr) == 0;
+    if (result) {
+      mRenderingToWindow = true;
+    }
+
+    return result;
+  }
 
   template <typename X>
   auto set_target(basic_texture<X>& target) noexcept -> result
   {
     assert(target.is_target());
-    return SDL_SetRenderTarget(get(), target.get()) == 0;
+    profile_target(target.get());
+    const auto result = SDL_SetRenderTarget(get(), target.get()) == 0;
+    if (result) {
+      mRenderingToWindow = false;
+    }
+
+    return result;
   }
 
   [[nodiscard]] auto get_target() noexcept -> texture_handle
@@ -589,6 +1147,7 @@ class basic_renderer final {
 
   auto set_color(const color& color) noexcept -> result
   {
+    profile_color(color);
     return SDL_SetRenderDrawColor(get(),
                                   color.red(),
                                   color.green(),
@@ -598,6 +1157,7 @@ class basic_renderer final {
 
   auto set_blend_mode(const blend_mode mode) noexcept -> result
   {
+    profile_blend_mode(mode);
     return SDL_SetRenderDrawBlendMode(get(), static_cast<SDL_BlendMode>(mode)) == 0;
   }
 
@@ -692,8 +1252,257 @@ class basic_renderer final {
     return accelerated | vsync;
   }
 
+  /**
+   * Sets the damage tracker that records the areas touched by draw calls.
+   *
+   * Draw calls are only recorded when rendering to the window, not to target textures. This
+   * is usually managed by `damage_tracker::begin_frame()` and `damage_tracker::end_frame()`.
+   *
+   * The render target is tracked by `set_target()` and `reset_target()`, so targets that are
+   * changed by other renderer handles or by calling SDL directly are not accounted for.
+   *
+   * \param tracker the damage tracker, or null to stop recording.
+   */
+  void set_damage_tracker(damage_tracker* tracker) noexcept { mDamage = tracker; }
+
+  [[nodiscard]] auto get_damage_tracker() const noexcept -> damage_tracker* { return mDamage; }
+
+#ifdef CENTURION_ENABLE_RENDER_PROFILER
+
+  /**
+   * Sets the profiler that records the work submitted to the renderer.
+   *
+   * This is only available when `CENTURION_ENABLE_RENDER_PROFILER` is defined, which must be
+   * done consistently for the entire program. Otherwise, renderers are not instrumented at all.
+   *
+   * \param profiler the render profiler, or null to stop recording.
+   */
+  void set_profiler(render_profiler* profiler) noexcept { mProfiler = profiler; }
+
+  [[nodiscard]] auto get_profiler() const noexcept -> render_profiler* { return mProfiler; }
+
+#endif  // CENTURION_ENABLE_RENDER_PROFILER
+
  private:
   detail::pointer<T, SDL_Renderer> mRenderer;
+  damage_tracker* mDamage {};
+  bool mRenderingToWindow {true};  ///< Cached, so that draw calls don't query the target.
+#ifdef CENTURION_ENABLE_RENDER_PROFILER
+  render_profiler* mProfiler {};
+#endif  // CENTURION_ENABLE_RENDER_PROFILER
+
+  /* The profiling functions are empty, and thus free, unless profiling is enabled */
+
+  void profile_draw([[maybe_unused]] const SDL_Texture* texture,
+                    [[maybe_unused]] const usize primitives) const noexcept
+  {
+#ifdef CENTURION_ENABLE_RENDER_PROFILER
+    if (mProfiler) {
+      mProfiler->record_draw(texture, primitives);
+    }
+#endif  // CENTURION_ENABLE_RENDER_PROFILER
+  }
+
+  void profile_upload([[maybe_unused]] const SDL_Surface* source) const noexcept
+  {
+#ifdef CENTURION_ENABLE_RENDER_PROFILER
+    if (mProfiler) {
+      mProfiler->record_upload(static_cast<usize>(source->pitch) *
+                               static_cast<usize>(source->h));
+    }
+#endif  // CENTURION_ENABLE_RENDER_PROFILER
+  }
+
+  void profile_upload([[maybe_unused]] SDL_Texture* texture) const noexcept
+  {
+#ifdef CENTURION_ENABLE_RENDER_PROFILER
+    uint32 format {};
+    int width {};
+    int height {};
+    if (mProfiler && SDL_QueryTexture(texture, &format, nullptr, &width, &height) == 0) {
+      mProfiler->record_upload(detail::texture_bytes(width, height, format));
+    }
+#endif  // CENTURION_ENABLE_RENDER_PROFILER
+  }
+
+  void profile_target([[maybe_unused]] const SDL_Texture* target) const noexcept
+  {
+#ifdef CENTURION_ENABLE_RENDER_PROFILER
+    if (mProfiler) {
+      mProfiler->record_target(target);
+    }
+#endif  // CENTURION_ENABLE_RENDER_PROFILER
+  }
+
+  void profile_color([[maybe_unused]] const color& color) const noexcept
+  {
+#ifdef CENTURION_ENABLE_RENDER_PROFILER
+    if (mProfiler) {
+      mProfiler->record_color(color);
+    }
+#endif  // CENTURION_ENABLE_RENDER_PROFILER
+  }
+
+  void profile_blend_mode([[maybe_unused]] const blend_mode mode) const noexcept
+  {
+#ifdef CENTURION_ENABLE_RENDER_PROFILER
+    if (mProfiler) {
+      mProfiler->record_blend_mode(mode);
+    }
+#endif  // CENTURION_ENABLE_RENDER_PROFILER
+  }
+
+  void profile_frame() const noexcept
+  {
+#ifdef CENTURION_ENABLE_RENDER_PROFILER
+    if (mProfiler) {
+      mProfiler->end_frame();
+    }
+#endif  // CENTURION_ENABLE_RENDER_PROFILER
+  }
+
+  template <typename X>
+  void mark_damaged(const basic_rect<X>& area) noexcept
+  {
+    if (mDamage && mRenderingToWindow) {
+      mDamage->add(area);
+    }
+  }
+
+  template <typename X>
+  void mark_damaged_points(const basic_point<X>* points, const usize count) noexcept
+  {
+    assert(points);
+    assert(count > 0);
+
+    auto minX = static_cast<float>(points[0].x());
+    auto minY = static_cast<float>(points[0].y());
+    auto maxX = minX;
+    auto maxY = minY;
+
+    for (usize index = 1; index < count; ++index) {
+      minX = detail::min(minX, static_cast<float>(points[index].x()));
+      minY = detail::min(minY, static_cast<float>(points[index].y()));
+      maxX = detail::max(maxX, static_cast<float>(points[index].x()));
+      maxY = detail::max(maxY, static_cast<float>(points[index].y()));
+    }
+
+    /* Points cover the pixel to their bottom-right */
+    mark_damaged(frect {minX, minY, maxX - minX + 1, maxY - minY + 1});
+  }
+
+  template <typename X>
+  void mark_damaged_rects(const basic_rect<X>* rects, const usize count) noexcept
+  {
+    assert(rects);
+    assert(count > 0);
+
+    auto minX = static_cast<float>(rects[0].x());
+    auto minY = static_cast<float>(rects[0].y());
+    auto maxX = static_cast<float>(rects[0].max_x());
+    auto maxY = static_cast<float>(rects[0].max_y());
+
+    for (usize index = 1; index < count; ++index) {
+      minX = detail::min(minX, static_cast<float>(rects[index].x()));
+      minY = detail::min(minY, static_cast<float>(rects[index].y()));
+      maxX = detail::max(maxX, static_cast<float>(rects[index].max_x()));
+      maxY = detail::max(maxY, static_cast<float>(rects[index].max_y()));
+    }
+
+    mark_damaged(frect {minX, minY, maxX - minX, maxY - minY});
+  }
+
+  /// Marks the bounds of a rectangle that is rotated clockwise around a pivot.
+  template <typename X>
+  void mark_damaged_rotated(const basic_rect<X>& dst,
+                            const double angle,
+                            const double pivotX,
+                            const double pivotY) noexcept
+  {
+    constexpr double pi = 3.14159265358979323846;
+
+    const auto radians = angle * pi / 180.0;
+    const auto cos = std::cos(radians);
+    const auto sin = std::sin(radians);
+
+    const double xs[] {static_cast<double>(dst.x()), static_cast<double>(dst.max_x())};
+    const double ys[] {static_cast<double>(dst.y()), static_cast<double>(dst.max_y())};
+
+    basic_point<float> corners[4];
+    for (usize index = 0; index < 4; ++index) {
+      const auto dx = xs[index % 2] - pivotX;
+      const auto dy = ys[index / 2] - pivotY;
+      corners[index] = {static_cast<float>(pivotX + dx * cos - dy * sin),
+                        static_cast<float>(pivotY + dx * sin + dy * cos)};
+    }
+
+    mark_damaged_points(corners, 4);
+  }
+
+  /// Marks the bounds of a strided array of vertex positions.
+  void mark_damaged_xy(const float* xy, const usize stride, const usize count) noexcept
+  {
+    if (!xy || count == 0) {
+      return;
+    }
+
+    const auto* bytes = reinterpret_cast<const uint8*>(xy);
+
+    auto minX = xy[0];
+    auto minY = xy[1];
+    auto maxX = minX;
+    auto maxY = minY;
+
+    for (usize index = 1; index < count; ++index) {
+      const auto* pos = reinterpret_cast<const float*>(bytes + index * stride);
+      minX = detail::min(minX, pos[0]);
+      minY = detail::min(minY, pos[1]);
+      maxX = detail::max(maxX, pos[0]);
+      maxY = detail::max(maxY, pos[1]);
+    }
+
+    mark_damaged(frect {minX, minY, maxX - minX, maxY - minY});
+  }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+  template <typename Index>
+  auto submit_geo_raw(SDL_Texture* texture,
+                      const float* xy,
+                      const int xyStride,
+                      const SDL_Color* colors,
+                      const int colorStride,
+                      const float* uv,
+                      const int uvStride,
+                      const usize vertexCount,
+                      const Index* indices,
+                      const usize indexCount) noexcept -> result
+  {
+    static_assert(std::is_integral_v<Index>);
+    static_assert(sizeof(Index) == 1 || sizeof(Index) == 2 || sizeof(Index) == 4,
+                  "Indices must be 8, 16 or 32 bit integers!");
+
+    if (mDamage) {
+      mark_damaged_xy(xy, static_cast<usize>(xyStride), vertexCount);
+    }
+
+    profile_draw(texture, (indices ? indexCount : vertexCount) / 3);
+
+    return SDL_RenderGeometryRaw(mRenderer,
+                                 texture,
+                                 xy,
+                                 xyStride,
+                                 colors,
+                                 colorStride,
+                                 uv,
+                                 uvStride,
+                                 static_cast<int>(vertexCount),
+                                 indices,
+                                 indices ? static_cast<int>(indexCount) : 0,
+                                 static_cast<int>(sizeof(Index))) == 0;
+  }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
 };
 
 template <typename T>
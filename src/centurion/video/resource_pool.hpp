@@ -0,0 +1,516 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_RESOURCE_POOL_HPP_
+#define CENTURION_VIDEO_RESOURCE_POOL_HPP_
+
+#include <SDL.h>
+
+#include <cassert>  // assert
+#include <map>      // map
+#include <tuple>    // tuple
+#include <utility>  // move, exchange
+#include <vector>   // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "renderer.hpp"
+#include "surface.hpp"
+#include "texture.hpp"
+
+namespace cen {
+
+/// Provides statistics about the resources of a surface or texture pool.
+struct pool_stats final {
+  usize requests {};      ///< The amount of leases that were requested.
+  usize reuses {};        ///< The amount of leases that recycled an idle resource.
+  usize allocations {};   ///< The amount of resources that were created.
+  usize discards {};      ///< The amount of returned resources that exceeded the idle budget.
+  usize leased {};        ///< The amount of resources that are currently leased.
+  usize idle {};          ///< The amount of resources that are waiting to be reused.
+  usize leased_bytes {};  ///< The estimated memory used by leased resources.
+  usize idle_bytes {};    ///< The estimated memory used by idle resources.
+  usize peak_leased {};   ///< The maximum amount of simultaneously leased resources.
+  usize peak_bytes {};    ///< The maximum estimated memory used by leased and idle resources.
+
+  /// Returns the ratio of requests that were served by recycled resources, in [0, 1].
+  [[nodiscard]] auto reuse_rate() const noexcept -> double
+  {
+    return (requests != 0) ? static_cast<double>(reuses) / static_cast<double>(requests) : 0.0;
+  }
+};
+
+namespace detail {
+
+/// Keeps the idle resources of a pool, grouped by key, along with their statistics.
+template <typename Key, typename Resource>
+class pool_storage final {
+ public:
+  explicit pool_storage(const usize budget) noexcept : mBudget {budget} {}
+
+  /// Returns an idle resource with the specified key, if there is one.
+  auto take(const Key& key) -> maybe<Resource>
+  {
+    ++mStats.requests;
+
+    const auto it = mBuckets.find(key);
+    if (it == mBuckets.end() || it->second.idle.empty()) {
+      return nothing;
+    }
+
+    auto& bucket = it->second;
+
+    maybe<Resource> resource {std::move(bucket.idle.back())};
+    bucket.idle.pop_back();
+
+    --mStats.idle;
+    mStats.idle_bytes -= bucket.bytes;
+    ++mStats.reuses;
+    lease(bucket.bytes);
+
+    return resource;
+  }
+
+  /// Accounts for a newly created resource that is leased immediately.
+  void add(const Key& key, const usize bytes)
+  {
+    auto& bucket = mBuckets[key];
+    bucket.bytes = bytes;
+
+    /* Every live resource with the key fits among the idle ones, so give_back never allocates */
+    bucket.idle.reserve(bucket.live + 1);
+    ++bucket.live;
+
+    ++mStats.allocations;
+    lease(bytes);
+  }
+
+  /// Returns a leased resource, which is released if it does not fit in the idle budget.
+  void give_back(const Key& key, Resource&& resource) noexcept
+  {
+    const auto it = mBuckets.find(key);
+    assert(it != mBuckets.end());
+
+    auto& bucket = it->second;
+
+    assert(mStats.leased > 0);
+    --mStats.leased;
+    mStats.leased_bytes -= bucket.bytes;
+
+    if (mStats.idle_bytes + bucket.bytes > mBudget) {
+      --bucket.live;
+      ++mStats.discards;
+      return;
+    }
+
+    bucket.idle.push_back(std::move(resource));
+    ++mStats.idle;
+    mStats.idle_bytes += bucket.bytes;
+  }
+
+  /// Releases idle resources until the idle memory fits in the budget.
+  void trim() noexcept
+  {
+    for (auto& [key, bucket] : mBuckets) {
+      while (mStats.idle_bytes > mBudget && !bucket.idle.empty()) {
+        bucket.idle.pop_back();
+        --bucket.live;
+        --mStats.idle;
+        mStats.idle_bytes -= bucket.bytes;
+      }
+    }
+  }
+
+  void release_idle() noexcept
+  {
+    for (auto& [key, bucket] : mBuckets) {
+      bucket.live -= bucket.idle.size();
+      bucket.idle.clear();
+    }
+
+    mStats.idle = 0;
+    mStats.idle_bytes = 0;
+  }
+
+  void set_budget(const usize bytes) noexcept
+  {
+    mBudget = bytes;
+    trim();
+  }
+
+  void reset_stats() noexcept
+  {
+    mStats.requests = 0;
+    mStats.reuses = 0;
+    mStats.allocations = 0;
+    mStats.discards = 0;
+    mStats.peak_leased = mStats.leased;
+    mStats.peak_bytes = mStats.leased_bytes + mStats.idle_bytes;
+  }
+
+  [[nodiscard]] auto budget() const noexcept -> usize { return mBudget; }
+
+  [[nodiscard]] auto stats() const noexcept -> const pool_stats& { return mStats; }
+
+ private:
+  struct bucket final {
+    usize bytes {};    ///< The estimated size of each resource with the key.
+    usize live {};     ///< The amount of leased and idle resources with the key.
+    std::vector<Resource> idle;
+  };
+
+  std::map<Key, bucket> mBuckets;
+  pool_stats mStats;
+  usize mBudget {};
+
+  void lease(const usize bytes) noexcept
+  {
+    ++mStats.leased;
+    mStats.leased_bytes += bytes;
+
+    mStats.peak_leased = detail::max(mStats.peak_leased, mStats.leased);
+    mStats.peak_bytes = detail::max(mStats.peak_bytes, mStats.leased_bytes + mStats.idle_bytes);
+  }
+};
+
+}  // namespace detail
+
+/**
+ * A move-only handle to a resource borrowed from a pool.
+ *
+ * The resource is returned to the pool when the lease is destroyed or reset, after which it
+ * may be handed out again. Leases must not outlive their pool.
+ *
+ * \see surface_lease
+ * \see texture_lease
+ */
+template <typename Pool>
+class basic_pool_lease final {
+  friend Pool;
+
+ public:
+  using resource_type = typename Pool::resource_type;
+  using key_type = typename Pool::key_type;
+
+  basic_pool_lease() noexcept = default;
+
+  CENTURION_DISABLE_COPY(basic_pool_lease)
+
+  basic_pool_lease(basic_pool_lease&& other) noexcept
+      : mPool {std::exchange(other.mPool, nullptr)}
+      , mKey {other.mKey}
+      , mResource {std::move(other.mResource)}
+      , mSize {other.mSize}
+  {
+    other.mResource.reset();
+  }
+
+  ~basic_pool_lease() noexcept { reset(); }
+
+  auto operator=(basic_pool_lease&& other) noexcept -> basic_pool_lease&
+  {
+    if (this != &other) {
+      reset();
+
+      mPool = std::exchange(other.mPool, nullptr);
+      mKey = other.mKey;
+      mResource = std::move(other.mResource);
+      mSize = other.mSize;
+
+      other.mResource.reset();
+    }
+
+    return *this;
+  }
+
+  /// Returns the resource to its pool.
+  void reset() noexcept
+  {
+    if (mPool) {
+      mPool->recycle(mKey, std::move(*mResource));
+      mResource.reset();
+      mPool = nullptr;
+    }
+  }
+
+  [[nodiscard]] auto get() noexcept -> resource_type&
+  {
+    assert(mResource);
+    return *mResource;
+  }
+
+  [[nodiscard]] auto get() const noexcept -> const resource_type&
+  {
+    assert(mResource);
+    return *mResource;
+  }
+
+  /// Returns the requested size, which may be smaller than the size of the resource.
+  [[nodiscard]] auto size() const noexcept -> iarea { return mSize; }
+
+  /// Indicates whether the lease holds a resource.
+  explicit operator bool() const noexcept { return mPool != nullptr; }
+
+ private:
+  Pool* mPool {};
+  key_type mKey {};
+  maybe<resource_type> mResource;
+  iarea mSize {};
+
+  basic_pool_lease(Pool* pool, const key_type& key, resource_type&& resource, const iarea size)
+      : mPool {pool}
+      , mKey {key}
+      , mResource {std::move(resource)}
+      , mSize {size}
+  {
+  }
+};
+
+class surface_pool;
+class texture_pool;
+
+using surface_lease = basic_pool_lease<surface_pool>;
+using texture_lease = basic_pool_lease<texture_pool>;
+
+/**
+ * Recycles scratch surfaces, to avoid allocating pixel memory for short-lived surfaces.
+ *
+ * Surfaces are grouped by size class and pixel format. The width and height of a request are
+ * rounded up to their size class, so that similarly sized requests share surfaces. Leased
+ * surfaces have their clip rectangle set to the requested size, which confines blits to it.
+ *
+ * Idle surfaces are kept as long as they fit in the idle budget, surfaces returned beyond
+ * that are released immediately.
+ *
+ * \note Recycled surfaces keep their previous contents, and are not cleared. However, their
+ * blend mode, color and alpha modulation, color key and RLE acceleration are reset to the
+ * defaults of new surfaces when they are returned.
+ *
+ * \see surface_lease
+ */
+class surface_pool final {
+  friend surface_lease;
+
+ public:
+  using resource_type = surface;
+  using key_type = std::tuple<int, int, uint32>;  ///< Class width, class height and format.
+
+  /**
+   * Creates a surface pool.
+   *
+   * \param budget the maximum estimated memory used by idle surfaces, in bytes.
+   */
+  explicit surface_pool(const usize budget = 32u * 1'024u * 1'024u) noexcept
+      : mStorage {budget}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(surface_pool)
+  CENTURION_DISABLE_MOVE(surface_pool)
+
+  ~surface_pool() noexcept { assert(mStorage.stats().leased == 0); }
+
+  /**
+   * Leases a surface that is at least as large as the requested size.
+   *
+   * \param size the requested size, must be greater than zero.
+   * \param format the pixel format of the surface.
+   *
+   * \return a lease of a surface with the size class of the requested size.
+   *
+   * \throws sdl_error if a new surface cannot be created.
+   */
+  [[nodiscard]] auto acquire(const iarea& size,
+                             const pixel_format format = pixel_format::rgba32) -> surface_lease
+  {
+    assert(size.width > 0);
+    assert(size.height > 0);
+
+    const key_type key {size_class(size.width), size_class(size.height), to_underlying(format)};
+
+    auto image = mStorage.take(key);
+    if (!image) {
+      image.emplace(iarea {std::get<0>(key), std::get<1>(key)}, format);
+      mStorage.add(key,
+                   static_cast<usize>(image->pitch()) * static_cast<usize>(image->height()));
+    }
+
+    const SDL_Rect clip {0, 0, size.width, size.height};
+    SDL_SetClipRect(image->get(), &clip);
+
+    return surface_lease {this, key, std::move(*image), size};
+  }
+
+  /// Releases all idle surfaces.
+  void release_idle() noexcept { mStorage.release_idle(); }
+
+  /// Sets the idle budget, and releases idle surfaces that exceed it.
+  void set_budget(const usize bytes) noexcept { mStorage.set_budget(bytes); }
+
+  [[nodiscard]] auto budget() const noexcept -> usize { return mStorage.budget(); }
+
+  [[nodiscard]] auto stats() const noexcept -> const pool_stats& { return mStorage.stats(); }
+
+  /// Resets the request, reuse, allocation and discard counters, and the peak values.
+  void reset_stats() noexcept { mStorage.reset_stats(); }
+
+  /**
+   * Returns the size class of a surface dimension.
+   *
+   * Dimensions are rounded up to a multiple of a quarter of the preceding power of two, which
+   * wastes at most 25% of each dimension, with a minimum of 16 pixels.
+   */
+  [[nodiscard]] constexpr static auto size_class(const int length) noexcept -> int
+  {
+    if (length <= 16) {
+      return 16;
+    }
+
+    auto power = 16;
+    while (power * 2 < length) {
+      power *= 2;
+    }
+
+    const auto step = power / 4;
+    return (length + step - 1) / step * step;
+  }
+
+ private:
+  detail::pool_storage<key_type, surface> mStorage;
+
+  void recycle(const key_type& key, surface&& image) noexcept
+  {
+    auto* ptr = image.get();
+
+    const auto hasAlpha = ptr->format->Amask != 0;
+    SDL_SetSurfaceBlendMode(ptr, hasAlpha ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+    SDL_SetSurfaceColorMod(ptr, 0xFF, 0xFF, 0xFF);
+    SDL_SetSurfaceAlphaMod(ptr, 0xFF);
+    SDL_SetColorKey(ptr, SDL_FALSE, 0);
+    SDL_SetSurfaceRLE(ptr, 0);
+
+    mStorage.give_back(key, std::move(image));
+  }
+};
+
+/**
+ * Recycles textures, intended for transient render targets such as post-processing buffers.
+ *
+ * Textures are grouped by their exact size, pixel format and access, so leased textures can
+ * be used as render targets without adjusting for a size class.
+ *
+ * \note Recycled textures keep their previous contents, and are not cleared. However, their
+ * blend mode and color and alpha modulation are reset to the defaults of new textures when
+ * they are returned.
+ *
+ * \see texture_lease
+ */
+class texture_pool final {
+  friend texture_lease;
+
+ public:
+  using resource_type = texture;
+  using key_type = std::tuple<int, int, uint32, int>;  ///< Width, height, format and access.
+
+  /**
+   * Creates a texture pool.
+   *
+   * \param renderer the renderer used to create textures, must outlive the pool.
+   * \param budget the maximum estimated memory used by idle textures, in bytes.
+   */
+  template <typename T>
+  explicit texture_pool(const basic_renderer<T>& renderer,
+                        const usize budget = 64u * 1'024u * 1'024u) noexcept
+      : mRenderer {renderer.get()}
+      , mStorage {budget}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(texture_pool)
+  CENTURION_DISABLE_MOVE(texture_pool)
+
+  ~texture_pool() noexcept { assert(mStorage.stats().leased == 0); }
+
+  /**
+   * Leases a texture.
+   *
+   * \param size the size of the texture, must be greater than zero.
+   * \param format the pixel format of the texture.
+   * \param access the access of the texture, render targets by default.
+   *
+   * \return a lease of a texture with the exact requested properties.
+   *
+   * \throws sdl_error if a new texture cannot be created.
+   */
+  [[nodiscard]] auto acquire(const iarea& size,
+                             const pixel_format format = pixel_format::rgba8888,
+                             const texture_access access = texture_access::target)
+      -> texture_lease
+  {
+    assert(size.width > 0);
+    assert(size.height > 0);
+
+    const key_type key {size.width, size.height, to_underlying(format), to_underlying(access)};
+
+    auto image = mStorage.take(key);
+    if (!image) {
+      image.emplace(mRenderer.make_texture(size, format, access));
+      mStorage.add(key, detail::texture_bytes(size.width, size.height, to_underlying(format)));
+    }
+
+    return texture_lease {this, key, std::move(*image), size};
+  }
+
+  /// Releases all idle textures.
+  void release_idle() noexcept { mStorage.release_idle(); }
+
+  /// Sets the idle budget, and releases idle textures that exceed it.
+  void set_budget(const usize bytes) noexcept { mStorage.set_budget(bytes); }
+
+  [[nodiscard]] auto budget() const noexcept -> usize { return mStorage.budget(); }
+
+  [[nodiscard]] auto stats() const noexcept -> const pool_stats& { return mStorage.stats(); }
+
+  /// Resets the request, reuse, allocation and discard counters, and the peak values.
+  void reset_stats() noexcept { mStorage.reset_stats(); }
+
+ private:
+  renderer_handle mRenderer;
+  detail::pool_storage<key_type, texture> mStorage;
+
+  void recycle(const key_type& key, texture&& image) noexcept
+  {
+    SDL_SetTextureBlendMode(image.get(), SDL_BLENDMODE_NONE);
+    SDL_SetTextureColorMod(image.get(), 0xFF, 0xFF, 0xFF);
+    SDL_SetTextureAlphaMod(image.get(), 0xFF);
+
+    mStorage.give_back(key, std::move(image));
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_RESOURCE_POOL_HPP_
@@ -0,0 +1,838 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_SHAPES_HPP_
+#define CENTURION_VIDEO_SHAPES_HPP_
+
+#include <SDL.h>
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+#include <cassert>        // assert
+#include <cmath>          // sqrt, cos, sin, atan2, ceil, abs
+#include <cstring>        // memcpy
+#include <functional>     // hash
+#include <iterator>       // prev
+#include <list>           // list
+#include <ostream>        // ostream
+#include <string_view>    // string_view
+#include <unordered_map>  // unordered_map
+#include <utility>        // move
+#include <vector>         // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "color.hpp"
+#include "renderer.hpp"
+
+namespace cen {
+
+/// Determines how the segments of thick polylines are connected.
+enum class line_join {
+  miter,  ///< Segments are extended until their edges meet, limited by the miter limit.
+  bevel,  ///< The outer corner is cut off.
+  round   ///< The outer corner is rounded.
+};
+
+[[nodiscard]] constexpr auto to_string(const line_join join) -> std::string_view
+{
+  switch (join) {
+    case line_join::miter:
+      return "miter";
+
+    case line_join::bevel:
+      return "bevel";
+
+    case line_join::round:
+      return "round";
+
+    default:
+      throw exception {"Did not recognize line join!"};
+  }
+}
+
+inline auto operator<<(std::ostream& stream, const line_join join) -> std::ostream&
+{
+  return stream << to_string(join);
+}
+
+/**
+ * A list of colored triangles that approximates one or more shapes.
+ *
+ * Shapes are tessellated on the CPU into an indexed triangle list, which is submitted with a
+ * single call to `SDL_RenderGeometry`. Meshes of static shapes can be kept around and
+ * rendered every frame without being tessellated again, see `shape_cache`.
+ *
+ * \see shape_cache
+ * \see basic_renderer::render_geo()
+ */
+class shape_mesh final {
+ public:
+  /// The maximum ratio between the miter length and the half thickness of a line.
+  inline constexpr static float miter_limit = 4.0f;
+
+  void add_triangle(const fpoint& a, const fpoint& b, const fpoint& c, const color& color)
+  {
+    const auto base = static_cast<int>(mVertices.size());
+    push_vertex(a.x(), a.y(), color);
+    push_vertex(b.x(), b.y(), color);
+    push_vertex(c.x(), c.y(), color);
+    mIndices.insert(mIndices.end(), {base, base + 1, base + 2});
+  }
+
+  /**
+   * Adds a filled simple polygon, which may be concave.
+   *
+   * The polygon is triangulated with ear clipping. The vertices may be in either winding
+   * order, but the edges must not intersect each other.
+   *
+   * \param points the vertices of the polygon.
+   * \param count the amount of vertices, at least three.
+   * \param color the fill color.
+   *
+   * \return `success` if the polygon was triangulated; `failure` otherwise.
+   */
+  auto add_polygon(const fpoint* points, const usize count, const color& color) -> result
+  {
+    if (!points || count < 3) {
+      return failure;
+    }
+
+    const auto base = static_cast<int>(mVertices.size());
+    for (usize i = 0; i < count; ++i) {
+      push_vertex(points[i].x(), points[i].y(), color);
+    }
+
+    triangulate(points, count, base);
+    return success;
+  }
+
+  template <typename Container>
+  auto add_polygon(const Container& points, const color& color) -> result
+  {
+    return add_polygon(points.data(), points.size(), color);
+  }
+
+  /**
+   * Adds a line strip with a thickness.
+   *
+   * The ends of open polylines are cut off squarely at the first and last points.
+   * Consecutive duplicate points are ignored.
+   *
+   * \param points the points of the polyline.
+   * \param count the amount of points, at least two.
+   * \param thickness the thickness of the line, in pixels.
+   * \param color the line color.
+   * \param join the style of the joints between segments.
+   * \param closed `true` if the last point should be connected to the first point.
+   *
+   * \return `success` if the polyline was tessellated; `failure` otherwise.
+   */
+  auto add_polyline(const fpoint* points,
+                    const usize count,
+                    const float thickness,
+                    const color& color,
+                    const line_join join = line_join::miter,
+                    const bool closed = false) -> result
+  {
+    if (!points || thickness <= 0) {
+      return failure;
+    }
+
+    mScratch.clear();
+    for (usize i = 0; i < count; ++i) {
+      const SDL_FPoint point {points[i].x(), points[i].y()};
+      if (mScratch.empty() || !same_point(mScratch.back(), point)) {
+        mScratch.push_back(point);
+      }
+    }
+
+    if (closed && mScratch.size() > 2 && same_point(mScratch.front(), mScratch.back())) {
+      mScratch.pop_back();
+    }
+
+    const auto n = mScratch.size();
+    if (n < 2) {
+      return failure;
+    }
+
+    const auto hw = thickness / 2.0f;
+    const auto segments = closed ? n : n - 1;
+
+    for (usize i = 0; i < segments; ++i) {
+      const auto& a = mScratch[i];
+      const auto& b = mScratch[(i + 1) % n];
+      const auto normal = unit_normal(a, b);
+
+      const auto base = static_cast<int>(mVertices.size());
+      push_vertex(a.x + normal.x * hw, a.y + normal.y * hw, color);
+      push_vertex(b.x + normal.x * hw, b.y + normal.y * hw, color);
+      push_vertex(b.x - normal.x * hw, b.y - normal.y * hw, color);
+      push_vertex(a.x - normal.x * hw, a.y - normal.y * hw, color);
+      mIndices.insert(mIndices.end(), {base, base + 1, base + 2, base + 2, base + 3, base});
+    }
+
+    const auto first = closed ? usize {0} : usize {1};
+    const auto last = closed ? n : n - 1;
+
+    for (usize i = first; i < last; ++i) {
+      const auto& prev = mScratch[(i + n - 1) % n];
+      const auto& point = mScratch[i];
+      const auto& next = mScratch[(i + 1) % n];
+      add_join(prev, point, next, hw, color, join);
+    }
+
+    return success;
+  }
+
+  template <typename Container>
+  auto add_polyline(const Container& points,
+                    const float thickness,
+                    const color& color,
+                    const line_join join = line_join::miter,
+                    const bool closed = false) -> result
+  {
+    return add_polyline(points.data(), points.size(), thickness, color, join, closed);
+  }
+
+  /**
+   * Adds a filled axis-aligned ellipse.
+   *
+   * \param center the center of the ellipse.
+   * \param radii the horizontal and vertical radii.
+   * \param color the fill color.
+   * \param segments the amount of segments, zero to pick an amount based on the size.
+   */
+  void add_ellipse(const fpoint& center,
+                   const farea& radii,
+                   const color& color,
+                   const usize segments = 0)
+  {
+    const auto n = segments ? detail::max(segments, usize {3}) : segments_for(radii);
+
+    const auto base = static_cast<int>(mVertices.size());
+    push_vertex(center.x(), center.y(), color);
+
+    for (usize i = 0; i < n; ++i) {
+      const auto angle = tau * static_cast<float>(i) / static_cast<float>(n);
+      push_vertex(center.x() + radii.width * std::cos(angle),
+                  center.y() + radii.height * std::sin(angle),
+                  color);
+    }
+
+    add_fan(base, n);
+  }
+
+  /// Adds the outline of an axis-aligned ellipse, centered on the ellipse edge.
+  auto add_ellipse_outline(const fpoint& center,
+                           const farea& radii,
+                           const float thickness,
+                           const color& color,
+                           const usize segments = 0) -> result
+  {
+    const auto n = segments ? detail::max(segments, usize {3}) : segments_for(radii);
+
+    mOutline.clear();
+    for (usize i = 0; i < n; ++i) {
+      const auto angle = tau * static_cast<float>(i) / static_cast<float>(n);
+      mOutline.emplace_back(center.x() + radii.width * std::cos(angle),
+                            center.y() + radii.height * std::sin(angle));
+    }
+
+    return add_polyline(mOutline, thickness, color, line_join::miter, true);
+  }
+
+  /**
+   * Adds a filled rectangle with rounded corners.
+   *
+   * \param rect the bounds of the rectangle.
+   * \param radius the corner radius, clamped to half of the smallest side.
+   * \param color the fill color.
+   * \param segments the amount of segments per corner, zero to pick an amount based on the
+   * radius.
+   */
+  void add_rounded_rect(const frect& rect,
+                        const float radius,
+                        const color& color,
+                        const usize segments = 0)
+  {
+    rounded_rect_outline(rect, radius, segments);
+
+    const auto base = static_cast<int>(mVertices.size());
+    push_vertex(rect.center_x(), rect.center_y(), color);
+
+    for (const auto& point : mOutline) {
+      push_vertex(point.x(), point.y(), color);
+    }
+
+    add_fan(base, mOutline.size());
+  }
+
+  /// Adds the outline of a rectangle with rounded corners, centered on the rectangle edge.
+  auto add_rounded_rect_outline(const frect& rect,
+                                const float radius,
+                                const float thickness,
+                                const color& color,
+                                const usize segments = 0) -> result
+  {
+    rounded_rect_outline(rect, radius, segments);
+    return add_polyline(mOutline, thickness, color, line_join::miter, true);
+  }
+
+  /// Renders the mesh with a single geometry call.
+  template <typename T>
+  auto render(basic_renderer<T>& renderer) const noexcept -> result
+  {
+    if (mIndices.empty()) {
+      return success;
+    }
+
+    return renderer.render_geo(mVertices.data(),
+                               mVertices.size(),
+                               mIndices.data(),
+                               mIndices.size());
+  }
+
+  /// Reserves space for the specified amount of vertices and indices.
+  void reserve(const usize vertices, const usize indices)
+  {
+    mVertices.reserve(vertices);
+    mIndices.reserve(indices);
+  }
+
+  /// Removes all triangles, without releasing the allocated memory.
+  void clear() noexcept
+  {
+    mVertices.clear();
+    mIndices.clear();
+  }
+
+  [[nodiscard]] auto vertices() const noexcept -> const std::vector<SDL_Vertex>&
+  {
+    return mVertices;
+  }
+
+  [[nodiscard]] auto indices() const noexcept -> const std::vector<int>& { return mIndices; }
+
+  [[nodiscard]] auto vertex_count() const noexcept -> usize { return mVertices.size(); }
+
+  [[nodiscard]] auto triangle_count() const noexcept -> usize { return mIndices.size() / 3u; }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mIndices.empty(); }
+
+ private:
+  inline constexpr static float tau = 6.28318530717958647692f;
+
+  std::vector<SDL_Vertex> mVertices;
+  std::vector<int> mIndices;
+  std::vector<SDL_FPoint> mScratch;  ///< Deduplicated polyline points.
+  std::vector<fpoint> mOutline;      ///< Generated outlines of curved shapes.
+  std::vector<int> mRemaining;       ///< Polygon vertices that have not been clipped yet.
+
+  void push_vertex(const float x, const float y, const color& color)
+  {
+    mVertices.push_back(SDL_Vertex {{x, y}, color.get(), {0, 0}});
+  }
+
+  /// Adds triangles between a center vertex and the following ring of vertices.
+  void add_fan(const int center, const usize count)
+  {
+    const auto n = static_cast<int>(count);
+    for (int i = 0; i < n; ++i) {
+      mIndices.insert(mIndices.end(), {center, center + 1 + i, center + 1 + ((i + 1) % n)});
+    }
+  }
+
+  [[nodiscard]] static auto same_point(const SDL_FPoint& a, const SDL_FPoint& b) noexcept
+      -> bool
+  {
+    return a.x == b.x && a.y == b.y;
+  }
+
+  [[nodiscard]] static auto cross(const fpoint& a, const fpoint& b, const fpoint& c) noexcept
+      -> float
+  {
+    return (b.x() - a.x()) * (c.y() - a.y()) - (b.y() - a.y()) * (c.x() - a.x());
+  }
+
+  [[nodiscard]] static auto unit_normal(const SDL_FPoint& a, const SDL_FPoint& b) noexcept
+      -> SDL_FPoint
+  {
+    const auto dx = b.x - a.x;
+    const auto dy = b.y - a.y;
+    const auto length = std::sqrt(dx * dx + dy * dy);
+    return {-dy / length, dx / length};
+  }
+
+  [[nodiscard]] static auto segments_for(const farea& radii) noexcept -> usize
+  {
+    // Aim for segments that are roughly four pixels long
+    const auto radius = std::sqrt((radii.width * radii.width + radii.height * radii.height) / 2);
+    const auto segments = static_cast<usize>(std::ceil(tau * radius / 4.0f));
+    return detail::clamp(segments, usize {12}, usize {256});
+  }
+
+  /// Triangulates a polygon whose vertices were pushed starting at the base index.
+  void triangulate(const fpoint* points, const usize count, const int base)
+  {
+    float area = 0;
+    for (usize i = 0; i < count; ++i) {
+      const auto& a = points[i];
+      const auto& b = points[(i + 1) % count];
+      area += a.x() * b.y() - b.x() * a.y();
+    }
+
+    const auto orientation = (area >= 0) ? 1.0f : -1.0f;
+
+    mRemaining.clear();
+    for (usize i = 0; i < count; ++i) {
+      mRemaining.push_back(static_cast<int>(i));
+    }
+
+    usize i = 0;
+    usize attempts = 0;
+    while (mRemaining.size() > 3) {
+      const auto n = mRemaining.size();
+      const auto prev = mRemaining[(i + n - 1) % n];
+      const auto curr = mRemaining[i % n];
+      const auto next = mRemaining[(i + 1) % n];
+
+      if (is_ear(points, prev, curr, next, orientation)) {
+        mIndices.insert(mIndices.end(), {base + prev, base + curr, base + next});
+        mRemaining.erase(mRemaining.begin() + static_cast<std::ptrdiff_t>(i % n));
+        attempts = 0;
+      }
+      else if (++attempts > n) {
+        /* Degenerate or self-intersecting polygon, fill the remainder as a fan */
+        break;
+      }
+      else {
+        ++i;
+      }
+
+      i %= mRemaining.size();
+    }
+
+    for (usize j = 1; j + 1 < mRemaining.size(); ++j) {
+      mIndices.insert(mIndices.end(),
+                      {base + mRemaining[0], base + mRemaining[j], base + mRemaining[j + 1]});
+    }
+  }
+
+  [[nodiscard]] auto is_ear(const fpoint* points,
+                            const int prev,
+                            const int curr,
+                            const int next,
+                            const float orientation) const noexcept -> bool
+  {
+    const auto& a = points[prev];
+    const auto& b = points[curr];
+    const auto& c = points[next];
+
+    if (cross(a, b, c) * orientation <= 0) {
+      return false;  // Reflex or collinear vertex
+    }
+
+    for (const auto index : mRemaining) {
+      if (index == prev || index == curr || index == next) {
+        continue;
+      }
+
+      const auto& p = points[index];
+      if (cross(a, b, p) * orientation >= 0 && cross(b, c, p) * orientation >= 0 &&
+          cross(c, a, p) * orientation >= 0) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  void add_join(const SDL_FPoint& prev,
+                const SDL_FPoint& point,
+                const SDL_FPoint& next,
+                const float hw,
+                const color& color,
+                const line_join join)
+  {
+    const auto n0 = unit_normal(prev, point);
+    const auto n1 = unit_normal(point, next);
+
+    const auto turn = (point.x - prev.x) * (next.y - point.y) -
+                      (point.y - prev.y) * (next.x - point.x);
+    if (turn == 0) {
+      return;  // Straight or reversed, the segment quads already meet
+    }
+
+    /* The gap to fill is on the outside of the turn */
+    const auto side = (turn > 0) ? -1.0f : 1.0f;
+
+    const SDL_FPoint a {point.x + n0.x * hw * side, point.y + n0.y * hw * side};
+    const SDL_FPoint b {point.x + n1.x * hw * side, point.y + n1.y * hw * side};
+
+    const auto base = static_cast<int>(mVertices.size());
+    push_vertex(point.x, point.y, color);
+    push_vertex(a.x, a.y, color);
+
+    if (join == line_join::round) {
+      const auto from = std::atan2(a.y - point.y, a.x - point.x);
+      auto sweep = std::atan2(b.y - point.y, b.x - point.x) - from;
+
+      if (sweep > tau / 2) {
+        sweep -= tau;
+      }
+      else if (sweep < -tau / 2) {
+        sweep += tau;
+      }
+
+      const auto steps = detail::max(usize {1},
+                                     static_cast<usize>(std::ceil(std::abs(sweep) * hw / 4.0f)));
+      for (usize i = 1; i <= steps; ++i) {
+        const auto angle = from + sweep * static_cast<float>(i) / static_cast<float>(steps);
+        push_vertex(point.x + hw * std::cos(angle), point.y + hw * std::sin(angle), color);
+        mIndices.insert(mIndices.end(),
+                        {base, base + static_cast<int>(i), base + static_cast<int>(i) + 1});
+      }
+
+      return;
+    }
+
+    push_vertex(b.x, b.y, color);
+    mIndices.insert(mIndices.end(), {base, base + 1, base + 2});
+
+    if (join == line_join::miter) {
+      const SDL_FPoint sum {n0.x + n1.x, n0.y + n1.y};
+      const auto length = std::sqrt(sum.x * sum.x + sum.y * sum.y);
+      if (length == 0) {
+        return;
+      }
+
+      const SDL_FPoint miter {sum.x / length, sum.y / length};
+      const auto ratio = 1.0f / (miter.x * n0.x + miter.y * n0.y);
+
+      if (ratio <= miter_limit) {
+        push_vertex(point.x + miter.x * hw * ratio * side,
+                    point.y + miter.y * hw * ratio * side,
+                    color);
+        mIndices.insert(mIndices.end(), {base + 1, base + 3, base + 2});
+      }
+    }
+  }
+
+  /// Generates the clockwise outline of a rounded rectangle into the outline buffer.
+  void rounded_rect_outline(const frect& rect, const float radius, const usize segments)
+  {
+    const auto r = detail::clamp(radius, 0.0f, detail::min(rect.width(), rect.height()) / 2);
+
+    mOutline.clear();
+
+    if (r <= 0) {
+      mOutline.emplace_back(rect.x(), rect.y());
+      mOutline.emplace_back(rect.max_x(), rect.y());
+      mOutline.emplace_back(rect.max_x(), rect.max_y());
+      mOutline.emplace_back(rect.x(), rect.max_y());
+      return;
+    }
+
+    const auto steps = segments ? segments : detail::max(segments_for({r, r}) / 4u, usize {2});
+
+    const SDL_FPoint centers[] {{rect.max_x() - r, rect.y() + r},
+                                {rect.max_x() - r, rect.max_y() - r},
+                                {rect.x() + r, rect.max_y() - r},
+                                {rect.x() + r, rect.y() + r}};
+
+    for (usize corner = 0; corner < 4; ++corner) {
+      const auto start = tau * (static_cast<float>(corner) - 1.0f) / 4.0f;
+      for (usize i = 0; i <= steps; ++i) {
+        const auto t = static_cast<float>(i) / static_cast<float>(steps);
+        const auto angle = start + (tau / 4.0f) * t;
+        mOutline.emplace_back(centers[corner].x + r * std::cos(angle),
+                              centers[corner].y + r * std::sin(angle));
+      }
+    }
+  }
+};
+
+/// Provides statistics about the meshes stored in a shape cache.
+struct shape_cache_stats final {
+  usize hits {};       ///< The amount of lookups that found a cached mesh.
+  usize misses {};     ///< The amount of lookups that tessellated a new mesh.
+  usize evictions {};  ///< The amount of meshes that were evicted to respect the budget.
+  usize vertices {};   ///< The total amount of vertices in the cached meshes.
+  usize count {};      ///< The amount of cached meshes.
+};
+
+/**
+ * Caches tessellated shapes, keyed on their parameters.
+ *
+ * The first time a shape is requested it is tessellated into a mesh, subsequent requests with
+ * identical parameters return the same mesh. This makes drawing static shapes every frame
+ * about as cheap as a single `SDL_RenderGeometry` call. The least recently used meshes are
+ * evicted when the total amount of cached vertices exceeds the vertex budget. The most
+ * recently requested mesh is never evicted.
+ *
+ * Returned meshes are valid until the next request or until the cache is cleared.
+ *
+ * \see shape_mesh
+ */
+class shape_cache final {
+ public:
+  explicit shape_cache(const usize vertexBudget = 65'536) : mBudget {vertexBudget} {}
+
+  template <typename Container>
+  auto polygon(const Container& points, const color& color) -> const shape_mesh&
+  {
+    begin_key(shape_kind::polygon, color);
+    push_points(points.data(), points.size());
+
+    return fetch([&](shape_mesh& mesh) { mesh.add_polygon(points, color); });
+  }
+
+  template <typename Container>
+  auto polyline(const Container& points,
+                const float thickness,
+                const color& color,
+                const line_join join = line_join::miter,
+                const bool closed = false) -> const shape_mesh&
+  {
+    begin_key(shape_kind::polyline, color);
+    mKey.insert(mKey.end(),
+                {thickness, static_cast<float>(to_underlying(join)), closed ? 1.0f : 0.0f});
+    push_points(points.data(), points.size());
+
+    return fetch(
+        [&](shape_mesh& mesh) { mesh.add_polyline(points, thickness, color, join, closed); });
+  }
+
+  auto ellipse(const fpoint& center,
+               const farea& radii,
+               const color& color,
+               const usize segments = 0) -> const shape_mesh&
+  {
+    begin_key(shape_kind::ellipse, color);
+    mKey.insert(mKey.end(),
+                {center.x(), center.y(), radii.width, radii.height, as_key(segments)});
+
+    return fetch([&](shape_mesh& mesh) { mesh.add_ellipse(center, radii, color, segments); });
+  }
+
+  auto ellipse_outline(const fpoint& center,
+                       const farea& radii,
+                       const float thickness,
+                       const color& color,
+                       const usize segments = 0) -> const shape_mesh&
+  {
+    begin_key(shape_kind::ellipse_outline, color);
+    mKey.insert(
+        mKey.end(),
+        {center.x(), center.y(), radii.width, radii.height, thickness, as_key(segments)});
+
+    return fetch([&](shape_mesh& mesh) {
+      mesh.add_ellipse_outline(center, radii, thickness, color, segments);
+    });
+  }
+
+  auto rounded_rect(const frect& rect,
+                    const float radius,
+                    const color& color,
+                    const usize segments = 0) -> const shape_mesh&
+  {
+    begin_key(shape_kind::rounded_rect, color);
+    mKey.insert(mKey.end(),
+                {rect.x(), rect.y(), rect.width(), rect.height(), radius, as_key(segments)});
+
+    return fetch(
+        [&](shape_mesh& mesh) { mesh.add_rounded_rect(rect, radius, color, segments); });
+  }
+
+  auto rounded_rect_outline(const frect& rect,
+                            const float radius,
+                            const float thickness,
+                            const color& color,
+                            const usize segments = 0) -> const shape_mesh&
+  {
+    begin_key(shape_kind::rounded_rect_outline, color);
+    mKey.insert(mKey.end(),
+                {rect.x(),
+                 rect.y(),
+                 rect.width(),
+                 rect.height(),
+                 radius,
+                 thickness,
+                 as_key(segments)});
+
+    return fetch([&](shape_mesh& mesh) {
+      mesh.add_rounded_rect_outline(rect, radius, thickness, color, segments);
+    });
+  }
+
+  /// Sets the maximum total amount of vertices in the cached meshes.
+  void set_budget(const usize vertices)
+  {
+    mBudget = vertices;
+    trim();
+  }
+
+  [[nodiscard]] auto budget() const noexcept -> usize { return mBudget; }
+
+  [[nodiscard]] auto stats() const noexcept -> shape_cache_stats
+  {
+    auto stats = mStats;
+    stats.count = mLru.size();
+    return stats;
+  }
+
+  /// Resets the hit, miss and eviction counters.
+  void reset_stats() noexcept
+  {
+    mStats.hits = 0;
+    mStats.misses = 0;
+    mStats.evictions = 0;
+  }
+
+  /// Removes all cached meshes.
+  void clear() noexcept
+  {
+    mIndex.clear();
+    mLru.clear();
+    mStats.vertices = 0;
+  }
+
+  [[nodiscard]] auto size() const noexcept -> usize { return mLru.size(); }
+
+ private:
+  enum class shape_kind {
+    polygon,
+    polyline,
+    ellipse,
+    ellipse_outline,
+    rounded_rect,
+    rounded_rect_outline
+  };
+
+  struct entry final {
+    std::vector<float> key;
+    usize hash {};
+    shape_mesh mesh;
+  };
+
+  std::list<entry> mLru;  ///< Most recently used meshes first.
+  std::unordered_map<usize, std::list<entry>::iterator> mIndex;
+  std::vector<float> mKey;  ///< The parameters of the shape being requested.
+  shape_cache_stats mStats;
+  usize mBudget {};
+
+  [[nodiscard]] static auto as_key(const usize value) noexcept -> float
+  {
+    return static_cast<float>(value);
+  }
+
+  void begin_key(const shape_kind type, const color& color)
+  {
+    mKey.clear();
+    mKey.insert(mKey.end(),
+                {static_cast<float>(to_underlying(type)),
+                 static_cast<float>(color.red()),
+                 static_cast<float>(color.green()),
+                 static_cast<float>(color.blue()),
+                 static_cast<float>(color.alpha())});
+  }
+
+  void push_points(const fpoint* points, const usize count)
+  {
+    mKey.push_back(as_key(count));
+    for (usize i = 0; i < count; ++i) {
+      mKey.insert(mKey.end(), {points[i].x(), points[i].y()});
+    }
+  }
+
+  [[nodiscard]] auto key_hash() const noexcept -> usize
+  {
+    usize seed = mKey.size();
+
+    for (const auto value : mKey) {
+      uint32 bits {};
+      std::memcpy(&bits, &value, sizeof bits);
+      seed ^= std::hash<uint32> {}(bits) + 0x9E3779B9u + (seed << 6u) + (seed >> 2u);
+    }
+
+    return seed;
+  }
+
+  template <typename Tessellator>
+  auto fetch(Tessellator&& tessellate) -> const shape_mesh&
+  {
+    const auto hash = key_hash();
+
+    if (const auto it = mIndex.find(hash); it != mIndex.end()) {
+      const auto cached = it->second;
+
+      if (cached->key == mKey) {
+        ++mStats.hits;
+        mLru.splice(mLru.begin(), mLru, cached);
+        return cached->mesh;
+      }
+
+      /* Different shapes with the same hash, replace the old one */
+      evict(cached);
+    }
+
+    ++mStats.misses;
+
+    shape_mesh mesh;
+    tessellate(mesh);
+
+    mStats.vertices += mesh.vertex_count();
+    mLru.push_front(entry {mKey, hash, std::move(mesh)});
+    mIndex.insert_or_assign(hash, mLru.begin());
+
+    trim();
+
+    return mLru.front().mesh;
+  }
+
+  void evict(const std::list<entry>::iterator cached)
+  {
+    mStats.vertices -= cached->mesh.vertex_count();
+    mIndex.erase(cached->hash);
+    mLru.erase(cached);
+  }
+
+  void trim()
+  {
+    while (mStats.vertices > mBudget && mLru.size() > 1) {
+      evict(std::prev(mLru.end()));
+      ++mStats.evictions;
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+#endif  // CENTURION_VIDEO_SHAPES_HPP_
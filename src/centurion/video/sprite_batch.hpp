@@ -0,0 +1,293 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_SPRITE_BATCH_HPP_
+#define CENTURION_VIDEO_SPRITE_BATCH_HPP_
+
+#include <SDL.h>
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+#include <algorithm>    // stable_sort
+#include <array>        // array
+#include <cassert>      // assert
+#include <cmath>        // cos, sin
+#include <functional>   // less
+#include <ostream>      // ostream
+#include <string_view>  // string_view
+#include <utility>      // swap
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "blend.hpp"
+#include "color.hpp"
+#include "renderer.hpp"
+#include "texture.hpp"
+
+namespace cen {
+
+/// Determines how queued sprites are reordered before being submitted.
+enum class sprite_sort_mode {
+  none,    ///< Sprites are submitted in the order they were added.
+  texture  ///< Sprites are grouped by texture and blend mode (stable).
+};
+
+[[nodiscard]] constexpr auto to_string(const sprite_sort_mode mode) -> std::string_view
+{
+  switch (mode) {
+    case sprite_sort_mode::none:
+      return "none";
+
+    case sprite_sort_mode::texture:
+      return "texture";
+
+    default:
+      throw exception {"Did not recognize sprite sort mode!"};
+  }
+}
+
+inline auto operator<<(std::ostream& stream, const sprite_sort_mode mode) -> std::ostream&
+{
+  return stream << to_string(mode);
+}
+
+/**
+ * Accumulates textured quads and submits them with as few geometry calls as possible.
+ *
+ * Every run of consecutive sprites that share texture and blend mode is flushed with a
+ * single call to `SDL_RenderGeometry`. Queued textures must outlive the next flush.
+ *
+ * \see basic_renderer::render_geo()
+ */
+class sprite_batch final {
+ public:
+  explicit sprite_batch(const sprite_sort_mode mode = sprite_sort_mode::texture)
+      : mSortMode {mode}
+  {
+  }
+
+  /// Reserves space for the specified amount of sprites.
+  void reserve(const usize count)
+  {
+    mSprites.reserve(count);
+    mVertices.reserve(count * 4u);
+  }
+
+  template <typename T>
+  void add(const basic_texture<T>& texture,
+           const irect& src,
+           const frect& dst,
+           const double angle = 0,
+           const renderer_flip flip = renderer_flip::none,
+           const color& tint = colors::white,
+           const blend_mode mode = blend_mode::blend)
+  {
+    assert(texture.get());
+
+    const auto [width, height] = texture.size();
+    const auto tw = static_cast<float>(width);
+    const auto th = static_cast<float>(height);
+
+    float u0 = static_cast<float>(src.x()) / tw;
+    float v0 = static_cast<float>(src.y()) / th;
+    float u1 = static_cast<float>(src.max_x()) / tw;
+    float v1 = static_cast<float>(src.max_y()) / th;
+
+    if (to_underlying(flip) & SDL_FLIP_HORIZONTAL) {
+      std::swap(u0, u1);
+    }
+
+    if (to_underlying(flip) & SDL_FLIP_VERTICAL) {
+      std::swap(v0, v1);
+    }
+
+    const auto hw = dst.width() / 2.0f;
+    const auto hh = dst.height() / 2.0f;
+    const auto cx = dst.x() + hw;
+    const auto cy = dst.y() + hh;
+
+    const std::array<SDL_FPoint, 4> offsets {{{-hw, -hh}, {hw, -hh}, {hw, hh}, {-hw, hh}}};
+    const std::array<SDL_FPoint, 4> uvs {{{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}}};
+
+    const auto col = tint.get();
+    auto& quad = mSprites.emplace_back(entry {texture.get(), mode, {}}).quad;
+
+    if (angle == 0) {
+      for (usize i = 0; i < 4; ++i) {
+        quad[i] = {{cx + offsets[i].x, cy + offsets[i].y}, col, uvs[i]};
+      }
+    }
+    else {
+      // Rotate clockwise about the center of the destination, like SDL_RenderCopyEx
+      const auto radians = angle * 3.14159265358979323846 / 180.0;
+      const auto cos = static_cast<float>(std::cos(radians));
+      const auto sin = static_cast<float>(std::sin(radians));
+
+      for (usize i = 0; i < 4; ++i) {
+        const auto [dx, dy] = offsets[i];
+        quad[i] = {{cx + dx * cos - dy * sin, cy + dx * sin + dy * cos}, col, uvs[i]};
+      }
+    }
+  }
+
+  /// Adds a sprite that covers the entire texture.
+  template <typename T>
+  void add(const basic_texture<T>& texture,
+           const frect& dst,
+           const color& tint = colors::white,
+           const blend_mode mode = blend_mode::blend)
+  {
+    const auto [width, height] = texture.size();
+    add(texture, irect {0, 0, width, height}, dst, 0, renderer_flip::none, tint, mode);
+  }
+
+  /**
+   * Submits all queued sprites and clears the batch.
+   *
+   * The blend mode of each texture is temporarily changed to that of its sprites and
+   * restored afterwards.
+   *
+   * \return `success` if all geometry was submitted; `failure` otherwise.
+   */
+  template <typename T>
+  auto flush(basic_renderer<T>& renderer) -> result
+  {
+    mDrawCalls = 0;
+    mFlushedSprites = mSprites.size();
+
+    if (mSprites.empty()) {
+      return success;
+    }
+
+    if (mSortMode == sprite_sort_mode::texture) {
+      std::stable_sort(mSprites.begin(),
+                       mSprites.end(),
+                       [](const entry& a, const entry& b) noexcept {
+                         /* Built-in < doesn't define an order for unrelated pointers */
+                         const std::less<const SDL_Texture*> less;
+                         return (a.texture != b.texture) ? less(a.texture, b.texture)
+                                                         : (a.mode < b.mode);
+                       });
+    }
+
+    mVertices.clear();
+    for (const auto& sprite : mSprites) {
+      mVertices.insert(mVertices.end(), sprite.quad.begin(), sprite.quad.end());
+    }
+
+    bool ok = true;
+
+    usize first = 0;
+    while (first < mSprites.size()) {
+      const auto& head = mSprites[first];
+
+      usize last = first + 1;
+      while (last < mSprites.size() && mSprites[last].texture == head.texture &&
+             mSprites[last].mode == head.mode) {
+        ++last;
+      }
+
+      const auto count = last - first;
+      prepare_indices(count);
+
+      SDL_BlendMode previous {};
+      SDL_GetTextureBlendMode(head.texture, &previous);
+      SDL_SetTextureBlendMode(head.texture, static_cast<SDL_BlendMode>(head.mode));
+
+      const texture_handle texture {head.texture};
+      if (!renderer.render_geo(texture,
+                               mVertices.data() + (first * 4u),
+                               count * 4u,
+                               mIndices.data(),
+                               count * 6u)) {
+        ok = false;
+      }
+
+      SDL_SetTextureBlendMode(head.texture, previous);
+
+      ++mDrawCalls;
+      first = last;
+    }
+
+    mSprites.clear();
+    return ok;
+  }
+
+  /// Discards all queued sprites without rendering them.
+  void clear() noexcept { mSprites.clear(); }
+
+  void set_sort_mode(const sprite_sort_mode mode) noexcept { mSortMode = mode; }
+
+  [[nodiscard]] auto sort_mode() const noexcept -> sprite_sort_mode { return mSortMode; }
+
+  /// Returns the amount of currently queued sprites.
+  [[nodiscard]] auto size() const noexcept -> usize { return mSprites.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mSprites.empty(); }
+
+  /// Returns the amount of geometry calls issued by the latest flush.
+  [[nodiscard]] auto draw_calls() const noexcept -> usize { return mDrawCalls; }
+
+  /// Returns the amount of sprites submitted by the latest flush.
+  [[nodiscard]] auto flushed_sprites() const noexcept -> usize { return mFlushedSprites; }
+
+ private:
+  struct entry final {
+    SDL_Texture* texture {};
+    blend_mode mode {blend_mode::blend};
+    std::array<SDL_Vertex, 4> quad {};
+  };
+
+  std::vector<entry> mSprites;
+  std::vector<SDL_Vertex> mVertices;
+  std::vector<int> mIndices;
+  usize mDrawCalls {};
+  usize mFlushedSprites {};
+  sprite_sort_mode mSortMode {sprite_sort_mode::texture};
+
+  /// Extends the shared quad index pattern to cover the specified amount of sprites.
+  void prepare_indices(const usize count)
+  {
+    const auto quads = mIndices.size() / 6u;
+    if (quads >= count) {
+      return;
+    }
+
+    mIndices.reserve(count * 6u);
+    for (auto quad = quads; quad < count; ++quad) {
+      const auto base = static_cast<int>(quad * 4u);
+      mIndices.insert(mIndices.end(),
+                      {base, base + 1, base + 2, base + 2, base + 3, base});
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+#endif  // CENTURION_VIDEO_SPRITE_BATCH_HPP_
@@ -40,12 +40,14 @@
 #include "../common/math.hpp"
 #include "../common/primitives.hpp"
 #include "../common/result.hpp"
+#include "../common/utils.hpp"
 #include "../detail/owner_handle_api.hpp"
 #include "../detail/stdlib.hpp"
 #include "../features.hpp"
 #include "../io/file.hpp"
 #include "blend.hpp"
 #include "color.hpp"
+#include "pixel_kernels.hpp"
 #include "pixels.hpp"
 
 #if CENTURION_HAS_FEATURE_FORMAT
@@ -62,6 +64,37 @@ class basic_surface;
 using surface = basic_surface<detail::owner_tag>;
 using surface_handle = basic_surface<detail::handle_tag>;
 
+namespace detail {
+
+/// Locks a surface for the lifetime of the lock, if the surface requires locking.
+class surface_pixel_lock final {
+ public:
+  explicit surface_pixel_lock(SDL_Surface* surface) noexcept
+      : mSurface {surface}
+      , mLocked {SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) == 0}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(surface_pixel_lock)
+  CENTURION_DISABLE_MOVE(surface_pixel_lock)
+
+  ~surface_pixel_lock() noexcept
+  {
+    if (mLocked) {
+      SDL_UnlockSurface(mSurface);
+    }
+  }
+
+  /// Indicates whether the pixel data of the surface may be accessed.
+  explicit operator bool() const noexcept { return mLocked || !SDL_MUSTLOCK(mSurface); }
+
+ private:
+  SDL_Surface* mSurface {};
+  bool mLocked {};
+};
+
+}  // namespace detail
+
 /**
  * Represents a non-accelerated image.
  *
@@ -237,6 +270,18 @@ class basic_surface final {
 
   [[nodiscard]] auto convert_to(const pixel_format format) const -> surface
   {
+    // The dedicated kernels skip the generic blitter, but don't handle color keys
+    if (has_pixel_kernel(format_info().format(), format) && !SDL_HasColorKey(mSurface)) {
+      surface result {size(), format};
+      result.set_blend_mode(get_blend_mode());
+      result.set_alpha_mod(alpha());
+      result.set_color_mod(color_mod());
+
+      if (convert_into(result)) {
+        return result;
+      }
+    }
+
     if (auto* converted = SDL_ConvertSurfaceFormat(mSurface, to_underlying(format), 0)) {
       surface result {converted};
       result.set_blend_mode(get_blend_mode());
@@ -247,6 +292,100 @@ class basic_surface final {
     }
   }
 
+  /**
+   * Converts the pixels of the surface into an existing surface of the same size.
+   *
+   * Unlike `convert_to()`, this doesn't allocate a new surface, which makes it suitable for
+   * conversions that are performed repeatedly. The target surface determines the format.
+   *
+   * \param target the surface that will receive the converted pixels.
+   *
+   * \return `success` if the pixels were converted; `failure` otherwise.
+   */
+  template <typename U>
+  auto convert_into(basic_surface<U>& target) const noexcept -> result
+  {
+    if (target.width() != width() || target.height() != height() || !target.lock()) {
+      return failure;
+    }
+
+    const auto res = with_pixels([&] {
+      return convert_pixels(size(),
+                            format_info().format(),
+                            pixel_data(),
+                            pitch(),
+                            target.format_info().format(),
+                            target.pixel_data(),
+                            target.pitch());
+    });
+
+    target.unlock();
+    return res;
+  }
+
+  /**
+   * Converts the pixels of the surface into an aligned pixel buffer.
+   *
+   * The buffer is resized to match the surface, but only reallocated if it is too small.
+   *
+   * \param buffer the buffer that will receive the converted pixels.
+   * \param format the pixel format used by the buffer.
+   *
+   * \return `success` if the pixels were converted; `failure` otherwise.
+   */
+  auto convert_into(pixel_buffer& buffer, const pixel_format format) const -> result
+  {
+    buffer.resize(size(), format);
+    return with_pixels([&] {
+      return convert_pixels(size(),
+                            format_info().format(),
+                            pixel_data(),
+                            pitch(),
+                            format,
+                            buffer.data(),
+                            buffer.pitch());
+    });
+  }
+
+  /// Multiplies the color channels of the pixels by their alpha values, in place.
+  auto premultiply_alpha() noexcept -> result
+  {
+    return with_pixels([this] {
+      return cen::premultiply_alpha(size(), format_info().format(), pixel_data(), pitch());
+    });
+  }
+
+  /// Divides the color channels of premultiplied pixels by their alpha values, in place.
+  auto unpremultiply_alpha() noexcept -> result
+  {
+    return with_pixels([this] {
+      return cen::unpremultiply_alpha(size(), format_info().format(), pixel_data(), pitch());
+    });
+  }
+
+  /**
+   * Applies the color and alpha modulation to the pixel data, and resets the modulation.
+   *
+   * This is useful for surfaces that are blitted or converted to textures many times, since
+   * the modulation no longer has to be applied to every pixel each time.
+   *
+   * \return `success` if the modulation was applied; `failure` otherwise.
+   */
+  auto bake_color_mod() noexcept -> result
+  {
+    const auto mod = color_mod().with_alpha(alpha());
+    const auto res = with_pixels([&] {
+      return cen::bake_color_mod(size(), format_info().format(), pixel_data(), pitch(), mod);
+    });
+
+    if (res) {
+      set_color_mod(colors::white);
+      set_alpha_mod(0xFF);
+    }
+
+    return res;
+  }
+
   /// Attempts to lock the surface, so that the associated pixel data can be modified.
   auto lock() noexcept -> result
   {
@@ -353,6 +492,23 @@ class basic_surface final {
 
   void copy(const basic_surface& other) { mSurface.reset(other.duplicate_surface()); }
 
+  /// Runs a pixel operation, temporarily locking the surface if required (even if const).
+  template <typename Fn>
+  auto with_pixels(Fn&& fn) const noexcept -> result
+  {
+    if (must_lock() && SDL_LockSurface(mSurface) != 0) {
+      return failure;
+    }
+
+    const result res = fn();
+
+    if (must_lock()) {
+      SDL_UnlockSurface(mSurface);
+    }
+
+    return res;
+  }
+
   [[nodiscard]] auto duplicate_surface() const -> owner<SDL_Surface*>
   {
     if (auto* copy = SDL_DuplicateSurface(mSurface)) {
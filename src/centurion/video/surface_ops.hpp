@@ -0,0 +1,1008 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_SURFACE_OPS_HPP_
+#define CENTURION_VIDEO_SURFACE_OPS_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>    // fill
+#include <array>        // array
+#include <cassert>      // assert
+#include <cmath>        // ceil, floor, lround, sin, exp, abs
+#include <cstring>      // memcpy
+#include <exception>    // exception_ptr, current_exception, rethrow_exception
+#include <ostream>      // ostream
+#include <string_view>  // string_view
+#include <type_traits>  // integral_constant
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/condition.hpp"
+#include "../concurrency/locks.hpp"
+#include "../concurrency/mutex.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../detail/stdlib.hpp"
+#include "color.hpp"
+#include "pixel_kernels.hpp"
+#include "pixels.hpp"
+#include "surface.hpp"
+
+namespace cen {
+
+/**
+ * Represents the filters available when resizing surfaces.
+ *
+ * \see resize()
+ */
+enum class resize_filter {
+  box,       ///< Averages the covered source pixels, suitable for large reductions.
+  bilinear,  ///< Linear interpolation, widened when downscaling to avoid aliasing.
+  lanczos    ///< Three-lobed Lanczos filter, the sharpest but also the slowest filter.
+};
+
+[[nodiscard]] constexpr auto to_string(const resize_filter filter) -> std::string_view
+{
+  switch (filter) {
+    case resize_filter::box:
+      return "box";
+
+    case resize_filter::bilinear:
+      return "bilinear";
+
+    case resize_filter::lanczos:
+      return "lanczos";
+
+    default:
+      throw exception {"Did not recognize resize filter!"};
+  }
+}
+
+inline auto operator<<(std::ostream& stream, const resize_filter filter) -> std::ostream&
+{
+  return stream << to_string(filter);
+}
+
+/**
+ * An affine color transformation, operating on normalized RGBA values.
+ *
+ * Each row computes an output channel (red, green, blue and alpha, in that order) from the
+ * input channels, with the last column as a constant offset.
+ *
+ * \see transform_colors()
+ */
+struct color_matrix final {
+  using row_type = std::array<float, 5>;
+
+  std::array<row_type, 4> rows {row_type {1, 0, 0, 0, 0},
+                                row_type {0, 1, 0, 0, 0},
+                                row_type {0, 0, 1, 0, 0},
+                                row_type {0, 0, 0, 1, 0}};
+
+  [[nodiscard]] constexpr static auto identity() noexcept -> color_matrix { return {}; }
+
+  /// Replaces the colors with their (Rec. 709) luminance.
+  [[nodiscard]] constexpr static auto grayscale() noexcept -> color_matrix
+  {
+    return saturation(0);
+  }
+
+  [[nodiscard]] constexpr static auto sepia() noexcept -> color_matrix
+  {
+    return {{row_type {0.393f, 0.769f, 0.189f, 0, 0},
+             row_type {0.349f, 0.686f, 0.168f, 0, 0},
+             row_type {0.272f, 0.534f, 0.131f, 0, 0},
+             row_type {0, 0, 0, 1, 0}}};
+  }
+
+  /// Interpolates between grayscale (0) and the original colors (1), may exceed 1.
+  [[nodiscard]] constexpr static auto saturation(const float amount) noexcept -> color_matrix
+  {
+    constexpr float r = 0.2126f;
+    constexpr float g = 0.7152f;
+    constexpr float b = 0.0722f;
+    const auto s = 1.0f - amount;
+    return {{row_type {r * s + amount, g * s, b * s, 0, 0},
+             row_type {r * s, g * s + amount, b * s, 0, 0},
+             row_type {r * s, g * s, b * s + amount, 0, 0},
+             row_type {0, 0, 0, 1, 0}}};
+  }
+
+  /// Adds an offset to the color channels, in the range [-1, 1].
+  [[nodiscard]] constexpr static auto brightness(const float offset) noexcept -> color_matrix
+  {
+    return {{row_type {1, 0, 0, 0, offset},
+             row_type {0, 1, 0, 0, offset},
+             row_type {0, 0, 1, 0, offset},
+             row_type {0, 0, 0, 1, 0}}};
+  }
+
+  /// Scales the distance of the color channels from the midpoint.
+  [[nodiscard]] constexpr static auto contrast(const float factor) noexcept -> color_matrix
+  {
+    const auto offset = 0.5f * (1.0f - factor);
+    return {{row_type {factor, 0, 0, 0, offset},
+             row_type {0, factor, 0, 0, offset},
+             row_type {0, 0, factor, 0, offset},
+             row_type {0, 0, 0, 1, 0}}};
+  }
+
+  /// Multiplies all channels by the normalized channels of a color.
+  [[nodiscard]] constexpr static auto tint(const color& tint) noexcept -> color_matrix
+  {
+    return {{row_type {tint.norm_red(), 0, 0, 0, 0},
+             row_type {0, tint.norm_green(), 0, 0, 0},
+             row_type {0, 0, tint.norm_blue(), 0, 0},
+             row_type {0, 0, 0, tint.norm_alpha(), 0}}};
+  }
+
+  /// Returns a matrix that applies the other matrix first, followed by this matrix.
+  [[nodiscard]] constexpr auto operator*(const color_matrix& other) const noexcept
+      -> color_matrix
+  {
+    color_matrix result;
+
+    for (usize row = 0; row < 4; ++row) {
+      for (usize column = 0; column < 5; ++column) {
+        float value = (column == 4) ? rows[row][4] : 0.0f;
+        for (usize k = 0; k < 4; ++k) {
+          value += rows[row][k] * other.rows[k][column];
+        }
+        result.rows[row][column] = value;
+      }
+    }
+
+    return result;
+  }
+};
+
+namespace detail {
+
+/// The smallest amount of rows that is worth handing to a worker thread.
+inline constexpr int min_rows_per_task = 16;
+
+inline constexpr int filter_bits = 14;
+inline constexpr int32 filter_one = 1 << filter_bits;
+inline constexpr int32 filter_half = filter_one / 2;
+
+/// Returns the amount of bytes per pixel, or zero if the surface can't be processed.
+[[nodiscard]] inline auto processable_bytes(const SDL_Surface* surface) noexcept -> int
+{
+  return layout_of(static_cast<pixel_format>(surface->format->format)).bytes;
+}
+
+/**
+ * Splits a range of rows into bands that are processed by a thread pool.
+ *
+ * The calling thread processes the first band and then waits for the others. This must not
+ * be called from a task running in the same pool, since that could deadlock.
+ */
+template <typename Fn>
+void parallel_rows(thread_pool* pool, const int rows, const Fn& fn)
+{
+  const auto workers = pool ? static_cast<int>(pool->size()) + 1 : 1;
+  const auto bands = pool ? detail::clamp(rows / min_rows_per_task, 1, workers * 2) : 1;
+
+  if (bands == 1) {
+    fn(0, rows);
+    return;
+  }
+
+  mutex guard;
+  condition finished;
+  int remaining = bands - 1;
+  int dispatched = 0;
+  std::exception_ptr error;  ///< The first exception thrown by a task, rethrown by this thread.
+
+  /* The tasks refer to this stack frame, so they must finish before it is left in any way */
+  const auto wait = [&]() noexcept {
+    scoped_lock lock {guard};
+    remaining -= bands - 1 - dispatched;  // Bands that were never dispatched
+    while (remaining != 0) {
+      finished.wait(guard);
+    }
+  };
+
+  try {
+    for (int band = 1; band < bands; ++band) {
+      const auto task = [&, begin = rows * band / bands, end = rows * (band + 1) / bands] {
+        struct on_exit final {
+          mutex& guard;
+          condition& finished;
+          int& remaining;
+
+          ~on_exit() noexcept
+          {
+            scoped_lock lock {guard};
+            if (--remaining == 0) {
+              finished.signal();
+            }
+          }
+        } notify {guard, finished, remaining};
+
+        try {
+          fn(begin, end);
+        }
+        catch (...) {
+          // The pool would swallow the exception, leaving the band unprocessed
+          scoped_lock lock {guard};
+          if (!error) {
+            error = std::current_exception();
+          }
+        }
+      };
+
+      ++dispatched;
+
+      try {
+        pool->submit(task);
+      }
+      catch (...) {
+        task();
+      }
+    }
+
+    fn(0, rows / bands);
+  }
+  catch (...) {
+    wait();
+    throw;
+  }
+
+  wait();
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+/// Stores a fixed-point value as a byte, with saturation.
+[[nodiscard]] constexpr auto fixed_to_byte(const int32 value) noexcept -> uint8
+{
+  return static_cast<uint8>(detail::clamp(value >> filter_bits, 0, 255));
+}
+
+/// Describes how the source pixels contribute to each target pixel along an axis.
+struct filter_contributions final {
+  std::vector<int> first;      ///< The first contributing source index of each target index.
+  std::vector<int> counts;     ///< The amount of contributing source indices.
+  std::vector<int32> weights;  ///< Fixed-point weights, `taps` for each target index.
+  int taps {};
+};
+
+[[nodiscard]] inline auto filter_support(const resize_filter filter) noexcept -> double
+{
+  switch (filter) {
+    case resize_filter::box:
+      return 0.5;
+
+    case resize_filter::lanczos:
+      return 3.0;
+
+    case resize_filter::bilinear:
+    default:
+      return 1.0;
+  }
+}
+
+[[nodiscard]] inline auto filter_value(const resize_filter filter, const double x) noexcept
+    -> double
+{
+  constexpr double pi = 3.14159265358979323846;
+
+  switch (filter) {
+    case resize_filter::box:
+      return (x >= -0.5 && x < 0.5) ? 1.0 : 0.0;
+
+    case resize_filter::lanczos: {
+      if (x == 0.0) {
+        return 1.0;
+      }
+      else if (x <= -3.0 || x >= 3.0) {
+        return 0.0;
+      }
+
+      const auto px = pi * x;
+      return 3.0 * std::sin(px) * std::sin(px / 3.0) / (px * px);
+    }
+
+    case resize_filter::bilinear:
+    default:
+      return detail::max(0.0, 1.0 - std::abs(x));
+  }
+}
+
+[[nodiscard]] inline auto make_contributions(const int sourceSize,
+                                             const int targetSize,
+                                             const resize_filter filter)
+    -> filter_contributions
+{
+  assert(sourceSize > 0);
+  assert(targetSize > 0);
+
+  const auto scale = static_cast<double>(sourceSize) / static_cast<double>(targetSize);
+  const auto stretch = detail::max(scale, 1.0);
+  const auto support = filter_support(filter) * stretch;
+
+  filter_contributions result;
+  result.taps = static_cast<int>(std::ceil(support)) * 2 + 1;
+  result.first.resize(static_cast<usize>(targetSize));
+  result.counts.resize(static_cast<usize>(targetSize));
+  result.weights.resize(static_cast<usize>(targetSize) * static_cast<usize>(result.taps));
+
+  std::vector<double> values(static_cast<usize>(result.taps));
+
+  for (int index = 0; index < targetSize; ++index) {
+    const auto center = (index + 0.5) * scale;
+    const auto begin = detail::max(0, static_cast<int>(std::floor(center - support)));
+    const auto end = detail::min(sourceSize, static_cast<int>(std::ceil(center + support)));
+    const auto count = detail::clamp(end - begin, 1, result.taps);
+
+    double total {};
+    for (int k = 0; k < count; ++k) {
+      const auto value = filter_value(filter, (begin + k + 0.5 - center) / stretch);
+      values[static_cast<usize>(k)] = value;
+      total += value;
+    }
+
+    auto* weights = result.weights.data() + static_cast<usize>(index * result.taps);
+
+    if (total == 0.0) {
+      weights[0] = filter_one;  // Can only happen for degenerate sizes, use the nearest pixel
+    }
+    else {
+      int32 sum {};
+      int largest {};
+      for (int k = 0; k < count; ++k) {
+        weights[k] = static_cast<int32>(std::lround(values[static_cast<usize>(k)] / total *
+                                                    static_cast<double>(filter_one)));
+        sum += weights[k];
+        largest = (weights[k] > weights[largest]) ? k : largest;
+      }
+
+      // Make sure that the weights add up to exactly one, to preserve flat colors
+      weights[largest] += filter_one - sum;
+    }
+
+    result.first[static_cast<usize>(index)] = begin;
+    result.counts[static_cast<usize>(index)] = count;
+  }
+
+  return result;
+}
+
+template <int Channels>
+void resample_row(const uint8* src,
+                  uint8* dst,
+                  const filter_contributions& contributions,
+                  const int width) noexcept
+{
+  for (int x = 0; x < width; ++x, dst += Channels) {
+    const auto* in = src + contributions.first[static_cast<usize>(x)] * Channels;
+    const auto* weights = contributions.weights.data() + static_cast<usize>(x * contributions.taps);
+    const auto count = contributions.counts[static_cast<usize>(x)];
+
+    int32 sums[Channels];
+    for (int channel = 0; channel < Channels; ++channel) {
+      sums[channel] = filter_half;
+    }
+
+    for (int tap = 0; tap < count; ++tap, in += Channels) {
+      for (int channel = 0; channel < Channels; ++channel) {
+        sums[channel] += weights[tap] * in[channel];
+      }
+    }
+
+    for (int channel = 0; channel < Channels; ++channel) {
+      dst[channel] = fixed_to_byte(sums[channel]);
+    }
+  }
+}
+
+/// Accumulates a weighted row, the loop is kept trivial so that it is auto-vectorized.
+inline void accumulate_row(int32* sums,
+                           const uint8* row,
+                           const int32 weight,
+                           const int bytes) noexcept
+{
+  for (int i = 0; i < bytes; ++i) {
+    sums[i] += weight * row[i];
+  }
+}
+
+inline void store_row(uint8* dst, const int32* sums, const int bytes) noexcept
+{
+  for (int i = 0; i < bytes; ++i) {
+    dst[i] = fixed_to_byte(sums[i]);
+  }
+}
+
+template <typename Fn>
+void dispatch_channels(const int bytes, Fn&& fn)
+{
+  if (bytes == 4) {
+    fn(std::integral_constant<int, 4> {});
+  }
+  else {
+    fn(std::integral_constant<int, 3> {});
+  }
+}
+
+template <int Channels>
+void box_blur_row(const uint8* src,
+                  uint8* dst,
+                  const int width,
+                  const int radius,
+                  const uint32 reciprocal) noexcept
+{
+  const auto last = width - 1;
+
+  for (int channel = 0; channel < Channels; ++channel) {
+    uint32 sum = static_cast<uint32>(radius + 1) * src[channel];
+    for (int k = 1; k <= radius; ++k) {
+      sum += src[detail::min(k, last) * Channels + channel];
+    }
+
+    for (int x = 0; x < width; ++x) {
+      dst[x * Channels + channel] = static_cast<uint8>((sum * reciprocal + (1u << 23u)) >> 24u);
+
+      const auto added = src[detail::min(x + radius + 1, last) * Channels + channel];
+      const auto removed = src[detail::max(x - radius, 0) * Channels + channel];
+      sum = sum + added - removed;
+    }
+  }
+}
+
+/// Convolves a row with a kernel, the sums buffer is used as scratch memory.
+template <int Channels>
+void convolve_row(const uint8* src,
+                  uint8* dst,
+                  const int width,
+                  const std::vector<int32>& kernel,
+                  std::vector<int32>& sums)
+{
+  const auto radius = static_cast<int>(kernel.size() / 2);
+  const auto last = width - 1;
+  const auto rowBytes = width * Channels;
+
+  sums.assign(static_cast<usize>(rowBytes), filter_half);
+
+  // Interior pixels are accumulated one tap at a time across the row, which vectorizes well
+  const auto begin = detail::min(radius, width);
+  const auto end = detail::max(width - radius, begin);
+
+  for (int tap = -radius; tap <= radius; ++tap) {
+    accumulate_row(sums.data() + begin * Channels,
+                   src + (begin + tap) * Channels,
+                   kernel[static_cast<usize>(tap + radius)],
+                   (end - begin) * Channels);
+  }
+
+  // Pixels near the edges need their coordinates clamped
+  const auto convolve_edge = [&](const int x) {
+    auto* pixel = sums.data() + x * Channels;
+    for (int tap = -radius; tap <= radius; ++tap) {
+      const auto* in = src + detail::clamp(x + tap, 0, last) * Channels;
+      const auto weight = kernel[static_cast<usize>(tap + radius)];
+      for (int channel = 0; channel < Channels; ++channel) {
+        pixel[channel] += weight * in[channel];
+      }
+    }
+  };
+
+  for (int x = 0; x < begin; ++x) {
+    convolve_edge(x);
+  }
+
+  for (int x = end; x < width; ++x) {
+    convolve_edge(x);
+  }
+
+  store_row(dst, sums.data(), rowBytes);
+}
+
+[[nodiscard]] inline auto make_gaussian_kernel(const float sigma) -> std::vector<int32>
+{
+  const auto radius = static_cast<int>(std::ceil(3.0f * sigma));
+
+  std::vector<double> values;
+  values.reserve(static_cast<usize>(2 * radius + 1));
+
+  double total {};
+  for (int x = -radius; x <= radius; ++x) {
+    const auto value = std::exp(-(x * x) / (2.0 * sigma * sigma));
+    values.push_back(value);
+    total += value;
+  }
+
+  std::vector<int32> kernel;
+  kernel.reserve(values.size());
+
+  int32 sum {};
+  for (const auto value : values) {
+    kernel.push_back(static_cast<int32>(std::lround(value / total * filter_one)));
+    sum += kernel.back();
+  }
+
+  kernel[static_cast<usize>(radius)] += filter_one - sum;
+  return kernel;
+}
+
+}  // namespace detail
+
+/**
+ * Resizes the contents of a surface into another surface.
+ *
+ * \details The image is resampled separably, first horizontally and then vertically, using
+ * fixed-point weights. Both passes are split into bands of rows, which are processed by the
+ * thread pool if one is supplied. The channels are filtered independently, so surfaces with
+ * translucent pixels should be premultiplied first to avoid dark fringes.
+ *
+ * \param source the surface that will be resized.
+ * \param target the surface that receives the result, its size determines the scale.
+ * \param filter the resampling filter.
+ * \param pool an optional thread pool used to process the image in parallel.
+ *
+ * \return `success` if the surface was resized; `failure` if the surfaces have different or
+ * unsupported formats, are empty, or are the same surface.
+ */
+template <typename T, typename U>
+auto resize(const basic_surface<T>& source,
+            basic_surface<U>& target,
+            const resize_filter filter = resize_filter::bilinear,
+            thread_pool* pool = nullptr) -> result
+{
+  const auto bytes = detail::processable_bytes(source.get());
+  if (bytes == 0 || source.get() == target.get() ||
+      source.format_info().format() != target.format_info().format()) {
+    return failure;
+  }
+
+  // The filter weights are computed from the ratio of the sizes
+  if (source.width() == 0 || source.height() == 0 || target.width() == 0 ||
+      target.height() == 0) {
+    return failure;
+  }
+
+  const detail::surface_pixel_lock sourceLock {source.get()};
+  const detail::surface_pixel_lock targetLock {target.get()};
+  if (!sourceLock || !targetLock) {
+    return failure;
+  }
+
+  const auto sourceSize = source.size();
+  const auto targetSize = target.size();
+
+  const auto* sourcePixels = static_cast<const uint8*>(source.pixel_data());
+  auto* targetPixels = static_cast<uint8*>(target.pixel_data());
+
+  const auto rowBytes = targetSize.width * bytes;
+
+  // The horizontal pass is skipped if the width is unchanged, using the source directly
+  const uint8* intermediate = sourcePixels;
+  int intermediatePitch = source.pitch();
+  std::vector<uint8> buffer;
+
+  if (sourceSize.width != targetSize.width) {
+    const auto horizontal = detail::make_contributions(sourceSize.width, targetSize.width, filter);
+
+    // Without a vertical pass, the horizontal pass can write directly to the target
+    const auto direct = sourceSize.height == targetSize.height;
+    if (!direct) {
+      buffer.resize(static_cast<usize>(rowBytes) * static_cast<usize>(sourceSize.height));
+      intermediate = buffer.data();
+      intermediatePitch = rowBytes;
+    }
+
+    auto* out = direct ? targetPixels : buffer.data();
+    const auto outPitch = direct ? target.pitch() : rowBytes;
+
+    detail::dispatch_channels(bytes, [&](auto channels) {
+      detail::parallel_rows(pool, sourceSize.height, [&](const int begin, const int end) {
+        for (int y = begin; y < end; ++y) {
+          detail::resample_row<channels>(sourcePixels + y * source.pitch(),
+                                         out + y * outPitch,
+                                         horizontal,
+                                         targetSize.width);
+        }
+      });
+    });
+
+    if (direct) {
+      return success;
+    }
+  }
+
+  if (sourceSize.height == targetSize.height) {
+    for (int y = 0; y < targetSize.height; ++y) {
+      std::memcpy(targetPixels + y * target.pitch(),
+                  intermediate + y * intermediatePitch,
+                  static_cast<usize>(rowBytes));
+    }
+
+    return success;
+  }
+
+  const auto vertical = detail::make_contributions(sourceSize.height, targetSize.height, filter);
+
+  detail::parallel_rows(pool, targetSize.height, [&](const int begin, const int end) {
+    std::vector<int32> sums(static_cast<usize>(rowBytes));
+
+    for (int y = begin; y < end; ++y) {
+      const auto first = vertical.first[static_cast<usize>(y)];
+      const auto count = vertical.counts[static_cast<usize>(y)];
+      const auto* weights = vertical.weights.data() + static_cast<usize>(y * vertical.taps);
+
+      std::fill(sums.begin(), sums.end(), detail::filter_half);
+      for (int tap = 0; tap < count; ++tap) {
+        detail::accumulate_row(sums.data(),
+                               intermediate + (first + tap) * intermediatePitch,
+                               weights[tap],
+                               rowBytes);
+      }
+
+      detail::store_row(targetPixels + y * target.pitch(), sums.data(), rowBytes);
+    }
+  });
+
+  return success;
+}
+
+/**
+ * Returns a resized copy of a surface.
+ *
+ * \throws exception if the surface could not be resized.
+ *
+ * \see resize()
+ */
+template <typename T>
+[[nodiscard]] auto resized(const basic_surface<T>& source,
+                           const iarea& size,
+                           const resize_filter filter = resize_filter::bilinear,
+                           thread_pool* pool = nullptr) -> surface
+{
+  surface target {size, source.format_info().format()};
+  target.set_blend_mode(source.get_blend_mode());
+
+  if (!resize(source, target, filter, pool)) {
+    throw exception {"Failed to resize surface!"};
+  }
+
+  return target;
+}
+
+/**
+ * Blurs a surface in place with a box filter.
+ *
+ * \details The blur is computed with running sums, so the cost is independent of the radius.
+ * Pixels outside of the surface are treated as copies of the nearest edge pixel.
+ *
+ * \param surface the surface that will be blurred.
+ * \param radius the radius of the box, in pixels. A radius of zero does nothing.
+ * \param pool an optional thread pool used to process the image in parallel.
+ *
+ * \return `success` if the surface was blurred; `failure` otherwise.
+ */
+template <typename T>
+auto box_blur(basic_surface<T>& surface, const int radius, thread_pool* pool = nullptr)
+    -> result
+{
+  const auto bytes = detail::processable_bytes(surface.get());
+  if (bytes == 0 || radius < 0) {
+    return failure;
+  }
+  else if (radius == 0 || surface.width() == 0 || surface.height() == 0) {
+    return success;
+  }
+
+  const detail::surface_pixel_lock lock {surface.get()};
+  if (!lock) {
+    return failure;
+  }
+
+  const auto width = surface.width();
+  const auto height = surface.height();
+  const auto pitch = surface.pitch();
+  const auto rowBytes = width * bytes;
+  auto* pixels = static_cast<uint8*>(surface.pixel_data());
+
+  // Used to divide the sums by the diameter of the box without a division
+  const auto reciprocal = static_cast<uint32>((1u << 24u) / static_cast<uint32>(2 * radius + 1));
+
+  std::vector<uint8> buffer(static_cast<usize>(rowBytes) * static_cast<usize>(height));
+
+  detail::dispatch_channels(bytes, [&](auto channels) {
+    detail::parallel_rows(pool, height, [&](const int begin, const int end) {
+      for (int y = begin; y < end; ++y) {
+        detail::box_blur_row<channels>(pixels + y * pitch,
+                                       buffer.data() + y * rowBytes,
+                                       width,
+                                       radius,
+                                       reciprocal);
+      }
+    });
+  });
+
+  detail::parallel_rows(pool, height, [&](const int begin, const int end) {
+    const auto row = [&](const int y) {
+      return buffer.data() + detail::clamp(y, 0, height - 1) * rowBytes;
+    };
+
+    std::vector<uint32> sums(static_cast<usize>(rowBytes));
+    for (int k = -radius; k <= radius; ++k) {
+      const auto* in = row(begin + k);
+      for (int i = 0; i < rowBytes; ++i) {
+        sums[static_cast<usize>(i)] += in[i];
+      }
+    }
+
+    for (int y = begin; y < end; ++y) {
+      auto* out = pixels + y * pitch;
+      const auto* added = row(y + radius + 1);
+      const auto* removed = row(y - radius);
+
+      for (int i = 0; i < rowBytes; ++i) {
+        auto& sum = sums[static_cast<usize>(i)];
+        out[i] = static_cast<uint8>((sum * reciprocal + (1u << 23u)) >> 24u);
+        sum = sum + added[i] - removed[i];
+      }
+    }
+  });
+
+  return success;
+}
+
+/**
+ * Blurs a surface in place with a separable Gaussian filter.
+ *
+ * \details The kernel covers three standard deviations on each side of a pixel. Pixels
+ * outside of the surface are treated as copies of the nearest edge pixel.
+ *
+ * \param surface the surface that will be blurred.
+ * \param sigma the standard deviation of the filter, in pixels. Zero does nothing.
+ * \param pool an optional thread pool used to process the image in parallel.
+ *
+ * \return `success` if the surface was blurred; `failure` otherwise.
+ */
+template <typename T>
+auto gaussian_blur(basic_surface<T>& surface, const float sigma, thread_pool* pool = nullptr)
+    -> result
+{
+  const auto bytes = detail::processable_bytes(surface.get());
+  if (bytes == 0 || sigma < 0) {
+    return failure;
+  }
+  else if (sigma == 0 || surface.width() == 0 || surface.height() == 0) {
+    return success;
+  }
+
+  const detail::surface_pixel_lock lock {surface.get()};
+  if (!lock) {
+    return failure;
+  }
+
+  const auto width = surface.width();
+  const auto height = surface.height();
+  const auto pitch = surface.pitch();
+  const auto rowBytes = width * bytes;
+  auto* pixels = static_cast<uint8*>(surface.pixel_data());
+
+  const auto kernel = detail::make_gaussian_kernel(sigma);
+  const auto radius = static_cast<int>(kernel.size() / 2);
+
+  std::vector<uint8> buffer(static_cast<usize>(rowBytes) * static_cast<usize>(height));
+
+  detail::dispatch_channels(bytes, [&](auto channels) {
+    detail::parallel_rows(pool, height, [&](const int begin, const int end) {
+      std::vector<int32> sums;
+      for (int y = begin; y < end; ++y) {
+        detail::convolve_row<channels>(pixels + y * pitch,
+                                       buffer.data() + y * rowBytes,
+                                       width,
+                                       kernel,
+                                       sums);
+      }
+    });
+  });
+
+  detail::parallel_rows(pool, height, [&](const int begin, const int end) {
+    std::vector<int32> sums(static_cast<usize>(rowBytes));
+
+    for (int y = begin; y < end; ++y) {
+      std::fill(sums.begin(), sums.end(), detail::filter_half);
+
+      for (int tap = -radius; tap <= radius; ++tap) {
+        const auto source = detail::clamp(y + tap, 0, height - 1);
+        detail::accumulate_row(sums.data(),
+                               buffer.data() + source * rowBytes,
+                               kernel[static_cast<usize>(tap + radius)],
+                               rowBytes);
+      }
+
+      detail::store_row(pixels + y * pitch, sums.data(), rowBytes);
+    }
+  });
+
+  return success;
+}
+
+/**
+ * Applies a color matrix to every pixel of a surface, in place.
+ *
+ * \details The matrix is converted to fixed-point coefficients in the byte order of the
+ * pixel format, so the same inner loop handles every supported format. Formats without an
+ * alpha channel are treated as opaque.
+ *
+ * \param surface the surface that will be transformed.
+ * \param matrix the color transformation.
+ * \param pool an optional thread pool used to process the image in parallel.
+ *
+ * \return `success` if the surface was transformed; `failure` otherwise.
+ */
+template <typename T>
+auto transform_colors(basic_surface<T>& surface,
+                      const color_matrix& matrix,
+                      thread_pool* pool = nullptr) -> result
+{
+  const auto layout = detail::layout_of(surface.format_info().format());
+  if (layout.bytes == 0) {
+    return failure;
+  }
+
+  const detail::surface_pixel_lock lock {surface.get()};
+  if (!lock) {
+    return failure;
+  }
+
+  constexpr int bits = 12;
+  constexpr float one = 1 << bits;
+
+  // Indexed by input byte and output byte, padding bytes are passed through unchanged
+  std::array<std::array<int32, 4>, 4> columns {};
+  std::array<int32, 4> offsets {};
+
+  for (usize b = 0; b < static_cast<usize>(layout.bytes); ++b) {
+    columns[b][b] = 1 << bits;
+    offsets[b] = 1 << (bits - 1);
+  }
+
+  for (usize out = 0; out < 4; ++out) {
+    const auto outByte = layout.channels[out];
+    if (outByte == -1) {
+      continue;
+    }
+
+    const auto target = static_cast<usize>(outByte);
+    for (auto& column : columns) {
+      column[target] = 0;
+    }
+
+    auto offset = matrix.rows[out][4] * 255.0f * one;
+    for (usize in = 0; in < 4; ++in) {
+      const auto coefficient = matrix.rows[out][in] * one;
+      if (const auto inByte = layout.channels[in]; inByte != -1) {
+        columns[static_cast<usize>(inByte)][target] = static_cast<int32>(std::lround(coefficient));
+      }
+      else {
+        offset += coefficient * 255.0f;  // Missing alpha channels are treated as opaque
+      }
+    }
+
+    offsets[target] = static_cast<int32>(std::lround(offset)) + (1 << (bits - 1));
+  }
+
+  const auto width = surface.width();
+  const auto pitch = surface.pitch();
+  auto* pixels = static_cast<uint8*>(surface.pixel_data());
+
+  detail::dispatch_channels(layout.bytes, [&](auto channels) {
+    constexpr int n = channels;
+
+    detail::parallel_rows(pool, surface.height(), [&](const int begin, const int end) {
+      for (int y = begin; y < end; ++y) {
+        auto* pixel = pixels + y * pitch;
+        for (int x = 0; x < width; ++x, pixel += n) {
+          // Accumulating whole columns lets the compiler compute all outputs at once
+          int32 sums[4] {offsets[0], offsets[1], offsets[2], offsets[3]};
+          for (int k = 0; k < n; ++k) {
+            const int32 value = pixel[k];
+            const auto& column = columns[static_cast<usize>(k)];
+            for (usize b = 0; b < 4; ++b) {
+              sums[b] += column[b] * value;
+            }
+          }
+
+          for (int b = 0; b < n; ++b) {
+            pixel[b] = static_cast<uint8>(detail::clamp(sums[b] >> bits, 0, 255));
+          }
+        }
+      }
+    });
+  });
+
+  return success;
+}
+
+/**
+ * Applies a function to every pixel of a surface, in place.
+ *
+ * \details The function is invoked with a `color` and must return the new `color` of the
+ * pixel. It may be invoked concurrently from several threads if a thread pool is supplied.
+ *
+ * \param surface the surface that will be transformed.
+ * \param fn the function that computes the new color of each pixel.
+ * \param pool an optional thread pool used to process the image in parallel.
+ *
+ * \return `success` if the surface was transformed; `failure` otherwise.
+ */
+template <typename T, typename Fn>
+auto transform_pixels(basic_surface<T>& surface, const Fn& fn, thread_pool* pool = nullptr)
+    -> result
+{
+  const auto layout = detail::layout_of(surface.format_info().format());
+  if (layout.bytes == 0) {
+    return failure;
+  }
+
+  const detail::surface_pixel_lock lock {surface.get()};
+  if (!lock) {
+    return failure;
+  }
+
+  const auto [red, green, blue, alpha] = layout.channels;
+
+  const auto width = surface.width();
+  const auto pitch = surface.pitch();
+  auto* pixels = static_cast<uint8*>(surface.pixel_data());
+
+  detail::parallel_rows(pool, surface.height(), [&](const int begin, const int end) {
+    for (int y = begin; y < end; ++y) {
+      auto* pixel = pixels + y * pitch;
+      for (int x = 0; x < width; ++x, pixel += layout.bytes) {
+        const color input {pixel[red],
+                           pixel[green],
+                           pixel[blue],
+                           (alpha != -1) ? pixel[alpha] : uint8 {0xFF}};
+        const color output = fn(input);
+
+        pixel[red] = output.red();
+        pixel[green] = output.green();
+        pixel[blue] = output.blue();
+        if (alpha != -1) {
+          pixel[alpha] = output.alpha();
+        }
+      }
+    }
+  });
+
+  return success;
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_SURFACE_OPS_HPP_
@@ -28,7 +28,8 @@
 #include <SDL.h>
 
 #include <cassert>      // assert
-#include <cstddef>      // size_t
+#include <cstddef>      // size_t, ptrdiff_t
+#include <cstring>      // memcpy
 #include <ostream>      // ostream
 #include <string>       // string, to_string
 #include <string_view>  // string_view
@@ -37,6 +38,7 @@
 #include "../common/math.hpp"
 #include "../common/primitives.hpp"
 #include "../common/result.hpp"
+#include "../common/utils.hpp"
 #include "../detail/owner_handle_api.hpp"
 #include "../detail/stdlib.hpp"
 #include "../features.hpp"
@@ -112,6 +114,19 @@ inline auto operator<<(std::ostream& stream, const scale_mode mode) -> std::ostr
 
 #endif  // SDL_VERSION_ATLEAST(2, 0, 12)
 
+namespace detail {
+
+/// Returns the estimated amount of memory, in bytes, used by a texture.
+[[nodiscard]] constexpr auto texture_bytes(const int width,
+                                           const int height,
+                                           const uint32 format) noexcept -> usize
+{
+  return static_cast<usize>(width) * static_cast<usize>(height) *
+         static_cast<usize>(SDL_BYTESPERPIXEL(format));
+}
+
+}  // namespace detail
+
 template <typename T>
 class basic_texture;
 
@@ -179,6 +194,102 @@ class basic_texture final {
 
 #endif  // SDL_VERSION_ATLEAST(2, 0, 18)
 
+  /**
+   * Replaces the pixels of the texture.
+   *
+   * This is intended for static textures, prefer `texture_lock` for streaming textures, which
+   * avoids an additional copy of the pixel data.
+   *
+   * \param pixels the new pixel data, in the format of the texture.
+   * \param pitch the amount of bytes in a row of the pixel data.
+   *
+   * \return `success` if the texture was updated; `failure` otherwise.
+   */
+  auto update(const void* pixels, const int pitch) noexcept -> result
+  {
+    assert(pixels);
+    return SDL_UpdateTexture(mTexture, nullptr, pixels, pitch) == 0;
+  }
+
+  /// Replaces the pixels in an area of the texture.
+  auto update(const irect& area, const void* pixels, const int pitch) noexcept -> result
+  {
+    assert(pixels);
+    return SDL_UpdateTexture(mTexture, area.data(), pixels, pitch) == 0;
+  }
+
+  /// Replaces the pixels of the texture with the pixels of a surface of the same format.
+  template <typename TT>
+  auto update(const basic_surface<TT>& surface) noexcept -> result
+  {
+    assert(surface.format_info().format() == format());
+    return SDL_UpdateTexture(mTexture, nullptr, surface.pixel_data(), surface.pitch()) == 0;
+  }
+
+  /**
+   * Replaces the pixels of a planar YV12 or IYUV texture.
+   *
+   * \param y the Y plane pixel data.
+   * \param yPitch the amount of bytes in a row of the Y plane.
+   * \param u the U plane pixel data.
+   * \param uPitch the amount of bytes in a row of the U plane.
+   * \param v the V plane pixel data.
+   * \param vPitch the amount of bytes in a row of the V plane.
+   *
+   * \return `success` if the texture was updated; `failure` otherwise.
+   */
+  auto update_yuv(const uint8* y,
+                  const int yPitch,
+                  const uint8* u,
+                  const int uPitch,
+                  const uint8* v,
+                  const int vPitch) noexcept -> result
+  {
+    return SDL_UpdateYUVTexture(mTexture, nullptr, y, yPitch, u, uPitch, v, vPitch) == 0;
+  }
+
+  /// Replaces the pixels in an area of a planar YV12 or IYUV texture.
+  auto update_yuv(const irect& area,
+                  const uint8* y,
+                  const int yPitch,
+                  const uint8* u,
+                  const int uPitch,
+                  const uint8* v,
+                  const int vPitch) noexcept -> result
+  {
+    return SDL_UpdateYUVTexture(mTexture, area.data(), y, yPitch, u, uPitch, v, vPitch) == 0;
+  }
+
+#if SDL_VERSION_ATLEAST(2, 0, 16)
+
+  /**
+   * Replaces the pixels of a planar NV12 or NV21 texture.
+   *
+   * \param y the Y plane pixel data.
+   * \param yPitch the amount of bytes in a row of the Y plane.
+   * \param uv the interleaved UV (or VU) plane pixel data.
+   * \param uvPitch the amount of bytes in a row of the UV plane.
+   *
+   * \return `success` if the texture was updated; `failure` otherwise.
+   */
+  auto update_nv(const uint8* y, const int yPitch, const uint8* uv, const int uvPitch) noexcept
+      -> result
+  {
+    return SDL_UpdateNVTexture(mTexture, nullptr, y, yPitch, uv, uvPitch) == 0;
+  }
+
+  /// Replaces the pixels in an area of a planar NV12 or NV21 texture.
+  auto update_nv(const irect& area,
+                 const uint8* y,
+                 const int yPitch,
+                 const uint8* uv,
+                 const int uvPitch) noexcept -> result
+  {
+    return SDL_UpdateNVTexture(mTexture, area.data(), y, yPitch, uv, uvPitch) == 0;
+  }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 16)
+
   [[nodiscard]] auto size() const noexcept -> iarea
   {
     int width {};
@@ -288,6 +399,125 @@ class basic_texture final {
   detail::pointer<T, SDL_Texture> mTexture;
 };
 
+/**
+ * An RAII style lock of the pixels of a streaming texture.
+ *
+ * The locked pixels are write-only, and their initial contents are undefined, so every pixel
+ * in the locked area should be written. The changes are uploaded when the lock is destroyed.
+ * Writing directly to the locked pixels avoids an intermediate surface copy when streaming
+ * decoded video frames or procedurally generated images.
+ *
+ * \note For planar YUV formats, the pixels and pitch refer to the Y plane, which is directly
+ *       followed by the chroma planes.
+ *
+ * \see basic_texture::is_streaming
+ */
+class texture_lock final {
+ public:
+  /**
+   * Locks the pixels of a streaming texture.
+   *
+   * \param texture the texture that will be locked, must be streaming.
+   * \param area the area that will be locked, the entire texture is locked by default.
+   *
+   * \throws sdl_error if the texture could not be locked.
+   */
+  template <typename T>
+  CENTURION_NODISCARD_CTOR explicit texture_lock(basic_texture<T>& texture,
+                                                 const maybe<irect>& area = nothing)
+      : mTexture {texture.get()}
+      , mFormat {texture.format()}
+      , mArea {area.value_or(irect {0, 0, texture.width(), texture.height()})}
+  {
+    if (SDL_LockTexture(mTexture, area ? area->data() : nullptr, &mPixels, &mPitch) != 0) {
+      throw sdl_error {};
+    }
+  }
+
+  CENTURION_DISABLE_COPY(texture_lock)
+  CENTURION_DISABLE_MOVE(texture_lock)
+
+  ~texture_lock() noexcept { unlock(); }
+
+  /// Uploads the changes and unlocks the texture, the lock may not be used afterwards.
+  void unlock() noexcept
+  {
+    if (mPixels) {
+      SDL_UnlockTexture(mTexture);
+      mPixels = nullptr;
+    }
+  }
+
+  /**
+   * Copies rows of pixel data into the locked area.
+   *
+   * \param pixels the source pixels, in the format of the texture and of the locked size.
+   * \param pitch the amount of bytes in a row of the source pixels.
+   */
+  void write(const void* pixels, const int pitch) noexcept
+  {
+    assert(mPixels);
+    assert(pixels);
+
+    const auto rowSize = static_cast<usize>(mArea.width() * bytes_per_pixel());
+    const auto* source = static_cast<const uint8*>(pixels);
+
+    if (pitch == mPitch && rowSize == static_cast<usize>(mPitch)) {
+      std::memcpy(mPixels, source, rowSize * static_cast<usize>(mArea.height()));
+      return;
+    }
+
+    for (int y = 0; y < mArea.height(); ++y) {
+      std::memcpy(row<uint8>(y), source + static_cast<std::ptrdiff_t>(y) * pitch, rowSize);
+    }
+  }
+
+  /// Returns a pointer to the first pixel in a row of the locked area.
+  template <typename Pixel>
+  [[nodiscard]] auto row(const int y) noexcept -> Pixel*
+  {
+    assert(mPixels);
+    assert(y >= 0 && y < mArea.height());
+    assert(sizeof(Pixel) == 1 || sizeof(Pixel) == static_cast<usize>(bytes_per_pixel()));
+
+    auto* bytes = static_cast<uint8*>(mPixels) + static_cast<std::ptrdiff_t>(y) * mPitch;
+    return reinterpret_cast<Pixel*>(bytes);
+  }
+
+  /// Returns a pixel in the locked area, relative to the top-left corner of the area.
+  template <typename Pixel>
+  [[nodiscard]] auto at(const int x, const int y) noexcept -> Pixel&
+  {
+    assert(x >= 0 && x < mArea.width());
+    return row<Pixel>(y)[x];
+  }
+
+  [[nodiscard]] auto pixels() noexcept -> void* { return mPixels; }
+
+  /// Returns the amount of bytes in a row of the locked pixels, which may include padding.
+  [[nodiscard]] auto pitch() const noexcept -> int { return mPitch; }
+
+  [[nodiscard]] auto format() const noexcept -> pixel_format { return mFormat; }
+
+  /// Returns the locked area of the texture.
+  [[nodiscard]] auto area() const noexcept -> const irect& { return mArea; }
+
+  [[nodiscard]] auto bytes_per_pixel() const noexcept -> int
+  {
+    return SDL_BYTESPERPIXEL(to_underlying(mFormat));
+  }
+
+  /// Indicates whether the texture is still locked.
+  explicit operator bool() const noexcept { return mPixels != nullptr; }
+
+ private:
+  SDL_Texture* mTexture {};
+  pixel_format mFormat {pixel_format::unknown};
+  irect mArea;
+  void* mPixels {};
+  int mPitch {};
+};
+
 template <typename T>
 [[nodiscard]] auto to_string(const basic_texture<T>& texture) -> std::string
 {
@@ -0,0 +1,557 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_TEXTURE_ATLAS_HPP_
+#define CENTURION_VIDEO_TEXTURE_ATLAS_HPP_
+
+#include <SDL.h>
+
+#ifndef CENTURION_NO_SDL_IMAGE
+#include <SDL_image.h>
+#endif  // CENTURION_NO_SDL_IMAGE
+
+#include <algorithm>      // stable_sort
+#include <sstream>        // stringstream
+#include <string>         // string, getline, to_string
+#include <unordered_map>  // unordered_map
+#include <utility>        // move
+#include <vector>         // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/rect_packer.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "../io/file.hpp"
+#include "blend.hpp"
+#include "pixels.hpp"
+#include "renderer.hpp"
+#include "renderer_info.hpp"
+#include "surface.hpp"
+#include "texture.hpp"
+
+namespace cen {
+
+/**
+ * A lightweight reference to a rectangular region of a texture, such as an atlas page.
+ *
+ * The texture and region can be passed to the `basic_renderer::render()` overloads that
+ * accept a source rectangle. Sub-textures do not own their textures.
+ *
+ * \see texture_atlas
+ */
+class sub_texture final {
+ public:
+  sub_texture() noexcept = default;
+
+  sub_texture(SDL_Texture* texture, const irect& region) noexcept
+      : mTexture {texture}
+      , mRegion {region}
+  {
+  }
+
+  template <typename T>
+  auto render(basic_renderer<T>& renderer, const fpoint& pos) const noexcept -> result
+  {
+    return renderer.render(texture_handle {mTexture}, mRegion, frect {pos, size().as_f()});
+  }
+
+  template <typename T, typename Y>
+  auto render(basic_renderer<T>& renderer, const basic_rect<Y>& dst) const noexcept -> result
+  {
+    return renderer.render(texture_handle {mTexture}, mRegion, dst);
+  }
+
+  template <typename T, typename Y>
+  auto render(basic_renderer<T>& renderer,
+              const basic_rect<Y>& dst,
+              const double angle,
+              const renderer_flip flip = renderer_flip::none) const noexcept -> result
+  {
+    using value_t = typename basic_rect<Y>::value_type;
+    const basic_point<value_t> center {dst.width() / 2, dst.height() / 2};
+    return renderer.render(texture_handle {mTexture}, mRegion, dst, angle, center, flip);
+  }
+
+  /// Returns a handle to the texture that contains the region.
+  [[nodiscard]] auto atlas() const noexcept -> texture_handle
+  {
+    return texture_handle {mTexture};
+  }
+
+  [[nodiscard]] auto region() const noexcept -> const irect& { return mRegion; }
+
+  [[nodiscard]] auto width() const noexcept -> int { return mRegion.width(); }
+  [[nodiscard]] auto height() const noexcept -> int { return mRegion.height(); }
+  [[nodiscard]] auto size() const noexcept -> iarea { return mRegion.size(); }
+
+  [[nodiscard]] auto get() const noexcept -> SDL_Texture* { return mTexture; }
+
+  /// Indicates whether the sub-texture refers to a texture.
+  explicit operator bool() const noexcept { return mTexture != nullptr; }
+
+ private:
+  SDL_Texture* mTexture {};
+  irect mRegion;
+};
+
+/// Describes the location of a named image in a texture atlas.
+struct atlas_region final {
+  std::string name;
+  usize page {};  ///< The index of the atlas page that contains the image.
+  irect area;     ///< The area of the image on the page, excluding padding.
+};
+
+/**
+ * The packed pages of a texture atlas, as surfaces, along with the index of the images.
+ *
+ * Layouts are created by `atlas_builder`, and can either be uploaded directly or saved to
+ * disk, so that later runs can load the finished atlas without packing it again.
+ *
+ * \see atlas_builder
+ * \see texture_atlas
+ */
+struct atlas_layout final {
+  std::vector<surface> pages;
+  std::vector<atlas_region> regions;
+
+#ifndef CENTURION_NO_SDL_IMAGE
+
+  /**
+   * Saves the atlas pages as PNG images along with a text index.
+   *
+   * A layout saved with the prefix `"res/ui"` results in the files `"res/ui.atlas"`,
+   * `"res/ui_0.png"`, `"res/ui_1.png"`, and so on. The index refers to the page images
+   * relative to its own location.
+   *
+   * \param prefix the path of the index file, without its extension.
+   *
+   * \return `success` if all files were written; `failure` otherwise.
+   *
+   * \see texture_atlas::load()
+   */
+  auto save(const std::string& prefix) const -> result
+  {
+    const auto separator = prefix.find_last_of("/\\");
+    const auto stem = (separator == std::string::npos) ? prefix : prefix.substr(separator + 1);
+
+    std::stringstream index;
+    index << "centurion-atlas 1\n";
+    index << "pages " << pages.size() << '\n';
+
+    for (usize page = 0; page < pages.size(); ++page) {
+      const auto suffix = "_" + std::to_string(page) + ".png";
+      if (!pages[page].save_as_png(prefix + suffix)) {
+        return failure;
+      }
+
+      index << stem << suffix << '\n';
+    }
+
+    index << "regions " << regions.size() << '\n';
+    for (const auto& region : regions) {
+      const auto& area = region.area;
+      index << region.page << ' ' << area.x() << ' ' << area.y() << ' ' << area.width() << ' '
+            << area.height() << ' ' << region.name << '\n';
+    }
+
+    file output {prefix + ".atlas", file_mode::wb};
+    if (!output) {
+      return failure;
+    }
+
+    const auto contents = index.str();
+    return output.write(contents) == contents.size();
+  }
+
+#endif  // CENTURION_NO_SDL_IMAGE
+};
+
+/**
+ * Packs many small images into a few large atlas pages.
+ *
+ * Images are sorted by height and packed into pages using the skyline heuristic of
+ * `rect_packer`, a new page is only started when an image does not fit on any of the
+ * existing pages. Each page is cropped to the area that is actually used.
+ *
+ * \see texture_atlas
+ * \see rect_packer
+ */
+class atlas_builder final {
+ public:
+  /**
+   * Creates an atlas builder.
+   *
+   * \param maxPageSize the maximum size of each atlas page.
+   * \param padding the amount of transparent pixels around each image, avoids bleeding
+   * between neighbouring images when the atlas is sampled with linear filtering.
+   */
+  explicit atlas_builder(const iarea maxPageSize = {2'048, 2'048}, const int padding = 1)
+      : mMaxPageSize {maxPageSize}
+      , mPadding {detail::max(padding, 0)}
+  {
+    if (mMaxPageSize.width <= 0 || mMaxPageSize.height <= 0) {
+      throw exception {"Invalid texture atlas page size!"};
+    }
+  }
+
+  /// Creates an atlas builder that uses the largest texture size supported by a renderer.
+  template <typename T>
+  explicit atlas_builder(const basic_renderer<T>& renderer, const int padding = 1)
+      : atlas_builder {max_page_size(renderer), padding}
+  {
+  }
+
+  /**
+   * Adds an image to the atlas.
+   *
+   * \param name the unique name of the image.
+   * \param image the image that will be packed.
+   */
+  void add(std::string name, surface image)
+  {
+    if (mNames.find(name) != mNames.end()) {
+      throw exception {"Duplicate texture atlas image name!"};
+    }
+
+    mNames.try_emplace(name, mImages.size());
+    mImages.push_back(entry {std::move(name), std::move(image)});
+  }
+
+#ifndef CENTURION_NO_SDL_IMAGE
+
+  /// Loads an image and adds it to the atlas.
+  void add(std::string name, const char* path) { add(std::move(name), surface {path}); }
+
+  void add(std::string name, const std::string& path) { add(std::move(name), path.c_str()); }
+
+#endif  // CENTURION_NO_SDL_IMAGE
+
+  /**
+   * Packs all added images into atlas pages.
+   *
+   * \return the packed atlas pages and the index of the images.
+   *
+   * \throws exception if an image is larger than the maximum page size.
+   */
+  [[nodiscard]] auto build() -> atlas_layout
+  {
+    std::vector<usize> order;
+    order.reserve(mImages.size());
+
+    for (usize index = 0; index < mImages.size(); ++index) {
+      order.push_back(index);
+    }
+
+    std::stable_sort(order.begin(), order.end(), [this](const usize a, const usize b) {
+      const auto& lhs = mImages[a].image;
+      const auto& rhs = mImages[b].image;
+      return (lhs.height() != rhs.height()) ? (lhs.height() > rhs.height())
+                                            : (lhs.width() > rhs.width());
+    });
+
+    std::vector<rect_packer> packers;
+    std::vector<iarea> used;
+
+    atlas_layout layout;
+    layout.regions.resize(mImages.size());
+
+    for (const auto index : order) {
+      const auto& image = mImages[index];
+      const iarea padded {image.image.width() + 2 * mPadding,
+                          image.image.height() + 2 * mPadding};
+
+      maybe<irect> slot;
+      usize page = 0;
+
+      for (; page < packers.size() && !slot; ++page) {
+        slot = packers[page].insert(padded);
+      }
+
+      if (slot) {
+        --page;
+      }
+      else {
+        slot = packers.emplace_back(mMaxPageSize).insert(padded);
+        used.push_back({0, 0});
+
+        if (!slot) {
+          throw exception {"Image is too large for the texture atlas!"};
+        }
+      }
+
+      used[page].width = detail::max(used[page].width, slot->max_x());
+      used[page].height = detail::max(used[page].height, slot->max_y());
+
+      layout.regions[index] = atlas_region {image.name,
+                                            page,
+                                            irect {slot->x() + mPadding,
+                                                   slot->y() + mPadding,
+                                                   image.image.width(),
+                                                   image.image.height()}};
+    }
+
+    layout.pages.reserve(used.size());
+    for (const auto& size : used) {
+      layout.pages.emplace_back(size, pixel_format::rgba32);
+    }
+
+    for (usize index = 0; index < mImages.size(); ++index) {
+      auto& image = mImages[index].image;
+      const auto& region = layout.regions[index];
+
+      // Copy the pixels as they are, including the alpha channel
+      const auto mode = image.get_blend_mode();
+      image.set_blend_mode(blend_mode::none);
+
+      SDL_Rect dst = region.area.get();
+      if (SDL_BlitSurface(image.get(), nullptr, layout.pages[region.page].get(), &dst) != 0) {
+        image.set_blend_mode(mode);
+        throw sdl_error {};
+      }
+
+      image.set_blend_mode(mode);
+    }
+
+    return layout;
+  }
+
+  /// Removes all added images.
+  void clear() noexcept
+  {
+    mImages.clear();
+    mNames.clear();
+  }
+
+  /// Returns the amount of added images.
+  [[nodiscard]] auto size() const noexcept -> usize { return mImages.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mImages.empty(); }
+
+  [[nodiscard]] auto max_page_size() const noexcept -> iarea { return mMaxPageSize; }
+
+  [[nodiscard]] auto padding() const noexcept -> int { return mPadding; }
+
+  /// Returns the largest texture size supported by a renderer, or a default if unlimited.
+  template <typename T>
+  [[nodiscard]] static auto max_page_size(const basic_renderer<T>& renderer) -> iarea
+  {
+    constexpr int fallback = 4'096;
+
+    auto size = get_info(renderer).value().max_texture_size();
+    size.width = (size.width > 0) ? size.width : fallback;
+    size.height = (size.height > 0) ? size.height : fallback;
+
+    return size;
+  }
+
+ private:
+  struct entry final {
+    std::string name;
+    surface image;
+  };
+
+  iarea mMaxPageSize;
+  int mPadding {};
+  std::vector<entry> mImages;
+  std::unordered_map<std::string, usize> mNames;
+};
+
+/**
+ * A set of atlas pages uploaded as textures, with named sub-texture lookup.
+ *
+ * Rendering many images from the same atlas page avoids texture switches, which makes it
+ * possible to batch the draw calls, for example with `sprite_batch`.
+ *
+ * \see atlas_builder
+ * \see sub_texture
+ */
+class texture_atlas final {
+ public:
+  texture_atlas() = default;
+
+  /// Uploads the pages of a packed atlas.
+  template <typename T>
+  texture_atlas(basic_renderer<T>& renderer, const atlas_layout& layout)
+  {
+    mPages.reserve(layout.pages.size());
+    for (const auto& page : layout.pages) {
+      mPages.push_back(renderer.make_texture(page));
+    }
+
+    for (const auto& region : layout.regions) {
+      add_region(region);
+    }
+  }
+
+#ifndef CENTURION_NO_SDL_IMAGE
+
+  /**
+   * Loads an atlas that was saved with `atlas_layout::save()`.
+   *
+   * \param renderer the renderer used to create the page textures.
+   * \param prefix the path of the index file, without its extension.
+   *
+   * \return the loaded atlas.
+   *
+   * \throws exception if the index is invalid.
+   */
+  template <typename T>
+  [[nodiscard]] static auto load(basic_renderer<T>& renderer, const std::string& prefix)
+      -> texture_atlas
+  {
+    file input {prefix + ".atlas", file_mode::rb};
+    if (!input) {
+      throw sdl_error {};
+    }
+
+    std::string contents;
+    contents.resize(input.size().value_or(0));
+
+    if (input.read_to(contents) != contents.size()) {
+      throw sdl_error {};
+    }
+
+    const auto separator = prefix.find_last_of("/\\");
+    const auto directory =
+        (separator == std::string::npos) ? std::string {} : prefix.substr(0, separator + 1);
+
+    std::stringstream index {contents};
+    std::string tag;
+    int version {};
+    usize pageCount {};
+
+    if (!(index >> tag >> version) || tag != "centurion-atlas" || version != 1) {
+      throw exception {"Unsupported texture atlas index!"};
+    }
+
+    if (!(index >> tag >> pageCount) || tag != "pages") {
+      throw exception {"Malformed texture atlas index!"};
+    }
+
+    texture_atlas atlas;
+    atlas.mPages.reserve(pageCount);
+
+    index.ignore(1);
+
+    /* Page names are stored one per line, since they may contain spaces */
+    for (usize page = 0; page < pageCount; ++page) {
+      std::string name;
+      if (!std::getline(index, name) || name.empty()) {
+        throw exception {"Malformed texture atlas index!"};
+      }
+
+      atlas.mPages.push_back(renderer.make_texture(directory + name));
+    }
+
+    usize regionCount {};
+    if (!(index >> tag >> regionCount) || tag != "regions") {
+      throw exception {"Malformed texture atlas index!"};
+    }
+
+    for (usize i = 0; i < regionCount; ++i) {
+      atlas_region region;
+      int x {};
+      int y {};
+      int width {};
+      int height {};
+
+      if (!(index >> region.page >> x >> y >> width >> height) ||
+          region.page >= pageCount) {
+        throw exception {"Malformed texture atlas index!"};
+      }
+
+      index.ignore(1);
+      std::getline(index, region.name);
+
+      region.area = irect {x, y, width, height};
+      atlas.add_region(region);
+    }
+
+    return atlas;
+  }
+
+#endif  // CENTURION_NO_SDL_IMAGE
+
+  /// Returns the sub-texture with the specified name, if there is one.
+  [[nodiscard]] auto find(const std::string& name) const -> maybe<sub_texture>
+  {
+    if (const auto it = mIndex.find(name); it != mIndex.end()) {
+      return mRegions[it->second];
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  /**
+   * Returns the sub-texture with the specified name.
+   *
+   * \throws exception if there is no image with the specified name.
+   */
+  [[nodiscard]] auto at(const std::string& name) const -> sub_texture
+  {
+    if (const auto it = mIndex.find(name); it != mIndex.end()) {
+      return mRegions[it->second];
+    }
+    else {
+      throw exception {"Did not find texture atlas image!"};
+    }
+  }
+
+  [[nodiscard]] auto contains(const std::string& name) const -> bool
+  {
+    return mIndex.find(name) != mIndex.end();
+  }
+
+  /// Returns the texture of an atlas page.
+  [[nodiscard]] auto page(const usize index) const -> const texture&
+  {
+    return mPages.at(index);
+  }
+
+  [[nodiscard]] auto page_count() const noexcept -> usize { return mPages.size(); }
+
+  /// Returns the amount of images in the atlas.
+  [[nodiscard]] auto size() const noexcept -> usize { return mRegions.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mRegions.empty(); }
+
+ private:
+  std::vector<texture> mPages;
+  std::vector<sub_texture> mRegions;
+  std::unordered_map<std::string, usize> mIndex;
+
+  void add_region(const atlas_region& region)
+  {
+    mIndex.insert_or_assign(region.name, mRegions.size());
+    mRegions.emplace_back(mPages.at(region.page).get(), region.area);
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_TEXTURE_ATLAS_HPP_
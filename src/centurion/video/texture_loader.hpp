@@ -0,0 +1,475 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_TEXTURE_LOADER_HPP_
+#define CENTURION_VIDEO_TEXTURE_LOADER_HPP_
+
+#ifndef CENTURION_NO_SDL_IMAGE
+
+#include <SDL.h>
+#include <SDL_image.h>
+
+#include <atomic>       // atomic
+#include <cassert>      // assert
+#include <cstddef>      // ptrdiff_t
+#include <memory>       // shared_ptr, make_shared
+#include <ostream>      // ostream
+#include <string>       // string
+#include <string_view>  // string_view
+#include <utility>      // move
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/locks.hpp"
+#include "../concurrency/mutex.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../features.hpp"
+#include "../io/file.hpp"
+#include "../system/timer.hpp"
+#include "renderer.hpp"
+#include "surface.hpp"
+#include "texture.hpp"
+
+namespace cen {
+
+/// The priority of an asynchronously loaded texture, higher priorities are loaded first.
+enum class load_priority {
+  prefetch,  ///< Assets that might be needed later.
+  normal,    ///< Assets that will be needed soon.
+  visible    ///< Assets that are needed on screen right now.
+};
+
+[[nodiscard]] constexpr auto to_string(const load_priority priority) -> std::string_view
+{
+  switch (priority) {
+    case load_priority::prefetch:
+      return "prefetch";
+
+    case load_priority::normal:
+      return "normal";
+
+    case load_priority::visible:
+      return "visible";
+
+    default:
+      throw exception {"Did not recognize load priority!"};
+  }
+}
+
+inline auto operator<<(std::ostream& stream, const load_priority priority) -> std::ostream&
+{
+  return stream << to_string(priority);
+}
+
+/// The state of an asynchronously loaded texture.
+enum class load_status {
+  queued,    ///< Waiting to be decoded.
+  decoding,  ///< Being decoded by a worker thread.
+  decoded,   ///< Decoded, waiting to be uploaded by the render thread.
+  ready,     ///< Uploaded, the texture is available.
+  failed,    ///< The image could not be decoded or uploaded.
+  cancelled  ///< The request was cancelled before the texture became available.
+};
+
+[[nodiscard]] constexpr auto to_string(const load_status status) -> std::string_view
+{
+  switch (status) {
+    case load_status::queued:
+      return "queued";
+
+    case load_status::decoding:
+      return "decoding";
+
+    case load_status::decoded:
+      return "decoded";
+
+    case load_status::ready:
+      return "ready";
+
+    case load_status::failed:
+      return "failed";
+
+    case load_status::cancelled:
+      return "cancelled";
+
+    default:
+      throw exception {"Did not recognize load status!"};
+  }
+}
+
+inline auto operator<<(std::ostream& stream, const load_status status) -> std::ostream&
+{
+  return stream << to_string(status);
+}
+
+/**
+ * A handle to a texture that is being loaded by a texture loader.
+ *
+ * The texture becomes available once the status of the request is `load_status::ready`.
+ * Handles are cheap to copy, and all copies refer to the same request. The loaded texture is
+ * owned by the request and is released when the last handle is destroyed.
+ *
+ * \see texture_loader
+ */
+class texture_request final {
+  friend class texture_loader;
+
+ public:
+  /// Creates an empty handle that does not refer to a request.
+  texture_request() noexcept = default;
+
+  /**
+   * Cancels the request, if the texture is not yet available.
+   *
+   * Requests that have not been decoded are skipped by the workers, and decoded images are
+   * discarded instead of being uploaded.
+   */
+  void cancel() noexcept
+  {
+    if (mState) {
+      mState->cancelled = true;
+    }
+  }
+
+  /// Changes the priority of the request, only affects requests that are not yet uploaded.
+  void set_priority(const load_priority priority) noexcept
+  {
+    if (mState) {
+      mState->priority = priority;
+    }
+  }
+
+  /// Returns the loaded texture, or null if the texture is not available.
+  [[nodiscard]] auto get() const noexcept -> const texture*
+  {
+    return is_ready() ? &*mState->result : nullptr;
+  }
+
+  [[nodiscard]] auto status() const noexcept -> load_status
+  {
+    if (!mState) {
+      return load_status::cancelled;
+    }
+
+    const auto status = mState->status.load();
+    if (mState->cancelled && status != load_status::ready && status != load_status::failed) {
+      return load_status::cancelled;
+    }
+
+    return status;
+  }
+
+  [[nodiscard]] auto is_ready() const noexcept -> bool
+  {
+    return mState && mState->status == load_status::ready;
+  }
+
+  /// Indicates whether the request has been completed, successfully or not.
+  [[nodiscard]] auto is_done() const noexcept -> bool
+  {
+    const auto current = status();
+    return current == load_status::ready || current == load_status::failed ||
+           current == load_status::cancelled;
+  }
+
+  [[nodiscard]] auto priority() const noexcept -> load_priority
+  {
+    return mState ? mState->priority.load() : load_priority::prefetch;
+  }
+
+  [[nodiscard]] auto path() const noexcept -> const std::string&
+  {
+    assert(mState);
+    return mState->path;
+  }
+
+  /// Returns a description of the error, if the request failed.
+  [[nodiscard]] auto error() const noexcept -> const std::string&
+  {
+    assert(mState);
+    return mState->error;
+  }
+
+  /// Indicates whether the handle refers to a request.
+  explicit operator bool() const noexcept { return mState != nullptr; }
+
+ private:
+  struct state final {
+    std::string path;
+    std::atomic<load_priority> priority {load_priority::normal};
+    std::atomic<load_status> status {load_status::queued};
+    std::atomic<bool> cancelled {false};
+    maybe<surface> image;   ///< Written by a worker, before the status is set to decoded.
+    maybe<texture> result;  ///< Written by the render thread, before the status is ready.
+    std::string error;      ///< Written before the status is set to failed.
+  };
+
+  std::shared_ptr<state> mState;
+
+  explicit texture_request(std::shared_ptr<state> state) noexcept : mState {std::move(state)}
+  {
+  }
+};
+
+/**
+ * Loads textures without stalling the render thread.
+ *
+ * Images are decoded into surfaces by worker threads, and the decoded surfaces are uploaded
+ * as textures by the render thread in `upload()`, which should be called once per frame with
+ * a time budget. Both stages process the requests with the highest priority first, so that
+ * on-screen assets are not held up by prefetched assets.
+ *
+ * \see texture_request
+ * \see thread_pool
+ */
+class texture_loader final {
+ public:
+  using ms_type = millis<double>;
+
+  /**
+   * Creates a texture loader.
+   *
+   * \param threads the amount of worker threads used to decode images.
+   */
+  CENTURION_NODISCARD_CTOR explicit texture_loader(
+      const usize threads = thread_pool::default_size())
+      : mWorkers {threads}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(texture_loader)
+  CENTURION_DISABLE_MOVE(texture_loader)
+
+  ~texture_loader() noexcept
+  {
+    {
+      scoped_lock lock {mMutex};
+      mStopping = true;
+    }
+
+    cancel_all();
+  }
+
+  /**
+   * Queues an image to be decoded and uploaded.
+   *
+   * \param path the file path of the image.
+   * \param priority the initial priority of the request.
+   *
+   * \return a handle to the request.
+   */
+  auto load(std::string path, const load_priority priority = load_priority::normal)
+      -> texture_request
+  {
+    auto state = std::make_shared<texture_request::state>();
+    state->path = std::move(path);
+    state->priority = priority;
+
+    {
+      scoped_lock lock {mMutex};
+      mQueued.push_back(state);
+    }
+
+    // Each task decodes whichever queued request has the highest priority when it runs
+    mWorkers.submit([this] { decode_next(); });
+
+    return texture_request {std::move(state)};
+  }
+
+  /**
+   * Uploads decoded images as textures, until the time budget is exhausted.
+   *
+   * This must be called on the thread that created the renderer. At least one image is
+   * uploaded if there is one available, even if that exceeds the budget.
+   *
+   * \param renderer the renderer used to create the textures.
+   * \param budget the maximum amount of time to spend uploading textures.
+   *
+   * \return the amount of uploaded textures.
+   */
+  template <typename T>
+  auto upload(basic_renderer<T>& renderer, const ms_type budget = ms_type {2.0}) -> usize
+  {
+    const auto start = now();
+    const auto ticksPerMs = static_cast<double>(frequency()) / 1'000.0;
+
+    usize uploaded = 0;
+
+    while (auto state = next_upload()) {
+      if (!state->cancelled) {
+        try {
+          state->result.emplace(renderer.make_texture(*state->image));
+          state->status = load_status::ready;
+          ++uploaded;
+        }
+        catch (const exception& e) {
+          fail(*state, e.what());
+        }
+      }
+
+      state->image.reset();
+
+      const auto elapsed = static_cast<double>(now() - start) / ticksPerMs;
+      if (elapsed >= budget.count()) {
+        break;
+      }
+    }
+
+    return uploaded;
+  }
+
+  /// Cancels all requests that are not yet uploaded.
+  void cancel_all() noexcept
+  {
+    scoped_lock lock {mMutex};
+
+    for (auto& state : mQueued) {
+      state->cancelled = true;
+    }
+
+    for (auto& state : mDecoded) {
+      state->cancelled = true;
+    }
+  }
+
+  /// Blocks until all queued images have been decoded, they still have to be uploaded.
+  void wait_decoded() { mWorkers.wait(); }
+
+  /// Returns the amount of requests that are waiting to be decoded or being decoded.
+  [[nodiscard]] auto decoding() -> usize
+  {
+    scoped_lock lock {mMutex};
+    return mQueued.size() + mDecoding;
+  }
+
+  /// Returns the amount of decoded images that are waiting to be uploaded.
+  [[nodiscard]] auto awaiting_upload() -> usize
+  {
+    scoped_lock lock {mMutex};
+    return mDecoded.size();
+  }
+
+  /// Indicates whether there are no requests in progress.
+  [[nodiscard]] auto idle() -> bool
+  {
+    scoped_lock lock {mMutex};
+    return mQueued.empty() && mDecoding == 0 && mDecoded.empty();
+  }
+
+  [[nodiscard]] auto thread_count() const noexcept -> usize { return mWorkers.size(); }
+
+ private:
+  using state_ptr = std::shared_ptr<texture_request::state>;
+
+  mutex mMutex;
+  std::vector<state_ptr> mQueued;   ///< Requests waiting to be decoded.
+  std::vector<state_ptr> mDecoded;  ///< Requests waiting to be uploaded.
+  usize mDecoding {};
+  bool mStopping {};  ///< Cancels requests that are being decoded during destruction.
+  thread_pool mWorkers;  ///< Declared last, so that it is joined first.
+
+  /// Removes and returns the request with the highest priority, the oldest one on ties.
+  [[nodiscard]] static auto take_best(std::vector<state_ptr>& requests) -> state_ptr
+  {
+    if (requests.empty()) {
+      return nullptr;
+    }
+
+    usize best = 0;
+    for (usize index = 1; index < requests.size(); ++index) {
+      if (to_underlying(requests[index]->priority.load()) >
+          to_underlying(requests[best]->priority.load())) {
+        best = index;
+      }
+    }
+
+    auto state = std::move(requests[best]);
+    requests.erase(requests.begin() + static_cast<std::ptrdiff_t>(best));
+
+    return state;
+  }
+
+  [[nodiscard]] auto next_upload() -> state_ptr
+  {
+    scoped_lock lock {mMutex};
+    return take_best(mDecoded);
+  }
+
+  void decode_next()
+  {
+    state_ptr state;
+
+    {
+      scoped_lock lock {mMutex};
+
+      state = take_best(mQueued);
+      if (!state) {
+        return;
+      }
+
+      ++mDecoding;
+    }
+
+    if (!state->cancelled) {
+      state->status = load_status::decoding;
+
+      try {
+        file source {state->path, file_mode::rb};
+        if (!source) {
+          throw sdl_error {};
+        }
+
+        state->image.emplace(source);
+      }
+      catch (const exception& e) {
+        fail(*state, e.what());
+      }
+    }
+
+    scoped_lock lock {mMutex};
+    --mDecoding;
+
+    if (mStopping) {
+      state->cancelled = true;
+    }
+
+    if (!state->cancelled && state->image) {
+      state->status = load_status::decoded;
+      mDecoded.push_back(std::move(state));
+    }
+  }
+
+  static void fail(texture_request::state& state, const char* what)
+  {
+    state.error = what ? what : "?";
+    state.status = load_status::failed;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_IMAGE
+#endif  // CENTURION_VIDEO_TEXTURE_LOADER_HPP_
@@ -0,0 +1,532 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_TEXTURE_MANAGER_HPP_
+#define CENTURION_VIDEO_TEXTURE_MANAGER_HPP_
+
+#include <SDL.h>
+
+#include <cassert>        // assert
+#include <cstring>        // memcmp
+#include <memory>         // unique_ptr, make_unique
+#include <string>         // string, to_string
+#include <unordered_map>  // unordered_map
+#include <utility>        // move, exchange
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "renderer.hpp"
+#include "surface.hpp"
+#include "texture.hpp"
+
+namespace cen {
+
+class texture_manager;
+
+namespace detail {
+
+struct managed_texture_entry final {
+  std::string key;
+  maybe<texture> image;   ///< The resident texture, empty if evicted.
+  maybe<surface> source;  ///< The source of textures that were not loaded from files.
+  usize bytes {};         ///< The estimated size of the texture, even when evicted.
+  usize refs {};          ///< The amount of live handles to the texture.
+  uint64 stamp {};        ///< The last time the texture was used, for eviction.
+};
+
+}  // namespace detail
+
+/// Provides statistics about the textures of a texture manager.
+struct texture_manager_stats final {
+  usize resident_bytes {};  ///< The estimated amount of memory used by resident textures.
+  usize resident {};        ///< The amount of textures that are currently loaded.
+  usize entries {};         ///< The amount of known textures, including evicted ones.
+  usize hits {};            ///< The amount of loads that reused a resident texture.
+  usize misses {};          ///< The amount of loads of previously unknown textures.
+  usize reloads {};         ///< The amount of loads of textures that had been evicted.
+  usize evictions {};       ///< The amount of textures that were evicted.
+};
+
+/**
+ * A reference-counted handle to a texture owned by a texture manager.
+ *
+ * The texture is kept resident as long as at least one handle refers to it. Handles must
+ * not outlive their manager.
+ *
+ * \see texture_manager
+ */
+class managed_texture final {
+  friend class texture_manager;
+
+ public:
+  managed_texture() noexcept = default;
+
+  managed_texture(const managed_texture& other) noexcept
+      : mManager {other.mManager}
+      , mEntry {other.mEntry}
+  {
+    if (mEntry) {
+      ++mEntry->refs;
+    }
+  }
+
+  managed_texture(managed_texture&& other) noexcept
+      : mManager {std::exchange(other.mManager, nullptr)}
+      , mEntry {std::exchange(other.mEntry, nullptr)}
+  {
+  }
+
+  ~managed_texture() noexcept { reset(); }
+
+  auto operator=(const managed_texture& other) noexcept -> managed_texture&
+  {
+    if (this != &other) {
+      reset();
+
+      mManager = other.mManager;
+      mEntry = other.mEntry;
+
+      if (mEntry) {
+        ++mEntry->refs;
+      }
+    }
+
+    return *this;
+  }
+
+  auto operator=(managed_texture&& other) noexcept -> managed_texture&
+  {
+    if (this != &other) {
+      reset();
+      mManager = std::exchange(other.mManager, nullptr);
+      mEntry = std::exchange(other.mEntry, nullptr);
+    }
+
+    return *this;
+  }
+
+  /// Releases the reference to the texture, which makes it eligible for eviction.
+  void reset() noexcept;
+
+  /**
+   * Returns the texture, and marks it as recently used.
+   *
+   * Textures that are used every frame are the last to be evicted once they are no longer
+   * referenced.
+   */
+  [[nodiscard]] auto get() const noexcept -> const texture&;
+
+  /// Returns the path or content key that identifies the texture.
+  [[nodiscard]] auto key() const noexcept -> const std::string&
+  {
+    assert(mEntry);
+    return mEntry->key;
+  }
+
+  /// Returns the amount of handles that refer to the same texture.
+  [[nodiscard]] auto use_count() const noexcept -> usize { return mEntry ? mEntry->refs : 0; }
+
+  /// Indicates whether the handle refers to a texture.
+  explicit operator bool() const noexcept { return mEntry != nullptr; }
+
+ private:
+  texture_manager* mManager {};
+  detail::managed_texture_entry* mEntry {};
+
+  managed_texture(texture_manager* manager, detail::managed_texture_entry* entry) noexcept
+      : mManager {manager}
+      , mEntry {entry}
+  {
+    ++mEntry->refs;
+  }
+};
+
+/**
+ * Deduplicates textures and keeps their estimated memory usage within a budget.
+ *
+ * Textures are identified either by their file path, or by a hash of the pixels of the
+ * surface they were created from, so loading the same image twice results in one texture.
+ * When the resident textures exceed the memory budget, the least recently used textures
+ * that are no longer referenced by any handle are released. The manager remembers evicted
+ * textures, and loading them again reloads them transparently.
+ *
+ * Textures created from surfaces keep a copy of the surface in system memory, so that they
+ * can be reloaded after being evicted.
+ *
+ * \see managed_texture
+ */
+class texture_manager final {
+  friend class managed_texture;
+
+ public:
+  /**
+   * Creates a texture manager.
+   *
+   * \param renderer the renderer used to create textures, must outlive the manager.
+   * \param budget the maximum estimated texture memory, in bytes.
+   */
+  template <typename T>
+  explicit texture_manager(const basic_renderer<T>& renderer,
+                           const usize budget = 256u * 1'024u * 1'024u)
+      : mRenderer {renderer.get()}
+      , mBudget {budget}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(texture_manager)
+  CENTURION_DISABLE_MOVE(texture_manager)
+
+#ifndef CENTURION_NO_SDL_IMAGE
+
+  /**
+   * Returns a handle to the texture loaded from a file.
+   *
+   * \param path the file path of the image.
+   *
+   * \return a handle to the texture.
+   *
+   * \throws img_error if the image cannot be loaded.
+   */
+  auto load(const std::string& path) -> managed_texture
+  {
+    auto& entry = make_resident(path, [this, &path](entry_type& entry) {
+      upload(entry, mRenderer.make_texture(path));
+    });
+
+    return acquire(entry);
+  }
+
+#endif  // CENTURION_NO_SDL_IMAGE
+
+  /**
+   * Returns a handle to a texture with the same contents as a surface.
+   *
+   * Surfaces with identical dimensions, formats and pixels share the same texture.
+   *
+   * \param image the source image.
+   *
+   * \return a handle to the texture.
+   *
+   * \throws sdl_error if the surface cannot be locked.
+   */
+  template <typename T>
+  auto load(const basic_surface<T>& image) -> managed_texture
+  {
+    auto& entry = make_resident(find_key(image), [this, &image](entry_type& entry) {
+      if (!entry.source) {
+        entry.source.emplace(SDL_DuplicateSurface(image.get()));
+      }
+
+      upload(entry, mRenderer.make_texture(*entry.source));
+    });
+
+    return acquire(entry);
+  }
+
+  /// Indicates whether a texture is currently loaded.
+  [[nodiscard]] auto is_resident(const std::string& key) const -> bool
+  {
+    const auto it = mEntries.find(key);
+    return it != mEntries.end() && it->second->image.has_value();
+  }
+
+  /// Sets the memory budget, and evicts unreferenced textures that exceed it.
+  void set_budget(const usize bytes)
+  {
+    mBudget = bytes;
+    trim();
+  }
+
+  [[nodiscard]] auto budget() const noexcept -> usize { return mBudget; }
+
+  /// Evicts all textures that are not referenced by any handle.
+  void evict_unused()
+  {
+    for (auto& [key, entry] : mEntries) {
+      if (entry->refs == 0 && entry->image) {
+        evict(*entry);
+      }
+    }
+  }
+
+  /// Evicts unused textures and forgets about them, including their source surfaces.
+  void purge()
+  {
+    for (auto it = mEntries.begin(); it != mEntries.end();) {
+      if (it->second->refs == 0) {
+        if (it->second->image) {
+          evict(*it->second);
+        }
+
+        it = mEntries.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+  }
+
+  [[nodiscard]] auto stats() const noexcept -> texture_manager_stats
+  {
+    auto stats = mStats;
+    stats.entries = mEntries.size();
+    return stats;
+  }
+
+  /// Resets the hit, miss, reload and eviction counters.
+  void reset_stats() noexcept
+  {
+    mStats.hits = 0;
+    mStats.misses = 0;
+    mStats.reloads = 0;
+    mStats.evictions = 0;
+  }
+
+  /// Returns the estimated amount of texture memory, in bytes, used by a texture.
+  template <typename T>
+  [[nodiscard]] static auto estimate_bytes(const basic_texture<T>& texture) noexcept -> usize
+  {
+    const auto [width, height] = texture.size();
+    return detail::texture_bytes(width, height, to_underlying(texture.format()));
+  }
+
+ private:
+  using entry_type = detail::managed_texture_entry;
+
+  renderer_handle mRenderer;
+  std::unordered_map<std::string, std::unique_ptr<entry_type>> mEntries;
+  texture_manager_stats mStats;
+  usize mBudget {};
+  uint64 mClock {};  ///< Incremented on every use of a texture.
+
+  auto find_or_add(const std::string& key) -> entry_type&
+  {
+    if (const auto it = mEntries.find(key); it != mEntries.end()) {
+      auto& entry = *it->second;
+
+      if (entry.image) {
+        ++mStats.hits;
+      }
+      else {
+        ++mStats.reloads;
+      }
+
+      return entry;
+    }
+
+    ++mStats.misses;
+
+    auto entry = std::make_unique<entry_type>();
+    entry->key = key;
+
+    return *mEntries.try_emplace(key, std::move(entry)).first->second;
+  }
+
+  /// Ensures that an entry has a texture, an entry that was just added is removed on failure.
+  template <typename Fn>
+  auto make_resident(const std::string& key, Fn&& make) -> entry_type&
+  {
+    const auto added = mEntries.find(key) == mEntries.end();
+    auto& entry = find_or_add(key);
+
+    if (!entry.image) {
+      try {
+        make(entry);
+      }
+      catch (...) {
+        if (added) {
+          mEntries.erase(key);
+        }
+
+        throw;
+      }
+    }
+
+    return entry;
+  }
+
+  void upload(entry_type& entry, texture image)
+  {
+    entry.bytes = estimate_bytes(image);
+    entry.image.emplace(std::move(image));
+
+    mStats.resident_bytes += entry.bytes;
+    ++mStats.resident;
+  }
+
+  auto acquire(entry_type& entry) -> managed_texture
+  {
+    entry.stamp = ++mClock;
+
+    managed_texture handle {this, &entry};
+    trim();
+
+    return handle;
+  }
+
+  void release(entry_type& entry) noexcept
+  {
+    assert(entry.refs > 0);
+    if (--entry.refs == 0 && mStats.resident_bytes > mBudget) {
+      trim();
+    }
+  }
+
+  void evict(entry_type& entry) noexcept
+  {
+    assert(entry.image);
+
+    entry.image.reset();
+    mStats.resident_bytes -= entry.bytes;
+    --mStats.resident;
+    ++mStats.evictions;
+  }
+
+  /// Evicts the least recently used unreferenced textures until the budget is respected.
+  void trim() noexcept
+  {
+    while (mStats.resident_bytes > mBudget) {
+      entry_type* oldest {};
+
+      for (auto& [key, entry] : mEntries) {
+        if (entry->refs == 0 && entry->image && (!oldest || entry->stamp < oldest->stamp)) {
+          oldest = entry.get();
+        }
+      }
+
+      if (!oldest) {
+        break;  // All resident textures are referenced
+      }
+
+      evict(*oldest);
+    }
+  }
+
+  auto touch(entry_type& entry) noexcept -> const texture&
+  {
+    entry.stamp = ++mClock;
+    return *entry.image;
+  }
+
+  /// Returns the key of a surface, skipping keys of surfaces with the same hash but other pixels.
+  template <typename T>
+  [[nodiscard]] auto find_key(const basic_surface<T>& image) const -> std::string
+  {
+    // The lock must not outlive this function, since locked surfaces can't be duplicated
+    const detail::surface_pixel_lock lock {image.get()};
+    if (!lock) {
+      throw sdl_error {};
+    }
+
+    auto key = content_key(image);
+    while (true) {
+      const auto it = mEntries.find(key);
+      if (it == mEntries.end() ||
+          (it->second->source && same_pixels(*it->second->source, image))) {
+        return key;
+      }
+
+      key += '+';  // Hash collision, probe for the next free key
+    }
+  }
+
+  /// Creates a key from the dimensions, format and a hash of the pixels of a surface.
+  template <typename T>
+  [[nodiscard]] static auto content_key(const basic_surface<T>& image) -> std::string
+  {
+    // 64-bit FNV-1a, over the visible part of each row
+    uint64 hash = 0xCBF29CE484222325u;
+
+    const auto* pixels = static_cast<const uint8*>(image.pixel_data());
+    const auto rowSize = row_size(image);
+
+    for (int y = 0; pixels && y < image.height(); ++y) {
+      const auto* row = pixels + static_cast<usize>(y) * static_cast<usize>(image.pitch());
+      for (usize x = 0; x < rowSize; ++x) {
+        hash = (hash ^ row[x]) * 0x100000001B3u;
+      }
+    }
+
+    return "#" + std::to_string(image.width()) + "x" + std::to_string(image.height()) + ":" +
+           std::to_string(image.get()->format->format) + ":" + std::to_string(hash);
+  }
+
+  template <typename T>
+  [[nodiscard]] static auto row_size(const basic_surface<T>& image) noexcept -> usize
+  {
+    return static_cast<usize>(image.width()) *
+           static_cast<usize>(image.get()->format->BytesPerPixel);
+  }
+
+  template <typename T>
+  [[nodiscard]] static auto same_pixels(const surface& a, const basic_surface<T>& b) noexcept
+      -> bool
+  {
+    if (a.size() != b.size() || a.get()->format->format != b.get()->format->format) {
+      return false;
+    }
+
+    // Cached sources can be RLE encoded when textures are created from them
+    const detail::surface_pixel_lock lock {a.get()};
+
+    const auto* lhs = static_cast<const uint8*>(a.pixel_data());
+    const auto* rhs = static_cast<const uint8*>(b.pixel_data());
+    if (!lock || !lhs || !rhs) {
+      return false;
+    }
+
+    const auto rowSize = row_size(a);
+
+    for (int y = 0; y < a.height(); ++y) {
+      const auto* lhsRow = lhs + static_cast<usize>(y) * static_cast<usize>(a.pitch());
+      const auto* rhsRow = rhs + static_cast<usize>(y) * static_cast<usize>(b.pitch());
+      if (std::memcmp(lhsRow, rhsRow, rowSize) != 0) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+};
+
+inline void managed_texture::reset() noexcept
+{
+  if (mEntry) {
+    mManager->release(*mEntry);
+    mManager = nullptr;
+    mEntry = nullptr;
+  }
+}
+
+inline auto managed_texture::get() const noexcept -> const texture&
+{
+  assert(mEntry);
+  assert(mEntry->image);
+  return mManager->touch(*mEntry);
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_TEXTURE_MANAGER_HPP_
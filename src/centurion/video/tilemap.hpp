@@ -0,0 +1,420 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_TILEMAP_HPP_
+#define CENTURION_VIDEO_TILEMAP_HPP_
+
+#include <SDL.h>
+
+#include <cassert>  // assert
+#include <cmath>    // floor, ceil
+#include <vector>   // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../detail/stdlib.hpp"
+#include "blend.hpp"
+#include "color.hpp"
+#include "pixels.hpp"
+#include "renderer.hpp"
+#include "texture.hpp"
+
+namespace cen {
+
+/// Provides statistics about the latest rendered frame of a tilemap.
+struct tilemap_stats final {
+  usize baked {};     ///< The amount of chunks that were redrawn into their textures.
+  usize rendered {};  ///< The amount of visible chunks that were rendered.
+  usize culled {};    ///< The amount of chunks outside of the viewport that were skipped.
+};
+
+/**
+ * Renders a grid of tiles, by caching chunks of tiles in target textures.
+ *
+ * The map is divided into square chunks, which are drawn into their own target textures the
+ * first time they become visible, and redrawn only after one of their tiles has changed.
+ * Rendering the map then costs one texture copy per visible chunk, instead of one per tile.
+ * Use one tilemap for each static layer of a map.
+ *
+ * Tiles are identified by their index in the tileset, starting at one, where zero represents
+ * an empty tile. The tileset is interpreted as a grid of equally sized tiles, numbered from
+ * left to right and top to bottom.
+ *
+ * Note, the contents of target textures may be lost when the rendering device is reset, in
+ * which case `invalidate()` should be called.
+ */
+class tilemap final {
+ public:
+  using tile_type = uint32;
+
+  inline constexpr static tile_type empty_tile = 0;
+
+  /**
+   * Creates an empty tilemap.
+   *
+   * \param tileset the texture that contains the tile images, must outlive the tilemap.
+   * \param tileSize the size of each tile, in pixels.
+   * \param mapSize the size of the map, in tiles.
+   * \param chunkSize the width and height of each chunk, in tiles.
+   */
+  template <typename T>
+  tilemap(const basic_texture<T>& tileset,
+          const iarea tileSize,
+          const iarea mapSize,
+          const int chunkSize = 16)
+      : mTileset {tileset.get()}
+      , mTileSize {tileSize}
+      , mMapSize {mapSize}
+      , mChunkSize {chunkSize}
+  {
+    if (tileSize.width <= 0 || tileSize.height <= 0 || mapSize.width <= 0 ||
+        mapSize.height <= 0 || chunkSize <= 0) {
+      throw exception {"Invalid tilemap dimensions!"};
+    }
+
+    mColumns = detail::max(tileset.width() / tileSize.width, 1);
+
+    mChunkCols = (mapSize.width + chunkSize - 1) / chunkSize;
+    mChunkRows = (mapSize.height + chunkSize - 1) / chunkSize;
+
+    mTiles.resize(static_cast<usize>(mapSize.width) * static_cast<usize>(mapSize.height));
+    mChunks.resize(static_cast<usize>(mChunkCols) * static_cast<usize>(mChunkRows));
+  }
+
+  /// Changes a tile, only the chunk that contains the tile will be redrawn.
+  void set_tile(const int x, const int y, const tile_type tile)
+  {
+    assert(contains(x, y));
+
+    auto& current = mTiles[tile_index(x, y)];
+    if (current != tile) {
+      current = tile;
+      mChunks[chunk_index(x / mChunkSize, y / mChunkSize)].dirty = true;
+    }
+  }
+
+  [[nodiscard]] auto tile(const int x, const int y) const -> tile_type
+  {
+    assert(contains(x, y));
+    return mTiles[tile_index(x, y)];
+  }
+
+  /// Sets all tiles to the same value.
+  void fill(const tile_type tile)
+  {
+    for (auto& current : mTiles) {
+      current = tile;
+    }
+
+    invalidate();
+  }
+
+  /// Marks all chunks as changed, so that they are redrawn when they are visible.
+  void invalidate() noexcept
+  {
+    for (auto& chunk : mChunks) {
+      chunk.dirty = true;
+    }
+  }
+
+  /// Releases the textures of all chunks, they are recreated when needed.
+  void release_chunks() noexcept
+  {
+    for (auto& chunk : mChunks) {
+      chunk.image.reset();
+      chunk.dirty = true;
+    }
+  }
+
+  /**
+   * Renders the chunks that intersect the viewport of a renderer.
+   *
+   * Chunks with changed tiles are redrawn first, which temporarily changes the render target.
+   * The previous render target, viewport and clip area are restored afterwards. Chunks that
+   * could not be redrawn stay dirty and are not rendered.
+   *
+   * \param renderer the renderer that will render the map.
+   * \param camera the position of the map that is rendered at the top-left corner of the
+   * viewport.
+   *
+   * \return `success` if all chunks were rendered; `failure` otherwise.
+   */
+  template <typename T>
+  auto render(basic_renderer<T>& renderer, const fpoint& camera = {}) -> result
+  {
+    mStats = tilemap_stats {};
+
+    const auto viewport = renderer.viewport();
+    const auto chunkWidth = static_cast<float>(mChunkSize * mTileSize.width);
+    const auto chunkHeight = static_cast<float>(mChunkSize * mTileSize.height);
+
+    const auto firstCol = visible_begin(camera.x(), chunkWidth, mChunkCols);
+    const auto firstRow = visible_begin(camera.y(), chunkHeight, mChunkRows);
+    const auto lastCol =
+        visible_end(camera.x() + static_cast<float>(viewport.width()), chunkWidth, mChunkCols);
+    const auto lastRow =
+        visible_end(camera.y() + static_cast<float>(viewport.height()), chunkHeight, mChunkRows);
+
+    const auto visibleCols = detail::max(lastCol - firstCol, 0);
+    const auto visibleRows = detail::max(lastRow - firstRow, 0);
+    mStats.culled = mChunks.size() - static_cast<usize>(visibleCols * visibleRows);
+
+    bool ok = static_cast<bool>(bake_visible(renderer, firstCol, firstRow, lastCol, lastRow));
+
+    for (auto row = firstRow; row < lastRow; ++row) {
+      for (auto col = firstCol; col < lastCol; ++col) {
+        const auto& chunk = mChunks[chunk_index(col, row)];
+        if (!chunk.image || chunk.dirty) {
+          ok = false;
+          continue;
+        }
+
+        const auto size = chunk_tiles(col, row);
+        const frect dst {static_cast<float>(col) * chunkWidth - camera.x(),
+                         static_cast<float>(row) * chunkHeight - camera.y(),
+                         static_cast<float>(size.width * mTileSize.width),
+                         static_cast<float>(size.height * mTileSize.height)};
+
+        if (!renderer.render(*chunk.image, dst)) {
+          ok = false;
+        }
+
+        ++mStats.rendered;
+      }
+    }
+
+    return ok;
+  }
+
+  /// Indicates whether a tile position is within the bounds of the map.
+  [[nodiscard]] auto contains(const int x, const int y) const noexcept -> bool
+  {
+    return x >= 0 && y >= 0 && x < mMapSize.width && y < mMapSize.height;
+  }
+
+  /// Returns the source rectangle of a tile in the tileset.
+  [[nodiscard]] auto source(const tile_type tile) const noexcept -> irect
+  {
+    assert(tile != empty_tile);
+
+    const auto index = static_cast<int>(tile - 1);
+    return {(index % mColumns) * mTileSize.width,
+            (index / mColumns) * mTileSize.height,
+            mTileSize.width,
+            mTileSize.height};
+  }
+
+  /// Returns the statistics of the latest call to `render()`.
+  [[nodiscard]] auto stats() const noexcept -> const tilemap_stats& { return mStats; }
+
+  /// Returns the amount of chunks that currently have a texture.
+  [[nodiscard]] auto resident_chunks() const noexcept -> usize
+  {
+    usize count = 0;
+    for (const auto& chunk : mChunks) {
+      if (chunk.image) {
+        ++count;
+      }
+    }
+
+    return count;
+  }
+
+  [[nodiscard]] auto chunk_count() const noexcept -> usize { return mChunks.size(); }
+
+  [[nodiscard]] auto chunk_size() const noexcept -> int { return mChunkSize; }
+
+  [[nodiscard]] auto tile_size() const noexcept -> iarea { return mTileSize; }
+
+  /// Returns the size of the map, in tiles.
+  [[nodiscard]] auto size() const noexcept -> iarea { return mMapSize; }
+
+ private:
+  struct chunk_data final {
+    maybe<texture> image;
+    bool dirty {true};
+  };
+
+  SDL_Texture* mTileset {};
+  iarea mTileSize;
+  iarea mMapSize;
+  int mChunkSize {};
+  int mColumns {};    ///< The amount of tiles on each row of the tileset.
+  int mChunkCols {};  ///< The amount of chunks on each row of the map.
+  int mChunkRows {};  ///< The amount of chunks on each column of the map.
+  std::vector<tile_type> mTiles;
+  std::vector<chunk_data> mChunks;
+  tilemap_stats mStats;
+
+  [[nodiscard]] auto tile_index(const int x, const int y) const noexcept -> usize
+  {
+    return static_cast<usize>(y) * static_cast<usize>(mMapSize.width) + static_cast<usize>(x);
+  }
+
+  [[nodiscard]] auto chunk_index(const int col, const int row) const noexcept -> usize
+  {
+    return static_cast<usize>(row) * static_cast<usize>(mChunkCols) + static_cast<usize>(col);
+  }
+
+  /// Returns the size of a chunk in tiles, chunks at the edges of the map may be smaller.
+  [[nodiscard]] auto chunk_tiles(const int col, const int row) const noexcept -> iarea
+  {
+    return {detail::min(mChunkSize, mMapSize.width - col * mChunkSize),
+            detail::min(mChunkSize, mMapSize.height - row * mChunkSize)};
+  }
+
+  [[nodiscard]] static auto visible_begin(const float pos, const float size, const int count)
+      -> int
+  {
+    return detail::clamp(static_cast<int>(std::floor(pos / size)), 0, count);
+  }
+
+  [[nodiscard]] static auto visible_end(const float pos, const float size, const int count)
+      -> int
+  {
+    return detail::clamp(static_cast<int>(std::ceil(pos / size)), 0, count);
+  }
+
+  template <typename T>
+  auto bake_visible(basic_renderer<T>& renderer,
+                    const int firstCol,
+                    const int firstRow,
+                    const int lastCol,
+                    const int lastRow) -> result
+  {
+    /* Restores the render state and tileset blend mode, even if baking a chunk throws */
+    struct restore_state final {
+      basic_renderer<T>& renderer;
+      texture_handle tileset;
+      texture_handle previous {nullptr};
+      irect viewport {};
+      maybe<irect> clip {};
+      blend_mode mode {};
+      bool active {};
+
+      ~restore_state() noexcept
+      {
+        if (active) {
+          tileset.set_blend_mode(mode);
+
+          if (previous) {
+            renderer.set_target(previous);
+          }
+          else {
+            renderer.reset_target();
+          }
+
+          /* The viewport and clip area are reset when the render target changes */
+          renderer.set_viewport(viewport);
+
+          if (clip) {
+            renderer.set_clip(*clip);
+          }
+          else {
+            renderer.reset_clip();
+          }
+        }
+      }
+    } restore {renderer, texture_handle {mTileset}};
+
+    bool ok = true;
+
+    for (auto row = firstRow; row < lastRow; ++row) {
+      for (auto col = firstCol; col < lastCol; ++col) {
+        auto& chunk = mChunks[chunk_index(col, row)];
+        if (!chunk.dirty && chunk.image) {
+          continue;
+        }
+
+        if (!restore.active) {
+          restore.previous = renderer.get_target();
+          restore.viewport = renderer.viewport();
+          restore.clip = renderer.is_clipping_enabled() ? renderer.clip() : nothing;
+          restore.mode = restore.tileset.get_blend_mode();
+          restore.active = true;
+
+          // Copy the tiles as they are, since the chunks start out fully transparent
+          restore.tileset.set_blend_mode(blend_mode::none);
+        }
+
+        if (bake(renderer, chunk, col, row)) {
+          ++mStats.baked;
+        }
+        else {
+          ok = false;
+        }
+      }
+    }
+
+    return ok;
+  }
+
+  /// Redraws a chunk, which is left dirty if it cannot be made the render target.
+  template <typename T>
+  auto bake(basic_renderer<T>& renderer, chunk_data& chunk, const int col, const int row)
+      -> result
+  {
+    const auto size = chunk_tiles(col, row);
+
+    if (!chunk.image) {
+      chunk.image.emplace(renderer.make_texture(
+          iarea {size.width * mTileSize.width, size.height * mTileSize.height},
+          pixel_format::rgba8888,
+          texture_access::target));
+      chunk.image->set_blend_mode(blend_mode::blend);
+    }
+
+    if (!renderer.set_target(*chunk.image)) {
+      return failure;
+    }
+
+    renderer.clear_with(colors::transparent);
+
+    const texture_handle tileset {mTileset};
+    const auto baseX = col * mChunkSize;
+    const auto baseY = row * mChunkSize;
+
+    for (int y = 0; y < size.height; ++y) {
+      for (int x = 0; x < size.width; ++x) {
+        const auto tile = mTiles[tile_index(baseX + x, baseY + y)];
+        if (tile != empty_tile) {
+          const irect dst {x * mTileSize.width,
+                           y * mTileSize.height,
+                           mTileSize.width,
+                           mTileSize.height};
+          renderer.render(tileset, source(tile), dst);
+        }
+      }
+    }
+
+    chunk.dirty = false;
+    return success;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_TILEMAP_HPP_
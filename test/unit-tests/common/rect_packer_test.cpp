@@ -0,0 +1,117 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/common/rect_packer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>  // vector
+
+TEST(RectPacker, Defaults)
+{
+  const cen::rect_packer packer {{128, 64}};
+  ASSERT_EQ(128, packer.size().width);
+  ASSERT_EQ(64, packer.size().height);
+  ASSERT_EQ(0u, packer.used_area());
+  ASSERT_EQ(0.0f, packer.occupancy());
+}
+
+TEST(RectPacker, Insert)
+{
+  cen::rect_packer packer {{100, 100}};
+
+  const auto first = packer.insert({50, 50});
+  ASSERT_TRUE(first);
+  ASSERT_EQ(cen::irect(0, 0, 50, 50), *first);
+
+  const auto second = packer.insert({50, 50});
+  ASSERT_TRUE(second);
+  ASSERT_EQ(cen::irect(50, 0, 50, 50), *second);
+
+  ASSERT_EQ(5'000u, packer.used_area());
+  ASSERT_FLOAT_EQ(0.5f, packer.occupancy());
+
+  ASSERT_FALSE(packer.insert({101, 10}));
+  ASSERT_FALSE(packer.insert({10, 51}));
+  ASSERT_FALSE(packer.insert({0, 10}));
+}
+
+TEST(RectPacker, NoOverlap)
+{
+  cen::rect_packer packer {{256, 256}};
+  std::vector<cen::irect> rects;
+
+  for (int i = 0; i < 500; ++i) {
+    const cen::iarea size {4 + (i * 7) % 19, 4 + (i * 11) % 23};
+    if (const auto rect = packer.insert(size)) {
+      rects.push_back(*rect);
+    }
+  }
+
+  ASSERT_FALSE(rects.empty());
+
+  for (cen::usize i = 0; i < rects.size(); ++i) {
+    const auto& rect = rects[i];
+    ASSERT_GE(rect.x(), 0);
+    ASSERT_GE(rect.y(), 0);
+    ASSERT_LE(rect.max_x(), 256);
+    ASSERT_LE(rect.max_y(), 256);
+
+    for (auto j = i + 1; j < rects.size(); ++j) {
+      ASSERT_FALSE(cen::intersects(rect, rects[j]));
+    }
+  }
+}
+
+TEST(RectPacker, Grow)
+{
+  cen::rect_packer packer {{32, 32}};
+
+  const auto first = packer.insert({32, 32});
+  ASSERT_TRUE(first);
+  ASSERT_FALSE(packer.insert({16, 16}));
+
+  packer.grow({64, 64});
+  ASSERT_EQ(64, packer.size().width);
+  ASSERT_EQ(64, packer.size().height);
+
+  const auto second = packer.insert({32, 64});
+  ASSERT_TRUE(second);
+  ASSERT_FALSE(cen::intersects(*first, *second));
+
+  const auto third = packer.insert({32, 32});
+  ASSERT_TRUE(third);
+  ASSERT_FALSE(cen::intersects(*first, *third));
+  ASSERT_FALSE(cen::intersects(*second, *third));
+}
+
+TEST(RectPacker, Reset)
+{
+  cen::rect_packer packer {{32, 32}};
+  ASSERT_TRUE(packer.insert({32, 32}));
+
+  packer.reset();
+  ASSERT_EQ(0u, packer.used_area());
+  ASSERT_TRUE(packer.insert({32, 32}));
+}
@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "centurion/concurrency/thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>  // atomic
+
+#include "centurion/common/literals.hpp"
+
+TEST(ThreadPool, Size)
+{
+  cen::thread_pool pool {3};
+  ASSERT_EQ(3u, pool.size());
+  ASSERT_GE(cen::thread_pool::default_size(), 1u);
+}
+
+TEST(ThreadPool, SubmitAndWait)
+{
+  std::atomic<int> count {0};
+
+  cen::thread_pool pool {4};
+  for (int i = 0; i < 100; ++i) {
+    pool.submit([&count] { ++count; });
+  }
+
+  pool.wait();
+  ASSERT_EQ(100, count);
+  ASSERT_TRUE(pool.idle());
+  ASSERT_EQ(0u, pool.pending());
+}
+
+TEST(ThreadPool, Pending)
+{
+  using namespace cen::literals::time_literals;
+
+  cen::thread_pool pool {1};
+  pool.submit([] { cen::thread::sleep(50_ms); });
+  pool.submit([] {});
+
+  ASSERT_FALSE(pool.idle());
+  ASSERT_GE(pool.pending(), 1u);
+
+  pool.wait();
+  ASSERT_TRUE(pool.idle());
+}
+
+TEST(ThreadPool, ThrowingTask)
+{
+  std::atomic<int> count {0};
+
+  cen::thread_pool pool {1};
+  pool.submit([] { throw cen::exception {"foo"}; });
+  pool.submit([&count] { ++count; });
+
+  pool.wait();
+  ASSERT_EQ(1, count);
+}
+
+TEST(ThreadPool, DestructorRunsQueuedTasks)
+{
+  std::atomic<int> count {0};
+
+  {
+    cen::thread_pool pool {1};
+    for (int i = 0; i < 10; ++i) {
+      pool.submit([&count] { ++count; });
+    }
+  }
+
+  ASSERT_EQ(10, count);
+}
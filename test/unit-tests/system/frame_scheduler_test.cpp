@@ -0,0 +1,133 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/system/frame_scheduler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>  // vector
+
+TEST(FrameScheduler, Options)
+{
+  ASSERT_THROW(cen::frame_scheduler({0}), cen::exception);
+  ASSERT_THROW(cen::frame_scheduler({-60}), cen::exception);
+  ASSERT_THROW(cen::frame_scheduler({60, 0, 0, 0}), cen::exception);
+
+  const cen::frame_scheduler scheduler {{50, 100}};
+  ASSERT_EQ(0.02, scheduler.step().count());
+  ASSERT_EQ(0.0, scheduler.refresh_interval().count());
+  ASSERT_FALSE(scheduler.vsync_detected());
+
+  const cen::frame_scheduler vsync {{60, 0, 50}};
+  ASSERT_EQ(0.02, vsync.refresh_interval().count());
+}
+
+TEST(FrameScheduler, FirstFrame)
+{
+  cen::frame_scheduler scheduler;
+
+  int updates = 0;
+  double alpha = -1;
+  scheduler.tick([&](cen::seconds<double>) { ++updates; },
+                 [&](const double interpolation) { alpha = interpolation; });
+
+  // The first frame has no elapsed time to update with
+  ASSERT_EQ(0, updates);
+  ASSERT_EQ(0.0, alpha);
+  ASSERT_EQ(1u, scheduler.stats().frames);
+}
+
+TEST(FrameScheduler, FixedUpdates)
+{
+  cen::frame_scheduler scheduler {{200, 100}};
+
+  int frames = 0;
+  int updates = 0;
+  std::vector<double> alphas;
+
+  const auto start = cen::now_in_seconds();
+  scheduler.run([&] { return frames++ < 21; },
+                [&](const cen::seconds<double> step) {
+                  ASSERT_EQ(0.005, step.count());
+                  ++updates;
+                },
+                [&](const double alpha) { alphas.push_back(alpha); });
+  const auto elapsed = cen::now_in_seconds() - start;
+
+  // The frames are capped to 100 FPS, so there should be about two updates per frame
+  ASSERT_GE(elapsed.count(), 0.2);
+  ASSERT_GE(updates, 30);
+  ASSERT_LE(updates, 50);
+
+  for (const auto alpha : alphas) {
+    ASSERT_GE(alpha, 0.0);
+    ASSERT_LT(alpha, 1.0);
+  }
+
+  const auto stats = scheduler.stats();
+  ASSERT_EQ(21u, stats.frames);
+  ASSERT_EQ(static_cast<cen::usize>(updates), stats.updates);
+  ASSERT_GT(stats.mean.count(), 5.0);
+  ASSERT_GE(stats.p99, stats.mean);
+  ASSERT_GE(stats.max, stats.p99);
+}
+
+TEST(FrameScheduler, MaxUpdates)
+{
+  cen::frame_scheduler scheduler {{1'000, 0, 0, 3}};
+
+  int updates = 0;
+  const auto update = [&](cen::seconds<double>) { ++updates; };
+  const auto render = [](double) {};
+
+  scheduler.tick(update, render);
+  SDL_Delay(50);
+  scheduler.tick(update, render);
+
+  // A long frame only results in the maximum amount of updates
+  ASSERT_EQ(3, updates);
+  ASSERT_EQ(1u, scheduler.stats().dropped_frames);
+
+  scheduler.reset_clock();
+  SDL_Delay(20);
+  scheduler.tick(update, render);
+  ASSERT_EQ(3, updates);
+}
+
+TEST(FrameScheduler, PreciseSleeper)
+{
+  cen::precise_sleeper sleeper;
+
+  for (int i = 0; i < 5; ++i) {
+    const auto start = cen::now_in_seconds();
+    sleeper.sleep_for(cen::seconds<double> {0.0025});
+    const auto elapsed = cen::now_in_seconds() - start;
+
+    ASSERT_GE(elapsed.count(), 0.0025);
+  }
+
+  ASSERT_GT(sleeper.spin_threshold().count(), 0.0);
+
+  sleeper.sleep_for(cen::seconds<double> {-1.0});
+}
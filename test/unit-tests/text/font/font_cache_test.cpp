@@ -26,8 +26,10 @@
 
 #include <gtest/gtest.h>
 
-#include <memory>  // unique_ptr
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
 
+#include "centurion/concurrency/thread_pool.hpp"
 #include "centurion/video/renderer.hpp"
 #include "centurion/video/window.hpp"
 
@@ -236,4 +238,231 @@ TEST_F(FontCacheTest, GetFont)
 TEST_F(FontCacheTest, ToString)
 {
   ASSERT_EQ("font_cache(font: 'JetBrains Mono', size: 12)", cen::to_string(mCache));
-}
\ No newline at end of file
+}
+TEST_F(FontCacheTest, GlyphStorageToString)
+{
+  ASSERT_THROW(to_string(static_cast<cen::glyph_storage>(2)), cen::exception);
+
+  ASSERT_EQ("textures", to_string(cen::glyph_storage::textures));
+  ASSERT_EQ("atlas", to_string(cen::glyph_storage::atlas));
+
+  std::cout << "glyph_storage::atlas == " << cen::glyph_storage::atlas << '\n';
+}
+
+TEST_F(FontCacheTest, TextRenderModeToString)
+{
+  ASSERT_THROW(to_string(static_cast<cen::text_render_mode>(3)), cen::exception);
+
+  ASSERT_EQ("solid", to_string(cen::text_render_mode::solid));
+  ASSERT_EQ("shaded", to_string(cen::text_render_mode::shaded));
+  ASSERT_EQ("blended", to_string(cen::text_render_mode::blended));
+
+  std::cout << "text_render_mode::blended == " << cen::text_render_mode::blended << '\n';
+}
+
+TEST_F(FontCacheTest, FetchString)
+{
+  const auto& first = mCache.fetch_string(*mRenderer, "foo", cen::colors::white);
+  ASSERT_TRUE(first.get());
+
+  auto stats = mCache.string_stats();
+  ASSERT_EQ(0u, stats.hits);
+  ASSERT_EQ(1u, stats.misses);
+  ASSERT_EQ(1u, stats.count);
+  ASSERT_GT(stats.bytes, 0u);
+
+  const auto* ptr = first.get();
+  ASSERT_EQ(ptr, mCache.fetch_string(*mRenderer, "foo", cen::colors::white).get());
+
+  /* Different colors and render modes are cached separately */
+  mCache.fetch_string(*mRenderer, "foo", cen::colors::red);
+  mCache.fetch_string(*mRenderer, "foo", cen::colors::white, cen::text_render_mode::solid);
+  mCache.fetch_string(*mRenderer,
+                      "foo",
+                      cen::colors::white,
+                      cen::text_render_mode::shaded,
+                      cen::colors::blue);
+
+  stats = mCache.string_stats();
+  ASSERT_EQ(1u, stats.hits);
+  ASSERT_EQ(4u, stats.misses);
+  ASSERT_EQ(4u, stats.count);
+  ASSERT_EQ(0u, stats.evictions);
+
+  mCache.reset_string_stats();
+  ASSERT_EQ(0u, mCache.string_stats().hits);
+  ASSERT_EQ(0u, mCache.string_stats().misses);
+  ASSERT_EQ(4u, mCache.string_stats().count);
+
+  mCache.clear_strings();
+  ASSERT_EQ(0u, mCache.string_stats().count);
+  ASSERT_EQ(0u, mCache.string_stats().bytes);
+}
+
+TEST_F(FontCacheTest, FetchStringEviction)
+{
+  mCache.fetch_string(*mRenderer, "first", cen::colors::white);
+  const auto bytes = mCache.string_stats().bytes;
+
+  /* Only allow a single string to be cached */
+  mCache.set_string_budget(bytes);
+  ASSERT_EQ(bytes, mCache.string_budget());
+
+  mCache.fetch_string(*mRenderer, "second", cen::colors::white);
+
+  auto stats = mCache.string_stats();
+  ASSERT_EQ(1u, stats.count);
+  ASSERT_EQ(1u, stats.evictions);
+
+  /* The least recently used string was evicted */
+  mCache.fetch_string(*mRenderer, "second", cen::colors::white);
+  ASSERT_EQ(1u, mCache.string_stats().hits);
+
+  mCache.fetch_string(*mRenderer, "first", cen::colors::white);
+  ASSERT_EQ(3u, mCache.string_stats().misses);
+
+  /* The most recently fetched string is never evicted */
+  mCache.set_string_budget(0);
+  ASSERT_EQ(1u, mCache.string_stats().count);
+}
+
+TEST_F(FontCacheTest, StoreGlyphsAsync)
+{
+  cen::thread_pool pool {2};
+  mCache.store_glyphs_async(*mRenderer, pool, 0x20, 0x7F);
+
+  const auto requested = mCache.glyph_progress().requested;
+  ASSERT_GT(requested, 10u);
+  ASSERT_TRUE(mCache.is_loading());
+  ASSERT_FALSE(mCache.has_glyph('a'));
+
+  pool.wait();
+  ASSERT_EQ(requested, mCache.glyph_progress().rasterized);
+  ASSERT_EQ(0u, mCache.glyph_progress().uploaded);
+
+  ASSERT_EQ(10u, mCache.upload_glyphs(*mRenderer, 10));
+  ASSERT_EQ(10u, mCache.glyph_progress().uploaded);
+
+  while (mCache.is_loading()) {
+    mCache.upload_glyphs(*mRenderer);
+  }
+
+  ASSERT_EQ(requested, mCache.glyph_progress().uploaded);
+  ASSERT_TRUE(mCache.has_glyph('a'));
+  ASSERT_TRUE(mCache.has_glyph('~'));
+
+  /* Cached glyphs are not requested again */
+  mCache.store_glyphs_async(*mRenderer, pool, 0x20, 0x7F);
+  ASSERT_FALSE(mCache.is_loading());
+}
+
+TEST_F(FontCacheTest, CancelAsyncGlyphs)
+{
+  cen::thread_pool pool {1};
+  mCache.store_latin1_glyphs_async(*mRenderer, pool);
+
+  mCache.cancel_async_glyphs();
+  ASSERT_FALSE(mCache.is_loading());
+
+  const auto progress = mCache.glyph_progress();
+  ASSERT_EQ(progress.requested, progress.uploaded);
+}
+
+TEST_F(FontCacheTest, StoreGlyphsAsyncWithoutPath)
+{
+  cen::thread_pool pool {1};
+  cen::font_cache cache {cen::font {"resources/jetbrains_mono.ttf", 12}};
+  ASSERT_THROW(cache.store_glyphs_async(*mRenderer, pool, 0x20, 0x7F), cen::exception);
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+TEST_F(FontCacheTest, AtlasStorage)
+{
+  ASSERT_EQ(cen::glyph_storage::textures, mCache.storage());
+
+  mCache.enable_atlas();
+  ASSERT_EQ(cen::glyph_storage::atlas, mCache.storage());
+
+  mCache.store_latin1_glyphs(*mRenderer);
+  ASSERT_EQ(1u, mCache.atlas_page_count());
+
+  ASSERT_TRUE(mCache.has_glyph('a'));
+  ASSERT_FALSE(mCache.find_glyph('a'));
+  ASSERT_THROW(mCache.get_glyph('a'), cen::exception);
+
+  const auto* data = mCache.find_atlas_glyph('a');
+  ASSERT_TRUE(data);
+  ASSERT_EQ(0u, data->page);
+  ASSERT_TRUE(data->source.has_area());
+
+  const auto& page = mCache.atlas_page(data->page);
+  ASSERT_GE(page.width(), data->source.max_x());
+  ASSERT_GE(page.height(), data->source.max_y());
+}
+
+TEST_F(FontCacheTest, AtlasGlyphsDoNotOverlap)
+{
+  mCache.enable_atlas();
+  mCache.store_latin1_glyphs(*mRenderer);
+
+  for (cen::unicode_t a = 0x20; a < 0x7F; ++a) {
+    for (cen::unicode_t b = a + 1; b < 0x7F; ++b) {
+      const auto& first = *mCache.find_atlas_glyph(a);
+      const auto& second = *mCache.find_atlas_glyph(b);
+
+      if (first.page == second.page && first.source.has_area() && second.source.has_area()) {
+        ASSERT_FALSE(cen::intersects(first.source, second.source));
+      }
+    }
+  }
+}
+
+TEST_F(FontCacheTest, AtlasGrowth)
+{
+  cen::glyph_atlas_cfg cfg;
+  cfg.page_size = {32, 32};
+  cfg.max_page_size = {64, 64};
+
+  mCache.enable_atlas(cfg);
+  mCache.store_latin1_glyphs(*mRenderer);
+
+  ASSERT_GT(mCache.atlas_page_count(), 1u);
+  ASSERT_EQ(64, mCache.atlas_page(0).width());
+  ASSERT_EQ(64, mCache.atlas_page(0).height());
+  ASSERT_TRUE(mCache.has_glyph('~'));
+}
+
+TEST_F(FontCacheTest, AtlasGrowthKeepsGlyphs)
+{
+  cen::glyph_atlas_cfg cfg;
+  cfg.page_size = {32, 32};
+  cfg.max_page_size = {128, 128};
+
+  mCache.enable_atlas(cfg);
+  mCache.store_glyph(*mRenderer, 'A');
+
+  const auto before = *mCache.find_atlas_glyph('A');
+
+  mCache.store_latin1_glyphs(*mRenderer);
+
+  const auto& after = *mCache.find_atlas_glyph('A');
+  ASSERT_EQ(before.page, after.page);
+  ASSERT_EQ(before.source, after.source);
+  ASSERT_LT(32, mCache.atlas_page(0).width());
+}
+
+TEST_F(FontCacheTest, AtlasRenderText)
+{
+  mCache.enable_atlas();
+  mCache.store_basic_latin_glyphs(*mRenderer);
+
+  mCache.render_text(*mRenderer, kUnicodeString, cen::ipoint {10, 10});
+  ASSERT_EQ(1u, mCache.atlas_draw_calls());
+
+  const auto& metrics = mCache.find_atlas_glyph('a')->metrics;
+  ASSERT_EQ(10 + metrics.min_x + metrics.advance,
+            mCache.render_glyph(*mRenderer, 'a', cen::ipoint {10, 10}));
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
@@ -0,0 +1,229 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/fonts/text_layout.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>    // unique_ptr
+#include <optional>  // optional
+#include <vector>    // vector
+
+#include "centurion/fonts/font_cache.hpp"
+#include "centurion/video/renderer.hpp"
+#include "centurion/video/window.hpp"
+
+class TextLayoutTest : public testing::Test {
+ protected:
+  TextLayoutTest() : mCache {"resources/jetbrains_mono.ttf", 12} {}
+
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+  cen::font_cache mCache;
+};
+
+TEST_F(TextLayoutTest, Defaults)
+{
+  const cen::text_layout layout;
+  ASSERT_TRUE(layout.empty());
+  ASSERT_TRUE(layout.quads().empty());
+  ASSERT_TRUE(layout.lines().empty());
+  ASSERT_EQ(0, layout.size().width);
+  ASSERT_EQ(0, layout.size().height);
+}
+
+TEST_F(TextLayoutTest, SingleLine)
+{
+  cen::text_layout layout;
+  ASSERT_TRUE(mCache.layout_utf8("Hello", layout));
+
+  ASSERT_EQ(5u, layout.quads().size());
+  ASSERT_EQ(1u, layout.lines().size());
+  ASSERT_EQ(mCache.get_font().height(), layout.size().height);
+
+  const auto& quads = layout.quads();
+  for (cen::usize index = 1; index < quads.size(); ++index) {
+    ASSERT_LT(quads[index - 1].position.x(), quads[index].position.x());
+    ASSERT_EQ(quads[index - 1].position.y(), quads[index].position.y());
+  }
+}
+
+TEST_F(TextLayoutTest, Reuse)
+{
+  cen::text_layout layout;
+  ASSERT_TRUE(mCache.layout_utf8("Reused", layout));
+  ASSERT_FALSE(mCache.layout_utf8("Reused", layout));
+
+  ASSERT_TRUE(mCache.layout_utf8("Changed", layout));
+
+  cen::text_layout_cfg cfg;
+  cfg.wrap_width = 40;
+  ASSERT_TRUE(mCache.layout_utf8("Changed", layout, cfg));
+  ASSERT_FALSE(mCache.layout_utf8("Changed", layout, cfg));
+
+  const cen::unicode_string str {'a', 'b', 'c'};
+  ASSERT_TRUE(mCache.layout_text(str, layout));
+  ASSERT_FALSE(mCache.layout_text(str, layout));
+}
+
+TEST_F(TextLayoutTest, ReuseAfterFontChange)
+{
+  cen::text_layout layout;
+  ASSERT_TRUE(mCache.layout_utf8("Outlined", layout));
+
+  mCache.get_font().set_outline(2);
+  ASSERT_TRUE(mCache.layout_utf8("Outlined", layout));
+  ASSERT_FALSE(mCache.layout_utf8("Outlined", layout));
+
+  mCache.get_font().set_bold(true);
+  ASSERT_TRUE(mCache.layout_utf8("Outlined", layout));
+
+  mCache.get_font().set_kerning(!mCache.get_font().has_kerning());
+  ASSERT_TRUE(mCache.layout_utf8("Outlined", layout));
+  ASSERT_FALSE(mCache.layout_utf8("Outlined", layout));
+}
+
+TEST_F(TextLayoutTest, ReuseAfterCacheIsReplaced)
+{
+  cen::text_layout layout;
+  std::optional<cen::font_cache> cache;
+
+  cache.emplace("resources/jetbrains_mono.ttf", 12);
+  ASSERT_TRUE(cache->layout_utf8("Replaced", layout));
+
+  /* The new cache is created at the same address as the old one */
+  cache.emplace("resources/jetbrains_mono.ttf", 12);
+  ASSERT_TRUE(cache->layout_utf8("Replaced", layout));
+  ASSERT_FALSE(cache->layout_utf8("Replaced", layout));
+}
+
+TEST_F(TextLayoutTest, NewLines)
+{
+  cen::text_layout layout;
+  mCache.layout_utf8("ab\ncd\n\nef", layout);
+
+  const auto& lines = layout.lines();
+  ASSERT_EQ(4u, lines.size());
+  ASSERT_EQ(2u, lines.at(0).count);
+  ASSERT_EQ(2u, lines.at(1).count);
+  ASSERT_EQ(0u, lines.at(2).count);
+  ASSERT_EQ(2u, lines.at(3).count);
+
+  const auto lineSkip = mCache.get_font().line_skip();
+  const auto& quads = layout.quads();
+  ASSERT_EQ(quads.at(0).position.y() + lineSkip, quads.at(2).position.y());
+  ASSERT_EQ(quads.at(0).position.y() + 3 * lineSkip, quads.at(4).position.y());
+}
+
+TEST_F(TextLayoutTest, Wrapping)
+{
+  cen::text_layout_cfg cfg;
+  cfg.wrap_width = 60;
+
+  cen::text_layout layout;
+  mCache.layout_utf8("The quick brown fox jumps over the lazy dog", layout, cfg);
+
+  ASSERT_GT(layout.lines().size(), 1u);
+  ASSERT_LE(layout.size().width, cfg.wrap_width);
+
+  for (const auto& line : layout.lines()) {
+    ASSERT_LE(line.width, cfg.wrap_width);
+  }
+
+  /* Words are not split when they fit on a line */
+  const auto& quads = layout.quads();
+  const auto& second = layout.lines().at(1);
+  ASSERT_NE(' ', quads.at(second.first).glyph);
+  ASSERT_EQ(' ', quads.at(second.first - 1).glyph);
+}
+
+#if SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+
+TEST_F(TextLayoutTest, Alignment)
+{
+  cen::text_layout_cfg cfg;
+  cfg.wrap_width = 200;
+
+  cen::text_layout left;
+  mCache.layout_utf8("abc", left, cfg);
+
+  cfg.align = cen::wrap_alignment::right;
+  cen::text_layout right;
+  mCache.layout_utf8("abc", right, cfg);
+
+  cfg.align = cen::wrap_alignment::center;
+  cen::text_layout center;
+  mCache.layout_utf8("abc", center, cfg);
+
+  const auto width = left.lines().at(0).width;
+  const auto leftX = left.quads().at(0).position.x();
+
+  ASSERT_EQ(leftX + (200 - width), right.quads().at(0).position.x());
+  ASSERT_EQ(leftX + (200 - width) / 2, center.quads().at(0).position.x());
+}
+
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+
+TEST_F(TextLayoutTest, RenderLayout)
+{
+  mCache.store_basic_latin_glyphs(*mRenderer);
+
+  cen::text_layout layout;
+  mCache.layout_utf8("Hello, world!", layout);
+
+  mCache.render_layout(*mRenderer, layout, cen::ipoint {10, 10});
+  mCache.render_text(*mRenderer, cen::unicode_string {'f', 'o', 'o'}, cen::ipoint {10, 30});
+}
+
+TEST(DecodeUTF8, Basic)
+{
+  std::vector<cen::unicode_t> out;
+
+  cen::detail::decode_utf8("abc", out);
+  ASSERT_EQ((std::vector<cen::unicode_t> {'a', 'b', 'c'}), out);
+
+  cen::detail::decode_utf8("\xC3\xA5\xE2\x82\xAC", out);  // U+00E5 U+20AC
+  ASSERT_EQ((std::vector<cen::unicode_t> {0xE5, 0x20AC}), out);
+
+  cen::detail::decode_utf8("\xF0\x9F\x98\x80", out);  // U+1F600 is outside of the BMP
+  ASSERT_EQ((std::vector<cen::unicode_t> {0xFFFD}), out);
+
+  cen::detail::decode_utf8("a\xC3", out);  // Truncated sequence
+  ASSERT_EQ((std::vector<cen::unicode_t> {'a', 0xFFFD}), out);
+
+  cen::detail::decode_utf8("\xFF" "b", out);  // Invalid lead byte
+  ASSERT_EQ((std::vector<cen::unicode_t> {0xFFFD, 'b'}), out);
+}
@@ -0,0 +1,269 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/color_ops.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>     // array
+#include <cstdlib>   // abs
+#include <iostream>  // cout
+#include <vector>    // vector
+
+namespace {
+
+[[nodiscard]] auto max_difference(const cen::color& a, const cen::color& b) -> int
+{
+  const auto diff = [](const cen::uint8 x, const cen::uint8 y) { return std::abs(x - y); };
+  return cen::detail::max(cen::detail::max(diff(a.red(), b.red()), diff(a.green(), b.green())),
+                          cen::detail::max(diff(a.blue(), b.blue()), diff(a.alpha(), b.alpha())));
+}
+
+[[nodiscard]] auto make_colors() -> std::vector<cen::color>
+{
+  std::vector<cen::color> colors;
+
+  for (int red = 0; red < 256; red += 15) {
+    for (int green = 0; green < 256; green += 17) {
+      for (int blue = 0; blue < 256; blue += 5) {
+        const auto alpha = (red + green + blue) & 0xFF;
+        colors.emplace_back(static_cast<cen::uint8>(red),
+                            static_cast<cen::uint8>(green),
+                            static_cast<cen::uint8>(blue),
+                            static_cast<cen::uint8>(alpha));
+      }
+    }
+  }
+
+  return colors;
+}
+
+}  // namespace
+
+class ColorOpsTest : public testing::Test {
+ protected:
+  void TearDown() override { cen::set_simd_level(cen::best_simd_level()); }
+};
+
+TEST_F(ColorOpsTest, HsvToRgb)
+{
+  std::vector<cen::hsv_color> hsv;
+  for (float hue = -10; hue <= 370; hue += 7.5f) {
+    for (float saturation = 0; saturation <= 100; saturation += 12.5f) {
+      for (float value = 0; value <= 100; value += 12.5f) {
+        hsv.push_back({hue, saturation, value});
+      }
+    }
+  }
+
+  for (const auto level : {cen::simd_level::scalar, cen::best_simd_level()}) {
+    cen::set_simd_level(level);
+
+    const auto colors = cen::hsv_to_rgb(hsv);
+    ASSERT_EQ(hsv.size(), colors.size());
+
+    for (cen::usize i = 0; i < hsv.size(); ++i) {
+      const auto& [hue, saturation, value] = hsv[i];
+      ASSERT_LE(max_difference(cen::color::from_hsv(hue, saturation, value), colors[i]), 1);
+    }
+  }
+}
+
+TEST_F(ColorOpsTest, HslToRgb)
+{
+  std::vector<cen::hsl_color> hsl;
+  for (float hue = -10; hue < 360; hue += 7.5f) {
+    for (float saturation = 0; saturation <= 100; saturation += 12.5f) {
+      for (float lightness = 0; lightness <= 100; lightness += 12.5f) {
+        hsl.push_back({hue, saturation, lightness});
+      }
+    }
+  }
+
+  for (const auto level : {cen::simd_level::scalar, cen::best_simd_level()}) {
+    cen::set_simd_level(level);
+
+    const auto colors = cen::hsl_to_rgb(hsl);
+    ASSERT_EQ(hsl.size(), colors.size());
+
+    for (cen::usize i = 0; i < hsl.size(); ++i) {
+      const auto& [hue, saturation, lightness] = hsl[i];
+      ASSERT_LE(max_difference(cen::color::from_hsl(hue, saturation, lightness), colors[i]), 1);
+    }
+  }
+
+  // A hue of 360 wraps around to red
+  const std::vector<cen::hsl_color> red {{360, 100, 50}};
+  ASSERT_EQ(cen::colors::red, cen::hsl_to_rgb(red).at(0));
+}
+
+TEST_F(ColorOpsTest, RgbToHsv)
+{
+  const std::vector<cen::color> primaries {cen::colors::red,
+                                           cen::colors::lime,
+                                           cen::colors::blue,
+                                           cen::colors::black};
+  const auto hsv = cen::rgb_to_hsv(primaries);
+
+  ASSERT_EQ(0, hsv.at(0).hue);
+  ASSERT_EQ(120, hsv.at(1).hue);
+  ASSERT_EQ(240, hsv.at(2).hue);
+  ASSERT_EQ(100, hsv.at(2).saturation);
+  ASSERT_EQ(100, hsv.at(2).value);
+  ASSERT_EQ(0, hsv.at(3).saturation);
+  ASSERT_EQ(0, hsv.at(3).value);
+
+  const auto colors = make_colors();
+
+  for (const auto level : {cen::simd_level::scalar, cen::best_simd_level()}) {
+    cen::set_simd_level(level);
+
+    const auto rgb = cen::hsv_to_rgb(cen::rgb_to_hsv(colors));
+    for (cen::usize i = 0; i < colors.size(); ++i) {
+      ASSERT_EQ(colors[i].with_alpha(0xFF), rgb[i]);
+    }
+  }
+}
+
+TEST_F(ColorOpsTest, RgbToHsl)
+{
+  const std::vector<cen::color> grays {cen::colors::white, cen::colors::gray};
+  const auto hsl = cen::rgb_to_hsl(grays);
+
+  ASSERT_EQ(0, hsl.at(0).saturation);
+  ASSERT_EQ(100, hsl.at(0).lightness);
+  ASSERT_EQ(0, hsl.at(1).saturation);
+
+  const auto colors = make_colors();
+
+  for (const auto level : {cen::simd_level::scalar, cen::best_simd_level()}) {
+    cen::set_simd_level(level);
+
+    const auto rgb = cen::hsl_to_rgb(cen::rgb_to_hsl(colors));
+    for (cen::usize i = 0; i < colors.size(); ++i) {
+      ASSERT_EQ(colors[i].with_alpha(0xFF), rgb[i]);
+    }
+  }
+}
+
+TEST_F(ColorOpsTest, LerpColors)
+{
+  const auto a = make_colors();
+  const std::vector<cen::color> b(a.rbegin(), a.rend());
+  std::vector<cen::color> result(a.size());
+
+  for (const auto bias : {0.0f, 0.1f, 0.5f, 0.77f, 1.0f}) {
+    cen::lerp_colors(a.data(), b.data(), result.data(), result.size(), bias);
+
+    for (cen::usize i = 0; i < a.size(); ++i) {
+      ASSERT_EQ(cen::blend(a[i], b[i], bias), result[i]);
+    }
+  }
+}
+
+TEST_F(ColorOpsTest, BlendColors)
+{
+  const auto a = make_colors();
+  const std::vector<cen::color> b(a.rbegin(), a.rend());
+  std::vector<cen::color> result(a.size());
+
+  for (const auto bias : {0.0f, 0.1f, 0.5f, 0.77f, 1.0f}) {
+    cen::blend_colors(a.data(), b.data(), result.data(), result.size(), bias);
+
+    for (cen::usize i = 0; i < a.size(); ++i) {
+      ASSERT_LE(max_difference(cen::blend(a[i], b[i], bias), result[i]), 1);
+    }
+  }
+
+  for (const auto space : {cen::blend_space::srgb, cen::blend_space::linear}) {
+    cen::blend_colors(a.data(), b.data(), result.data(), result.size(), 0.0f, space);
+    ASSERT_EQ(a, result);
+
+    cen::blend_colors(a.data(), b.data(), result.data(), result.size(), 1.0f, space);
+    ASSERT_EQ(b, result);
+  }
+
+  // Blending in linear light avoids the dark transition between red and green
+  const std::array red {cen::colors::red};
+  const std::array green {cen::colors::lime};
+  std::array<cen::color, 1> mixed;
+
+  cen::blend_colors(red.data(), green.data(), mixed.data(), 1, 0.5f, cen::blend_space::linear);
+  ASSERT_EQ(cen::color(188, 188, 0), mixed[0]);
+}
+
+TEST_F(ColorOpsTest, MakeGradient)
+{
+  ASSERT_TRUE(cen::make_gradient(0, cen::colors::red, cen::colors::blue).empty());
+  ASSERT_EQ(cen::colors::red, cen::make_gradient(1, cen::colors::red, cen::colors::blue).at(0));
+
+  for (const auto space : {cen::blend_space::srgb, cen::blend_space::linear}) {
+    const auto gradient = cen::make_gradient(1'000, cen::colors::red, cen::colors::blue, space);
+    ASSERT_EQ(1'000u, gradient.size());
+    ASSERT_EQ(cen::colors::red, gradient.front());
+    ASSERT_EQ(cen::colors::blue, gradient.back());
+  }
+
+  const auto gradient = cen::make_gradient(11, cen::colors::black, cen::colors::white);
+  for (cen::usize i = 0; i < gradient.size(); ++i) {
+    const auto expected =
+        cen::blend(cen::colors::black, cen::colors::white, static_cast<float>(i) / 10.0f);
+    ASSERT_LE(max_difference(expected, gradient[i]), 1);
+  }
+}
+
+TEST_F(ColorOpsTest, MakeGradientWithStops)
+{
+  // The colors are sampled at 0, 1/8, 2/8, ..., 1
+  const std::vector<cen::gradient_stop> stops {{0.25f, cen::colors::red},
+                                               {0.5f, cen::colors::lime},
+                                               {0.5f, cen::colors::blue},
+                                               {0.75f, cen::colors::white}};
+  const auto gradient = cen::make_gradient(9, stops);
+  ASSERT_EQ(9u, gradient.size());
+
+  ASSERT_EQ(cen::colors::red, gradient.at(0));
+  ASSERT_EQ(cen::colors::red, gradient.at(2));
+  ASSERT_EQ(cen::color(128, 128, 0), gradient.at(3));
+  ASSERT_EQ(cen::colors::blue, gradient.at(4));
+  ASSERT_EQ(cen::color(128, 128, 255), gradient.at(5));
+  ASSERT_EQ(cen::colors::white, gradient.at(6));
+  ASSERT_EQ(cen::colors::white, gradient.at(8));
+
+  const std::vector<cen::gradient_stop> unsorted {{0.5f, cen::colors::red},
+                                                  {0.2f, cen::colors::blue}};
+  ASSERT_TRUE(cen::make_gradient(4, unsorted).empty());
+  ASSERT_TRUE(cen::make_gradient(4, std::vector<cen::gradient_stop> {}).empty());
+  ASSERT_FALSE(cen::fill_gradient(nullptr, 0, nullptr, 0));
+}
+
+TEST_F(ColorOpsTest, BlendSpaceToString)
+{
+  ASSERT_THROW(cen::to_string(static_cast<cen::blend_space>(2)), cen::exception);
+
+  ASSERT_EQ("srgb", cen::to_string(cen::blend_space::srgb));
+  ASSERT_EQ("linear", cen::to_string(cen::blend_space::linear));
+
+  std::cout << "blend_space::linear == " << cen::blend_space::linear << '\n';
+}
@@ -0,0 +1,284 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/palette_ops.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>   // abs
+#include <iostream>  // cout
+#include <vector>    // vector
+
+namespace {
+
+inline constexpr auto kPath = "resources/panda.png";
+
+/// Creates an RGBA32 surface from row-major colors.
+[[nodiscard]] auto make_surface(const cen::iarea size, const std::vector<cen::color>& colors)
+    -> cen::surface
+{
+  cen::surface result {size, cen::pixel_format::rgba32};
+
+  for (int y = 0; y < size.height; ++y) {
+    auto* row = static_cast<cen::uint8*>(result.pixel_data()) + y * result.pitch();
+    for (int x = 0; x < size.width; ++x) {
+      const auto& color = colors.at(static_cast<cen::usize>(y * size.width + x));
+      row[4 * x + 0] = color.red();
+      row[4 * x + 1] = color.green();
+      row[4 * x + 2] = color.blue();
+      row[4 * x + 3] = color.alpha();
+    }
+  }
+
+  return result;
+}
+
+[[nodiscard]] auto index_at(const cen::surface& image, const int x, const int y) -> int
+{
+  return static_cast<const cen::uint8*>(image.pixel_data())[y * image.pitch() + x];
+}
+
+/// Returns the average difference per channel between a surface and its indexed version.
+[[nodiscard]] auto mean_error(const cen::surface& source, const cen::indexed_image& indexed)
+    -> double
+{
+  const auto& size = source.size();
+  std::vector<cen::uint8> expanded(static_cast<cen::usize>(size.width * size.height * 4));
+
+  if (!cen::expand_indexed(indexed.image,
+                           cen::pixel_format::rgba32,
+                           expanded.data(),
+                           size.width * 4)) {
+    return 255;
+  }
+
+  const auto rgba = source.convert_to(cen::pixel_format::rgba32);
+
+  double sum {};
+  for (int y = 0; y < size.height; ++y) {
+    const auto* a = static_cast<const cen::uint8*>(rgba.pixel_data()) + y * rgba.pitch();
+    const auto* b = expanded.data() + y * size.width * 4;
+
+    for (int x = 0; x < size.width * 4; ++x) {
+      if (x % 4 != 3) {
+        sum += std::abs(a[x] - b[x]);
+      }
+    }
+  }
+
+  return sum / (size.width * size.height * 3.0);
+}
+
+}  // namespace
+
+TEST(PaletteOps, Quantize)
+{
+  const cen::surface source {kPath};
+
+  for (const auto dither : {cen::dither_mode::none,
+                            cen::dither_mode::ordered,
+                            cen::dither_mode::floyd_steinberg}) {
+    cen::quantize_options options;
+    options.dither = dither;
+
+    const auto indexed = cen::quantize(source, options);
+    ASSERT_EQ(source.size(), indexed.image.size());
+    ASSERT_EQ(cen::pixel_format::index8, indexed.image.format_info().format());
+    ASSERT_LE(indexed.colors.size(), 256);
+    ASSERT_EQ(indexed.colors.get(), indexed.image.get()->format->palette);
+
+    // The dithered images are noisier per pixel, but should still be close on average
+    ASSERT_LT(mean_error(source, indexed), dither == cen::dither_mode::none ? 6.0 : 12.0);
+  }
+}
+
+TEST(PaletteOps, QuantizeFewColors)
+{
+  const auto a = cen::colors::red;
+  const auto b = cen::colors::dark_cyan;
+  const auto c = cen::colors::gold;
+  const auto source = make_surface({3, 2}, {a, b, c, c, b, a});
+
+  cen::quantize_options options;
+  options.max_colors = 16;
+
+  const auto indexed = cen::quantize(source, options);
+  ASSERT_EQ(3, indexed.colors.size());
+  ASSERT_FALSE(indexed.transparent_index.has_value());
+
+  // Distinct colors in separate histogram bins are reproduced exactly
+  ASSERT_EQ(a, indexed.colors.at(index_at(indexed.image, 0, 0)));
+  ASSERT_EQ(b, indexed.colors.at(index_at(indexed.image, 1, 0)));
+  ASSERT_EQ(c, indexed.colors.at(index_at(indexed.image, 2, 0)));
+  ASSERT_EQ(index_at(indexed.image, 0, 0), index_at(indexed.image, 2, 1));
+  ASSERT_EQ(index_at(indexed.image, 2, 0), index_at(indexed.image, 0, 1));
+}
+
+TEST(PaletteOps, QuantizeTransparency)
+{
+  const auto clear = cen::colors::white.with_alpha(0x10);
+  const auto source = make_surface({2, 2}, {cen::colors::blue, clear, clear, cen::colors::lime});
+
+  const auto indexed = cen::quantize(source);
+  ASSERT_EQ(0, indexed.transparent_index);
+  ASSERT_EQ(cen::colors::transparent, indexed.colors.at(0));
+  ASSERT_TRUE(SDL_HasColorKey(indexed.image.get()));
+
+  ASSERT_EQ(0, index_at(indexed.image, 1, 0));
+  ASSERT_EQ(0, index_at(indexed.image, 0, 1));
+  ASSERT_EQ(cen::colors::blue, indexed.colors.at(index_at(indexed.image, 0, 0)));
+  ASSERT_EQ(cen::colors::lime, indexed.colors.at(index_at(indexed.image, 1, 1)));
+
+  cen::uint8 expanded[16] {};
+  ASSERT_TRUE(cen::expand_indexed(indexed.image, cen::pixel_format::rgba32, expanded, 8));
+  ASSERT_EQ(0xFF, expanded[3]);
+  ASSERT_EQ(0, expanded[7]);
+}
+
+TEST(PaletteOps, GeneratePalette)
+{
+  const auto source = make_surface({2, 1}, {cen::colors::red, cen::colors::blue});
+
+  const auto colors = cen::generate_palette(source);
+  ASSERT_EQ(2u, colors.size());
+
+  const auto transparent = make_surface({1, 1}, {cen::colors::transparent});
+  ASSERT_TRUE(cen::generate_palette(transparent).empty());
+}
+
+TEST(PaletteOps, RemapToPalette)
+{
+  cen::palette palette {3};
+  palette.set_color(0, cen::colors::transparent);
+  palette.set_color(1, cen::colors::black);
+  palette.set_color(2, cen::colors::white);
+
+  const auto source = make_surface({4, 1},
+                                   {cen::color {0x10, 0x10, 0x10},
+                                    cen::color {0xF0, 0xE0, 0xF0},
+                                    cen::colors::transparent,
+                                    cen::colors::gray});
+
+  const auto image = cen::remap_to_palette(source, palette);
+  ASSERT_EQ(palette.get(), image.get()->format->palette);
+  ASSERT_TRUE(SDL_HasColorKey(image.get()));
+
+  ASSERT_EQ(1, index_at(image, 0, 0));
+  ASSERT_EQ(2, index_at(image, 1, 0));
+  ASSERT_EQ(0, index_at(image, 2, 0));
+  ASSERT_NE(0, index_at(image, 3, 0));
+
+  cen::palette clear {1};
+  clear.set_color(0, cen::colors::transparent);
+  ASSERT_THROW(cen::remap_to_palette(source, clear), cen::exception);
+}
+
+TEST(PaletteOps, ExpandIndexed)
+{
+  const auto source = make_surface({2, 1}, {cen::colors::red, cen::colors::blue});
+  const auto indexed = cen::quantize(source);
+
+  cen::uint32 pixels[2] {};
+  ASSERT_TRUE(cen::expand_indexed(indexed.image, cen::pixel_format::argb8888, pixels, 8));
+  ASSERT_EQ(0xFFFF0000u, pixels[0]);
+  ASSERT_EQ(0xFF0000FFu, pixels[1]);
+
+  // Only 32-bit destination formats are supported
+  ASSERT_FALSE(cen::expand_indexed(indexed.image, cen::pixel_format::rgb565, pixels, 8));
+  ASSERT_FALSE(cen::expand_indexed(source, cen::pixel_format::argb8888, pixels, 8));
+}
+
+TEST(PaletteOps, PaletteCycler)
+{
+  const std::vector<cen::color> base {cen::colors::black,
+                                      cen::colors::red,
+                                      cen::colors::green,
+                                      cen::colors::blue,
+                                      cen::colors::white};
+
+  cen::palette palette {5};
+  ASSERT_TRUE(palette.set_colors(0, base.data(), 5));
+
+  cen::palette_cycler cycler {palette};
+  ASSERT_FALSE(cycler.add({3, 3, 1.0f}));
+  ASSERT_FALSE(cycler.add({-1, 2, 1.0f}));
+  ASSERT_FALSE(cycler.add({0, 0, 1.0f}));
+  ASSERT_TRUE(cycler.add({1, 3, 2.0f}));
+  ASSERT_EQ(1u, cycler.count());
+
+  // Half a step doesn't change any entries
+  ASSERT_EQ(0, cycler.update(palette, cen::seconds<double> {0.25}));
+  ASSERT_EQ(cen::colors::red, palette.at(1));
+
+  ASSERT_EQ(3, cycler.update(palette, cen::seconds<double> {0.25}));
+  ASSERT_EQ(cen::colors::black, palette.at(0));
+  ASSERT_EQ(cen::colors::blue, palette.at(1));
+  ASSERT_EQ(cen::colors::red, palette.at(2));
+  ASSERT_EQ(cen::colors::green, palette.at(3));
+  ASSERT_EQ(cen::colors::white, palette.at(4));
+
+  // Completing the period restores the original order
+  ASSERT_EQ(3, cycler.update(palette, cen::seconds<double> {1.0}));
+  ASSERT_EQ(cen::colors::red, palette.at(1));
+  ASSERT_EQ(3, cycler.update(palette, cen::seconds<double> {0.5}));
+  ASSERT_EQ(cen::colors::blue, palette.at(1));
+
+  cycler.reset(palette);
+  ASSERT_EQ(cen::colors::red, palette.at(1));
+
+  cycler.clear();
+  ASSERT_TRUE(cycler.add({1, 3, -1.0f}));
+  ASSERT_EQ(3, cycler.update(palette, cen::seconds<double> {1.0}));
+  ASSERT_EQ(cen::colors::green, palette.at(1));
+  ASSERT_EQ(cen::colors::blue, palette.at(2));
+  ASSERT_EQ(cen::colors::red, palette.at(3));
+}
+
+TEST(PaletteOps, PaletteCyclerWriteFailures)
+{
+  cen::palette palette {5};
+  cen::palette small {2};
+
+  cen::palette_cycler cycler {palette};
+  ASSERT_TRUE(cycler.add({1, 3, 1.0f}));
+
+  // The range doesn't fit in the smaller palette, so nothing is written
+  ASSERT_EQ(0, cycler.update(small, cen::seconds<double> {1.0}));
+  ASSERT_FALSE(cycler.reset(small));
+
+  // Failed writes are retried by the next update
+  ASSERT_EQ(3, cycler.update(palette, cen::seconds<double> {0.0}));
+  ASSERT_TRUE(cycler.reset(palette));
+}
+
+TEST(PaletteOps, DitherModeToString)
+{
+  ASSERT_THROW(cen::to_string(static_cast<cen::dither_mode>(3)), cen::exception);
+
+  ASSERT_EQ("none", cen::to_string(cen::dither_mode::none));
+  ASSERT_EQ("ordered", cen::to_string(cen::dither_mode::ordered));
+  ASSERT_EQ("floyd_steinberg", cen::to_string(cen::dither_mode::floyd_steinberg));
+
+  std::cout << "dither_mode::floyd_steinberg == " << cen::dither_mode::floyd_steinberg << '\n';
+}
@@ -24,6 +24,7 @@
 
 #include <gtest/gtest.h>
 
+#include <array>     // array
 #include <iostream>  // cout
 
 #include "centurion/video/color.hpp"
@@ -79,6 +80,53 @@ TEST(Palette, GetColor)
   ASSERT_THROW(palette.at(4), cen::exception);
 }
 
+TEST(Palette, SetColors)
+{
+  cen::palette palette {4};
+
+  const std::array colors {cen::colors::red, cen::colors::lime, cen::colors::blue};
+  const auto version = palette.version();
+
+  ASSERT_TRUE(palette.set_colors(1, colors.data(), 3));
+  ASSERT_NE(version, palette.version());
+
+  ASSERT_EQ(cen::colors::white, palette.at(0));
+  ASSERT_EQ(cen::colors::red, palette.at(1));
+  ASSERT_EQ(cen::colors::lime, palette.at(2));
+  ASSERT_EQ(cen::colors::blue, palette.at(3));
+
+  ASSERT_FALSE(palette.set_colors(2, colors.data(), 3));
+  ASSERT_FALSE(palette.set_colors(-1, colors.data(), 1));
+  ASSERT_FALSE(palette.set_colors(0, nullptr, 1));
+}
+
+TEST(Palette, Rotate)
+{
+  cen::palette palette {5};
+
+  const std::array colors {cen::colors::red, cen::colors::lime, cen::colors::blue};
+  ASSERT_TRUE(palette.set_colors(1, colors.data(), 3));
+
+  const auto version = palette.version();
+
+  ASSERT_TRUE(palette.rotate(1, 3, 1));
+  ASSERT_NE(version, palette.version());
+
+  ASSERT_EQ(cen::colors::white, palette.at(0));
+  ASSERT_EQ(cen::colors::blue, palette.at(1));
+  ASSERT_EQ(cen::colors::red, palette.at(2));
+  ASSERT_EQ(cen::colors::lime, palette.at(3));
+  ASSERT_EQ(cen::colors::white, palette.at(4));
+
+  ASSERT_TRUE(palette.rotate(1, 3, -4));
+  ASSERT_EQ(cen::colors::red, palette.at(1));
+  ASSERT_EQ(cen::colors::lime, palette.at(2));
+  ASSERT_EQ(cen::colors::blue, palette.at(3));
+
+  ASSERT_FALSE(palette.rotate(3, 3, 1));
+  ASSERT_FALSE(palette.rotate(0, 0, 1));
+}
+
 TEST(Palette, GetSize)
 {
   const cen::palette palette {7};
@@ -0,0 +1,246 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/pixel_kernels.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>     // array
+#include <iostream>  // cout
+#include <vector>    // vector
+
+namespace {
+
+inline constexpr std::array formats {cen::pixel_format::rgba8888,
+                                     cen::pixel_format::argb8888,
+                                     cen::pixel_format::bgra8888,
+                                     cen::pixel_format::abgr8888,
+                                     cen::pixel_format::rgbx8888,
+                                     cen::pixel_format::bgrx8888,
+                                     cen::pixel_format::rgb888,
+                                     cen::pixel_format::bgr888,
+                                     cen::pixel_format::rgb24,
+                                     cen::pixel_format::bgr24};
+
+inline constexpr std::array levels {cen::simd_level::sse2,
+                                    cen::simd_level::avx2,
+                                    cen::simd_level::neon};
+
+[[nodiscard]] auto make_pixels(const int bytes) -> std::vector<cen::uint8>
+{
+  std::vector<cen::uint8> pixels(static_cast<cen::usize>(bytes));
+
+  cen::uint32 seed {42};
+  for (auto& pixel : pixels) {
+    seed = seed * 1'664'525u + 1'013'904'223u;
+    pixel = static_cast<cen::uint8>(seed >> 24u);
+  }
+
+  return pixels;
+}
+
+}  // namespace
+
+class PixelKernelsTest : public testing::Test {
+ protected:
+  void TearDown() override { cen::set_simd_level(cen::best_simd_level()); }
+};
+
+TEST_F(PixelKernelsTest, SimdLevel)
+{
+  ASSERT_TRUE(cen::has_simd_level(cen::simd_level::scalar));
+  ASSERT_TRUE(cen::has_simd_level(cen::best_simd_level()));
+  ASSERT_EQ(cen::best_simd_level(), cen::current_simd_level());
+
+  ASSERT_TRUE(cen::set_simd_level(cen::simd_level::scalar));
+  ASSERT_EQ(cen::simd_level::scalar, cen::current_simd_level());
+
+  ASSERT_EQ("scalar", cen::to_string(cen::simd_level::scalar));
+  ASSERT_EQ("sse2", cen::to_string(cen::simd_level::sse2));
+  ASSERT_EQ("avx2", cen::to_string(cen::simd_level::avx2));
+  ASSERT_EQ("neon", cen::to_string(cen::simd_level::neon));
+
+  std::cout << cen::best_simd_level() << '\n';
+}
+
+TEST_F(PixelKernelsTest, HasPixelKernel)
+{
+  ASSERT_TRUE(cen::has_pixel_kernel(cen::pixel_format::rgba32, cen::pixel_format::bgra32));
+  ASSERT_TRUE(cen::has_pixel_kernel(cen::pixel_format::rgb24, cen::pixel_format::argb8888));
+  ASSERT_FALSE(cen::has_pixel_kernel(cen::pixel_format::rgb565, cen::pixel_format::rgba32));
+}
+
+TEST_F(PixelKernelsTest, ConvertPixels)
+{
+  // An odd width makes sure that the scalar tail of each row is exercised
+  constexpr cen::iarea size {37, 3};
+
+  for (const auto from : formats) {
+    for (const auto to : formats) {
+      const auto srcPitch = size.width * 4 + 4;
+      const auto dstPitch = size.width * 4 + 8;
+      const auto src = make_pixels(srcPitch * size.height);
+
+      cen::set_simd_level(cen::simd_level::scalar);
+
+      std::vector<cen::uint8> expected(static_cast<cen::usize>(dstPitch * size.height));
+      ASSERT_TRUE(
+          cen::convert_pixels(size, from, src.data(), srcPitch, to, expected.data(), dstPitch));
+
+      for (const auto level : levels) {
+        if (!cen::set_simd_level(level)) {
+          continue;
+        }
+
+        std::vector<cen::uint8> actual(expected.size());
+        ASSERT_TRUE(
+            cen::convert_pixels(size, from, src.data(), srcPitch, to, actual.data(), dstPitch));
+        ASSERT_EQ(expected, actual) << cen::to_string(from) << " -> " << cen::to_string(to);
+      }
+    }
+  }
+}
+
+TEST_F(PixelKernelsTest, ConvertPixelsChannels)
+{
+  const std::array<cen::uint8, 6> rgb {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+  std::array<cen::uint32, 2> rgba {};
+
+  ASSERT_TRUE(cen::convert_pixels({2, 1},
+                                  cen::pixel_format::rgb24,
+                                  rgb.data(),
+                                  6,
+                                  cen::pixel_format::rgba8888,
+                                  rgba.data(),
+                                  8));
+  ASSERT_EQ(0x11'22'33'FFu, rgba[0]);
+  ASSERT_EQ(0x44'55'66'FFu, rgba[1]);
+
+  // Conversions between formats of the same size may be done in place
+  ASSERT_TRUE(cen::convert_pixels({2, 1},
+                                  cen::pixel_format::rgba8888,
+                                  rgba.data(),
+                                  8,
+                                  cen::pixel_format::argb8888,
+                                  rgba.data(),
+                                  8));
+  ASSERT_EQ(0xFF'11'22'33u, rgba[0]);
+
+  ASSERT_FALSE(cen::convert_pixels({2, 1},
+                                   cen::pixel_format::argb8888,
+                                   rgba.data(),
+                                   8,
+                                   cen::pixel_format::rgb24,
+                                   rgba.data(),
+                                   8));
+  ASSERT_FALSE(cen::convert_pixels({2, 1},
+                                   cen::pixel_format::rgb24,
+                                   nullptr,
+                                   6,
+                                   cen::pixel_format::rgba8888,
+                                   rgba.data(),
+                                   8));
+}
+
+TEST_F(PixelKernelsTest, PremultiplyAlpha)
+{
+  constexpr cen::iarea size {37, 2};
+  constexpr auto pitch = size.width * 4;
+  const auto src = make_pixels(pitch * size.height);
+
+  cen::set_simd_level(cen::simd_level::scalar);
+
+  auto expected = src;
+  ASSERT_TRUE(cen::premultiply_alpha(size, cen::pixel_format::argb8888, expected.data(), pitch));
+
+  for (const auto level : levels) {
+    if (!cen::set_simd_level(level)) {
+      continue;
+    }
+
+    auto actual = src;
+    ASSERT_TRUE(cen::premultiply_alpha(size, cen::pixel_format::argb8888, actual.data(), pitch));
+    ASSERT_EQ(expected, actual);
+  }
+
+  std::vector<cen::uint8> rgb(static_cast<cen::usize>(size.width * 3 * size.height));
+  ASSERT_FALSE(cen::premultiply_alpha(size, cen::pixel_format::rgb24, rgb.data(), size.width * 3));
+}
+
+TEST_F(PixelKernelsTest, UnpremultiplyAlpha)
+{
+  std::array<cen::uint32, 2> pixels {0x80'40'20'80u, 0x10'20'30'00u};
+
+  ASSERT_TRUE(cen::unpremultiply_alpha({2, 1}, cen::pixel_format::rgba8888, pixels.data(), 8));
+  ASSERT_EQ(0xFF'80'40'80u, pixels[0]);
+  ASSERT_EQ(0u, pixels[1]);
+}
+
+TEST_F(PixelKernelsTest, BakeColorMod)
+{
+  constexpr cen::iarea size {37, 2};
+  constexpr auto pitch = size.width * 4;
+  constexpr cen::color mod {0xC8, 0x11, 0xFF, 0x63};
+  const auto src = make_pixels(pitch * size.height);
+
+  cen::set_simd_level(cen::simd_level::scalar);
+
+  auto expected = src;
+  ASSERT_TRUE(cen::bake_color_mod(size, cen::pixel_format::abgr8888, expected.data(), pitch, mod));
+
+  for (const auto level : levels) {
+    if (!cen::set_simd_level(level)) {
+      continue;
+    }
+
+    auto actual = src;
+    ASSERT_TRUE(cen::bake_color_mod(size, cen::pixel_format::abgr8888, actual.data(), pitch, mod));
+    ASSERT_EQ(expected, actual);
+  }
+
+  std::array<cen::uint32, 1> pixel {0xFF'FF'FF'FFu};
+  ASSERT_TRUE(cen::bake_color_mod({1, 1}, cen::pixel_format::rgbx8888, pixel.data(), 4, mod));
+  ASSERT_EQ(0xC8'11'FF'FFu, pixel[0]);  // The padding byte is left untouched
+}
+
+TEST_F(PixelKernelsTest, PixelBuffer)
+{
+  cen::pixel_buffer buffer;
+  ASSERT_FALSE(buffer.data());
+  ASSERT_EQ(0u, buffer.capacity());
+
+  buffer.resize({10, 3}, cen::pixel_format::rgba32);
+  ASSERT_TRUE(buffer.data());
+  ASSERT_EQ(64, buffer.pitch());
+  ASSERT_EQ(192u, buffer.capacity());
+  ASSERT_EQ(cen::pixel_format::rgba32, buffer.format());
+
+  // Shrinking the buffer should reuse the allocation
+  const auto* data = buffer.data();
+  buffer.resize({5, 2}, cen::pixel_format::rgb24);
+  ASSERT_EQ(data, buffer.data());
+
+  ASSERT_THROW(buffer.resize({-1, 2}, cen::pixel_format::rgb24), cen::exception);
+  ASSERT_THROW(cen::pixel_buffer({4, 4}, cen::pixel_format::yv12), cen::exception);
+}
@@ -0,0 +1,140 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "centurion/video/damage_tracker.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>  // unique_ptr
+
+#include "centurion/video/renderer.hpp"
+#include "centurion/video/window.hpp"
+
+class DamageTrackerTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>("", cen::iarea {200, 100});
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer(cen::renderer::software));
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(DamageTrackerTest, InitiallyInvalid)
+{
+  const cen::damage_tracker tracker {{200, 100}};
+  ASSERT_TRUE(tracker.needs_redraw());
+  ASSERT_EQ(1u, tracker.invalid_rects().size());
+  ASSERT_EQ((cen::irect {0, 0, 200, 100}), tracker.invalid_rects().front());
+  ASSERT_FALSE(tracker.is_recording());
+}
+
+TEST_F(DamageTrackerTest, MergeOverlappingAreas)
+{
+  cen::damage_tracker tracker {{200, 100}};
+  tracker.begin_frame(*mRenderer);
+  ASSERT_TRUE(tracker.end_frame(*mRenderer, *mWindow));
+  ASSERT_FALSE(tracker.needs_redraw());
+
+  tracker.invalidate({10, 10, 20, 20});
+  tracker.invalidate({20, 20, 20, 20});
+  tracker.invalidate({100, 50, 10, 10});
+
+  ASSERT_EQ(2u, tracker.invalid_rects().size());
+
+  /* Areas are clipped to the window */
+  tracker.invalidate({190, 90, 50, 50});
+  ASSERT_EQ(3u, tracker.invalid_rects().size());
+  ASSERT_EQ((cen::irect {190, 90, 10, 10}), tracker.invalid_rects().back());
+}
+
+TEST_F(DamageTrackerTest, MaxRects)
+{
+  cen::damage_tracker tracker {{200, 100}, 4};
+  tracker.begin_frame(*mRenderer);
+  ASSERT_TRUE(tracker.end_frame(*mRenderer, *mWindow));
+
+  for (int i = 0; i < 10; ++i) {
+    tracker.invalidate({i * 20, 0, 5, 5});
+  }
+
+  ASSERT_LE(tracker.invalid_rects().size(), 4u);
+}
+
+TEST_F(DamageTrackerTest, PartialFrame)
+{
+  cen::damage_tracker tracker {{200, 100}};
+
+  tracker.begin_frame(*mRenderer);
+  ASSERT_TRUE(tracker.is_recording());
+  ASSERT_EQ(&tracker, mRenderer->get_damage_tracker());
+
+  mRenderer->fill_with(cen::colors::black);
+  ASSERT_TRUE(tracker.end_frame(*mRenderer, *mWindow));
+  ASSERT_FLOAT_EQ(1.0f, tracker.redraw_fraction());
+  ASSERT_FALSE(mRenderer->get_damage_tracker());
+
+  /* Only a small label changed, so only that area is presented */
+  tracker.invalidate({10, 10, 20, 10});
+  tracker.begin_frame(*mRenderer);
+  ASSERT_EQ((cen::irect {10, 10, 20, 10}), mRenderer->clip());
+
+  mRenderer->fill_with(cen::colors::black);
+  mRenderer->fill_rect(cen::irect {12, 12, 100, 100});
+  ASSERT_TRUE(tracker.end_frame(*mRenderer, *mWindow));
+
+  ASSERT_EQ(1u, tracker.rects().size());
+  ASSERT_EQ((cen::irect {10, 10, 20, 10}), tracker.rects().front());
+  ASSERT_EQ(200u, tracker.damaged_pixels());
+  ASSERT_FLOAT_EQ(0.01f, tracker.redraw_fraction());
+  ASSERT_FALSE(mRenderer->clip().has_value());
+}
+
+TEST_F(DamageTrackerTest, IgnoreTargetTextures)
+{
+  auto target = mRenderer->make_texture({16, 16},
+                                        cen::pixel_format::rgba8888,
+                                        cen::texture_access::target);
+
+  cen::damage_tracker tracker {{200, 100}};
+  tracker.begin_frame(*mRenderer);
+
+  ASSERT_TRUE(mRenderer->set_target(target));
+  mRenderer->fill_rect(cen::irect {0, 0, 16, 16});
+  ASSERT_TRUE(tracker.rects().empty());
+
+  ASSERT_TRUE(mRenderer->reset_target());
+  mRenderer->fill_rect(cen::irect {10, 10, 20, 20});
+  ASSERT_TRUE(tracker.end_frame(*mRenderer, *mWindow));
+
+  ASSERT_EQ(1u, tracker.rects().size());
+  ASSERT_EQ((cen::irect {10, 10, 20, 20}), tracker.rects().front());
+}
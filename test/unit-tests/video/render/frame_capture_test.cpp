@@ -0,0 +1,163 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "centurion/video/frame_capture.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>    // atomic
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
+
+#include "centurion/concurrency/semaphore.hpp"
+#include "centurion/video/renderer.hpp"
+#include "centurion/video/window.hpp"
+
+class FrameCaptureTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(FrameCaptureTest, CustomSink)
+{
+  std::atomic<int> frames {0};
+
+  cen::frame_capture capture {[&frames](const cen::surface& frame, const cen::usize) {
+                                ++frames;
+                                return cen::result {frame.width() > 0};
+                              },
+                              2};
+  ASSERT_EQ(2u, capture.buffer_count());
+  ASSERT_EQ(cen::pixel_format::argb8888, capture.format());
+
+  for (int i = 0; i < 5; ++i) {
+    mRenderer->clear_with(cen::colors::red);
+    ASSERT_TRUE(capture.capture(*mRenderer));
+    capture.wait();
+  }
+
+  ASSERT_EQ(5, frames);
+
+  const auto stats = capture.stats();
+  ASSERT_EQ(5u, stats.captured);
+  ASSERT_EQ(5u, stats.encoded);
+  ASSERT_EQ(0u, stats.dropped);
+  ASSERT_EQ(0u, stats.failed);
+}
+
+TEST_F(FrameCaptureTest, CaptureArea)
+{
+  cen::iarea size;
+
+  cen::frame_capture capture {[&size](const cen::surface& frame, const cen::usize) {
+                                size = frame.size();
+                                return cen::success;
+                              },
+                              1};
+
+  ASSERT_TRUE(capture.capture(*mRenderer, cen::irect {10, 10, 32, 16}));
+  capture.wait();
+
+  ASSERT_EQ(32, size.width);
+  ASSERT_EQ(16, size.height);
+}
+
+TEST_F(FrameCaptureTest, DropFramesUnderBackpressure)
+{
+  cen::semaphore gate {0};
+
+  cen::frame_capture capture {[&gate](const cen::surface&, const cen::usize) {
+                                return gate.acquire();
+                              },
+                              1};
+
+  ASSERT_TRUE(capture.capture(*mRenderer));
+  ASSERT_FALSE(capture.capture(*mRenderer));
+  ASSERT_EQ(1u, capture.pending());
+
+  gate.release();
+  capture.wait();
+
+  const auto stats = capture.stats();
+  ASSERT_EQ(1u, stats.captured);
+  ASSERT_EQ(1u, stats.dropped);
+  ASSERT_EQ(0u, capture.pending());
+}
+
+TEST_F(FrameCaptureTest, ThrowingSink)
+{
+  cen::frame_capture capture {[](const cen::surface&, const cen::usize) -> cen::result {
+                                throw cen::exception {"Sink failure!"};
+                              },
+                              1};
+
+  /* The buffer must be released, otherwise every later frame would be dropped */
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(capture.capture(*mRenderer));
+    capture.wait();
+  }
+
+  const auto stats = capture.stats();
+  ASSERT_EQ(3u, stats.captured);
+  ASSERT_EQ(3u, stats.failed);
+  ASSERT_EQ(0u, stats.dropped);
+  ASSERT_EQ(0u, capture.pending());
+}
+
+TEST_F(FrameCaptureTest, SaveAsBmp)
+{
+  cen::frame_capture_cfg cfg;
+  cfg.prefix = "frame_capture_test_";
+  cfg.format = cen::capture_format::bmp;
+
+  cen::frame_capture capture {cfg};
+  ASSERT_TRUE(capture.capture(*mRenderer));
+  capture.wait();
+
+  ASSERT_EQ(1u, capture.stats().encoded);
+  ASSERT_NO_THROW(cen::surface::from_bmp("frame_capture_test_000000.bmp"));
+}
+
+TEST(CaptureFormat, ToString)
+{
+  ASSERT_THROW(cen::to_string(static_cast<cen::capture_format>(3)), cen::exception);
+
+  ASSERT_EQ("png", cen::to_string(cen::capture_format::png));
+  ASSERT_EQ("bmp", cen::to_string(cen::capture_format::bmp));
+  ASSERT_EQ("raw", cen::to_string(cen::capture_format::raw));
+
+  std::cout << "capture_format::png == " << cen::capture_format::png << '\n';
+}
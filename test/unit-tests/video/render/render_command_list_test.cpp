@@ -0,0 +1,177 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "centurion/video/render_command_list.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>  // unique_ptr
+#include <vector>  // vector
+
+#include "centurion/video/window.hpp"
+
+class RenderCommandListTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+    mTexture = std::make_unique<cen::texture>(mRenderer->make_texture("resources/panda.png"));
+  }
+
+  static void TearDownTestSuite()
+  {
+    mTexture.reset();
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+  inline static std::unique_ptr<cen::texture> mTexture;
+};
+
+TEST_F(RenderCommandListTest, Defaults)
+{
+  const cen::render_command_list list;
+  ASSERT_TRUE(list.empty());
+  ASSERT_EQ(0u, list.size());
+}
+
+TEST_F(RenderCommandListTest, Record)
+{
+  cen::render_command_list list;
+
+  list.clear_with(cen::colors::black);
+  list.set_color(cen::colors::red);
+  list.fill_rect(cen::irect {10, 10, 50, 50});
+  list.draw_rect(cen::frect {10, 10, 50, 50});
+  list.draw_line(cen::ipoint {0, 0}, cen::ipoint {100, 100});
+  list.draw_lines(std::vector<cen::fpoint> {{0, 0}, {10, 10}, {20, 0}});
+  list.draw_point(cen::ipoint {5, 5});
+  list.render(*mTexture, cen::ipoint {10, 20});
+
+  ASSERT_FALSE(list.empty());
+  ASSERT_EQ(8u, list.size());
+
+  /* Empty polylines are not recorded */
+  list.draw_lines(std::vector<cen::fpoint> {});
+  ASSERT_EQ(8u, list.size());
+}
+
+TEST_F(RenderCommandListTest, ResetKeepsCapacity)
+{
+  cen::render_command_list list;
+  list.reserve(64);
+
+  for (int i = 0; i < 32; ++i) {
+    list.fill_rect(cen::irect {i, i, 10, 10});
+  }
+
+  const auto capacity = list.capacity();
+  ASSERT_GE(capacity, 64u);
+
+  list.reset();
+  ASSERT_TRUE(list.empty());
+  ASSERT_EQ(capacity, list.capacity());
+}
+
+TEST_F(RenderCommandListTest, Replay)
+{
+  cen::render_command_list list;
+
+  list.clear_with(cen::colors::black);
+  list.set_color(cen::colors::red);
+  list.fill_rect(cen::irect {10, 10, 50, 50});
+  list.render(*mTexture, cen::ipoint {10, 20});
+  list.render(*mTexture, cen::frect {10, 10, 100, 100});
+  list.render(*mTexture, cen::irect {0, 0, 20, 20}, cen::irect {10, 10, 20, 20});
+  list.render(*mTexture, cen::irect {0, 0, 20, 20}, cen::frect {10, 10, 20, 20}, 45.0);
+  list.render(*mTexture,
+              cen::irect {0, 0, 20, 20},
+              cen::irect {10, 10, 20, 20},
+              45.0,
+              cen::ipoint {0, 0},
+              cen::renderer_flip::horizontal);
+
+  const auto stats = list.replay(*mRenderer);
+  ASSERT_EQ(list.size(), stats.executed);
+  ASSERT_EQ(0u, stats.elided);
+  ASSERT_EQ(0u, stats.failed);
+  ASSERT_EQ(cen::colors::red, mRenderer->get_color());
+
+  /* Lists can be replayed several times */
+  ASSERT_EQ(list.size(), list.replay(*mRenderer).executed);
+}
+
+TEST_F(RenderCommandListTest, StateElision)
+{
+  cen::render_command_list list;
+
+  list.set_color(cen::colors::red);
+  list.fill_rect(cen::irect {0, 0, 10, 10});
+  list.set_color(cen::colors::red);
+  list.fill_rect(cen::irect {10, 0, 10, 10});
+  list.set_color(cen::colors::blue);
+
+  list.set_blend_mode(cen::blend_mode::blend);
+  list.set_blend_mode(cen::blend_mode::blend);
+
+  list.set_clip(cen::irect {0, 0, 50, 50});
+  list.set_clip(cen::irect {0, 0, 50, 50});
+  list.reset_clip();
+  list.reset_clip();
+
+  const auto stats = list.replay(*mRenderer);
+  ASSERT_EQ(4u, stats.elided);
+  ASSERT_EQ(list.size() - 4u, stats.executed);
+  ASSERT_EQ(cen::colors::blue, mRenderer->get_color());
+  ASSERT_FALSE(mRenderer->clip().has_value());
+}
+
+TEST_F(RenderCommandListTest, ClearWithKeepsColor)
+{
+  cen::render_command_list list;
+  list.set_color(cen::colors::red);
+  list.clear_with(cen::colors::black);
+  list.fill_with(cen::colors::blue);
+
+  list.replay(*mRenderer);
+  ASSERT_EQ(cen::colors::red, mRenderer->get_color());
+}
+
+TEST_F(RenderCommandListTest, RenderTarget)
+{
+  auto target = mRenderer->make_texture({32, 32},
+                                        mWindow->format(),
+                                        cen::texture_access::target);
+
+  cen::render_command_list list;
+  list.set_target(target);
+  list.clear_with(cen::colors::green);
+  list.reset_target();
+
+  const auto stats = list.replay(*mRenderer);
+  ASSERT_EQ(3u, stats.executed);
+  ASSERT_FALSE(mRenderer->get_target());
+}
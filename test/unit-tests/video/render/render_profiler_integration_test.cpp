@@ -0,0 +1,103 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>  // unique_ptr
+#include <vector>  // vector
+
+#include "centurion/video/render_profiler.hpp"
+#include "centurion/video/renderer.hpp"
+#include "centurion/video/surface.hpp"
+#include "centurion/video/window.hpp"
+
+#ifndef CENTURION_ENABLE_RENDER_PROFILER
+#error "The render profiler integration tests require CENTURION_ENABLE_RENDER_PROFILER"
+#endif  // CENTURION_ENABLE_RENDER_PROFILER
+
+class InstrumentedRendererTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>("", cen::iarea {200, 100});
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer(cen::renderer::software));
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(InstrumentedRendererTest, RecordFrame)
+{
+  cen::render_profiler profiler;
+  mRenderer->set_profiler(&profiler);
+  ASSERT_EQ(&profiler, mRenderer->get_profiler());
+
+  const cen::surface image {{8, 4}, cen::pixel_format::rgba8888};
+  const auto texture = mRenderer->make_texture(image);
+
+  auto target = mRenderer->make_texture({16, 16},
+                                        cen::pixel_format::rgba8888,
+                                        cen::texture_access::target);
+
+  mRenderer->set_color(cen::colors::black);
+  mRenderer->clear();
+
+  mRenderer->set_color(cen::colors::black);
+  mRenderer->set_blend_mode(cen::blend_mode::blend);
+  mRenderer->fill_rect(cen::irect {10, 10, 20, 20});
+
+  const std::vector<cen::fpoint> points {{1, 1}, {2, 2}, {3, 3}};
+  mRenderer->draw_points(points);
+  mRenderer->draw_lines(points);
+
+  mRenderer->set_target(target);
+  mRenderer->render(texture, cen::ipoint {0, 0});
+  mRenderer->reset_target();
+
+  mRenderer->render(texture, cen::frect {20, 20, 8, 4});
+  mRenderer->present();
+
+  mRenderer->set_profiler(nullptr);
+  mRenderer->fill_rect(cen::irect {10, 10, 20, 20});
+
+  ASSERT_EQ(1u, profiler.frame_count());
+  ASSERT_EQ(0u, profiler.current().draw_calls);
+
+  const auto stats = profiler.last_frame().value();
+  ASSERT_EQ(6u, stats.draw_calls);
+  ASSERT_EQ(1u + 3u + 2u + 2u, stats.primitives);
+  ASSERT_EQ(1u, stats.texture_binds);
+  ASSERT_EQ(2u, stats.target_switches);
+  ASSERT_EQ(2u, stats.color_sets);
+  ASSERT_EQ(1u, stats.redundant_color_sets);
+  ASSERT_EQ(1u, stats.blend_sets);
+  ASSERT_EQ(static_cast<cen::usize>(image.pitch() * image.height()), stats.bytes_uploaded);
+}
@@ -0,0 +1,125 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/render_profiler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <sstream>  // stringstream
+
+TEST(RenderProfiler, RecordDraw)
+{
+  cen::render_profiler profiler;
+
+  int a {};
+  int b {};
+  const auto* first = reinterpret_cast<const SDL_Texture*>(&a);
+  const auto* second = reinterpret_cast<const SDL_Texture*>(&b);
+
+  profiler.record_draw(nullptr, 4);
+  profiler.record_draw(first, 1);
+  profiler.record_draw(first, 1);
+  profiler.record_draw(nullptr, 1); /* Untextured draws do not unbind textures */
+  profiler.record_draw(first, 1);
+  profiler.record_draw(second, 2);
+
+  const auto& stats = profiler.current();
+  ASSERT_EQ(6u, stats.draw_calls);
+  ASSERT_EQ(10u, stats.primitives);
+  ASSERT_EQ(2u, stats.texture_binds);
+}
+
+TEST(RenderProfiler, RedundantStateChanges)
+{
+  cen::render_profiler profiler;
+
+  profiler.record_color(cen::colors::red);
+  profiler.record_color(cen::colors::red);
+  profiler.record_color(cen::colors::blue);
+
+  profiler.record_blend_mode(cen::blend_mode::blend);
+  profiler.record_blend_mode(cen::blend_mode::add);
+  profiler.record_blend_mode(cen::blend_mode::add);
+  profiler.record_blend_mode(cen::blend_mode::add);
+
+  profiler.record_target(nullptr);  // Already using the default target
+
+  const auto& stats = profiler.current();
+  ASSERT_EQ(3u, stats.color_sets);
+  ASSERT_EQ(1u, stats.redundant_color_sets);
+  ASSERT_EQ(4u, stats.blend_sets);
+  ASSERT_EQ(2u, stats.redundant_blend_sets);
+  ASSERT_EQ(0u, stats.target_switches);
+}
+
+TEST(RenderProfiler, History)
+{
+  cen::render_profiler profiler {3};
+  ASSERT_EQ(3u, profiler.history());
+  ASSERT_FALSE(profiler.last_frame().has_value());
+
+  for (int i = 0; i < 5; ++i) {
+    profiler.record_upload(100);
+    profiler.end_frame();
+  }
+
+  ASSERT_EQ(3u, profiler.frame_count());
+  ASSERT_EQ(2u, profiler.frame(0).index);
+  ASSERT_EQ(3u, profiler.frame(1).index);
+  ASSERT_THROW((void) profiler.frame(3), cen::exception);
+  ASSERT_EQ(4u, profiler.last_frame()->index);
+  ASSERT_EQ(100u, profiler.last_frame()->bytes_uploaded);
+  ASSERT_LE(profiler.last_frame()->start, profiler.last_frame()->end);
+
+  /* Counters are reset for every frame */
+  ASSERT_EQ(5u, profiler.current().index);
+  ASSERT_EQ(0u, profiler.current().bytes_uploaded);
+
+  profiler.clear();
+  ASSERT_EQ(0u, profiler.frame_count());
+  ASSERT_EQ(0u, profiler.current().index);
+}
+
+TEST(RenderProfiler, ChromeTrace)
+{
+  cen::render_profiler profiler;
+
+  profiler.record_draw(nullptr, 2);
+  profiler.end_frame();
+  profiler.record_draw(nullptr, 1);
+  profiler.end_frame();
+
+  std::stringstream stream;
+  profiler.write_chrome_trace(stream);
+
+  const auto json = stream.str();
+  ASSERT_EQ(0u, json.find("{\"traceEvents\":["));
+  ASSERT_NE(std::string::npos, json.find("\"name\":\"frame 0\""));
+  ASSERT_NE(std::string::npos, json.find("\"name\":\"frame 1\""));
+  ASSERT_NE(std::string::npos, json.find("\"ph\":\"X\""));
+  ASSERT_NE(std::string::npos, json.find("\"ph\":\"C\""));
+  ASSERT_NE(std::string::npos, json.find("\"primitives\":2"));
+
+  ASSERT_TRUE(profiler.save_chrome_trace("render_trace.json"));
+}
@@ -28,6 +28,7 @@
 
 #include <iostream>  // cout
 #include <memory>    // unique_ptr
+#include <vector>    // vector
 
 #include "centurion/common/math.hpp"
 #include "centurion/fonts/font.hpp"
@@ -198,6 +199,37 @@ TEST_F(RendererTest, Capture)
   mWindow->hide();
 }
 
+TEST_F(RendererTest, BatchedPrimitives)
+{
+  const std::vector<cen::ipoint> ipoints {{10, 10}, {20, 20}, {30, 30}};
+  const std::vector<cen::fpoint> fpoints {{10.5f, 10.5f}, {20.5f, 20.5f}};
+  const std::vector<cen::irect> irects {{10, 10, 50, 50}, {80, 80, 20, 20}};
+  const std::vector<cen::frect> frects {{10, 10, 50, 50}, {80.5f, 80.5f, 20, 20}};
+
+  ASSERT_TRUE(mRenderer->draw_points(ipoints));
+  ASSERT_TRUE(mRenderer->draw_points(fpoints));
+  ASSERT_TRUE(mRenderer->draw_rects(irects));
+  ASSERT_TRUE(mRenderer->draw_rects(frects));
+  ASSERT_TRUE(mRenderer->fill_rects(irects));
+  ASSERT_TRUE(mRenderer->fill_rects(frects));
+
+  ASSERT_FALSE(mRenderer->draw_points(std::vector<cen::ipoint> {}));
+  ASSERT_FALSE(mRenderer->draw_rects(std::vector<cen::irect> {}));
+  ASSERT_FALSE(mRenderer->fill_rects(std::vector<cen::frect> {}));
+  ASSERT_FALSE(mRenderer->fill_rects(static_cast<const cen::irect*>(nullptr), 1));
+
+  ASSERT_TRUE(mRenderer->draw_circle(cen::ipoint {100, 100}, 20));
+  ASSERT_TRUE(mRenderer->fill_circle(cen::fpoint {100, 100}, 20));
+  ASSERT_TRUE(mRenderer->draw_ellipse(cen::fpoint {200, 100}, {40, 20}));
+  ASSERT_TRUE(mRenderer->fill_ellipse(cen::ipoint {200, 100}, {40, 20}));
+
+  ASSERT_FALSE(mRenderer->fill_ellipse(cen::fpoint {200, 100}, {-1, 20}));
+
+  /* Shapes that are too small to cover any pixels are not errors */
+  ASSERT_TRUE(mRenderer->draw_circle(cen::fpoint {100, 100}, 0.25f));
+  ASSERT_TRUE(mRenderer->fill_circle(cen::ipoint {100, 100}, 0.5f));
+}
+
 TEST_F(RendererTest, StreamOperator)
 {
   std::cout << *mRenderer << '\n';
@@ -217,4 +249,41 @@ TEST_F(RendererTest, ToLogical)
   ASSERT_EQ(real, mRenderer->from_logical(logical));
 }
 
+TEST_F(RendererTest, RenderGeo)
+{
+  const std::vector<SDL_Vertex> vertices {{{10, 10}, cen::colors::red.get(), {0, 0}},
+                                          {{60, 10}, cen::colors::green.get(), {1, 0}},
+                                          {{60, 60}, cen::colors::blue.get(), {1, 1}},
+                                          {{10, 60}, cen::colors::white.get(), {0, 1}}};
+  const std::vector<int> indices {0, 1, 2, 2, 3, 0};
+
+  ASSERT_TRUE(mRenderer->render_geo(vertices));
+  ASSERT_TRUE(mRenderer->render_geo(vertices, indices));
+  ASSERT_TRUE(mRenderer->render_geo(*mTexture, vertices));
+  ASSERT_TRUE(mRenderer->render_geo(*mTexture, vertices, indices));
+
+  ASSERT_TRUE(mRenderer->render_geo(vertices.data(), vertices.size()));
+  ASSERT_TRUE(mRenderer->render_geo(*mTexture,
+                                    vertices.data(),
+                                    vertices.size(),
+                                    indices.data(),
+                                    indices.size()));
+}
+
+TEST_F(RendererTest, RenderGeoRaw)
+{
+  // Positions and texture coordinates in separate arrays, with a single shared color
+  const float xy[] = {10, 10, 60, 10, 60, 60, 10, 60};
+  const float uv[] = {0, 0, 1, 0, 1, 1, 0, 1};
+  const SDL_Color color = cen::colors::white.get();
+  const cen::uint16 indices[] = {0, 1, 2, 2, 3, 0};
+
+  const int stride = 2 * sizeof(float);
+  ASSERT_TRUE(mRenderer->render_geo_raw(xy, stride, &color, 0, 4));
+  ASSERT_TRUE(mRenderer->render_geo_raw(xy, stride, &color, 0, 4, indices, 6));
+  ASSERT_TRUE(mRenderer->render_geo_raw(*mTexture, xy, stride, &color, 0, uv, stride, 4));
+  ASSERT_TRUE(
+      mRenderer->render_geo_raw(*mTexture, xy, stride, &color, 0, uv, stride, 4, indices, 6));
+}
+
 #endif  // SDL_VERSION_ATLEAST(2, 0, 18)
\ No newline at end of file
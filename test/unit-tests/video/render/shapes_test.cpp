@@ -0,0 +1,203 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/shapes.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>     // abs
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
+#include <vector>    // vector
+
+#include "centurion/video/window.hpp"
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+namespace {
+
+[[nodiscard]] auto mesh_area(const cen::shape_mesh& mesh) -> float
+{
+  const auto& vertices = mesh.vertices();
+  const auto& indices = mesh.indices();
+
+  float area = 0;
+  for (cen::usize i = 0; i + 2 < indices.size(); i += 3) {
+    const auto& a = vertices[static_cast<cen::usize>(indices[i])].position;
+    const auto& b = vertices[static_cast<cen::usize>(indices[i + 1])].position;
+    const auto& c = vertices[static_cast<cen::usize>(indices[i + 2])].position;
+    area += std::abs((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) / 2.0f;
+  }
+
+  return area;
+}
+
+}  // namespace
+
+class ShapesTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(ShapesTest, ConcavePolygon)
+{
+  const std::vector<cen::fpoint> points {{0, 0}, {10, 0}, {10, 4}, {4, 4}, {4, 10}, {0, 10}};
+
+  cen::shape_mesh mesh;
+  ASSERT_TRUE(mesh.add_polygon(points, cen::colors::red));
+
+  ASSERT_EQ(6u, mesh.vertex_count());
+  ASSERT_EQ(4u, mesh.triangle_count());
+  ASSERT_FLOAT_EQ(64.0f, mesh_area(mesh));
+
+  // The winding order of the polygon should not matter
+  const std::vector<cen::fpoint> reversed {points.rbegin(), points.rend()};
+  mesh.clear();
+  ASSERT_TRUE(mesh.add_polygon(reversed, cen::colors::red));
+  ASSERT_FLOAT_EQ(64.0f, mesh_area(mesh));
+
+  ASSERT_FALSE(mesh.add_polygon(points.data(), 2, cen::colors::red));
+  ASSERT_TRUE(mesh.render(*mRenderer));
+}
+
+TEST_F(ShapesTest, Polyline)
+{
+  const std::vector<cen::fpoint> square {{0, 0}, {100, 0}, {100, 100}, {0, 100}};
+  cen::shape_mesh mesh;
+
+  ASSERT_TRUE(mesh.add_polyline(square.data(), 2, 4, cen::colors::red));
+  ASSERT_FLOAT_EQ(400.0f, mesh_area(mesh));
+
+  // The segment quads overlap in the corners, so the sum is larger than the covered area
+  mesh.clear();
+  ASSERT_TRUE(mesh.add_polyline(square, 10, cen::colors::red, cen::line_join::bevel, true));
+  ASSERT_FLOAT_EQ(4'050.0f, mesh_area(mesh));
+
+  mesh.clear();
+  ASSERT_TRUE(mesh.add_polyline(square, 10, cen::colors::red, cen::line_join::miter, true));
+  ASSERT_FLOAT_EQ(4'100.0f, mesh_area(mesh));
+
+  mesh.clear();
+  ASSERT_TRUE(mesh.add_polyline(square, 10, cen::colors::red, cen::line_join::round, true));
+  ASSERT_GT(mesh_area(mesh), 4'050.0f);
+  ASSERT_LT(mesh_area(mesh), 4'100.0f);
+
+  ASSERT_FALSE(mesh.add_polyline(square, 0, cen::colors::red));
+  ASSERT_FALSE(mesh.add_polyline(square.data(), 1, 4, cen::colors::red));
+  ASSERT_TRUE(mesh.render(*mRenderer));
+}
+
+TEST_F(ShapesTest, CurvedShapes)
+{
+  cen::shape_mesh mesh;
+
+  mesh.add_ellipse({50, 50}, {20, 10}, cen::colors::red, 64);
+  ASSERT_EQ(65u, mesh.vertex_count());
+  ASSERT_EQ(64u, mesh.triangle_count());
+  ASSERT_NEAR(628.3f, mesh_area(mesh), 5.0f);
+
+  mesh.clear();
+  mesh.add_rounded_rect({0, 0, 100, 50}, 10, cen::colors::red);
+  ASSERT_NEAR(4'914.2f, mesh_area(mesh), 15.0f);
+
+  mesh.clear();
+  mesh.add_rounded_rect({0, 0, 100, 50}, 0, cen::colors::red);
+  ASSERT_FLOAT_EQ(5'000.0f, mesh_area(mesh));
+
+  ASSERT_TRUE(mesh.add_ellipse_outline({50, 50}, {20, 10}, 2, cen::colors::blue));
+  ASSERT_TRUE(mesh.add_rounded_rect_outline({0, 0, 100, 50}, 8, 2, cen::colors::blue));
+  ASSERT_TRUE(mesh.render(*mRenderer));
+}
+
+TEST_F(ShapesTest, Cache)
+{
+  cen::shape_cache cache;
+
+  const auto& first = cache.ellipse({50, 50}, {20, 10}, cen::colors::red);
+  const auto& second = cache.ellipse({50, 50}, {20, 10}, cen::colors::red);
+  ASSERT_EQ(&first, &second);
+
+  cache.ellipse({50, 50}, {20, 10}, cen::colors::blue);
+
+  const std::vector<cen::fpoint> points {{0, 0}, {10, 0}, {10, 10}};
+  cache.polyline(points, 2, cen::colors::red);
+  cache.polyline(points, 2, cen::colors::red, cen::line_join::round);
+  cache.polygon(points, cen::colors::red);
+
+  const auto stats = cache.stats();
+  ASSERT_EQ(1u, stats.hits);
+  ASSERT_EQ(5u, stats.misses);
+  ASSERT_EQ(5u, stats.count);
+  ASSERT_EQ(0u, stats.evictions);
+
+  ASSERT_TRUE(cache.rounded_rect({0, 0, 40, 20}, 4, cen::colors::red).render(*mRenderer));
+
+  cache.clear();
+  ASSERT_EQ(0u, cache.size());
+  ASSERT_EQ(0u, cache.stats().vertices);
+}
+
+TEST_F(ShapesTest, CacheBudget)
+{
+  cen::shape_cache cache {100};
+
+  for (int i = 0; i < 10; ++i) {
+    cache.ellipse({0, 0}, {10.0f + static_cast<float>(i), 10}, cen::colors::red, 32);
+  }
+
+  const auto stats = cache.stats();
+  ASSERT_LE(stats.vertices, cache.budget());
+  ASSERT_EQ(3u, stats.count);
+  ASSERT_EQ(7u, stats.evictions);
+
+  // The most recent mesh is kept even if it exceeds the budget on its own
+  cache.set_budget(0);
+  ASSERT_EQ(1u, cache.size());
+}
+
+TEST(LineJoin, ToString)
+{
+  ASSERT_THROW(to_string(static_cast<cen::line_join>(3)), cen::exception);
+
+  ASSERT_EQ("miter", to_string(cen::line_join::miter));
+  ASSERT_EQ("bevel", to_string(cen::line_join::bevel));
+  ASSERT_EQ("round", to_string(cen::line_join::round));
+
+  std::cout << "line_join::round == " << cen::line_join::round << '\n';
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
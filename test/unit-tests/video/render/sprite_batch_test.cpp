@@ -0,0 +1,150 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/sprite_batch.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
+
+#include "centurion/video/window.hpp"
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+class SpriteBatchTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+    mTexture = std::make_unique<cen::texture>(mRenderer->make_texture("resources/panda.png"));
+    mOther = std::make_unique<cen::texture>(mRenderer->make_texture("resources/panda.png"));
+  }
+
+  static void TearDownTestSuite()
+  {
+    mOther.reset();
+    mTexture.reset();
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+  inline static std::unique_ptr<cen::texture> mTexture;
+  inline static std::unique_ptr<cen::texture> mOther;
+};
+
+TEST_F(SpriteBatchTest, Defaults)
+{
+  const cen::sprite_batch batch;
+  ASSERT_TRUE(batch.empty());
+  ASSERT_EQ(0u, batch.size());
+  ASSERT_EQ(0u, batch.draw_calls());
+  ASSERT_EQ(0u, batch.flushed_sprites());
+  ASSERT_EQ(cen::sprite_sort_mode::texture, batch.sort_mode());
+}
+
+TEST_F(SpriteBatchTest, Add)
+{
+  cen::sprite_batch batch;
+
+  batch.add(*mTexture, cen::frect {10, 10, 50, 50});
+  batch.add(*mTexture,
+            cen::irect {0, 0, 25, 25},
+            cen::frect {20, 20, 25, 25},
+            45.0,
+            cen::renderer_flip::horizontal,
+            cen::colors::red);
+
+  ASSERT_FALSE(batch.empty());
+  ASSERT_EQ(2u, batch.size());
+
+  batch.clear();
+  ASSERT_TRUE(batch.empty());
+}
+
+TEST_F(SpriteBatchTest, FlushEmpty)
+{
+  cen::sprite_batch batch;
+  ASSERT_TRUE(batch.flush(*mRenderer));
+  ASSERT_EQ(0u, batch.draw_calls());
+}
+
+TEST_F(SpriteBatchTest, FlushSortedByTexture)
+{
+  cen::sprite_batch batch;
+
+  for (int i = 0; i < 10; ++i) {
+    const auto& texture = (i % 2 == 0) ? *mTexture : *mOther;
+    batch.add(texture, cen::frect {i * 10.0f, 0, 10, 10});
+  }
+
+  ASSERT_TRUE(batch.flush(*mRenderer));
+  ASSERT_EQ(2u, batch.draw_calls());
+  ASSERT_EQ(10u, batch.flushed_sprites());
+  ASSERT_TRUE(batch.empty());
+}
+
+TEST_F(SpriteBatchTest, FlushUnsorted)
+{
+  cen::sprite_batch batch {cen::sprite_sort_mode::none};
+
+  for (int i = 0; i < 10; ++i) {
+    const auto& texture = (i % 2 == 0) ? *mTexture : *mOther;
+    batch.add(texture, cen::frect {i * 10.0f, 0, 10, 10});
+  }
+
+  ASSERT_TRUE(batch.flush(*mRenderer));
+  ASSERT_EQ(10u, batch.draw_calls());
+}
+
+TEST_F(SpriteBatchTest, FlushSplitsBlendModes)
+{
+  const auto mode = mTexture->get_blend_mode();
+  cen::sprite_batch batch;
+
+  batch.add(*mTexture, cen::frect {0, 0, 10, 10}, cen::colors::white, cen::blend_mode::add);
+  batch.add(*mTexture, cen::frect {0, 0, 10, 10});
+  batch.add(*mTexture, cen::frect {0, 0, 10, 10}, cen::colors::white, cen::blend_mode::add);
+
+  ASSERT_TRUE(batch.flush(*mRenderer));
+  ASSERT_EQ(2u, batch.draw_calls());
+
+  // The original blend mode of the texture should be restored
+  ASSERT_EQ(mode, mTexture->get_blend_mode());
+}
+
+TEST(SpriteSortMode, ToString)
+{
+  ASSERT_THROW(to_string(static_cast<cen::sprite_sort_mode>(2)), cen::exception);
+
+  ASSERT_EQ("none", to_string(cen::sprite_sort_mode::none));
+  ASSERT_EQ("texture", to_string(cen::sprite_sort_mode::texture));
+
+  std::cout << "sprite_sort_mode::texture == " << cen::sprite_sort_mode::texture << '\n';
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
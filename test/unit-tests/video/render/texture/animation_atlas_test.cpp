@@ -0,0 +1,199 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/animation_atlas.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
+#include <vector>    // vector
+
+#include "centurion/video/window.hpp"
+
+#if SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
+
+namespace {
+
+/// Creates an animation with solid colored frames, allocated like SDL_image does.
+[[nodiscard]] auto make_animation(const cen::iarea size, const std::vector<int>& delays)
+    -> cen::animation
+{
+  auto* anim = static_cast<IMG_Animation*>(SDL_calloc(1, sizeof(IMG_Animation)));
+  anim->w = size.width;
+  anim->h = size.height;
+  anim->count = static_cast<int>(delays.size());
+  anim->frames = static_cast<SDL_Surface**>(SDL_calloc(delays.size(), sizeof(SDL_Surface*)));
+  anim->delays = static_cast<int*>(SDL_calloc(delays.size(), sizeof(int)));
+
+  for (cen::usize i = 0; i < delays.size(); ++i) {
+    anim->frames[i] = SDL_CreateRGBSurfaceWithFormat(0,
+                                                     size.width,
+                                                     size.height,
+                                                     32,
+                                                     SDL_PIXELFORMAT_ARGB8888);
+    SDL_FillRect(anim->frames[i], nullptr, 0xFF000000u | static_cast<cen::uint32>(i * 40));
+    anim->delays[i] = delays[i];
+  }
+
+  return cen::animation {anim};
+}
+
+}  // namespace
+
+class AnimationAtlasTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(AnimationAtlasTest, Layout)
+{
+  cen::animation_atlas atlas {*mRenderer, make_animation({16, 12}, {10, 20, 30, 40, 50})};
+
+  ASSERT_EQ(5u, atlas.frame_count());
+  ASSERT_EQ(16, atlas.frame_size().width);
+  ASSERT_EQ(12, atlas.frame_size().height);
+  ASSERT_EQ(150, atlas.duration());
+  ASSERT_EQ(30, atlas.delay(2));
+
+  const auto textureSize = atlas.get_texture().size();
+  for (cen::usize i = 0; i < atlas.frame_count(); ++i) {
+    const auto& region = atlas.region(i);
+    ASSERT_EQ(atlas.frame_size().width, region.width());
+    ASSERT_EQ(atlas.frame_size().height, region.height());
+    ASSERT_LE(region.max_x() + atlas.padding(), textureSize.width);
+    ASSERT_LE(region.max_y() + atlas.padding(), textureSize.height);
+
+    for (cen::usize j = i + 1; j < atlas.frame_count(); ++j) {
+      ASSERT_FALSE(cen::overlaps(region, atlas.region(j)));
+    }
+  }
+
+  ASSERT_THROW(cen::animation_atlas(*mRenderer, make_animation({16, 16}, {})), cen::exception);
+}
+
+TEST_F(AnimationAtlasTest, LazyUpload)
+{
+  cen::animation_atlas atlas {*mRenderer, make_animation({8, 8}, {10, 10, 10})};
+  ASSERT_EQ(0u, atlas.uploaded_count());
+
+  const auto frame = atlas.frame(1);
+  ASSERT_TRUE(frame);
+  ASSERT_EQ(atlas.region(1), frame.region());
+  ASSERT_EQ(atlas.get_texture().get(), frame.get());
+
+  ASSERT_TRUE(atlas.is_uploaded(1));
+  ASSERT_FALSE(atlas.is_uploaded(0));
+  ASSERT_EQ(1u, atlas.uploaded_count());
+
+  ASSERT_TRUE(atlas.prepare_all());
+  ASSERT_EQ(3u, atlas.uploaded_count());
+  ASSERT_FALSE(atlas.prepare(3));
+
+  cen::animation_atlas eager {*mRenderer,
+                              make_animation({8, 8}, {10, 10}),
+                              cen::frame_upload::eager};
+  ASSERT_EQ(2u, eager.uploaded_count());
+}
+
+TEST_F(AnimationAtlasTest, FrameAt)
+{
+  // The zero delay is replaced by the default delay
+  cen::animation_atlas atlas {*mRenderer, make_animation({4, 4}, {30, 70, 0})};
+  ASSERT_EQ(200, atlas.duration());
+
+  ASSERT_EQ(0u, atlas.frame_at(-5));
+  ASSERT_EQ(0u, atlas.frame_at(0));
+  ASSERT_EQ(0u, atlas.frame_at(29.9));
+  ASSERT_EQ(1u, atlas.frame_at(30));
+  ASSERT_EQ(1u, atlas.frame_at(99));
+  ASSERT_EQ(2u, atlas.frame_at(100));
+  ASSERT_EQ(2u, atlas.frame_at(199));
+  ASSERT_EQ(0u, atlas.frame_at(200));
+  ASSERT_EQ(1u, atlas.frame_at(2'045));
+
+  ASSERT_EQ(2u, atlas.frame_at(200, false));
+  ASSERT_EQ(2u, atlas.frame_at(1e9, false));
+
+  // Delays without a useful common divisor use a binary search instead of a table
+  cen::animation_atlas irregular {*mRenderer, make_animation({4, 4}, {4'001, 3'989, 1})};
+  ASSERT_EQ(0u, irregular.frame_at(4'000));
+  ASSERT_EQ(1u, irregular.frame_at(4'001));
+  ASSERT_EQ(2u, irregular.frame_at(7'990));
+  ASSERT_EQ(0u, irregular.frame_at(7'991));
+}
+
+TEST_F(AnimationAtlasTest, Player)
+{
+  cen::animation_atlas atlas {*mRenderer, make_animation({4, 4}, {100, 100, 100})};
+  cen::animation_player player {atlas};
+
+  const auto first = player.play();
+  player.update(cen::seconds<double> {0.125});
+
+  const auto second = player.play(2.0f, false);
+  ASSERT_EQ(125.0, player.time());
+  ASSERT_EQ(1u, player.frame_index(first));
+  ASSERT_EQ(0u, player.frame_index(second));
+
+  player.update(cen::seconds<double> {0.125});
+  ASSERT_EQ(2u, player.frame_index(first));
+  ASSERT_EQ(2u, player.frame_index(second));
+  ASSERT_FALSE(player.finished(second));
+
+  player.update(cen::seconds<double> {0.125});
+  ASSERT_EQ(0u, player.frame_index(first));
+  ASSERT_EQ(2u, player.frame_index(second));
+  ASSERT_TRUE(player.finished(second));
+  ASSERT_FALSE(player.finished(first));
+
+  ASSERT_TRUE(player.render(*mRenderer, first, cen::frect {0, 0, 4, 4}));
+  ASSERT_TRUE(atlas.is_uploaded(0));
+  ASSERT_FALSE(atlas.is_uploaded(1));
+}
+
+TEST_F(AnimationAtlasTest, FrameUploadToString)
+{
+  ASSERT_THROW(cen::to_string(static_cast<cen::frame_upload>(2)), cen::exception);
+
+  ASSERT_EQ("eager", cen::to_string(cen::frame_upload::eager));
+  ASSERT_EQ("lazy", cen::to_string(cen::frame_upload::lazy));
+
+  std::cout << "frame_upload::lazy == " << cen::frame_upload::lazy << '\n';
+}
+
+#endif  // SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
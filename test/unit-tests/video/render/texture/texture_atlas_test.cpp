@@ -0,0 +1,152 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/texture_atlas.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>  // unique_ptr
+#include <string>  // string, to_string
+
+#include "centurion/video/window.hpp"
+
+class TextureAtlasTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(TextureAtlasTest, Build)
+{
+  cen::atlas_builder builder {{64, 64}, 1};
+
+  for (int i = 0; i < 8; ++i) {
+    builder.add("image" + std::to_string(i),
+                cen::surface {{20, 10 + i}, cen::pixel_format::rgba32});
+  }
+
+  ASSERT_EQ(8u, builder.size());
+  ASSERT_THROW(builder.add("image0", cen::surface {{4, 4}, cen::pixel_format::rgba32}),
+               cen::exception);
+
+  const auto layout = builder.build();
+  ASSERT_EQ(8u, layout.regions.size());
+  ASSERT_FALSE(layout.pages.empty());
+
+  for (cen::usize i = 0; i < layout.regions.size(); ++i) {
+    const auto& region = layout.regions.at(i);
+    ASSERT_EQ("image" + std::to_string(i), region.name);
+    ASSERT_EQ(20, region.area.width());
+    ASSERT_EQ(10 + static_cast<int>(i), region.area.height());
+
+    const auto& page = layout.pages.at(region.page);
+    ASSERT_LE(region.area.max_x(), page.width());
+    ASSERT_LE(region.area.max_y(), page.height());
+
+    // Images on the same page must not overlap, including their padding
+    for (cen::usize j = i + 1; j < layout.regions.size(); ++j) {
+      const auto& other = layout.regions.at(j);
+      if (other.page == region.page) {
+        const cen::irect padded {region.area.x() - 1,
+                                 region.area.y() - 1,
+                                 region.area.width() + 2,
+                                 region.area.height() + 2};
+        ASSERT_FALSE(cen::overlaps(padded, other.area));
+      }
+    }
+  }
+}
+
+TEST_F(TextureAtlasTest, ImageTooLarge)
+{
+  cen::atlas_builder builder {{32, 32}};
+  builder.add("large", cen::surface {{64, 16}, cen::pixel_format::rgba32});
+  ASSERT_THROW((void) builder.build(), cen::exception);
+}
+
+TEST_F(TextureAtlasTest, Lookup)
+{
+  cen::atlas_builder builder {*mRenderer};
+  builder.add("panda", "resources/panda.png");
+  builder.add("small", cen::surface {{8, 8}, cen::pixel_format::rgba32});
+
+  const cen::texture_atlas atlas {*mRenderer, builder.build()};
+  ASSERT_EQ(1u, atlas.page_count());
+  ASSERT_EQ(2u, atlas.size());
+
+  ASSERT_TRUE(atlas.contains("panda"));
+  ASSERT_FALSE(atlas.contains("foo"));
+  ASSERT_FALSE(atlas.find("foo").has_value());
+  ASSERT_THROW((void) atlas.at("foo"), cen::exception);
+
+  const auto small = atlas.at("small");
+  ASSERT_TRUE(small);
+  ASSERT_EQ(atlas.page(0).get(), small.get());
+  ASSERT_EQ(8, small.width());
+  ASSERT_EQ(8, small.height());
+
+  ASSERT_TRUE(small.render(*mRenderer, cen::fpoint {10, 10}));
+  ASSERT_TRUE(small.render(*mRenderer, cen::irect {10, 10, 16, 16}));
+  ASSERT_TRUE(small.render(*mRenderer, cen::frect {10, 10, 16, 16}, 45.0));
+  ASSERT_TRUE(mRenderer->render(small.atlas(), small.region(), cen::frect {0, 0, 8, 8}));
+}
+
+TEST_F(TextureAtlasTest, SaveAndLoad)
+{
+  cen::atlas_builder builder {{128, 128}};
+  builder.add("panda", "resources/panda.png");
+  builder.add("name with spaces", cen::surface {{8, 4}, cen::pixel_format::rgba32});
+
+  const auto layout = builder.build();
+  ASSERT_TRUE(layout.save("atlas_test"));
+
+  const auto atlas = cen::texture_atlas::load(*mRenderer, "atlas_test");
+  ASSERT_EQ(layout.pages.size(), atlas.page_count());
+  ASSERT_EQ(layout.regions.size(), atlas.size());
+
+  for (const auto& region : layout.regions) {
+    const auto loaded = atlas.find(region.name);
+    ASSERT_TRUE(loaded.has_value());
+    ASSERT_EQ(region.area, loaded->region());
+    ASSERT_EQ(atlas.page(region.page).get(), loaded->get());
+  }
+
+  /* The page file names are derived from the prefix, so they contain spaces as well */
+  ASSERT_TRUE(layout.save("atlas test"));
+  ASSERT_EQ(layout.pages.size(), cen::texture_atlas::load(*mRenderer, "atlas test").page_count());
+
+  ASSERT_THROW(cen::texture_atlas::load(*mRenderer, "foo"), cen::exception);
+}
@@ -0,0 +1,185 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/texture_loader.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
+#include <vector>    // vector
+
+#include "centurion/video/window.hpp"
+
+class TextureLoaderTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(TextureLoaderTest, EmptyRequest)
+{
+  const cen::texture_request request;
+  ASSERT_FALSE(request);
+  ASSERT_FALSE(request.is_ready());
+  ASSERT_TRUE(request.is_done());
+  ASSERT_EQ(nullptr, request.get());
+}
+
+TEST_F(TextureLoaderTest, Load)
+{
+  cen::texture_loader loader {2};
+  ASSERT_EQ(2u, loader.thread_count());
+
+  auto request = loader.load("resources/panda.png");
+  ASSERT_TRUE(request);
+  ASSERT_EQ("resources/panda.png", request.path());
+  ASSERT_EQ(cen::load_priority::normal, request.priority());
+  ASSERT_FALSE(request.is_ready());
+
+  loader.wait_decoded();
+  ASSERT_EQ(cen::load_status::decoded, request.status());
+  ASSERT_EQ(1u, loader.awaiting_upload());
+
+  ASSERT_EQ(1u, loader.upload(*mRenderer));
+  ASSERT_TRUE(request.is_ready());
+  ASSERT_TRUE(request.is_done());
+  ASSERT_TRUE(loader.idle());
+
+  const auto* texture = request.get();
+  ASSERT_TRUE(texture);
+  ASSERT_EQ(200, texture->width());
+  ASSERT_EQ(150, texture->height());
+}
+
+TEST_F(TextureLoaderTest, Failure)
+{
+  cen::texture_loader loader {1};
+
+  auto request = loader.load("foo.png");
+  loader.wait_decoded();
+
+  ASSERT_EQ(cen::load_status::failed, request.status());
+  ASSERT_FALSE(request.error().empty());
+  ASSERT_EQ(0u, loader.upload(*mRenderer));
+  ASSERT_EQ(nullptr, request.get());
+}
+
+TEST_F(TextureLoaderTest, Cancel)
+{
+  cen::texture_loader loader {1};
+
+  std::vector<cen::texture_request> requests;
+  for (int i = 0; i < 4; ++i) {
+    requests.push_back(loader.load("resources/panda.png", cen::load_priority::prefetch));
+  }
+
+  requests.at(3).cancel();
+  ASSERT_EQ(cen::load_status::cancelled, requests.at(3).status());
+
+  loader.wait_decoded();
+  requests.at(2).cancel();
+
+  loader.upload(*mRenderer, cen::texture_loader::ms_type {1'000});
+
+  ASSERT_TRUE(requests.at(0).is_ready());
+  ASSERT_TRUE(requests.at(1).is_ready());
+  ASSERT_EQ(cen::load_status::cancelled, requests.at(2).status());
+  ASSERT_EQ(cen::load_status::cancelled, requests.at(3).status());
+  ASSERT_EQ(nullptr, requests.at(3).get());
+  ASSERT_TRUE(loader.idle());
+}
+
+TEST_F(TextureLoaderTest, UploadPriority)
+{
+  cen::texture_loader loader {1};
+
+  auto prefetch = loader.load("resources/panda.png", cen::load_priority::prefetch);
+  auto normal = loader.load("resources/panda.png");
+  auto visible = loader.load("resources/panda.png", cen::load_priority::visible);
+
+  loader.wait_decoded();
+  prefetch.set_priority(cen::load_priority::visible);
+
+  // A zero budget still uploads one texture, which should be the oldest visible request
+  ASSERT_EQ(1u, loader.upload(*mRenderer, cen::texture_loader::ms_type {0}));
+  ASSERT_TRUE(prefetch.is_ready());
+  ASSERT_FALSE(normal.is_ready());
+
+  ASSERT_EQ(1u, loader.upload(*mRenderer, cen::texture_loader::ms_type {0}));
+  ASSERT_TRUE(visible.is_ready());
+  ASSERT_FALSE(normal.is_ready());
+}
+
+TEST_F(TextureLoaderTest, DestroyWithPendingRequests)
+{
+  cen::texture_request request;
+
+  {
+    cen::texture_loader loader {1};
+    for (int i = 0; i < 8; ++i) {
+      request = loader.load("resources/panda.png", cen::load_priority::prefetch);
+    }
+  }
+
+  ASSERT_FALSE(request.is_ready());
+  ASSERT_TRUE(request.is_done());
+}
+
+TEST(LoadPriority, ToString)
+{
+  ASSERT_THROW(to_string(static_cast<cen::load_priority>(3)), cen::exception);
+
+  ASSERT_EQ("prefetch", to_string(cen::load_priority::prefetch));
+  ASSERT_EQ("normal", to_string(cen::load_priority::normal));
+  ASSERT_EQ("visible", to_string(cen::load_priority::visible));
+
+  std::cout << "load_priority::visible == " << cen::load_priority::visible << '\n';
+}
+
+TEST(LoadStatus, ToString)
+{
+  ASSERT_THROW(to_string(static_cast<cen::load_status>(6)), cen::exception);
+
+  ASSERT_EQ("queued", to_string(cen::load_status::queued));
+  ASSERT_EQ("decoding", to_string(cen::load_status::decoding));
+  ASSERT_EQ("decoded", to_string(cen::load_status::decoded));
+  ASSERT_EQ("ready", to_string(cen::load_status::ready));
+  ASSERT_EQ("failed", to_string(cen::load_status::failed));
+  ASSERT_EQ("cancelled", to_string(cen::load_status::cancelled));
+
+  std::cout << "load_status::ready == " << cen::load_status::ready << '\n';
+}
@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <gtest/gtest.h>
+
+#include <memory>       // unique_ptr
+#include <type_traits>  // ...
+#include <vector>       // vector
+
+#include "centurion/video/renderer.hpp"
+#include "centurion/video/texture.hpp"
+#include "centurion/video/window.hpp"
+
+static_assert(std::is_final_v<cen::texture_lock>);
+
+static_assert(!std::is_copy_constructible_v<cen::texture_lock>);
+static_assert(!std::is_copy_assignable_v<cen::texture_lock>);
+
+class TextureLockTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+    mTexture = std::make_unique<cen::texture>(
+        mRenderer->make_texture({16, 8},
+                                cen::pixel_format::argb8888,
+                                cen::texture_access::streaming));
+  }
+
+  static void TearDownTestSuite()
+  {
+    mTexture.reset();
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+  inline static std::unique_ptr<cen::texture> mTexture;
+};
+
+TEST_F(TextureLockTest, LockEntireTexture)
+{
+  cen::texture_lock lock {*mTexture};
+  ASSERT_TRUE(lock);
+  ASSERT_TRUE(lock.pixels());
+  ASSERT_GE(lock.pitch(), 16 * 4);
+  ASSERT_EQ(4, lock.bytes_per_pixel());
+  ASSERT_EQ(cen::pixel_format::argb8888, lock.format());
+  ASSERT_EQ((cen::irect {0, 0, 16, 8}), lock.area());
+
+  for (int y = 0; y < lock.area().height(); ++y) {
+    auto* row = lock.row<cen::uint32>(y);
+    for (int x = 0; x < lock.area().width(); ++x) {
+      row[x] = 0xFF'00'FF'00;
+    }
+  }
+
+  lock.at<cen::uint32>(3, 2) = 0xFF'FF'00'00;
+  ASSERT_EQ(0xFF'FF'00'00u, lock.at<cen::uint32>(3, 2));
+
+  lock.unlock();
+  ASSERT_FALSE(lock);
+}
+
+TEST_F(TextureLockTest, LockArea)
+{
+  const cen::irect area {4, 2, 8, 4};
+
+  cen::texture_lock lock {*mTexture, area};
+  ASSERT_EQ(area, lock.area());
+
+  const std::vector<cen::uint32> pixels(32, 0xFF'00'00'FF);
+  lock.write(pixels.data(), 8 * 4);
+
+  ASSERT_EQ(0xFF'00'00'FFu, lock.at<cen::uint32>(7, 3));
+}
+
+TEST_F(TextureLockTest, LockStaticTexture)
+{
+  auto texture = mRenderer->make_texture({8, 8},
+                                         cen::pixel_format::argb8888,
+                                         cen::texture_access::non_lockable);
+  ASSERT_THROW(cen::texture_lock {texture}, cen::sdl_error);
+}
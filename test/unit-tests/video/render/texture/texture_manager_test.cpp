@@ -0,0 +1,201 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/texture_manager.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>       // unique_ptr
+#include <type_traits>  // ...
+#include <utility>      // move
+
+#include "centurion/video/window.hpp"
+
+static_assert(std::is_nothrow_copy_constructible_v<cen::managed_texture>);
+static_assert(std::is_nothrow_move_constructible_v<cen::managed_texture>);
+
+static_assert(!std::is_copy_constructible_v<cen::texture_manager>);
+static_assert(!std::is_move_constructible_v<cen::texture_manager>);
+
+class TextureManagerTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static constexpr cen::usize kImageBytes = 200u * 150u * 4u;
+  inline static constexpr const char* kImagePath = "resources/panda.png";
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(TextureManagerTest, Deduplication)
+{
+  cen::texture_manager manager {*mRenderer};
+
+  const auto first = manager.load(kImagePath);
+  const auto second = manager.load(kImagePath);
+
+  ASSERT_TRUE(first);
+  ASSERT_EQ(&first.get(), &second.get());
+  ASSERT_EQ(2u, first.use_count());
+  ASSERT_EQ(kImagePath, first.key());
+
+  const auto stats = manager.stats();
+  ASSERT_EQ(1u, stats.misses);
+  ASSERT_EQ(1u, stats.hits);
+  ASSERT_EQ(1u, stats.resident);
+  ASSERT_EQ(1u, stats.entries);
+  ASSERT_EQ(cen::texture_manager::estimate_bytes(first.get()), stats.resident_bytes);
+}
+
+TEST_F(TextureManagerTest, SurfaceDeduplication)
+{
+  cen::texture_manager manager {*mRenderer};
+
+  const cen::surface image {kImagePath};
+  const cen::surface copy {image};
+  const cen::surface other {{8, 8}, cen::pixel_format::rgba32};
+
+  const auto a = manager.load(image);
+  const auto b = manager.load(copy);
+  const auto c = manager.load(other);
+
+  ASSERT_EQ(&a.get(), &b.get());
+  ASSERT_NE(&a.get(), &c.get());
+  ASSERT_EQ(2u, manager.stats().entries);
+}
+
+TEST_F(TextureManagerTest, RleSurfaceDeduplication)
+{
+  cen::texture_manager manager {*mRenderer};
+
+  cen::surface image {kImagePath};
+  ASSERT_TRUE(image.set_rle(true));
+
+  // Blitting lets SDL encode the surface, after which it must be locked to be read
+  cen::surface target {image.size(), image.format_info().format()};
+  ASSERT_EQ(0, SDL_BlitSurface(image.get(), nullptr, target.get(), nullptr));
+
+  const auto a = manager.load(image);
+  const auto b = manager.load(image);
+
+  ASSERT_EQ(&a.get(), &b.get());
+  ASSERT_EQ(1u, manager.stats().entries);
+}
+
+TEST_F(TextureManagerTest, FailedLoadIsForgotten)
+{
+  cen::texture_manager manager {*mRenderer};
+
+  ASSERT_THROW(manager.load("resources/missing.png"), cen::img_error);
+  ASSERT_EQ(0u, manager.stats().entries);
+  ASSERT_FALSE(manager.is_resident("resources/missing.png"));
+}
+
+TEST_F(TextureManagerTest, EvictionAndReload)
+{
+  cen::texture_manager manager {*mRenderer, 0};
+
+  auto handle = manager.load(kImagePath);
+  ASSERT_TRUE(manager.is_resident(kImagePath));  // Referenced textures are never evicted
+
+  handle.reset();
+  ASSERT_FALSE(handle);
+  ASSERT_FALSE(manager.is_resident(kImagePath));
+
+  auto stats = manager.stats();
+  ASSERT_EQ(0u, stats.resident_bytes);
+  ASSERT_EQ(0u, stats.resident);
+  ASSERT_EQ(1u, stats.entries);
+  ASSERT_EQ(1u, stats.evictions);
+
+  handle = manager.load(kImagePath);
+  ASSERT_TRUE(manager.is_resident(kImagePath));
+  ASSERT_EQ(1u, manager.stats().reloads);
+}
+
+TEST_F(TextureManagerTest, LeastRecentlyUsedIsEvicted)
+{
+  cen::texture_manager manager {*mRenderer};
+
+  const cen::surface image {kImagePath};
+  const cen::surface other {{16, 16}, cen::pixel_format::rgba32};
+
+  {
+    const auto a = manager.load(image);
+    const auto b = manager.load(kImagePath);
+    const auto c = manager.load(other);
+
+    (void) a.get();  // Now used more recently than b
+  }
+
+  manager.set_budget(manager.stats().resident_bytes - 1);
+
+  ASSERT_FALSE(manager.is_resident(kImagePath));
+  ASSERT_EQ(2u, manager.stats().resident);
+  ASSERT_EQ(1u, manager.stats().evictions);
+
+  manager.evict_unused();
+  ASSERT_EQ(0u, manager.stats().resident);
+  ASSERT_EQ(3u, manager.stats().entries);
+
+  manager.purge();
+  ASSERT_EQ(0u, manager.stats().entries);
+}
+
+TEST_F(TextureManagerTest, HandleSemantics)
+{
+  cen::texture_manager manager {*mRenderer};
+
+  cen::managed_texture empty;
+  ASSERT_FALSE(empty);
+  ASSERT_EQ(0u, empty.use_count());
+
+  auto handle = manager.load(kImagePath);
+  auto copy = handle;
+  ASSERT_EQ(2u, handle.use_count());
+
+  auto moved = std::move(copy);
+  ASSERT_EQ(2u, moved.use_count());
+
+  moved = handle;
+  ASSERT_EQ(2u, moved.use_count());
+
+  handle = cen::managed_texture {};
+  ASSERT_EQ(1u, moved.use_count());
+
+  manager.reset_stats();
+  ASSERT_EQ(0u, manager.stats().misses);
+  ASSERT_EQ(kImageBytes, manager.stats().resident_bytes);
+}
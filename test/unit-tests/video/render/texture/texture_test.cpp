@@ -30,6 +30,7 @@
 #include <iostream>     // cout
 #include <memory>       // unique_ptr
 #include <type_traits>  // ...
+#include <vector>       // vector
 
 #include "centurion/video/color.hpp"
 #include "centurion/video/window.hpp"
@@ -210,6 +211,47 @@ TEST_F(TextureTest, StreamOperator)
   std::cout << *mTexture << '\n';
 }
 
+TEST_F(TextureTest, Update)
+{
+  auto texture = mRenderer->make_texture({8, 8},
+                                         cen::pixel_format::argb8888,
+                                         cen::texture_access::streaming);
+
+  const std::vector<cen::uint32> pixels(64, 0xFF'FF'00'00);
+  ASSERT_TRUE(texture.update(pixels.data(), 8 * 4));
+  ASSERT_TRUE(texture.update(cen::irect {2, 2, 4, 4}, pixels.data(), 4 * 4));
+
+  const cen::surface image {{8, 8}, cen::pixel_format::argb8888};
+  ASSERT_TRUE(texture.update(image));
+}
+
+TEST_F(TextureTest, UpdateYUV)
+{
+  auto texture =
+      mRenderer->make_texture({8, 8}, cen::pixel_format::iyuv, cen::texture_access::streaming);
+
+  const std::vector<cen::uint8> y(64, 0x80);
+  const std::vector<cen::uint8> uv(16, 0x80);
+  ASSERT_TRUE(texture.update_yuv(y.data(), 8, uv.data(), 4, uv.data(), 4));
+  ASSERT_TRUE(
+      texture.update_yuv(cen::irect {0, 0, 4, 4}, y.data(), 8, uv.data(), 4, uv.data(), 4));
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 16)
+
+TEST_F(TextureTest, UpdateNV)
+{
+  auto texture =
+      mRenderer->make_texture({8, 8}, cen::pixel_format::nv12, cen::texture_access::streaming);
+
+  const std::vector<cen::uint8> y(64, 0x80);
+  const std::vector<cen::uint8> uv(32, 0x80);
+  ASSERT_TRUE(texture.update_nv(y.data(), 8, uv.data(), 8));
+  ASSERT_TRUE(texture.update_nv(cen::irect {0, 0, 4, 4}, y.data(), 8, uv.data(), 8));
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 16)
+
 #if SDL_VERSION_ATLEAST(2, 0, 12)
 
 TEST_F(TextureTest, SetScaleMode)
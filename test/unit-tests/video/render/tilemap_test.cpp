@@ -0,0 +1,137 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/tilemap.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>  // unique_ptr
+
+#include "centurion/video/window.hpp"
+
+class TilemapTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>("Centurion", cen::iarea {800, 600});
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+    mTileset = std::make_unique<cen::texture>(mRenderer->make_texture("resources/panda.png"));
+  }
+
+  static void TearDownTestSuite()
+  {
+    mTileset.reset();
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+  inline static std::unique_ptr<cen::texture> mTileset;
+};
+
+TEST_F(TilemapTest, Construction)
+{
+  ASSERT_THROW(cen::tilemap(*mTileset, {0, 16}, {8, 8}), cen::exception);
+  ASSERT_THROW(cen::tilemap(*mTileset, {16, 16}, {8, 0}), cen::exception);
+  ASSERT_THROW(cen::tilemap(*mTileset, {16, 16}, {8, 8}, 0), cen::exception);
+
+  const cen::tilemap map {*mTileset, {16, 16}, {100, 40}, 16};
+  ASSERT_EQ(7u * 3u, map.chunk_count());
+  ASSERT_EQ(16, map.chunk_size());
+  ASSERT_EQ(100, map.size().width);
+  ASSERT_EQ(40, map.size().height);
+  ASSERT_EQ(0u, map.resident_chunks());
+  ASSERT_EQ(cen::tilemap::empty_tile, map.tile(99, 39));
+}
+
+TEST_F(TilemapTest, Source)
+{
+  const cen::tilemap map {*mTileset, {16, 16}, {8, 8}};
+
+  // The tileset is 200 pixels wide, so there are 12 tiles on each row
+  ASSERT_EQ(cen::irect(0, 0, 16, 16), map.source(1));
+  ASSERT_EQ(cen::irect(176, 0, 16, 16), map.source(12));
+  ASSERT_EQ(cen::irect(0, 16, 16, 16), map.source(13));
+}
+
+TEST_F(TilemapTest, Render)
+{
+  cen::tilemap map {*mTileset, {16, 16}, {256, 256}, 16};
+  map.fill(1);
+
+  ASSERT_TRUE(map.render(*mRenderer));
+
+  // An 800x600 viewport intersects 4x3 chunks of 256x256 pixels
+  ASSERT_EQ(12u, map.stats().baked);
+  ASSERT_EQ(12u, map.stats().rendered);
+  ASSERT_EQ(256u - 12u, map.stats().culled);
+  ASSERT_EQ(12u, map.resident_chunks());
+
+  // The render target should be restored after baking
+  ASSERT_FALSE(mRenderer->get_target());
+
+  ASSERT_TRUE(map.render(*mRenderer));
+  ASSERT_EQ(0u, map.stats().baked);
+  ASSERT_EQ(12u, map.stats().rendered);
+
+  map.set_tile(3, 3, 2);
+  map.set_tile(200, 200, 2);  // Not visible, so not baked yet
+  ASSERT_EQ(2u, map.tile(3, 3));
+
+  ASSERT_TRUE(map.render(*mRenderer));
+  ASSERT_EQ(1u, map.stats().baked);
+
+  ASSERT_TRUE(map.render(*mRenderer, {3'000, 3'000}));
+  ASSERT_EQ(16u, map.stats().rendered);
+  ASSERT_EQ(16u, map.stats().baked);
+
+  ASSERT_TRUE(map.render(*mRenderer, {-5'000, 0}));
+  ASSERT_EQ(0u, map.stats().rendered);
+  ASSERT_EQ(256u, map.stats().culled);
+
+  map.release_chunks();
+  ASSERT_EQ(0u, map.resident_chunks());
+}
+
+TEST_F(TilemapTest, RenderRestoresViewportAndClip)
+{
+  cen::tilemap map {*mTileset, {16, 16}, {64, 64}, 16};
+  map.fill(1);
+
+  const cen::irect viewport {10, 20, 400, 300};
+  const cen::irect clip {30, 40, 100, 50};
+  ASSERT_TRUE(mRenderer->set_viewport(viewport));
+  ASSERT_TRUE(mRenderer->set_clip(clip));
+
+  ASSERT_TRUE(map.render(*mRenderer));
+  ASSERT_LT(0u, map.stats().baked);
+
+  ASSERT_EQ(viewport, mRenderer->viewport());
+  ASSERT_TRUE(mRenderer->is_clipping_enabled());
+  ASSERT_EQ(clip, mRenderer->clip());
+
+  ASSERT_TRUE(mRenderer->reset_clip());
+  ASSERT_TRUE(mRenderer->set_viewport({0, 0, 800, 600}));
+}
@@ -0,0 +1,215 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/resource_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>       // unique_ptr
+#include <type_traits>  // ...
+#include <utility>      // move
+#include <vector>       // vector
+
+#include "centurion/video/window.hpp"
+
+static_assert(!std::is_copy_constructible_v<cen::surface_lease>);
+static_assert(std::is_nothrow_move_constructible_v<cen::surface_lease>);
+static_assert(std::is_nothrow_move_assignable_v<cen::texture_lease>);
+
+static_assert(!std::is_copy_constructible_v<cen::surface_pool>);
+static_assert(!std::is_move_constructible_v<cen::texture_pool>);
+
+static_assert(cen::surface_pool::size_class(1) == 16);
+static_assert(cen::surface_pool::size_class(16) == 16);
+static_assert(cen::surface_pool::size_class(17) == 20);
+static_assert(cen::surface_pool::size_class(100) == 112);
+static_assert(cen::surface_pool::size_class(1'080) == 1'280);
+static_assert(cen::surface_pool::size_class(1'920) == 2'048);
+
+class ResourcePoolTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(ResourcePoolTest, SurfaceSizeClasses)
+{
+  cen::surface_pool pool;
+
+  {
+    auto lease = pool.acquire({100, 30}, cen::pixel_format::rgba32);
+    ASSERT_TRUE(lease);
+    ASSERT_EQ(112, lease.get().width());
+    ASSERT_EQ(32, lease.get().height());
+    ASSERT_EQ(100, lease.size().width);
+    ASSERT_EQ(30, lease.size().height);
+    ASSERT_EQ((cen::irect {0, 0, 100, 30}), lease.get().clip());
+  }
+
+  /* Requests in the same size class and format share surfaces */
+  {
+    ASSERT_EQ(1u, pool.stats().idle);
+
+    auto lease = pool.acquire({110, 29}, cen::pixel_format::rgba32);
+    ASSERT_EQ((cen::irect {0, 0, 110, 29}), lease.get().clip());
+  }
+
+  {
+    auto lease = pool.acquire({100, 30}, cen::pixel_format::bgra32);
+    ASSERT_EQ(cen::pixel_format::bgra32, lease.get().format_info().format());
+  }
+
+  const auto& stats = pool.stats();
+  ASSERT_EQ(3u, stats.requests);
+  ASSERT_EQ(1u, stats.reuses);
+  ASSERT_EQ(2u, stats.allocations);
+  ASSERT_EQ(0u, stats.leased);
+  ASSERT_EQ(2u, stats.idle);
+  ASSERT_EQ(1u, stats.peak_leased);
+  ASSERT_EQ(2u * 112u * 4u * 32u, stats.idle_bytes);
+  ASSERT_EQ(stats.idle_bytes, stats.peak_bytes);
+  ASSERT_DOUBLE_EQ(1.0 / 3.0, stats.reuse_rate());
+
+  pool.release_idle();
+  ASSERT_EQ(0u, pool.stats().idle);
+  ASSERT_EQ(0u, pool.stats().idle_bytes);
+
+  pool.reset_stats();
+  ASSERT_EQ(0u, pool.stats().requests);
+  ASSERT_EQ(0u, pool.stats().peak_bytes);
+}
+
+TEST_F(ResourcePoolTest, SurfaceBudget)
+{
+  constexpr auto bytes = 16u * 16u * 4u;
+  cen::surface_pool pool {bytes};
+
+  {
+    std::vector<cen::surface_lease> leases;
+    leases.push_back(pool.acquire({8, 8}));
+    leases.push_back(pool.acquire({8, 8}));
+    ASSERT_EQ(2u, pool.stats().leased);
+    ASSERT_EQ(2u * bytes, pool.stats().leased_bytes);
+  }
+
+  /* Only one of the returned surfaces fits in the idle budget */
+  ASSERT_EQ(1u, pool.stats().idle);
+  ASSERT_EQ(1u, pool.stats().discards);
+  ASSERT_EQ(2u * bytes, pool.stats().peak_bytes);
+
+  pool.set_budget(0);
+  ASSERT_EQ(0u, pool.stats().idle);
+  ASSERT_EQ(0u, pool.budget());
+}
+
+TEST_F(ResourcePoolTest, LeaseMoveAndReset)
+{
+  cen::surface_pool pool;
+
+  auto lease = pool.acquire({32, 32});
+  auto other = std::move(lease);
+  ASSERT_FALSE(lease);
+  ASSERT_TRUE(other);
+  ASSERT_EQ(1u, pool.stats().leased);
+
+  lease = pool.acquire({64, 64});
+  lease = std::move(other);
+  ASSERT_EQ(1u, pool.stats().leased);
+  ASSERT_EQ(32, lease.get().width());
+
+  lease.reset();
+  ASSERT_FALSE(lease);
+  ASSERT_EQ(0u, pool.stats().leased);
+  ASSERT_EQ(2u, pool.stats().idle);
+}
+
+TEST_F(ResourcePoolTest, RecycledSurfaceStateIsReset)
+{
+  cen::surface_pool pool;
+
+  {
+    auto lease = pool.acquire({16, 16});
+    auto& image = lease.get();
+    image.set_blend_mode(cen::blend_mode::add);
+    image.set_color_mod(cen::colors::red);
+    image.set_alpha_mod(0x80);
+    ASSERT_EQ(0, SDL_SetColorKey(image.get(), SDL_TRUE, 0));
+  }
+
+  auto lease = pool.acquire({16, 16});
+  const auto& image = lease.get();
+  ASSERT_EQ(1u, pool.stats().reuses);
+  ASSERT_EQ(cen::blend_mode::blend, image.get_blend_mode());
+  ASSERT_EQ(cen::colors::white, image.color_mod());
+  ASSERT_EQ(0xFF, image.alpha());
+  ASSERT_FALSE(SDL_HasColorKey(image.get()));
+}
+
+TEST_F(ResourcePoolTest, Textures)
+{
+  cen::texture_pool pool {*mRenderer};
+
+  SDL_Texture* first {};
+  {
+    auto lease = pool.acquire({64, 32});
+    first = lease.get().get();
+    ASSERT_TRUE(lease.get().is_target());
+    ASSERT_EQ(64, lease.get().width());
+    ASSERT_EQ(32, lease.get().height());
+
+    ASSERT_TRUE(mRenderer->set_target(lease.get()));
+    ASSERT_TRUE(mRenderer->reset_target());
+  }
+
+  {
+    auto lease = pool.acquire({64, 32});
+    ASSERT_EQ(first, lease.get().get());
+
+    /* Textures are only shared between identical requests */
+    auto streaming = pool.acquire({64, 32},
+                                  cen::pixel_format::rgba8888,
+                                  cen::texture_access::streaming);
+    ASSERT_NE(first, streaming.get().get());
+    ASSERT_EQ(cen::texture_access::streaming, streaming.get().access());
+  }
+
+  const auto& stats = pool.stats();
+  ASSERT_EQ(3u, stats.requests);
+  ASSERT_EQ(1u, stats.reuses);
+  ASSERT_EQ(2u, stats.allocations);
+  ASSERT_EQ(2u, stats.peak_leased);
+  ASSERT_EQ(2u * 64u * 32u * 4u, stats.idle_bytes);
+}
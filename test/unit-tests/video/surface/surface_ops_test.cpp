@@ -0,0 +1,210 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/surface_ops.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>   // memcmp
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
+
+#include "centurion/concurrency/thread_pool.hpp"
+
+namespace {
+
+inline constexpr auto kPath = "resources/panda.png";
+
+[[nodiscard]] auto same_pixels(const cen::surface& a, const cen::surface& b) -> bool
+{
+  if (a.size() != b.size()) {
+    return false;
+  }
+
+  const auto rowBytes = static_cast<cen::usize>(a.width() * a.get()->format->BytesPerPixel);
+  for (int y = 0; y < a.height(); ++y) {
+    const auto* rowA = static_cast<const cen::uint8*>(a.pixel_data()) + y * a.pitch();
+    const auto* rowB = static_cast<const cen::uint8*>(b.pixel_data()) + y * b.pitch();
+    if (std::memcmp(rowA, rowB, rowBytes) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+class SurfaceOpsTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mPool = std::make_unique<cen::thread_pool>(3);
+    mSurface = std::make_unique<cen::surface>(
+        cen::surface {kPath}.convert_to(cen::pixel_format::rgba32));
+  }
+
+  static void TearDownTestSuite()
+  {
+    mSurface.reset();
+    mPool.reset();
+  }
+
+  inline static std::unique_ptr<cen::thread_pool> mPool;
+  inline static std::unique_ptr<cen::surface> mSurface;
+};
+
+TEST_F(SurfaceOpsTest, Resize)
+{
+  for (const auto filter :
+       {cen::resize_filter::box, cen::resize_filter::bilinear, cen::resize_filter::lanczos}) {
+    const auto serial = cen::resized(*mSurface, {64, 48}, filter);
+    const auto parallel = cen::resized(*mSurface, {64, 48}, filter, mPool.get());
+
+    ASSERT_EQ(64, serial.width());
+    ASSERT_EQ(48, serial.height());
+    ASSERT_EQ(mSurface->format_info().format(), serial.format_info().format());
+    ASSERT_TRUE(same_pixels(serial, parallel));
+
+    const auto upscaled = cen::resized(*mSurface, {320, 200}, filter, mPool.get());
+    ASSERT_EQ(320, upscaled.width());
+  }
+
+  // Resizing to the same size should produce an identical copy
+  const auto copy = cen::resized(*mSurface, mSurface->size());
+  ASSERT_TRUE(same_pixels(*mSurface, copy));
+
+  cen::surface other {{10, 10}, cen::pixel_format::bgra32};
+  ASSERT_FALSE(cen::resize(*mSurface, other));
+  ASSERT_FALSE(cen::resize(*mSurface, *mSurface));
+
+  cen::surface empty {{0, 10}, cen::pixel_format::rgba32};
+  ASSERT_FALSE(cen::resize(*mSurface, empty));
+  ASSERT_FALSE(cen::resize(empty, *mSurface));
+  ASSERT_TRUE(cen::box_blur(empty, 2));
+}
+
+TEST_F(SurfaceOpsTest, ParallelRowsRethrowsTaskExceptions)
+{
+  const auto fn = [](const int begin, const int) {
+    if (begin != 0) {
+      throw cen::exception {"Band failure!"};
+    }
+  };
+
+  ASSERT_THROW(cen::detail::parallel_rows(mPool.get(), 1024, fn), cen::exception);
+}
+
+TEST_F(SurfaceOpsTest, ResizePreservesFlatColors)
+{
+  cen::surface flat {{40, 30}, cen::pixel_format::rgb24};
+  auto* pixels = static_cast<cen::uint8*>(flat.pixel_data());
+  for (int y = 0; y < flat.height(); ++y) {
+    for (int x = 0; x < flat.width() * 3; ++x) {
+      pixels[y * flat.pitch() + x] = static_cast<cen::uint8>(50 + 40 * (x % 3));
+    }
+  }
+
+  const auto result = cen::resized(flat, {13, 77}, cen::resize_filter::lanczos);
+  const auto* out = static_cast<const cen::uint8*>(result.pixel_data());
+  for (int y = 0; y < result.height(); ++y) {
+    for (int x = 0; x < result.width() * 3; ++x) {
+      ASSERT_EQ(50 + 40 * (x % 3), out[y * result.pitch() + x]);
+    }
+  }
+}
+
+TEST_F(SurfaceOpsTest, Blur)
+{
+  auto serial = *mSurface;
+  auto parallel = *mSurface;
+
+  ASSERT_TRUE(cen::box_blur(serial, 4));
+  ASSERT_TRUE(cen::box_blur(parallel, 4, mPool.get()));
+  ASSERT_TRUE(same_pixels(serial, parallel));
+  ASSERT_FALSE(same_pixels(serial, *mSurface));
+
+  serial = *mSurface;
+  parallel = *mSurface;
+
+  ASSERT_TRUE(cen::gaussian_blur(serial, 2.5f));
+  ASSERT_TRUE(cen::gaussian_blur(parallel, 2.5f, mPool.get()));
+  ASSERT_TRUE(same_pixels(serial, parallel));
+
+  auto unchanged = *mSurface;
+  ASSERT_TRUE(cen::box_blur(unchanged, 0));
+  ASSERT_TRUE(cen::gaussian_blur(unchanged, 0));
+  ASSERT_TRUE(same_pixels(unchanged, *mSurface));
+
+  ASSERT_FALSE(cen::box_blur(unchanged, -1));
+  ASSERT_FALSE(cen::gaussian_blur(unchanged, -1));
+}
+
+TEST_F(SurfaceOpsTest, TransformColors)
+{
+  auto surface = *mSurface;
+
+  ASSERT_TRUE(cen::transform_colors(surface, cen::color_matrix::identity(), mPool.get()));
+  ASSERT_TRUE(same_pixels(surface, *mSurface));
+
+  ASSERT_TRUE(cen::transform_colors(surface, cen::color_matrix::grayscale(), mPool.get()));
+
+  const auto* pixels = static_cast<const cen::uint8*>(surface.pixel_data());
+  for (int x = 0; x < surface.width(); ++x) {
+    const auto* pixel = pixels + 4 * x;
+    ASSERT_EQ(pixel[0], pixel[1]);
+    ASSERT_EQ(pixel[1], pixel[2]);
+  }
+
+  constexpr auto matrix = cen::color_matrix::brightness(0.1f) * cen::color_matrix::contrast(2);
+  ASSERT_FLOAT_EQ(2.0f, matrix.rows[0][0]);
+  ASSERT_FLOAT_EQ(-0.4f, matrix.rows[0][4]);
+}
+
+TEST_F(SurfaceOpsTest, TransformPixels)
+{
+  auto surface = *mSurface;
+
+  const auto invert = [](const cen::color& color) {
+    return cen::color {static_cast<cen::uint8>(255 - color.red()),
+                       static_cast<cen::uint8>(255 - color.green()),
+                       static_cast<cen::uint8>(255 - color.blue()),
+                       color.alpha()};
+  };
+
+  ASSERT_TRUE(cen::transform_pixels(surface, invert, mPool.get()));
+  ASSERT_TRUE(cen::transform_pixels(surface, invert));
+  ASSERT_TRUE(same_pixels(surface, *mSurface));
+}
+
+TEST_F(SurfaceOpsTest, ResizeFilterToString)
+{
+  ASSERT_THROW(cen::to_string(static_cast<cen::resize_filter>(3)), cen::exception);
+
+  ASSERT_EQ("box", cen::to_string(cen::resize_filter::box));
+  ASSERT_EQ("bilinear", cen::to_string(cen::resize_filter::bilinear));
+  ASSERT_EQ("lanczos", cen::to_string(cen::resize_filter::lanczos));
+
+  std::cout << "resize_filter::lanczos == " << cen::resize_filter::lanczos << '\n';
+}
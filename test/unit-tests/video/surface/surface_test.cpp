@@ -241,3 +241,65 @@ TEST_F(SurfaceTest, StreamOperator)
 {
   std::cout << *mSurface << '\n';
 }
+
+TEST_F(SurfaceTest, ConvertInto)
+{
+  const auto source = mSurface->convert_to(cen::pixel_format::rgba8888);
+
+  cen::surface target {source.size(), cen::pixel_format::bgr24};
+  ASSERT_TRUE(source.convert_into(target));
+
+  cen::surface roundTrip {source.size(), cen::pixel_format::argb8888};
+  ASSERT_TRUE(target.convert_into(roundTrip));
+
+  const auto* original = static_cast<const cen::uint32*>(source.pixel_data());
+  const auto* converted = static_cast<const cen::uint32*>(roundTrip.pixel_data());
+
+  // The colors survive the round trip, but the alpha channel is lost
+  const auto rgba = original[source.width() + 1];
+  const auto argb = converted[roundTrip.pitch() / 4 + 1];
+  ASSERT_EQ(rgba >> 8u, argb & 0xFF'FF'FFu);
+  ASSERT_EQ(0xFFu, argb >> 24u);
+
+  cen::surface small {{10, 10}, cen::pixel_format::rgba8888};
+  ASSERT_FALSE(source.convert_into(small));
+
+  cen::pixel_buffer buffer;
+  ASSERT_TRUE(source.convert_into(buffer, cen::pixel_format::rgb24));
+  ASSERT_EQ(source.size(), buffer.size());
+  ASSERT_EQ(0, buffer.pitch() % cen::pixel_buffer::alignment);
+}
+
+TEST_F(SurfaceTest, PremultiplyAlpha)
+{
+  cen::surface surface {{4, 4}, cen::pixel_format::rgba8888};
+  auto* pixels = static_cast<cen::uint32*>(surface.pixel_data());
+
+  pixels[0] = 0xFF'80'40'80u;  // 50% alpha
+  pixels[1] = 0xFF'FF'FF'00u;  // Fully transparent
+
+  ASSERT_TRUE(surface.premultiply_alpha());
+  ASSERT_EQ(0x80'40'20'80u, pixels[0]);
+  ASSERT_EQ(0u, pixels[1]);
+
+  ASSERT_TRUE(surface.unpremultiply_alpha());
+  ASSERT_EQ(0xFF'80'40'80u, pixels[0]);
+
+  cen::surface opaque {{4, 4}, cen::pixel_format::rgb24};
+  ASSERT_FALSE(opaque.premultiply_alpha());
+}
+
+TEST_F(SurfaceTest, BakeColorMod)
+{
+  cen::surface surface {{4, 4}, cen::pixel_format::argb8888};
+  auto* pixels = static_cast<cen::uint32*>(surface.pixel_data());
+  pixels[0] = 0xFF'FF'FF'FFu;
+
+  surface.set_color_mod(cen::color {0xFF, 0x80, 0x00});
+  surface.set_alpha_mod(0x40);
+
+  ASSERT_TRUE(surface.bake_color_mod());
+  ASSERT_EQ(0x40'FF'80'00u, pixels[0]);
+  ASSERT_EQ(cen::colors::white, surface.color_mod());
+  ASSERT_EQ(0xFF, surface.alpha());
+}